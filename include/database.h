@@ -5,6 +5,10 @@
 #include <stdbool.h>
 #include <time.h>
 
+// Database location and lock wait
+#define DATABASE_PATH "data/automation.db"
+#define DATABASE_BUSY_TIMEOUT_MS 5000
+
 // Database connection
 extern sqlite3 *db;
 
@@ -65,10 +69,116 @@ typedef struct {
     char status[32];
 } ScheduledTask;
 
+// One execution of a scheduled task (task_id is scheduled_tasks.id)
+typedef struct {
+    long long id;
+    int task_id;
+    time_t start_time;
+    time_t end_time;
+    int exit_code;
+    long long duration_ms;
+    long long output_bytes;
+} TaskRun;
+
+// Run statistics of one task, or of all tasks for task_id 0
+typedef struct {
+    long long run_count;
+    long long success_count;            // exit code 0
+    long long failure_count;
+    double avg_duration_ms;
+    long long max_duration_ms;
+    long long total_output_bytes;
+    time_t last_run;
+    int last_exit_code;
+} TaskRunStats;
+
+// Rollup resolutions (bucket width in seconds)
+typedef enum {
+    ROLLUP_1MIN = 60,
+    ROLLUP_1HOUR = 3600,
+    ROLLUP_1DAY = 86400
+} RollupResolution;
+
+// How long each rollup tier is kept by cleanup_old_records() (0 = forever)
+#define ROLLUP_1MIN_KEEP_DAYS 30
+#define ROLLUP_1HOUR_KEEP_DAYS 365
+#define ROLLUP_1DAY_KEEP_DAYS 0
+
+// Default number of points a dashboard query is allowed to return
+#define ROLLUP_DEFAULT_MAX_POINTS 1000
+
+// Aggregated values of a single metric inside a rollup bucket.
+// p95 is computed by the first finalize_metric_rollups pass after the bucket
+// closes (the retention worker runs one when idle); until then max is reported.
+typedef struct {
+    double min;
+    double max;
+    double avg;
+    double p95;
+} MetricAggregate;
+
+// System metrics rollup bucket
+typedef struct {
+    time_t bucket_start;
+    RollupResolution resolution;
+    char hostname[256];
+    int sample_count;
+    MetricAggregate cpu;
+    MetricAggregate memory;
+    MetricAggregate disk;
+} SystemMetricsRollup;
+
+// Network metrics rollup bucket (ping aggregates only cover samples with ping_time >= 0)
+typedef struct {
+    time_t bucket_start;
+    RollupResolution resolution;
+    char target[256];
+    int sample_count;
+    int success_count;
+    int ping_count;
+    MetricAggregate ping;
+} NetworkMetricsRollup;
+
+// Row counts of the main tables
+typedef struct {
+    long long system_metrics;
+    long long archived_system_metrics;  // rows packed into archive blocks
+    long long file_operations;
+    long long network_metrics;
+    long long security_scans;
+    long long scheduled_tasks;
+} TableCounts;
+
+// Storage used by one table or index (from the dbstat virtual table)
+typedef struct {
+    char name[128];
+    long long pages;
+    long long bytes;
+} TableSize;
+
+// Page-level layout of the database file
+typedef struct {
+    int page_size;
+    long long page_count;
+    long long freelist_count;
+    long long total_bytes;              // page_size * page_count
+} DatabasePageStats;
+
+// min/max/avg of one metric column over a time window
+typedef struct {
+    long long sample_count;
+    double min;
+    double max;
+    double avg;
+} MetricSummary;
+
 // Database operations for system metrics
 bool insert_system_metrics(const SystemMetrics *metrics);
 bool get_system_metrics_history(SystemMetrics **metrics, int *count, int limit);
 bool get_system_metrics_by_date(SystemMetrics **metrics, int *count, const char *date);
+bool get_system_metrics_range(SystemMetrics **metrics, int *count, time_t from, time_t to);
+// Last few minutes of samples, oldest first; usually answered from memory
+bool get_recent_system_metrics(SystemMetrics **metrics, int *count);
 
 // Database operations for file operations
 bool insert_file_operation(const FileOperation *operation);
@@ -91,6 +201,36 @@ bool update_scheduled_task(const ScheduledTask *task);
 bool delete_scheduled_task(int task_id);
 bool get_scheduled_tasks(ScheduledTask **tasks, int *count);
 bool get_scheduled_task_by_id(ScheduledTask *task, int task_id);
+// Inserts or updates the task with the same task_name and fills in task->id
+bool upsert_scheduled_task(ScheduledTask *task);
+
+// Task run history. Runs are buffered and written TASK_RUN_BATCH_SIZE at a
+// time; reads, close_database and the retention worker's idle pass flush
+// the buffer first.
+#define TASK_RUN_BATCH_SIZE 32
+#define TASK_RUN_FLUSH_SECONDS 60
+bool record_task_run(const TaskRun *run);
+bool flush_task_runs(void);
+bool get_task_runs(int task_id, TaskRun **runs, int *count, int limit);
+bool get_task_run_stats(int task_id, TaskRunStats *stats);
+
+// Metric rollups (1 minute / 1 hour / 1 day), maintained on every insert
+RollupResolution select_rollup_resolution(time_t from, time_t to, int max_points);
+bool get_system_metrics_rollup(time_t from, time_t to, int max_points,
+                               SystemMetricsRollup **rows, int *count);
+bool get_network_metrics_rollup(time_t from, time_t to, int max_points,
+                                NetworkMetricsRollup **rows, int *count);
+bool finalize_metric_rollups(void);
+bool rebuild_metric_rollups(void);
+
+// Aggregate queries, evaluated inside SQLite (no rows are copied out).
+// Metric names: cpu_usage, memory_usage, disk_usage, ping_time, threats_found
+bool get_table_counts(TableCounts *counts);
+bool get_table_sizes(TableSize **sizes, int *count);
+bool get_database_page_stats(DatabasePageStats *stats);
+// Summaries read raw rows only: system metrics already moved into the
+// archive are not counted (use the rollups for long ranges)
+bool get_metric_summary(const char *metric, time_t from, time_t to, MetricSummary *summary);
 
 // Utility functions
 bool create_tables(void);
@@ -98,9 +238,31 @@ bool execute_query(const char *query);
 char* get_timestamp_string(time_t timestamp);
 time_t parse_timestamp_string(const char *timestamp_str);
 
-// Database maintenance
+// Retention tuning: rows deleted per transaction, pause between batches,
+// pages released per incremental_vacuum step, worker idle interval
+#define RETENTION_BATCH_ROWS 1000
+#define RETENTION_BATCH_PAUSE_MS 50
+#define RETENTION_VACUUM_PAGES 256
+#define RETENTION_IDLE_SECONDS 60
+
+// Compressed archive blocks (metrics_archive.h) outlive the raw rows they
+// replace; they are trimmed on their own schedule (0 = forever)
+#define ARCHIVE_RETENTION_DEFAULT_DAYS 365
+
+// Database maintenance. cleanup_old_records archives expired system metrics
+// (whole days, see metrics_archive.h) instead of deleting them unless
+// archiving is turned off, then deletes the other tables in batches.
 bool cleanup_old_records(int days_to_keep);
 bool vacuum_database(void);
+bool incremental_vacuum_database(int max_pages);
+bool reclaim_free_pages(int pages_per_step, int pause_ms);
 bool backup_database(const char *backup_path);
 
+// Background retention worker (own connection, batched deletes). Expired
+// system metrics are archived one whole day per pass; archive blocks are
+// kept archive_days_to_keep days (0 = forever, never less than the raw rows,
+// negative = no archiving)
+bool start_retention_worker(int days_to_keep, int archive_days_to_keep);
+void stop_retention_worker(void);
+
 #endif // DATABASE_H
\ No newline at end of file
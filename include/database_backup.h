@@ -0,0 +1,45 @@
+/*
+ * ========================================
+ * Database Backup Header - Çevrimiçi Veritabanı Yedekleme
+ * ========================================
+ */
+
+#ifndef DATABASE_BACKUP_H
+#define DATABASE_BACKUP_H
+
+#include "database.h"
+#include "file_compress.h"
+
+// Pacing defaults: pages copied per sqlite3_backup_step() call, pause
+// between steps, and how many consecutive BUSY/LOCKED steps are tolerated
+#define DB_BACKUP_PAGES_PER_STEP 128
+#define DB_BACKUP_STEP_PAUSE_MS 20
+#define DB_BACKUP_MAX_RETRIES 100
+
+// Called after every successful step
+typedef void (*DatabaseBackupProgress)(int copied_pages, int total_pages, void *user_data);
+
+typedef struct {
+    int pages_per_step;
+    int step_pause_ms;
+    int max_retries;
+    bool compressed;                    // write a compressed, checksummed snapshot
+    DatabaseBackupProgress progress;
+    void *user_data;
+} DatabaseBackupOptions;
+
+// checksum is the CRC-32 of the uncompressed database
+typedef CompressedFileInfo DatabaseSnapshotInfo;
+
+void init_database_backup_options(DatabaseBackupOptions *options);
+
+// Online backup of the open database; options may be NULL for defaults
+bool backup_database_paced(const char *backup_path, const DatabaseBackupOptions *options);
+
+// Snapshot files: the database file packed with compress_file()
+bool write_database_snapshot(const char *database_path, const char *snapshot_path,
+                             DatabaseSnapshotInfo *info);
+bool verify_database_snapshot(const char *snapshot_path, DatabaseSnapshotInfo *info);
+bool restore_database_snapshot(const char *snapshot_path, const char *database_path);
+
+#endif // DATABASE_BACKUP_H
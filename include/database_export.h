@@ -0,0 +1,58 @@
+/*
+ * ========================================
+ * Database Export Header - Akışlı Veri Dışa Aktarma
+ * ========================================
+ */
+
+#ifndef DATABASE_EXPORT_H
+#define DATABASE_EXPORT_H
+
+#include "database.h"
+
+// Output is staged in one buffer of this size and handed to the sink when
+// full, so memory use does not depend on the number of exported rows
+#define DB_EXPORT_BUFFER_SIZE (256 * 1024)
+
+// Binary format: "SACEXP01", u16 column count, per column u16 length + name,
+// then one record per row: u32 payload length followed by the values, each
+// a type byte (0 null, 1 int64, 2 double, 3 text: u32 length + bytes).
+// A zero length record ends the stream. All integers are little-endian.
+#define DB_EXPORT_BINARY_MAGIC "SACEXP01"
+
+typedef enum {
+    EXPORT_FORMAT_CSV,
+    EXPORT_FORMAT_NDJSON,
+    EXPORT_FORMAT_BINARY
+} ExportFormat;
+
+typedef enum {
+    EXPORT_TABLE_SYSTEM_METRICS,
+    EXPORT_TABLE_FILE_OPERATIONS,
+    EXPORT_TABLE_NETWORK_METRICS,
+    EXPORT_TABLE_SECURITY_SCANS,
+    EXPORT_TABLE_SCHEDULED_TASKS,
+    EXPORT_TABLE_COUNT
+} ExportTable;
+
+// Receives each filled buffer; returning false aborts the export
+typedef bool (*ExportSink)(const void *data, size_t size, void *user_data);
+
+// Streams rows of table with time in [from, to) (scheduled tasks: next_run).
+// from/to of 0 leave that side of the range open. rows may be NULL.
+// System metrics are exported from the raw table only; rows already moved
+// into the compressed archive are not included.
+bool export_table(ExportTable table, ExportFormat format, time_t from, time_t to,
+                  ExportSink sink, void *user_data, long long *rows);
+
+// Same, written to a file that is replaced only when the export succeeds
+bool export_table_to_file(ExportTable table, ExportFormat format, time_t from, time_t to,
+                          const char *path, long long *rows);
+
+// Name lookups used by the CLI and the REST API ("system_metrics", "csv", ...)
+bool export_table_from_name(const char *name, ExportTable *table);
+bool export_format_from_name(const char *name, ExportFormat *format);
+const char* export_table_name(ExportTable table);
+const char* export_format_extension(ExportFormat format);
+const char* export_format_content_type(ExportFormat format);
+
+#endif // DATABASE_EXPORT_H
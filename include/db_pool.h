@@ -0,0 +1,42 @@
+/*
+ * ========================================
+ * Database Pool Header - Okuyucu Havuzu ve Tek Yazıcı Kuyruğu
+ * ========================================
+ */
+
+#ifndef DB_POOL_H
+#define DB_POOL_H
+
+#include "database.h"
+
+// Read-only connections kept open next to the writer
+#define DB_READER_POOL_SIZE 4
+
+// Most queued jobs committed together in one writer transaction
+#define DB_WRITE_BATCH_MAX 256
+
+// A unit of work executed on the writer connection (the global db)
+typedef bool (*DatabaseWriteFn)(void *arg);
+
+// Opens the reader pool and starts the writer thread
+bool db_pool_init(const char *database_path, int reader_count);
+
+// Drains the write queue, stops the writer thread, closes the readers
+void db_pool_shutdown(void);
+
+// Read-only connection for the calling thread. Nested calls on the same
+// thread return the same connection; every acquire needs a release.
+// Falls back to the writer connection when the pool is not running.
+sqlite3* db_acquire_reader(void);
+void db_release_reader(sqlite3 *conn);
+
+// Runs fn on the writer thread and waits for its result. Jobs queued by
+// different threads are committed together, each inside its own savepoint,
+// so a failing job does not undo the others.
+bool db_write(DatabaseWriteFn fn, void *arg);
+
+// Same, but the job runs alone and outside any transaction
+// (VACUUM, jobs with their own BEGIN/COMMIT)
+bool db_write_exclusive(DatabaseWriteFn fn, void *arg);
+
+#endif // DB_POOL_H
@@ -0,0 +1,30 @@
+/*
+ * ========================================
+ * File Compress Header - Dosya Sıkıştırma
+ * ========================================
+ */
+
+#ifndef FILE_COMPRESS_H
+#define FILE_COMPRESS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Uncompressed bytes per chunk
+#define COMPRESSED_CHUNK_SIZE (1024 * 1024)
+
+typedef struct {
+    long long raw_bytes;
+    long long stored_bytes;
+    int chunk_count;
+    uint32_t checksum;                  // CRC-32 of the uncompressed data
+} CompressedFileInfo;
+
+// Chunked, LZ-compressed files with a CRC-32 per chunk and overall.
+// compress_file removes a partly written output on failure; decompress_file
+// decodes to "<output>.tmp" and replaces output only when every chunk checked out
+bool compress_file(const char *input_path, const char *output_path, CompressedFileInfo *info);
+bool verify_compressed_file(const char *path, CompressedFileInfo *info);
+bool decompress_file(const char *input_path, const char *output_path);
+
+#endif // FILE_COMPRESS_H
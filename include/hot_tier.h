@@ -0,0 +1,42 @@
+/*
+ * ========================================
+ * Hot Tier Header - Son Metrikler İçin Bellek İçi Halka Tampon
+ * ========================================
+ */
+
+#ifndef HOT_TIER_H
+#define HOT_TIER_H
+
+#include "database.h"
+#include <stdint.h>
+
+// Samples kept per host (system metrics) or per target (network metrics);
+// must be a power of two
+#define HOT_TIER_CAPACITY 512
+#define HOT_TIER_MAX_HOSTS 16
+#define HOT_TIER_CACHE_LINE 64
+
+// "Recent" window of get_recent_system_metrics, well inside what the rings
+// hold at the collectors' sampling rate
+#define HOT_TIER_RECENT_SECONDS (5 * 60)
+
+// Starts coverage: samples recorded from now on are served from memory
+void init_hot_tier(void);
+
+// Called by the insert path once the row is committed, with its row id, so
+// memory never holds a sample the database does not
+void hot_tier_record_system(const SystemMetrics *metrics, int id);
+void hot_tier_record_network(const NetworkMetrics *metrics, int id);
+
+// Lock-free reads. Each returns false, without allocating, when memory may
+// not hold every matching row; the caller then queries SQLite. Results are
+// malloc'd like the database getters.
+
+// Newest limit samples across all hosts, newest first
+bool hot_tier_latest_system(int limit, SystemMetrics **metrics, int *count);
+bool hot_tier_latest_network(int limit, NetworkMetrics **metrics, int *count);
+
+// Samples with from <= timestamp < to, oldest first
+bool hot_tier_system_range(time_t from, time_t to, SystemMetrics **metrics, int *count);
+
+#endif // HOT_TIER_H
@@ -0,0 +1,108 @@
+/*
+ * ========================================
+ * Log Analysis Header - Paralel Log Analizi
+ * ========================================
+ */
+
+#ifndef LOG_ANALYSIS_H
+#define LOG_ANALYSIS_H
+
+#include "log_kernel.h"
+#include "logger.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+
+// Days kept in the per-day histogram, counted back from the reference time
+#define LOG_ANALYSIS_DAYS 92
+
+// Files are cut into newline-aligned chunks of this size; workers take the
+// next chunk from a shared counter, so a slow chunk does not hold up others
+#define LOG_ANALYSIS_CHUNK_SIZE (32ULL * 1024 * 1024)
+#define LOG_ANALYSIS_MAX_THREADS 64
+
+#define LOG_STATS_TOP_MESSAGES 10
+#define LOG_STATS_ERROR_LINES 10
+#define LOG_STATS_MESSAGE_MAX 120       // message bytes kept, longer ones are cut
+
+// Message templates tracked per worker, and so the memory bound of the top
+// message counts for any log size: when all slots are used a new template
+// replaces the least counted one (space-saving), see LogMessageCount.error
+#define LOG_STATS_MESSAGE_SLOTS 4096
+
+typedef enum {
+    LOG_CATEGORY_NETWORK = 0,
+    LOG_CATEGORY_FILE,
+    LOG_CATEGORY_MEMORY,
+    LOG_CATEGORY_SECURITY,
+    LOG_CATEGORY_COUNT
+} LogErrorCategory;
+
+typedef struct {
+    char text[LOG_STATS_MESSAGE_MAX];   // template of the text after the level token
+    uint64_t count;                     // never too low
+    uint64_t error;                     // count may be this much too high, 0: exact
+} LogMessageCount;
+
+typedef struct {
+    char time[20];                      // "" if the line has no timestamp
+    char message[LOG_STATS_MESSAGE_MAX];
+    int file;                           // index into the analyzed paths
+    uint64_t offset;
+} LogErrorLine;
+
+// Everything the menus, reports and the API show about a log set, filled
+// in one pass
+typedef struct {
+    LogLevelCounts counts;
+    uint64_t hourly[24];                                    // all dated lines by hour of day
+    uint64_t daily[LOG_ANALYSIS_DAYS][LOG_KERNEL_LEVELS + 1]; // [days ago][level], last column unclassified
+    uint64_t older;                 // dated lines LOG_ANALYSIS_DAYS or more days old
+    uint64_t undated;               // no timestamp at the line start
+    uint64_t bytes;                 // bytes analyzed
+    int files;                      // files that could be read
+    char first_time[20];            // earliest and latest "YYYY-MM-DD HH:MM:SS", "" if none
+    char last_time[20];
+    time_t reference;               // day 0 of daily
+
+    uint64_t error_categories[LOG_CATEGORY_COUNT];
+    LogMessageCount top_messages[LOG_STATS_TOP_MESSAGES];   // most frequent first
+    int top_message_count;
+    LogErrorLine recent_errors[LOG_STATS_ERROR_LINES];      // latest errors, oldest first
+    int recent_error_count;
+} LogStatistics;
+
+// Analyzes the files as one set on threads workers (0: one per CPU).
+// Unreadable and binary log files are skipped; returns false if none could be read.
+bool build_log_statistics(const char *const *paths, int path_count, int threads,
+                          time_t reference, LogStatistics *stats);
+
+// Same for the logger's file and its rotated segments; compressed segments
+// are restored to temporary files next to them for the duration
+bool build_log_set_statistics(int threads, time_t reference, LogStatistics *stats);
+
+// Lines starting in [start, end) of a segment; start may fall inside a line
+#define LOG_RANGE_END UINT64_MAX
+typedef struct {
+    LogSegment segment;
+    uint64_t start;
+    uint64_t end;
+} LogSegmentRange;
+
+// Analyzes the ranges as one set. A raw segment that was compressed since it
+// was listed is read from its archive. recent_errors[].file indexes ranges.
+bool build_log_segment_statistics(LogSegmentRange *ranges, int count, int threads,
+                                  time_t reference, LogStatistics *stats);
+
+// Adds the statistics of a later run over other bytes: into's per-day rows
+// are moved to from's reference first. Top messages are combined from both
+// lists; one missing from a full list gets that list's last count as error.
+void merge_log_statistics(LogStatistics *into, const LogStatistics *from);
+
+// Dated lines at least days old (0 <= days <= LOG_ANALYSIS_DAYS)
+uint64_t count_log_lines_older_than(const LogStatistics *stats, int days);
+
+const char* get_log_category_name(LogErrorCategory category);
+int get_log_analysis_threads(void);
+
+#endif // LOG_ANALYSIS_H
@@ -0,0 +1,73 @@
+/*
+ * ========================================
+ * Binary Log Header - Yapılandırılmış Log Kayıtları
+ * ========================================
+ */
+
+#ifndef LOG_BINARY_H
+#define LOG_BINARY_H
+
+#include "logger.h"
+#include <stdint.h>
+
+#define LOG_BINARY_MAGIC "SACLOGB1"
+#define LOG_BINARY_MAGIC_SIZE 8
+
+// Format strings and module names are interned once per process; ids are
+// 1..LOG_BINARY_MAX_IDS
+#define LOG_BINARY_MAX_IDS 4096
+#define LOG_BINARY_MAX_ARGS 16
+#define LOG_BINARY_FORMAT_MAX 512
+#define LOG_BINARY_DEFINITION_MAX (LOG_BINARY_FORMAT_MAX + 8)
+#define LOG_BINARY_TEXT_HEADER_SIZE 3
+
+typedef enum {
+    LOG_RECORD_DEFINE = 1,      // format string or module name for an id
+    LOG_RECORD_ENTRY = 2,       // timestamp, level, module id, format id, args
+    LOG_RECORD_TEXT = 3         // preformatted line (format not encodable)
+} LogRecordType;
+
+typedef enum {
+    LOG_RENDER_TEXT,            // same lines as automation.log
+    LOG_RENDER_LOGCAT           // "01-31 12:00:00.123 E network_monitor: ..."
+} LogRenderStyle;
+
+// One decoded record. module and format point into the reader and stay
+// valid until it is closed; message is filled only when rendering is asked.
+typedef struct {
+    LogRecordType type;
+    time_t timestamp;
+    long microseconds;
+    LogLevel level;
+    const char *module;
+    const char *format;         // NULL for TEXT records
+    char message[LOG_LINE_MAX];
+} LogBinaryRecord;
+
+typedef struct LogBinaryReader LogBinaryReader;
+
+// Writer side (used by the logger). encode_log_record returns the record
+// size, or -1 when the format cannot be encoded and a TEXT record is needed.
+int encode_log_record(char *out, size_t capacity, const char *module, LogLevel level,
+                      uint64_t time_us, const char *format, va_list args);
+void get_log_record_ids(const char *record, uint32_t *module_id, uint32_t *format_id);
+size_t write_log_definition(uint32_t id, char *out, size_t capacity);
+size_t write_log_text_header(char *out, size_t text_length);
+size_t render_log_record_line(const char *record, size_t length, char *out, size_t capacity);
+
+// Reader side: read_binary_log_record returns 1 per record, 0 at the end
+// and -1 on a damaged file
+LogBinaryReader* open_binary_log(const char *path);
+int read_binary_log_record(LogBinaryReader *reader, LogBinaryRecord *record, int render_message);
+void close_binary_log(LogBinaryReader *reader);
+
+// True when the file starts with LOG_BINARY_MAGIC. The line-based readers
+// (log_analysis, log_checkpoint, log_follow) skip such files: only
+// render_binary_log decodes binary records.
+bool is_binary_log_file(const char *path);
+
+// Writes every record at or above min_level as text; returns the number
+// of lines written, or -1 on error
+long render_binary_log(const char *path, FILE *output, LogRenderStyle style, LogLevel min_level);
+
+#endif // LOG_BINARY_H
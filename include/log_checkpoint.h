@@ -0,0 +1,35 @@
+/*
+ * ========================================
+ * Log Checkpoint Header - Artımlı Log Analizi
+ * ========================================
+ */
+
+#ifndef LOG_CHECKPOINT_H
+#define LOG_CHECKPOINT_H
+
+#include "database.h"
+#include "log_analysis.h"
+
+// Stored with every checkpoint; checkpoints of another format (or another
+// LogStatistics layout) are ignored and the log set is analyzed again
+#define LOG_CHECKPOINT_FORMAT 2
+
+// Bytes at the start of the active file whose hash tells a file that was
+// emptied and refilled in place from the one checkpointed
+#define LOG_CHECKPOINT_HEAD_BYTES 256
+
+bool create_log_checkpoint_table(void);
+
+// Statistics of the logger's file set, analyzing only the lines written since
+// the last call: the checkpoint keeps the active file's identity (device and
+// inode), the offset after its last complete line, the newest rotated segment
+// already counted and the statistics so far. After a rotation the rest of the
+// former active file and any newer segments are analyzed. Counts stay for
+// segments the logger deleted since. Without a usable checkpoint (or without
+// a database) the whole set is analyzed.
+bool update_log_set_statistics(int threads, time_t reference, LogStatistics *stats);
+
+// Next update analyzes the whole set again, e.g. after the logs were cleared
+bool clear_log_checkpoints(void);
+
+#endif // LOG_CHECKPOINT_H
@@ -0,0 +1,86 @@
+/*
+ * ========================================
+ * Log Follow Header - Canlı Log Takibi ve Alarmlar
+ * ========================================
+ */
+
+#ifndef LOG_FOLLOW_H
+#define LOG_FOLLOW_H
+
+#include "database.h"
+#include "log_kernel.h"
+
+#define LOG_FOLLOW_MAX_FILES 8
+
+// Longest wait between checks: the polling interval where inotify is not
+// available, otherwise only the timeout that lets alerts clear when the
+// files go quiet
+#define LOG_FOLLOW_POLL_MS 250
+
+// Alert thresholds are lines per this many seconds, counted in one-second
+// buckets
+#define LOG_FOLLOW_WINDOW_SECONDS 60
+
+#define LOG_FOLLOW_RECENT_ALERTS 16
+
+typedef struct {
+    char paths[LOG_FOLLOW_MAX_FILES][MAX_PATH_LEN];
+    int path_count;                         // 0: the logger's file
+    int thresholds[LOG_KERNEL_LEVELS];      // lines per minute above which an alert is raised, 0: off
+} LogFollowOptions;
+
+typedef struct {
+    time_t timestamp;
+    int level;                              // LogLevel
+    int line_count;                         // lines of the level in the last minute
+    int threshold;
+    char message[160];
+} LogAlert;
+
+typedef struct {
+    char path[MAX_PATH_LEN];
+    bool open;
+    bool binary;                            // binary log: skipped, not counted
+    int rotations;
+    uint64_t bytes;
+    LogLevelCounts counts;
+} LogFollowFile;
+
+typedef struct {
+    bool running;
+    bool inotify;                           // false: polling
+    time_t started;
+    LogLevelCounts counts;                  // lines since the start, all files
+    uint64_t last_minute[LOG_KERNEL_LEVELS + 1];    // last column unclassified
+    int thresholds[LOG_KERNEL_LEVELS];
+    LogFollowFile files[LOG_FOLLOW_MAX_FILES];
+    int file_count;
+    LogAlert recent_alerts[LOG_FOLLOW_RECENT_ALERTS];  // oldest first
+    int recent_alert_count;
+    uint64_t alert_count;
+} LogFollowStatus;
+
+bool create_log_alert_table(void);
+
+// Follows the logger's file with every alert off
+void init_log_follow_options(LogFollowOptions *options);
+
+// Comma separated list, e.g. "logs/automation.log,/var/log/syslog"
+void set_log_follow_paths(LogFollowOptions *options, const char *list);
+
+// Starts a thread that reads lines as they are appended, from the current
+// end of each file on. Rotated and truncated files are followed under the
+// same name. An alert is raised when a level's lines in the last minute go
+// above its threshold, and again only after the rate has dropped back.
+// Binary logs are not followed: a binary file in the list is marked and
+// skipped, and with no list the start fails while logging.format=binary.
+bool start_log_follow(const LogFollowOptions *options);
+void stop_log_follow(void);
+bool is_log_follow_running(void);
+
+void get_log_follow_status(LogFollowStatus *status);
+
+// Stored alerts, newest first; *alerts is malloc'ed
+bool get_log_alerts(LogAlert **alerts, int *count, int limit);
+
+#endif // LOG_FOLLOW_H
@@ -0,0 +1,44 @@
+/*
+ * ========================================
+ * Log Kernel Header - Vektörel Satır ve Seviye Tarama
+ * ========================================
+ */
+
+#ifndef LOG_KERNEL_H
+#define LOG_KERNEL_H
+
+#include "logger.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define LOG_KERNEL_LEVELS 4         // LOG_DEBUG..LOG_ERROR
+
+typedef enum {
+    LOG_KERNEL_AUTO = 0,            // best kernel the CPU supports
+    LOG_KERNEL_SCALAR,
+    LOG_KERNEL_SSE2,
+    LOG_KERNEL_AVX2
+} LogKernel;
+
+typedef struct {
+    uint64_t lines;
+    uint64_t levels[LOG_KERNEL_LEVELS];     // indexed by LogLevel
+    uint64_t unclassified;                  // no level token after the timestamp
+} LogLevelCounts;
+
+// Level of one line from the token after the fixed-width timestamp:
+// "[2024-01-31 12:00:00] INFO: ..." (also with .mmm / .uuuuuu and the older
+// "[INFO]" spelling). Returns the LogLevel, or -1.
+int classify_log_line(const char *line, size_t length);
+
+// Adds the lines in data (whole lines; the last one may lack a newline)
+// and their levels to counts
+void count_log_levels(const char *data, size_t length, LogLevelCounts *counts);
+void count_log_levels_with(LogKernel kernel, const char *data, size_t length, LogLevelCounts *counts);
+
+bool log_kernel_supported(LogKernel kernel);
+LogKernel get_log_kernel(void);
+const char* get_log_kernel_name(LogKernel kernel);
+
+#endif // LOG_KERNEL_H
@@ -0,0 +1,78 @@
+/*
+ * ========================================
+ * Log Scanner Header - Bellek Eşlemeli Satır Tarama
+ * ========================================
+ */
+
+#ifndef LOG_SCANNER_H
+#define LOG_SCANNER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// Files up to this size are mapped in one view; larger files (or any file
+// on a 32-bit build) are walked through windows of LOG_SCAN_WINDOW_SIZE
+#define LOG_SCAN_SINGLE_MAP_MAX (4ULL * 1024 * 1024 * 1024)
+#define LOG_SCAN_WINDOW_SIZE (256ULL * 1024 * 1024)
+
+// One line inside the mapped file. data is not NUL-terminated and is only
+// valid during the callback; length excludes the "\n" / "\r\n".
+typedef struct {
+    const char *data;
+    size_t length;
+    uint64_t offset;            // byte offset of the line in the file
+} LogLine;
+
+// A run of whole lines inside one mapped window (the last line may lack its
+// newline at the end of the file). Kernels that work on many lines at once
+// take blocks instead of single lines.
+typedef struct {
+    const char *data;
+    size_t length;
+    uint64_t offset;
+} LogBlock;
+
+// Return false to stop the scan
+typedef bool (*LogLineCallback)(const LogLine *line, void *context);
+typedef bool (*LogBlockCallback)(const LogBlock *block, void *context);
+
+typedef struct LogScanner LogScanner;
+
+// Opens the file read-only (the logger may keep appending; the scan covers
+// the size seen at open). Returns NULL if the file cannot be opened.
+LogScanner* open_log_scanner(const char *path);
+uint64_t get_log_scanner_size(const LogScanner *scanner);
+void close_log_scanner(LogScanner *scanner);
+
+// Calls callback for every line starting in [start, end). start may fall
+// inside a line, so consecutive ranges split a file's lines exactly once.
+// A line longer than one window is delivered in window-sized pieces.
+// Returns the number of lines delivered, or -1 on a mapping error.
+long long scan_log_lines(LogScanner *scanner, uint64_t start, uint64_t end,
+                         LogLineCallback callback, void *context);
+
+// Same range as scan_log_lines, delivered as blocks of up to one window.
+// Returns false on a mapping error.
+bool scan_log_blocks(LogScanner *scanner, uint64_t start, uint64_t end,
+                     LogBlockCallback callback, void *context);
+
+// Whole-file scan; returns -1 if the file cannot be opened
+long long scan_log_file(const char *path, LogLineCallback callback, void *context);
+
+// Device and inode (volume serial and file index on Windows) of a path and
+// optionally its size. A different id under the same path means the file
+// was replaced, e.g. rotated.
+typedef struct {
+    uint64_t device;
+    uint64_t inode;
+} LogFileId;
+
+bool get_log_file_id(const char *path, LogFileId *id, uint64_t *size);
+bool same_log_file_id(const LogFileId *a, const LogFileId *b);
+
+// Line helpers that work on the mapped bytes without copying
+const char* find_in_log_line(const LogLine *line, const char *token);
+size_t copy_log_line(const LogLine *line, size_t skip, char *out, size_t capacity);
+
+#endif // LOG_SCANNER_H
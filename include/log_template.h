@@ -0,0 +1,26 @@
+/*
+ * ========================================
+ * Log Template Header - Mesaj Şablonu Çıkarma
+ * ========================================
+ */
+
+#ifndef LOG_TEMPLATE_H
+#define LOG_TEMPLATE_H
+
+#include <stddef.h>
+
+// Placeholders written for the variable parts of a message
+#define LOG_TEMPLATE_NUMBER "<num>"
+#define LOG_TEMPLATE_HEX "<hex>"
+#define LOG_TEMPLATE_IP "<ip>"
+#define LOG_TEMPLATE_PATH "<path>"
+
+// Writes the message's template to out, so that messages differing only in
+// variable parts count as one: IPv4/IPv6 addresses (with a port), file paths
+// and URLs, hex ids of 8+ digits (also UUIDs) and numbers (also dates, times
+// and versions such as "2024-01-31", "12:00:05", "1.2.3") not glued to a
+// word ("user42", "v1.2.3" stay). The template is cut to size - 1 bytes
+// without splitting a UTF-8 sequence or a placeholder; returns its length.
+size_t make_log_template(const char *message, size_t length, char *out, size_t size);
+
+#endif // LOG_TEMPLATE_H
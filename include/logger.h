@@ -8,6 +8,7 @@
 #define LOGGER_H
 
 #include "core.h"
+#include <stdarg.h>
 
 // Log seviyeleri
 typedef enum {
@@ -17,6 +18,39 @@ typedef enum {
     LOG_ERROR = 3
 } LogLevel;
 
+// Kuyruk dolduğunda ne yapılacağı
+typedef enum {
+    LOG_OVERFLOW_BLOCK = 0,     // yer açılana kadar bekle
+    LOG_OVERFLOW_DROP = 1,      // mesajı sessizce at
+    LOG_OVERFLOW_COUNT = 2      // mesajı at, sayısını log'a yaz
+} LogOverflowPolicy;
+
+// Zaman damgası hassasiyeti: "2024-01-31 12:00:00", ".123" veya ".123456" eklenir
+typedef enum {
+    LOG_TIMESTAMP_SECONDS = 0,
+    LOG_TIMESTAMP_MILLIS = 1,
+    LOG_TIMESTAMP_MICROS = 2
+} LogTimestampPrecision;
+
+// Dosya biçimi: metin satırları veya log_binary.h'deki yapılandırılmış kayıtlar.
+// Binary kayıtta yalnızca argümanlar kopyalanır, metin okunurken üretilir.
+typedef enum {
+    LOG_FORMAT_TEXT = 0,
+    LOG_FORMAT_BINARY = 1
+} LogFormat;
+
+// Asenkron yazıcı: satırlar sabit boyutlu slotlardan oluşan kilitsiz bir
+// halka tampona yazılır, arka plan thread'i bunları writev ile dosyaya aktarır
+#define LOG_RING_SLOTS 2048         // 2'nin kuvveti olmalı
+#define LOG_LINE_MAX 1152           // zaman damgası + seviye + 1 KB mesaj
+#define LOG_FLUSH_BATCH 64          // tek writev çağrısındaki satır sayısı
+#define LOG_FLUSH_INTERVAL_MS 20
+
+// Boyut eşiğinde dosya "automation.log.YYYYMMDD_HHMMSS" adına taşınır; arşiv
+// thread'i bu segmentleri compress_file() ile sıkıştırıp ".snap" ekler
+#define LOG_ARCHIVE_EXTENSION ".snap"
+#define LOG_ARCHIVE_POLL_MS 200
+
 // Log konfigürasyonu
 typedef struct {
     char log_file_path[MAX_PATH_LEN];
@@ -25,6 +59,9 @@ typedef struct {
     int file_output;
     int max_file_size; // MB cinsinden
     int max_backup_files;
+    LogOverflowPolicy overflow_policy;
+    LogTimestampPrecision timestamp_precision;
+    LogFormat format;
 } LogConfig;
 
 // Fonksiyon prototipleri
@@ -34,6 +71,27 @@ int set_log_level(LogLevel level);
 int set_log_file(const char* filepath);
 int enable_console_logging(int enable);
 int enable_file_logging(int enable);
+int set_log_overflow_policy(LogOverflowPolicy policy);
+int set_log_timestamp_precision(LogTimestampPrecision precision);
+
+// Biçim ve dosya yolu birlikte değişir, dosya bir kez yeniden açılır.
+// Binary için ayrı bir yol (ör. logs/automation.logb) verilmelidir;
+// filepath NULL ise mevcut yol kalır.
+int set_log_format(LogFormat format, const char* filepath);
+
+// Yalnızca LOG_RATE_LIMITED yerleri sınırlanır; diğer loglar hiç etkilenmez.
+// per_second > 0 bu yerlerin kendi oranını geçici olarak ezer (burst kadar
+// birikme), 0 yerlerin kendi oranına döner. Sınırlanan yerlerde art arda
+// aynı mesaj "son mesaj N kez tekrarlandı" olur.
+int set_log_rate_limit(double per_second, int burst);
+
+// max_file_size_mb <= 0 otomatik döndürmeyi kapatır,
+// max_backup_files < 0 eski segmentleri hiç silmez
+int set_log_rotation(int max_file_size_mb, int max_backup_files);
+
+// Kuyruktaki satırları hemen dosyaya yazar
+int flush_logger(void);
+unsigned long long get_log_dropped_count(void);
 
 // Ana loglama fonksiyonları
 void log_debug(const char* format, ...);
@@ -43,13 +101,61 @@ void log_error(const char* format, ...);
 
 // Yardımcı fonksiyonlar
 void log_message(LogLevel level, const char* format, ...);
+void vlog_message(LogLevel level, const char* format, va_list args);
+void log_module_message(const char* module, LogLevel level, const char* format, ...);
+void vlog_module_message(const char* module, LogLevel level, const char* format, va_list args);
+void log_limited_message(const char* module, const char* file, int line, LogLevel level,
+                         double per_second, const char* format, ...);
 const char* get_log_level_string(LogLevel level);
-int rotate_log_file(void);
-int get_log_file_size(void);
+int rotate_log_file(void);            // yalnızca eşik aşıldıysa döndürür
+int get_log_file_size(void);          // MB cinsinden, yazılan bayt sayacından
+unsigned long long get_log_file_bytes(void);
 
 // Log dosyası yönetimi
 int create_log_directory(void);
-int backup_log_file(void);
-int clear_old_logs(void);
+const char* get_log_file_path(void);      // aktif dosya, döndürmede adı değişmez
+LogFormat get_log_format(void);
+int backup_log_file(void);            // eşiğe bakmadan hemen döndürür
+int clear_old_logs(void);             // max_backup_files'tan eski segmentleri siler
+
+// Aktif dosya ve döndürülmüş segmentleri, eskiden yeniye (aktif dosya en
+// sonda). compressed segment LOG_ARCHIVE_EXTENSION arşividir.
+typedef struct {
+    char path[MAX_PATH_LEN + 256];
+    int compressed;
+} LogSegment;
+int list_log_segments(LogSegment **segments);    // *segments malloc'lu, sayıyı döner
+
+// Seviye kontrolü çağrı yerinde yapılır: kapalı seviyedeki bir log_debug
+// argümanlarını değerlendirmez ve fonksiyon çağrısı yapmaz.
+// -DLOG_COMPILE_LEVEL=1 gibi bir değer alt seviyeleri derlemeden çıkarır.
+#ifndef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL 0
+#endif
+
+// Binary kayıtlardaki modül adı; varsayılan çağıran kaynak dosyadır
+#ifndef LOG_MODULE
+#define LOG_MODULE __FILE__
+#endif
+
+extern LogLevel g_log_min_level;
+
+static inline int log_level_enabled(LogLevel level) {
+    return (int)level >= LOG_COMPILE_LEVEL && level >= g_log_min_level;
+}
+
+#define LOG_AT_LEVEL(level, ...) \
+    (log_level_enabled(level) ? log_module_message(LOG_MODULE, level, __VA_ARGS__) : (void)0)
+
+#define log_debug(...)   LOG_AT_LEVEL(LOG_DEBUG, __VA_ARGS__)
+#define log_info(...)    LOG_AT_LEVEL(LOG_INFO, __VA_ARGS__)
+#define log_warning(...) LOG_AT_LEVEL(LOG_WARNING, __VA_ARGS__)
+#define log_error(...)   LOG_AT_LEVEL(LOG_ERROR, __VA_ARGS__)
+
+// Sıcak döngüler için: bu çağrı yeri (dosya ve satır) saniyede en fazla
+// per_second mesaj yazar
+#define LOG_RATE_LIMITED(level, per_second, ...) \
+    (log_level_enabled(level) ? \
+     log_limited_message(LOG_MODULE, __FILE__, __LINE__, level, per_second, __VA_ARGS__) : (void)0)
 
 #endif // LOGGER_H
\ No newline at end of file
@@ -0,0 +1,56 @@
+/*
+ * ========================================
+ * Metric Partitions Header - Zamana Göre Bölümlenmiş Metrik Tabloları
+ * ========================================
+ */
+
+#ifndef METRIC_PARTITIONS_H
+#define METRIC_PARTITIONS_H
+
+#include "database.h"
+
+// system_metrics_pYYYYMMDD; a partition that does not start at midnight
+// gets an _HHMMSS suffix
+#define METRIC_PARTITION_NAME_SIZE 64
+
+typedef enum {
+    PARTITION_NONE,
+    PARTITION_DAILY,
+    PARTITION_WEEKLY
+} PartitionSpan;
+
+// One partition table holding rows with start_ts <= timestamp < end_ts
+typedef struct {
+    char name[METRIC_PARTITION_NAME_SIZE];
+    time_t start_ts;
+    time_t end_ts;
+} MetricPartition;
+
+// Catalog tables; also detects whether system_metrics is already partitioned.
+// Called from create_tables.
+bool create_partition_tables(void);
+
+// Converts system_metrics between one table and per-day/per-week tables
+// behind a view of the same name. Existing rows are kept either way.
+bool set_metric_partitioning(PartitionSpan span);
+bool partition_span_from_name(const char *name, PartitionSpan *span);
+bool metric_partitioning_enabled(void);
+
+// Writer side (inside a db_write job): returns the partition for a new row,
+// creating it when needed, and the row id to insert with
+bool resolve_insert_partition(time_t timestamp, char *table, size_t table_size, long long *row_id);
+
+// Retention: drops every fully expired partition, then deletes expired rows
+// from the partition holding the cutoff until batch_rows rows in total
+// (dropped ones included) have been removed.
+// Returns the number of rows removed, or -1 on error.
+int expire_metric_partitions(time_t cutoff_time, int batch_rows);
+
+// Deletes every row older than cutoff_time (archive tier), either layout
+bool delete_system_metrics_before(time_t cutoff_time);
+
+// Reader side: partitions overlapping [from, to), newest first. Returns the
+// count, or -1 on error; *partitions is malloc'd.
+int list_metric_partitions(sqlite3 *conn, time_t from, time_t to, MetricPartition **partitions);
+
+#endif // METRIC_PARTITIONS_H
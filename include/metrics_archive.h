@@ -0,0 +1,53 @@
+/*
+ * ========================================
+ * Metrics Archive Header - Sıkıştırılmış Soğuk Veri Katmanı
+ * ========================================
+ */
+
+#ifndef METRICS_ARCHIVE_H
+#define METRICS_ARCHIVE_H
+
+#include "database.h"
+#include <stdint.h>
+#include <stddef.h>
+
+// Rows packed into a single archive block (per hostname)
+#define ARCHIVE_BLOCK_ROWS 4096
+
+// Raw rows are archived in whole UTC days; a day denser than ARCHIVE_JOB_ROWS
+// is split into halves, down to ARCHIVE_MIN_SPAN_SECONDS, so one write job
+// stays short
+#define ARCHIVE_SPAN_SECONDS (24 * 60 * 60)
+#define ARCHIVE_MIN_SPAN_SECONDS (60 * 60)
+#define ARCHIVE_JOB_ROWS (16 * ARCHIVE_BLOCK_ROWS)
+
+// Archive summary
+typedef struct {
+    long long block_count;
+    long long row_count;
+    long long compressed_bytes;
+    time_t oldest_timestamp;
+    time_t newest_timestamp;
+} ArchiveStats;
+
+// Gorilla-style column codecs: delta-of-delta timestamps, XOR-encoded doubles.
+// Encoders return the encoded size and a malloc'ed buffer (0 on failure).
+size_t archive_encode_timestamps(const int64_t *timestamps, int count, uint8_t **out);
+bool archive_decode_timestamps(const uint8_t *data, size_t size, int count, int64_t *timestamps);
+size_t archive_encode_doubles(const double *values, int count, uint8_t **out);
+bool archive_decode_doubles(const uint8_t *data, size_t size, int count, double *values);
+
+// Archive tier for system_metrics
+bool create_archive_tables(void);
+// Archives the oldest whole span before cutoff_time and deletes its raw
+// rows; returns the rows archived, 0 when no whole span is left, -1 on error
+int archive_system_metrics_span(time_t cutoff_time);
+// Repeats archive_system_metrics_span until the backlog is archived. Rows of
+// the day holding the cutoff stay raw until that day has fully expired.
+bool archive_old_system_metrics(int days_to_keep);
+bool get_archived_system_metrics(time_t from, time_t to, SystemMetrics **metrics, int *count);
+bool get_latest_archived_system_metrics(time_t before, int limit, SystemMetrics **metrics, int *count);
+bool cleanup_old_archive_blocks(time_t cutoff_time);
+bool get_archive_statistics(ArchiveStats *stats);
+
+#endif // METRICS_ARCHIVE_H
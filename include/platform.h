@@ -0,0 +1,17 @@
+/*
+ * ========================================
+ * Platform Header - Taşınabilir Yardımcılar
+ * ========================================
+ */
+
+#ifndef PLATFORM_H
+#define PLATFORM_H
+
+// Blocks the calling thread for at least milliseconds
+void sleep_ms(int milliseconds);
+
+// Milliseconds from an arbitrary start point; never goes backwards, so it
+// is the clock to measure durations with
+long long monotonic_ms(void);
+
+#endif // PLATFORM_H
@@ -0,0 +1,29 @@
+/*
+ * ========================================
+ * String Dictionary Header - Tekrarlanan Metinler İçin Sözlük
+ * ========================================
+ */
+
+#ifndef STRING_DICTIONARY_H
+#define STRING_DICTIONARY_H
+
+#include "database.h"
+
+// Upper bound for the in-process cache; it is simply emptied when full
+#define STRING_CACHE_MAX_ENTRIES 4096
+
+// Low-cardinality columns of the raw tables (hostname, target, severity, ...)
+// store an id into interned_strings instead of the text itself.
+bool create_string_dictionary(void);
+
+// Returns the id of value, adding it on first use (-1 on error)
+int intern_string(const char *value);
+
+// Returns the id of value without adding it: 0 if unknown, -1 on error.
+// conn may be a pooled reader; intern_string() always uses the writer.
+int find_interned_string(sqlite3 *conn, const char *value);
+
+// Drops cached ids; called after a rollback could have undone an insert
+void clear_string_cache(void);
+
+#endif // STRING_DICTIONARY_H
@@ -95,6 +95,12 @@ void api_get_file_operations(const HttpRequest* request, HttpResponse* response)
 void api_get_network_metrics(const HttpRequest* request, HttpResponse* response);
 void api_get_security_scans(const HttpRequest* request, HttpResponse* response);
 void api_get_scheduled_tasks(const HttpRequest* request, HttpResponse* response);
+void api_get_metrics_rollup(const HttpRequest* request, HttpResponse* response);
+void api_get_database_stats(const HttpRequest* request, HttpResponse* response);
+void api_get_log_stats(const HttpRequest* request, HttpResponse* response);
+void api_get_log_live(const HttpRequest* request, HttpResponse* response);
+void api_get_log_alerts(const HttpRequest* request, HttpResponse* response);
+void api_stream_export(int client_socket, const HttpRequest* request);
 
 // Static file serving
 void serve_static_file(const char* file_path, HttpResponse* response);
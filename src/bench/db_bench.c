@@ -0,0 +1,501 @@
+/*
+ * ========================================
+ * Database Benchmark - Veri Katmanı Performans Ölçümü
+ * ========================================
+ *
+ * Fills a throw-away database with synthetic metrics and measures the data
+ * layer: insert throughput, history query latency at growing row counts,
+ * retention cleanup and online backup. Results are printed as one JSON
+ * object so runs can be stored and compared across releases.
+ *
+ *   db_bench [--rows 1000,100000,10000000] [--inserts 5000] [--queries 200]
+ *            [--output results.json]
+ */
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L     // clock_gettime, mkdtemp
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+    #include <direct.h>
+    #define chdir _chdir
+    #define rmdir _rmdir
+#else
+    #include <unistd.h>
+    #include <sys/stat.h>
+#endif
+
+#include "../../include/database.h"
+#include "../../include/database_backup.h"
+#include "../../include/db_pool.h"
+#include "../../include/string_dictionary.h"
+#include "../../include/logger.h"
+
+#define BENCH_MAX_SIZES 8
+#define BENCH_FILL_CHUNK 100000
+#define BENCH_HISTORY_LIMIT 50
+#define BENCH_HOSTS 8
+
+// Synthetic rows start 20 days ago at this rate (10M rows span ~14 days),
+// so they are older than anything the hot tier holds and a large fill is
+// partly past a 10 day retention
+#define BENCH_ROWS_PER_SECOND 8
+#define BENCH_HISTORY_DAYS 20
+#define BENCH_RETENTION_DAYS 10
+
+typedef struct {
+    double min_us;
+    double p50_us;
+    double p95_us;
+    double max_us;
+    double mean_us;
+} LatencyStats;
+
+static double now_seconds(void) {
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+#endif
+}
+
+static int compare_doubles(const void *a, const void *b) {
+    double da = *(const double*)a, db_value = *(const double*)b;
+    return (da > db_value) - (da < db_value);
+}
+
+static void summarize(double *samples_us, int count, LatencyStats *stats) {
+    qsort(samples_us, count, sizeof(double), compare_doubles);
+
+    double sum = 0;
+    for (int i = 0; i < count; i++) {
+        sum += samples_us[i];
+    }
+
+    stats->min_us = samples_us[0];
+    stats->p50_us = samples_us[count / 2];
+    stats->p95_us = samples_us[(int)(count * 0.95) < count ? (int)(count * 0.95) : count - 1];
+    stats->max_us = samples_us[count - 1];
+    stats->mean_us = sum / count;
+}
+
+static void print_latency(FILE *out, const char *name, const LatencyStats *stats, const char *suffix) {
+    fprintf(out, "        \"%s\": {\"min_us\": %.1f, \"p50_us\": %.1f, \"p95_us\": %.1f, "
+            "\"max_us\": %.1f, \"mean_us\": %.1f}%s\n",
+            name, stats->min_us, stats->p50_us, stats->p95_us, stats->max_us, stats->mean_us, suffix);
+}
+
+static void make_metrics(SystemMetrics *metrics, long long index, time_t timestamp) {
+    memset(metrics, 0, sizeof(*metrics));
+    metrics->timestamp = timestamp;
+    metrics->cpu_usage = (double)(index % 1000) / 10.0;
+    metrics->memory_usage = 40.0 + (double)(index % 500) / 10.0;
+    metrics->disk_usage = 70.0 + (double)(index % 100) / 10.0;
+    snprintf(metrics->hostname, sizeof(metrics->hostname), "bench-host-%02d", (int)(index % BENCH_HOSTS));
+}
+
+static time_t bench_start_time;
+
+static time_t synthetic_timestamp(long long index) {
+    return bench_start_time - BENCH_HISTORY_DAYS * 24 * 60 * 60 + (time_t)(index / BENCH_ROWS_PER_SECOND);
+}
+
+// ========================================
+// Insert throughput
+// ========================================
+
+typedef struct {
+    int count;
+    long long first_index;
+    bool ok;
+} InsertRun;
+
+// One job per row: what the collectors do today
+static double bench_single_inserts(int count, long long first_index) {
+    SystemMetrics metrics;
+    time_t now = time(NULL);
+
+    double start = now_seconds();
+    for (int i = 0; i < count; i++) {
+        make_metrics(&metrics, first_index + i, now);
+        insert_system_metrics(&metrics);
+    }
+    return count / (now_seconds() - start);
+}
+
+// Calls made from inside a writer job run inline, in the job's transaction
+static bool batched_insert_job(void *arg) {
+    InsertRun *run = arg;
+    SystemMetrics metrics;
+    time_t now = time(NULL);
+
+    run->ok = true;
+    for (int i = 0; i < run->count && run->ok; i++) {
+        make_metrics(&metrics, run->first_index + i, now);
+        run->ok = insert_system_metrics(&metrics);
+    }
+    return run->ok;
+}
+
+static double bench_batched_inserts(int count, long long first_index) {
+    InsertRun run = { count, first_index, false };
+
+    double start = now_seconds();
+    db_write(batched_insert_job, &run);
+    return count / (now_seconds() - start);
+}
+
+// Raw rows through one cached prepared statement (no rollups): the ceiling
+// the insert path could reach
+static bool prepared_insert_job(void *arg) {
+    InsertRun *run = arg;
+    const char *sql = "INSERT INTO system_metrics (timestamp, cpu_usage, memory_usage, disk_usage, hostname_id) "
+                      "VALUES (?, ?, ?, ?, ?);";
+    int host_ids[BENCH_HOSTS];
+    SystemMetrics metrics;
+
+    for (int i = 0; i < BENCH_HOSTS; i++) {
+        char hostname[32];
+        snprintf(hostname, sizeof(hostname), "bench-host-%02d", i);
+        host_ids[i] = intern_string(hostname);
+    }
+
+    sqlite3_stmt *stmt;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK) {
+        log_error("Failed to prepare statement: %s", sqlite3_errmsg(db));
+        run->ok = false;
+        return false;
+    }
+
+    run->ok = true;
+    for (int i = 0; i < run->count && run->ok; i++) {
+        long long index = run->first_index + i;
+        make_metrics(&metrics, index, synthetic_timestamp(index));
+
+        sqlite3_bind_int64(stmt, 1, metrics.timestamp);
+        sqlite3_bind_double(stmt, 2, metrics.cpu_usage);
+        sqlite3_bind_double(stmt, 3, metrics.memory_usage);
+        sqlite3_bind_double(stmt, 4, metrics.disk_usage);
+        sqlite3_bind_int(stmt, 5, host_ids[index % BENCH_HOSTS]);
+
+        run->ok = sqlite3_step(stmt) == SQLITE_DONE;
+        sqlite3_reset(stmt);
+    }
+
+    sqlite3_finalize(stmt);
+    return run->ok;
+}
+
+static double bench_prepared_inserts(int count, long long first_index) {
+    InsertRun run = { count, first_index, false };
+
+    double start = now_seconds();
+    db_write(prepared_insert_job, &run);
+    return count / (now_seconds() - start);
+}
+
+// ========================================
+// Queries
+// ========================================
+
+// Bulk fill with the prepared path, one transaction per chunk
+static bool fill_rows(long long from_index, long long to_index) {
+    for (long long index = from_index; index < to_index; index += BENCH_FILL_CHUNK) {
+        long long chunk = to_index - index < BENCH_FILL_CHUNK ? to_index - index : BENCH_FILL_CHUNK;
+        InsertRun run = { (int)chunk, index, false };
+        if (!db_write(prepared_insert_job, &run)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool bench_history(int queries, LatencyStats *stats) {
+    double *samples = malloc(sizeof(double) * queries);
+    if (!samples) {
+        return false;
+    }
+
+    for (int i = 0; i < queries; i++) {
+        SystemMetrics *metrics = NULL;
+        int count = 0;
+
+        double start = now_seconds();
+        bool ok = get_system_metrics_history(&metrics, &count, BENCH_HISTORY_LIMIT);
+        samples[i] = (now_seconds() - start) * 1e6;
+
+        free(metrics);
+        if (!ok) {
+            free(samples);
+            return false;
+        }
+    }
+
+    summarize(samples, queries, stats);
+    free(samples);
+    return true;
+}
+
+static bool bench_range(int queries, long long rows, LatencyStats *stats) {
+    double *samples = malloc(sizeof(double) * queries);
+    if (!samples) {
+        return false;
+    }
+
+    // Newest synthetic hour
+    time_t to = synthetic_timestamp(rows - 1) + 1;
+    time_t from = to - 60 * 60;
+
+    for (int i = 0; i < queries; i++) {
+        SystemMetrics *metrics = NULL;
+        int count = 0;
+
+        double start = now_seconds();
+        bool ok = get_system_metrics_range(&metrics, &count, from, to);
+        samples[i] = (now_seconds() - start) * 1e6;
+
+        free(metrics);
+        if (!ok) {
+            free(samples);
+            return false;
+        }
+    }
+
+    summarize(samples, queries, stats);
+    free(samples);
+    return true;
+}
+
+// ========================================
+// Main
+// ========================================
+
+static int parse_sizes(const char *list, long long *sizes) {
+    int count = 0;
+    char buffer[256];
+    strncpy(buffer, list, sizeof(buffer) - 1);
+    buffer[sizeof(buffer) - 1] = '\0';
+
+    for (char *token = strtok(buffer, ","); token && count < BENCH_MAX_SIZES; token = strtok(NULL, ",")) {
+        long long value = atoll(token);
+        if (value > 0 && (count == 0 || value > sizes[count - 1])) {
+            sizes[count++] = value;
+        }
+    }
+    return count;
+}
+
+static bool prepare_work_directory(char *path, size_t size) {
+#ifdef _WIN32
+    char temp[MAX_PATH];
+    GetTempPathA(sizeof(temp), temp);
+    snprintf(path, size, "%sdb_bench_%lu", temp, (unsigned long)GetCurrentProcessId());
+    if (_mkdir(path) != 0) {
+        return false;
+    }
+#else
+    snprintf(path, size, "/tmp/db_bench_XXXXXX");
+    if (!mkdtemp(path)) {
+        return false;
+    }
+#endif
+    if (chdir(path) != 0) {
+        return false;
+    }
+#ifdef _WIN32
+    _mkdir("data");
+    _mkdir("logs");
+#else
+    mkdir("data", 0755);
+    mkdir("logs", 0755);
+#endif
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    long long sizes[BENCH_MAX_SIZES] = { 1000, 100000, 10000000 };
+    int size_count = 3;
+    int inserts = 5000;
+    int queries = 200;
+    const char *output_path = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--rows") == 0 && i + 1 < argc) {
+            size_count = parse_sizes(argv[++i], sizes);
+        } else if (strcmp(argv[i], "--inserts") == 0 && i + 1 < argc) {
+            inserts = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--queries") == 0 && i + 1 < argc) {
+            queries = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            output_path = argv[++i];
+        } else {
+            fprintf(stderr, "Usage: %s [--rows 1000,100000,10000000] [--inserts N] [--queries N] [--output file]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (size_count == 0 || inserts <= 0 || queries <= 0) {
+        fprintf(stderr, "Invalid arguments\n");
+        return 1;
+    }
+
+    // Resolve the output file before moving into the work directory
+    FILE *out = stdout;
+    if (output_path) {
+        out = fopen(output_path, "w");
+        if (!out) {
+            fprintf(stderr, "Cannot open %s\n", output_path);
+            return 1;
+        }
+    }
+
+    char work_dir[512];
+    if (!prepare_work_directory(work_dir, sizeof(work_dir))) {
+        fprintf(stderr, "Cannot create work directory\n");
+        return 1;
+    }
+
+    bench_start_time = time(NULL);
+
+    // Keep stdout clean for the JSON
+    init_logger();
+    enable_console_logging(0);
+    set_log_level(LOG_WARNING);
+
+    if (!init_database()) {
+        fprintf(stderr, "Cannot open benchmark database in %s\n", work_dir);
+        return 1;
+    }
+
+    fprintf(stderr, "db_bench: working in %s\n", work_dir);
+
+    fprintf(out, "{\n");
+    fprintf(out, "  \"benchmark\": \"db\",\n");
+    fprintf(out, "  \"timestamp\": %lld,\n", (long long)time(NULL));
+    fprintf(out, "  \"sqlite_version\": \"%s\",\n", sqlite3_libversion());
+
+    fprintf(out, "  \"queries\": [\n");
+    long long filled = 0;
+    for (int s = 0; s < size_count; s++) {
+        fprintf(stderr, "db_bench: filling %lld rows\n", sizes[s]);
+
+        double fill_start = now_seconds();
+        if (!fill_rows(filled, sizes[s])) {
+            fprintf(stderr, "Fill failed\n");
+            return 1;
+        }
+        double fill_seconds = now_seconds() - fill_start;
+        long long added = sizes[s] - filled;
+        filled = sizes[s];
+
+        LatencyStats history, range;
+        if (!bench_history(queries, &history) || !bench_range(queries, sizes[s], &range)) {
+            fprintf(stderr, "Query failed\n");
+            return 1;
+        }
+
+        fprintf(out, "    {\n");
+        fprintf(out, "      \"rows\": %lld,\n", sizes[s]);
+        fprintf(out, "      \"fill_rows_per_sec\": %.0f,\n", added / fill_seconds);
+        fprintf(out, "      \"latency\": {\n");
+        print_latency(out, "history_latest_50", &history, ",");
+        print_latency(out, "range_last_hour", &range, "");
+        fprintf(out, "      }\n");
+        fprintf(out, "    }%s\n", s + 1 < size_count ? "," : "");
+    }
+    fprintf(out, "  ],\n");
+
+    // Backup of the largest database, paced defaults and unpaced
+    fprintf(stderr, "db_bench: backup\n");
+    DatabasePageStats pages;
+    get_database_page_stats(&pages);
+
+    double start = now_seconds();
+    bool backup_ok = backup_database("data/bench_backup.db");
+    double paced_seconds = now_seconds() - start;
+    remove("data/bench_backup.db");
+
+    DatabaseBackupOptions unpaced;
+    init_database_backup_options(&unpaced);
+    unpaced.step_pause_ms = 0;
+    start = now_seconds();
+    backup_ok = backup_database_paced("data/bench_backup.db", &unpaced) && backup_ok;
+    double unpaced_seconds = now_seconds() - start;
+    remove("data/bench_backup.db");
+
+    fprintf(out, "  \"backup\": {\n");
+    fprintf(out, "    \"ok\": %s,\n", backup_ok ? "true" : "false");
+    fprintf(out, "    \"database_bytes\": %lld,\n", pages.total_bytes);
+    fprintf(out, "    \"paced_seconds\": %.3f,\n", paced_seconds);
+    fprintf(out, "    \"unpaced_seconds\": %.3f\n", unpaced_seconds);
+    fprintf(out, "  },\n");
+
+    // Retention: rows older than 10 days go, in paced batches
+    fprintf(stderr, "db_bench: cleanup\n");
+    TableCounts before, after;
+    get_table_counts(&before);
+    start = now_seconds();
+    bool cleanup_ok = cleanup_old_records(BENCH_RETENTION_DAYS);
+    double cleanup_seconds = now_seconds() - start;
+    get_table_counts(&after);
+
+    start = now_seconds();
+    bool reclaim_ok = reclaim_free_pages(RETENTION_VACUUM_PAGES, 0);
+    double reclaim_seconds = now_seconds() - start;
+
+    fprintf(out, "  \"cleanup\": {\n");
+    fprintf(out, "    \"ok\": %s,\n", cleanup_ok && reclaim_ok ? "true" : "false");
+    fprintf(out, "    \"rows_deleted\": %lld,\n", before.system_metrics - after.system_metrics);
+    fprintf(out, "    \"seconds\": %.3f,\n", cleanup_seconds);
+    fprintf(out, "    \"reclaim_seconds\": %.3f\n", reclaim_seconds);
+    fprintf(out, "  },\n");
+
+    // Insert throughput on the filled database, through the real insert path
+    // (last, so the hot tier was empty while the queries above ran)
+    fprintf(stderr, "db_bench: inserts\n");
+    double single = bench_single_inserts(inserts, 0);
+    double batched = bench_batched_inserts(inserts, inserts);
+    double prepared = bench_prepared_inserts(inserts, filled);
+
+    fprintf(out, "  \"inserts\": {\n");
+    fprintf(out, "    \"rows\": %d,\n", inserts);
+    fprintf(out, "    \"single_rows_per_sec\": %.0f,\n", single);
+    fprintf(out, "    \"batched_rows_per_sec\": %.0f,\n", batched);
+    fprintf(out, "    \"prepared_cached_rows_per_sec\": %.0f\n", prepared);
+    fprintf(out, "  }\n");
+
+    fprintf(out, "}\n");
+
+    if (out != stdout) {
+        fclose(out);
+    }
+
+    close_database();
+    cleanup_logger();
+
+    remove("data/automation.db");
+    remove("data/automation.db-wal");
+    remove("data/automation.db-shm");
+    remove("logs/automation.log");
+    rmdir("data");
+    rmdir("logs");
+#ifndef _WIN32
+    remove("nul"); // stderr of init_database()'s "mkdir data 2>nul"
+#endif
+    if (chdir("..") == 0) {
+        rmdir(work_dir);
+    }
+
+    fprintf(stderr, "db_bench: done\n");
+    return 0;
+}
@@ -0,0 +1,280 @@
+/*
+ * ========================================
+ * Log Benchmark - Log Tarama Hızı Ölçümü
+ * ========================================
+ *
+ * Measures how fast a log buffer is split into lines and counted by level:
+ * the strtok + strstr loop the analyzer used before, and every log_kernel
+ * implementation the CPU supports. Each path runs on the same in-memory
+ * buffer; the best of --repeat runs is reported in GB/s as one JSON object,
+ * together with whether its counts match the baseline.
+ *
+ *   log_bench [--size-mb 256] [--file logs/automation.log] [--repeat 5]
+ *             [--output results.json]
+ */
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L     // clock_gettime
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+#endif
+
+#include "../../include/log_kernel.h"
+
+#define BENCH_DEFAULT_SIZE_MB 256
+#define BENCH_DEFAULT_REPEAT 5
+
+static double now_seconds(void) {
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+#endif
+}
+
+// ========================================
+// Input
+// ========================================
+
+// Lines in the logger's text format with a realistic level mix and message
+// lengths between 20 and ~200 bytes
+static char* make_synthetic_log(size_t size, size_t *length) {
+    static const char *levels[] = { "DEBUG", "INFO", "INFO", "INFO", "INFO", "WARNING", "ERROR", "INFO" };
+    static const char *words[] = { "bağlantı", "dosya", "yedekleme", "tamamlandı", "port", "açık",
+                                   "timeout", "disk", "kullanımı", "%87", "servis", "başlatıldı" };
+
+    char *buffer = malloc(size + 512);
+    if (!buffer) {
+        return NULL;
+    }
+
+    size_t used = 0;
+    unsigned int seed = 12345;
+    time_t timestamp = 1700000000;
+    while (used < size) {
+        seed = seed * 1103515245u + 12345u;
+        struct tm *tm_info = gmtime(&timestamp);
+        char stamp[32];
+        strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", tm_info);
+
+        used += (size_t)sprintf(buffer + used, "[%s] %s: ", stamp, levels[(seed >> 8) % 8]);
+        int word_count = 2 + (int)((seed >> 16) % 24);
+        for (int w = 0; w < word_count; w++) {
+            used += (size_t)sprintf(buffer + used, "%s ", words[(seed >> (w % 16)) % 12]);
+        }
+        buffer[used - 1] = '\n';
+        if ((seed & 3) == 0) {
+            timestamp++;
+        }
+    }
+
+    *length = used;
+    return buffer;
+}
+
+static char* read_log_file(const char *path, size_t *length) {
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    char *buffer = size > 0 ? malloc((size_t)size) : NULL;
+    if (!buffer || fread(buffer, 1, (size_t)size, file) != (size_t)size) {
+        free(buffer);
+        fclose(file);
+        return NULL;
+    }
+    fclose(file);
+    *length = (size_t)size;
+    return buffer;
+}
+
+// ========================================
+// Paths
+// ========================================
+
+// What log_analyzer.c did before the kernel: strtok over a writable copy,
+// then up to four strstr calls per line
+static void count_with_strtok(char *copy, LogLevelCounts *counts) {
+    for (char *line = strtok(copy, "\n"); line; line = strtok(NULL, "\n")) {
+        counts->lines++;
+        if (strstr(line, "INFO:")) counts->levels[LOG_INFO]++;
+        else if (strstr(line, "WARNING:")) counts->levels[LOG_WARNING]++;
+        else if (strstr(line, "ERROR:")) counts->levels[LOG_ERROR]++;
+        else if (strstr(line, "DEBUG:")) counts->levels[LOG_DEBUG]++;
+        else counts->unclassified++;
+    }
+}
+
+static double bench_strtok(const char *data, size_t length, int repeat, LogLevelCounts *counts) {
+    char *copy = malloc(length + 1);
+    if (!copy) {
+        return -1;
+    }
+
+    double best = -1;
+    for (int r = 0; r < repeat; r++) {
+        memcpy(copy, data, length);
+        copy[length] = '\0';
+        memset(counts, 0, sizeof(*counts));
+
+        double start = now_seconds();
+        count_with_strtok(copy, counts);
+        double elapsed = now_seconds() - start;
+        if (best < 0 || elapsed < best) {
+            best = elapsed;
+        }
+    }
+
+    free(copy);
+    return best;
+}
+
+static double bench_kernel(LogKernel kernel, const char *data, size_t length, int repeat, LogLevelCounts *counts) {
+    double best = -1;
+    for (int r = 0; r < repeat; r++) {
+        memset(counts, 0, sizeof(*counts));
+
+        double start = now_seconds();
+        count_log_levels_with(kernel, data, length, counts);
+        double elapsed = now_seconds() - start;
+        if (best < 0 || elapsed < best) {
+            best = elapsed;
+        }
+    }
+    return best;
+}
+
+static bool same_counts(const LogLevelCounts *a, const LogLevelCounts *b) {
+    if (a->lines != b->lines || a->unclassified != b->unclassified) {
+        return false;
+    }
+    for (int level = 0; level < LOG_KERNEL_LEVELS; level++) {
+        if (a->levels[level] != b->levels[level]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void print_result(FILE *out, const char *name, double seconds, size_t length,
+                         const LogLevelCounts *counts, const LogLevelCounts *baseline, const char *suffix) {
+    fprintf(out, "    {\"path\": \"%s\", \"seconds\": %.4f, \"gb_per_sec\": %.2f, \"matches_baseline\": %s}%s\n",
+            name, seconds, seconds > 0 ? length / seconds / 1e9 : 0.0,
+            same_counts(counts, baseline) ? "true" : "false", suffix);
+}
+
+// ========================================
+// Main
+// ========================================
+
+int main(int argc, char *argv[]) {
+    long size_mb = BENCH_DEFAULT_SIZE_MB;
+    int repeat = BENCH_DEFAULT_REPEAT;
+    const char *input_path = NULL;
+    const char *output_path = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--size-mb") == 0 && i + 1 < argc) {
+            size_mb = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--file") == 0 && i + 1 < argc) {
+            input_path = argv[++i];
+        } else if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            repeat = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            output_path = argv[++i];
+        } else {
+            fprintf(stderr, "Usage: %s [--size-mb N] [--file log] [--repeat N] [--output file]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (size_mb <= 0 || repeat <= 0) {
+        fprintf(stderr, "Invalid arguments\n");
+        return 1;
+    }
+
+    size_t length = 0;
+    char *data;
+    if (input_path) {
+        fprintf(stderr, "log_bench: reading %s\n", input_path);
+        data = read_log_file(input_path, &length);
+    } else {
+        fprintf(stderr, "log_bench: generating %ld MB\n", size_mb);
+        data = make_synthetic_log((size_t)size_mb * 1024 * 1024, &length);
+    }
+    if (!data) {
+        fprintf(stderr, "Cannot load benchmark input\n");
+        return 1;
+    }
+
+    FILE *out = stdout;
+    if (output_path) {
+        out = fopen(output_path, "w");
+        if (!out) {
+            fprintf(stderr, "Cannot open %s\n", output_path);
+            free(data);
+            return 1;
+        }
+    }
+
+    fprintf(stderr, "log_bench: strtok + strstr\n");
+    LogLevelCounts baseline;
+    double baseline_seconds = bench_strtok(data, length, repeat, &baseline);
+
+    static const LogKernel kernels[] = { LOG_KERNEL_SCALAR, LOG_KERNEL_SSE2, LOG_KERNEL_AVX2 };
+    int kernel_count = (int)(sizeof(kernels) / sizeof(kernels[0]));
+
+    fprintf(out, "{\n");
+    fprintf(out, "  \"benchmark\": \"log_scan\",\n");
+    fprintf(out, "  \"timestamp\": %lld,\n", (long long)time(NULL));
+    fprintf(out, "  \"bytes\": %llu,\n", (unsigned long long)length);
+    fprintf(out, "  \"lines\": %llu,\n", (unsigned long long)baseline.lines);
+    fprintf(out, "  \"selected_kernel\": \"%s\",\n", get_log_kernel_name(get_log_kernel()));
+    fprintf(out, "  \"results\": [\n");
+    print_result(out, "strtok_strstr", baseline_seconds, length, &baseline, &baseline, ",");
+
+    int printed = 0;
+    int supported = 0;
+    for (int k = 0; k < kernel_count; k++) {
+        supported += log_kernel_supported(kernels[k]) ? 1 : 0;
+    }
+    for (int k = 0; k < kernel_count; k++) {
+        if (!log_kernel_supported(kernels[k])) {
+            fprintf(stderr, "log_bench: %s not supported, skipped\n", get_log_kernel_name(kernels[k]));
+            continue;
+        }
+        fprintf(stderr, "log_bench: %s\n", get_log_kernel_name(kernels[k]));
+
+        LogLevelCounts counts;
+        double seconds = bench_kernel(kernels[k], data, length, repeat, &counts);
+        printed++;
+        print_result(out, get_log_kernel_name(kernels[k]), seconds, length, &counts, &baseline,
+                     printed < supported ? "," : "");
+    }
+
+    fprintf(out, "  ]\n");
+    fprintf(out, "}\n");
+
+    if (out != stdout) {
+        fclose(out);
+    }
+    free(data);
+
+    fprintf(stderr, "log_bench: done\n");
+    return 0;
+}
@@ -1,10 +1,13 @@
 #include "../include/core.h"
 #include "../include/logger.h"
 #include "../include/database.h"
+#include "../include/metric_partitions.h"
 #include "../include/web_server.h"
 #include "../include/modules.h"
 #include "../include/reports.h"
 #include "../include/system_settings.h"
+#include "../include/config.h"
+#include "../include/log_follow.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -67,6 +70,53 @@ int main() {
     }
     log_info("Database initialized successfully");
 
+    load_config();
+    
+    // Log dosyası eşikte döndürülür, eski segmentler sıkıştırılıp budanır
+    set_log_rotation(get_config_int("logging.max_file_size", 10),
+                     get_config_int("logging.max_backup_files", 5));
+    
+    // Yalnızca LOG_RATE_LIMITED yerleri sınırlanır; rate_limit > 0 onların
+    // oranını ezer, varsayılan 0 her yerin kendi oranını kullanır
+    set_log_rate_limit(get_config_int("logging.rate_limit", 0),
+                       get_config_int("logging.rate_burst", 0));
+    
+    // Yapılandırılmış (binary) log: metin dosyasının yerine ayrı dosyaya yazılır
+    const char *log_format = get_config_value("logging.format");
+    if (log_format && strcmp(log_format, "binary") == 0) {
+        const char *binary_file = get_config_value("logging.binary_file");
+        set_log_format(LOG_FORMAT_BINARY, binary_file ? binary_file : "logs/automation.logb");
+    }
+    
+    // Yeni satırlar anında sayılır; dakikalık eşik aşılınca alarm üretilir.
+    // log_follow.files boşsa logger'ın dosyası izlenir.
+    if (get_config_bool("log_follow.enabled", 1)) {
+        LogFollowOptions follow;
+        init_log_follow_options(&follow);
+        set_log_follow_paths(&follow, get_config_value("log_follow.files"));
+        follow.thresholds[LOG_ERROR] = get_config_int("log_follow.error_per_minute", 30);
+        follow.thresholds[LOG_WARNING] = get_config_int("log_follow.warning_per_minute", 0);
+        if (!start_log_follow(&follow)) {
+            log_warning("Live log follow could not be started");
+        }
+    }
+    
+    // system_metrics as one table or as per-day/per-week partitions
+    PartitionSpan partition_span;
+    if (partition_span_from_name(get_config_value("database.partitioning"), &partition_span)) {
+        set_metric_partitioning(partition_span);
+    } else {
+        log_warning("Unknown database.partitioning value, keeping the current layout");
+    }
+    
+    // Old rows are trimmed in the background in small batches. Off unless
+    // database.retention_days is set, so an upgrade never deletes history
+    int retention_days = get_config_int("database.retention_days", 0);
+    if (retention_days > 0) {
+        start_retention_worker(retention_days,
+                               get_config_int("database.archive_retention_days", ARCHIVE_RETENTION_DEFAULT_DAYS));
+    }
+
     // Initialize modules
     printf(COLOR_GREEN "✅ Modüller yükleniyor...\n" COLOR_RESET);
     
@@ -222,6 +272,8 @@ int main() {
     cleanup_task_scheduler();
     cleanup_backup_system();
     
+    stop_log_follow();
+    stop_retention_worker();
     close_database();
     cleanup_logger();
     
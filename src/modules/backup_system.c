@@ -625,9 +625,11 @@ int copy_directory(const char* source, const char* destination) {
             
             if (copy_file(sourcePath, destPath) == 0) {
                 printf(" ✅\n");
+                LOG_RATE_LIMITED(LOG_DEBUG, 20, "Dosya kopyalandı: %s", sourcePath);
                 successCount++;
             } else {
                 printf(" ❌\n");
+                LOG_RATE_LIMITED(LOG_WARNING, 5, "Dosya kopyalanamadı: %s", sourcePath);
             }
             
             // İlerleme göstergesi için kısa bekleme
@@ -710,9 +712,11 @@ int copy_directory(const char* source, const char* destination) {
                 
                 if (copy_file(sourcePath, destPath) == 0) {
                     printf(" ✅\n");
+                    LOG_RATE_LIMITED(LOG_DEBUG, 20, "Dosya kopyalandı: %s", sourcePath);
                     successCount++;
                 } else {
                     printf(" ❌\n");
+                    LOG_RATE_LIMITED(LOG_WARNING, 5, "Dosya kopyalanamadı: %s", sourcePath);
                 }
                 
                 usleep(50000); // 50ms bekleme
@@ -11,6 +11,9 @@
 #include "../../include/logger.h"
 #include "../../include/modules.h"
 #include "../../include/database.h"
+#include "../../include/metrics_archive.h"
+#include "../../include/database_backup.h"
+#include "../../include/database_export.h"
 
 // Function prototypes
 void show_database_menu();
@@ -48,6 +51,7 @@ void run_database_viewer() {
             while (getchar() != '\n'); // Clear input buffer
             continue;
         }
+        while (getchar() != '\n'); // Drop the rest of the line so fgets() prompts work
         
         switch (choice) {
             case 1:
@@ -86,7 +90,6 @@ void run_database_viewer() {
         
         if (choice != 0) {
             printf("\n⏸️  Devam etmek için Enter tuşuna basın...");
-            getchar(); // Clear newline
             getchar(); // Wait for Enter
         }
         
@@ -383,44 +386,48 @@ void generate_reports() {
     
     printf("\n📈 Özet rapor oluşturuluyor...\n");
     
-    // Get counts from each table
-    SystemMetrics *sys_metrics = NULL;
-    FileOperation *file_ops = NULL;
-    NetworkMetrics *net_metrics = NULL;
-    SecurityScan *sec_scans = NULL;
-    ScheduledTask *tasks = NULL;
-    
-    int sys_count = 0, file_count = 0, net_count = 0, sec_count = 0, task_count = 0;
-    
-    get_system_metrics_history(&sys_metrics, &sys_count, 1000);
-    get_file_operations_history(&file_ops, &file_count, 1000);
-    get_network_metrics_history(&net_metrics, &net_count, 1000);
-    get_security_scans_history(&sec_scans, &sec_count, 1000);
-    get_scheduled_tasks(&tasks, &task_count);
+    // Counts are computed by SQLite; no rows are loaded
+    TableCounts counts;
+    if (!get_table_counts(&counts)) {
+        printf("\n❌ Kayıt sayıları alınamadı!\n");
+        return;
+    }
     
     printf("\n📊 VERİTABANI ÖZET RAPORU\n");
     printf("═══════════════════════════════════════════════════════════════\n");
-    printf("📈 Sistem Metrikleri      : %d kayıt\n", sys_count);
-    printf("📁 Dosya İşlemleri        : %d kayıt\n", file_count);
-    printf("🌐 Ağ Metrikleri          : %d kayıt\n", net_count);
-    printf("🔒 Güvenlik Taramaları    : %d kayıt\n", sec_count);
-    printf("⏰ Zamanlanmış Görevler   : %d kayıt\n", task_count);
+    printf("📈 Sistem Metrikleri      : %lld kayıt\n", counts.system_metrics);
+    printf("🗜️  Arşivlenmiş Metrikler  : %lld kayıt\n", counts.archived_system_metrics);
+    printf("📁 Dosya İşlemleri        : %lld kayıt\n", counts.file_operations);
+    printf("🌐 Ağ Metrikleri          : %lld kayıt\n", counts.network_metrics);
+    printf("🔒 Güvenlik Taramaları    : %lld kayıt\n", counts.security_scans);
+    printf("⏰ Zamanlanmış Görevler   : %lld kayıt\n", counts.scheduled_tasks);
     printf("═══════════════════════════════════════════════════════════════\n");
-    printf("📊 TOPLAM KAYIT           : %d\n", 
-           sys_count + file_count + net_count + sec_count + task_count);
+    printf("📊 TOPLAM KAYIT           : %lld\n", 
+           counts.system_metrics + counts.archived_system_metrics + counts.file_operations +
+           counts.network_metrics + counts.security_scans + counts.scheduled_tasks);
     
-    // Generate timestamp for report
+    // Last 24 hours, summarized in SQL
+    const char *metrics[] = { "cpu_usage", "memory_usage", "disk_usage", "ping_time" };
+    const char *labels[] = { "CPU (%)", "Bellek (%)", "Disk (%)", "Ping (ms)" };
     time_t now = time(NULL);
+    
+    printf("\n📉 SON 24 SAAT\n");
+    printf("%-14s %10s %10s %10s %10s\n", "Metrik", "Örnek", "Min", "Ort", "Maks");
+    for (int i = 0; i < 4; i++) {
+        MetricSummary summary;
+        if (get_metric_summary(metrics[i], now - 24 * 60 * 60, now + 1, &summary) &&
+            summary.sample_count > 0) {
+            printf("%-14s %10lld %10.2f %10.2f %10.2f\n", labels[i],
+                   summary.sample_count, summary.min, summary.avg, summary.max);
+        } else {
+            printf("%-14s %10d %10s %10s %10s\n", labels[i], 0, "-", "-", "-");
+        }
+    }
+    
+    // Generate timestamp for report
     char time_str[64];
     format_timestamp(now, time_str, sizeof(time_str));
-    printf("🕒 Rapor Tarihi           : %s\n", time_str);
-    
-    // Free allocated memory
-    if (sys_metrics) free(sys_metrics);
-    if (file_ops) free(file_ops);
-    if (net_metrics) free(net_metrics);
-    if (sec_scans) free(sec_scans);
-    if (tasks) free(tasks);
+    printf("\n🕒 Rapor Tarihi           : %s\n", time_str);
     
     log_info("Database özet raporu oluşturuldu");
 }
@@ -432,43 +439,213 @@ void database_statistics() {
     
     printf("\n📊 Veritabanı istatistikleri hesaplanıyor...\n");
     
-    // This would require additional SQL queries to get table sizes, etc.
-    // For now, we'll show basic information
-    
     printf("\n📈 VERİTABANI BİLGİLERİ\n");
     printf("═══════════════════════════════════════════════════════════════\n");
-    printf("📂 Veritabanı Dosyası     : data/automation.db\n");
+    printf("📂 Veritabanı Dosyası     : %s\n", DATABASE_PATH);
     printf("🔧 SQLite Versiyonu       : %s\n", sqlite3_libversion());
     printf("📊 Aktif Bağlantı         : %s\n", db ? "Evet" : "Hayır");
     
-    // Get database file size (approximate)
-    FILE *db_file = fopen("data/automation.db", "rb");
-    if (db_file) {
-        fseek(db_file, 0, SEEK_END);
-        long size = ftell(db_file);
-        fclose(db_file);
-        printf("💾 Dosya Boyutu           : %ld bytes (%.2f KB)\n", 
-               size, (double)size / 1024.0);
+    DatabasePageStats pages;
+    if (get_database_page_stats(&pages)) {
+        printf("💾 Veritabanı Boyutu      : %lld bytes (%.2f KB)\n", 
+               pages.total_bytes, (double)pages.total_bytes / 1024.0);
+        printf("📄 Sayfa                  : %lld x %d bytes\n", pages.page_count, pages.page_size);
+        printf("🕳️  Boş Sayfa              : %lld (%.2f KB geri kazanılabilir)\n",
+               pages.freelist_count, (double)(pages.freelist_count * pages.page_size) / 1024.0);
     }
     
     printf("═══════════════════════════════════════════════════════════════\n");
     
+    TableSize *sizes = NULL;
+    int count = 0;
+    if (get_table_sizes(&sizes, &count)) {
+        printf("\n📦 TABLO VE İNDEKS BOYUTLARI\n");
+        printf("%-40s %10s %14s\n", "Ad", "Sayfa", "Boyut (KB)");
+        print_separator();
+        for (int i = 0; i < count; i++) {
+            printf("%-40s %10lld %14.2f\n", sizes[i].name, sizes[i].pages, sizes[i].bytes / 1024.0);
+        }
+        free(sizes);
+    } else {
+        printf("\n⚠️  Tablo boyutları için SQLite dbstat desteği gerekli.\n");
+    }
+    
     log_info("Veritabanı istatistikleri görüntülendi");
 }
 
+static void print_backup_progress(int copied_pages, int total_pages, void *user_data) {
+    (void)user_data;
+    int percent = total_pages > 0 ? (copied_pages * 100) / total_pages : 100;
+    printf("\r   ⏳ %d / %d sayfa (%%%d)", copied_pages, total_pages, percent);
+    fflush(stdout);
+}
+
+static void backup_database_interactive(bool compressed) {
+    char timestamp[32];
+    char backup_path[512];
+    time_t now = time(NULL);
+    
+    strftime(timestamp, sizeof(timestamp), "%Y%m%d_%H%M%S", localtime(&now));
+    snprintf(backup_path, sizeof(backup_path), "data/automation_%s.%s",
+             timestamp, compressed ? "snap" : "db");
+    
+    DatabaseBackupOptions options;
+    init_database_backup_options(&options);
+    options.compressed = compressed;
+    options.progress = print_backup_progress;
+    
+    printf("\n💾 Yedekleniyor: %s\n", backup_path);
+    
+    if (!backup_database_paced(backup_path, &options)) {
+        printf("\n❌ Yedekleme başarısız!\n");
+        return;
+    }
+    printf("\n✅ Yedek oluşturuldu: %s\n", backup_path);
+    
+    if (compressed) {
+        DatabaseSnapshotInfo info;
+        if (verify_database_snapshot(backup_path, &info)) {
+            printf("🔐 Doğrulandı: %lld -> %lld bytes, %d parça, CRC32 %08x\n",
+                   info.raw_bytes, info.stored_bytes, info.chunk_count, (unsigned int)info.checksum);
+        } else {
+            printf("❌ Snapshot doğrulaması başarısız!\n");
+        }
+    }
+}
+
+static void restore_snapshot_interactive(void) {
+    char snapshot_path[512];
+    char database_path[512];
+    
+    printf("\n📂 Snapshot dosyası: ");
+    if (fgets(snapshot_path, sizeof(snapshot_path), stdin) == NULL) {
+        return;
+    }
+    snapshot_path[strcspn(snapshot_path, "\n")] = 0;
+    
+    DatabaseSnapshotInfo info;
+    if (!verify_database_snapshot(snapshot_path, &info)) {
+        printf("❌ Snapshot bozuk veya okunamadı!\n");
+        return;
+    }
+    printf("🔐 Snapshot sağlam: %lld bytes, %d parça, CRC32 %08x\n",
+           info.raw_bytes, info.chunk_count, (unsigned int)info.checksum);
+    
+    printf("💾 Açılacak veritabanı dosyası (canlı veritabanı değil): ");
+    if (fgets(database_path, sizeof(database_path), stdin) == NULL) {
+        return;
+    }
+    database_path[strcspn(database_path, "\n")] = 0;
+    
+    if (strcmp(database_path, DATABASE_PATH) == 0) {
+        printf("❌ Açık veritabanının üzerine yazılamaz!\n");
+        return;
+    }
+    
+    if (restore_database_snapshot(snapshot_path, database_path)) {
+        printf("✅ Snapshot açıldı: %s\n", database_path);
+    } else {
+        printf("❌ Snapshot açılamadı!\n");
+    }
+}
+
+static void export_table_interactive() {
+    printf("\n📋 Tablo:\n");
+    for (int i = 0; i < EXPORT_TABLE_COUNT; i++) {
+        printf("   %d. %s\n", i + 1, export_table_name((ExportTable)i));
+    }
+    printf("Seçim (1-%d): ", EXPORT_TABLE_COUNT);
+    
+    char input[256];
+    if (fgets(input, sizeof(input), stdin) == NULL) {
+        return;
+    }
+    int table_choice = atoi(input);
+    if (table_choice < 1 || table_choice > EXPORT_TABLE_COUNT) {
+        printf("❌ Geçersiz seçim!\n");
+        return;
+    }
+    ExportTable table = (ExportTable)(table_choice - 1);
+    
+    printf("\n📄 Biçim: 1. CSV  2. NDJSON  3. Binary (uzunluk önekli)\n");
+    printf("Seçim (1-3): ");
+    if (fgets(input, sizeof(input), stdin) == NULL) {
+        return;
+    }
+    ExportFormat format;
+    switch (atoi(input)) {
+        case 1: format = EXPORT_FORMAT_CSV; break;
+        case 2: format = EXPORT_FORMAT_NDJSON; break;
+        case 3: format = EXPORT_FORMAT_BINARY; break;
+        default:
+            printf("❌ Geçersiz seçim!\n");
+            return;
+    }
+    
+    printf("\n📅 Son kaç günün verisi? (0 = tümü, varsayılan: 0): ");
+    int days = 0;
+    if (fgets(input, sizeof(input), stdin) != NULL) {
+        days = atoi(input);
+    }
+    time_t now = time(NULL);
+    time_t from = days > 0 ? now - (time_t)days * 24 * 60 * 60 : 0;
+    
+    char default_path[256];
+    char stamp[32];
+    strftime(stamp, sizeof(stamp), "%Y%m%d_%H%M%S", localtime(&now));
+    snprintf(default_path, sizeof(default_path), "data/%s_%s.%s",
+             export_table_name(table), stamp, export_format_extension(format));
+    
+    printf("📁 Dosya yolu (varsayılan: %s): ", default_path);
+    char path[256];
+    if (fgets(path, sizeof(path), stdin) == NULL || path[0] == '\n') {
+        strcpy(path, default_path);
+    }
+    path[strcspn(path, "\r\n")] = '\0';
+    
+    printf("\n📤 Dışa aktarılıyor...\n");
+    
+    long long rows = 0;
+    if (export_table_to_file(table, format, from, 0, path, &rows)) {
+        printf("✅ %lld kayıt aktarıldı: %s\n", rows, path);
+    } else {
+        printf("❌ Dışa aktarma başarısız!\n");
+    }
+}
+
 void export_data() {
     printf("\n╔══════════════════════════════════════════════════════════════╗\n");
     printf("║                      VERİ DIŞA AKTARMA                      ║\n");
     printf("╚══════════════════════════════════════════════════════════════╝\n");
     
-    printf("\n💾 Veri dışa aktarma özelliği geliştirilme aşamasında...\n");
-    printf("🔧 Bu özellik gelecek sürümlerde eklenecektir.\n");
+    printf("\n1. 💾 Veritabanı yedeği (çevrimiçi, sayfa sayfa)\n");
+    printf("2. 🗜️  Sıkıştırılmış ve sağlama toplamlı snapshot\n");
+    printf("3. 🔐 Snapshot doğrula ve aç\n");
+    printf("4. 📤 Tabloyu dışa aktar (CSV / NDJSON / binary)\n");
+    printf("\nSeçim (1-4): ");
     
-    // Future implementation:
-    // - Export to CSV
-    // - Export to JSON
-    // - Export to XML
-    // - Backup database
+    char input[10];
+    if (fgets(input, sizeof(input), stdin) == NULL) {
+        return;
+    }
+    
+    switch (atoi(input)) {
+        case 1:
+            backup_database_interactive(false);
+            break;
+        case 2:
+            backup_database_interactive(true);
+            break;
+        case 3:
+            restore_snapshot_interactive();
+            break;
+        case 4:
+            export_table_interactive();
+            break;
+        default:
+            printf("❌ Geçersiz seçim!\n");
+            return;
+    }
     
     log_info("Veri dışa aktarma menüsü görüntülendi");
 }
@@ -490,6 +667,7 @@ void cleanup_old_data() {
     }
     
     printf("\n⚠️  %d günden eski tüm veriler silinecek!\n", days);
+    printf("🗜️  Arşivleme açıksa sistem metrikleri silinmeden önce sıkıştırılmış arşive taşınır.\n");
     printf("❓ Devam etmek istediğinizden emin misiniz? (E/H): ");
     
     if (fgets(input, sizeof(input), stdin) != NULL) {
@@ -499,8 +677,14 @@ void cleanup_old_data() {
             if (cleanup_old_records(days)) {
                 printf("✅ %d günden eski veriler başarıyla temizlendi!\n", days);
                 
-                // Vacuum database to reclaim space
-                if (vacuum_database()) {
+                ArchiveStats stats;
+                if (get_archive_statistics(&stats)) {
+                    printf("🗜️  Arşiv: %lld kayıt, %lld blok, %.2f KB\n",
+                           stats.row_count, stats.block_count, stats.compressed_bytes / 1024.0);
+                }
+                
+                // Release freed pages in small steps instead of a blocking VACUUM
+                if (reclaim_free_pages(RETENTION_VACUUM_PAGES, RETENTION_BATCH_PAUSE_MS)) {
                     printf("🗜️  Veritabanı optimize edildi.\n");
                 }
             } else {
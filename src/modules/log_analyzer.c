@@ -16,6 +16,9 @@
 #endif
 
 #include "../../include/logger.h"
+#include "../../include/log_binary.h"
+#include "../../include/log_checkpoint.h"
+#include "../../include/log_follow.h"
 
 void show_log_analyzer_menu() {
     printf("\n╔══════════════════════════════════════════════════════════════╗\n");
@@ -27,99 +30,86 @@ void show_log_analyzer_menu() {
     printf("║  [4] Zaman Bazlı Analiz                                     ║\n");
     printf("║  [5] Log Temizleme                                          ║\n");
     printf("║  [6] Otomatik Rapor Oluştur                                 ║\n");
+    printf("║  [7] Binary Log Görüntüle                                   ║\n");
+    printf("║  [8] Canlı Log Takibi                                       ║\n");
     printf("║  [0] Ana Menüye Dön                                         ║\n");
     printf("╚══════════════════════════════════════════════════════════════╝\n");
-    printf("\nSeçiminizi yapın (0-6): ");
+    printf("\nSeçiminizi yapın (0-8): ");
+}
+// Tüm menüler aynı istatistik nesnesini kullanır: log_analysis aktif log
+// dosyasını ve döndürülmüş segmentleri tek geçişte, tüm çekirdeklerde tarar.
+// log_checkpoint yalnızca son analizden sonra yazılan satırları okur.
+
+#define DEFAULT_LOG_PATH "logs/automation.log"
+
+static bool load_log_statistics(LogStatistics *stats) {
+    return update_log_set_statistics(0, time(NULL), stats);
 }
 
 void analyze_log_file() {
     printf("\nLog Dosyası Analizi\n");
     printf("==================\n");
-    
-    #ifdef _WIN32
-    // Gerçek log dosyasını analiz et
-    const char* logPath = "logs/automation.log";
-    HANDLE hFile = CreateFile(logPath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
-    
-    if (hFile != INVALID_HANDLE_VALUE) {
-        LARGE_INTEGER fileSize;
-        GetFileSizeEx(hFile, &fileSize);
-        double fileSizeMB = (double)fileSize.QuadPart / (1024.0 * 1024.0);
-        
-        printf("📁 Analiz edilen dosya: %s\n", logPath);
-        printf("📊 Dosya boyutu: %.2f MB\n", fileSizeMB);
-        
-        // Dosya içeriğini oku ve analiz et
-        DWORD bytesRead;
-        char buffer[8192];
-        int infoCount = 0, warningCount = 0, errorCount = 0, debugCount = 0;
-        int totalLines = 0;
-        
-        SYSTEMTIME firstTime = {0}, lastTime = {0};
-        BOOL firstTimeSet = FALSE;
-        
-        while (ReadFile(hFile, buffer, sizeof(buffer) - 1, &bytesRead, NULL) && bytesRead > 0) {
-            buffer[bytesRead] = '\0';
-            
-            char* line = strtok(buffer, "\n");
-            while (line != NULL) {
-                totalLines++;
-                
-                // Log seviyelerini say
-                if (strstr(line, "[INFO]")) infoCount++;
-                else if (strstr(line, "[WARNING]")) warningCount++;
-                else if (strstr(line, "[ERROR]")) errorCount++;
-                else if (strstr(line, "[DEBUG]")) debugCount++;
-                
-                // İlk ve son zaman damgalarını bul
-                if (!firstTimeSet && strlen(line) > 19) {
-                    // Basit tarih formatı kontrolü (YYYY-MM-DD HH:MM:SS)
-                    if (line[4] == '-' && line[7] == '-' && line[10] == ' ' && line[13] == ':' && line[16] == ':') {
-                        GetSystemTime(&firstTime);
-                        firstTimeSet = TRUE;
-                    }
-                }
-                
-                line = strtok(NULL, "\n");
-            }
+
+    LogStatistics stats;
+    if (load_log_statistics(&stats)) {
+        printf("📁 Analiz edilen dosya: %d (aktif log ve döndürülmüş segmentler)\n", stats.files);
+        printf("📊 Toplam boyut: %.2f MB\n", stats.bytes / (1024.0 * 1024.0));
+
+        if (stats.first_time[0] != '\0') {
+            printf("📅 Tarih aralığı: %.10s - %.10s\n\n", stats.first_time, stats.last_time);
+        } else {
+            printf("📅 Tarih aralığı: Zaman damgası bulunamadı\n\n");
         }
-        
-        GetSystemTime(&lastTime);
-        CloseHandle(hFile);
-        
-        printf("📅 Tarih aralığı: %04d-%02d-%02d - %04d-%02d-%02d\n\n", 
-               firstTime.wYear, firstTime.wMonth, firstTime.wDay,
-               lastTime.wYear, lastTime.wMonth, lastTime.wDay);
-        
-        int totalLogs = infoCount + warningCount + errorCount + debugCount;
+
+        long long infoCount = (long long)stats.counts.levels[LOG_INFO];
+        long long warningCount = (long long)stats.counts.levels[LOG_WARNING];
+        long long errorCount = (long long)stats.counts.levels[LOG_ERROR];
+        long long debugCount = (long long)stats.counts.levels[LOG_DEBUG];
+        long long totalLogs = infoCount + warningCount + errorCount + debugCount;
         if (totalLogs > 0) {
             printf("📈 Log Seviyesi Dağılımı:\n");
-            printf("   ✅ INFO:    %d kayıt (%d%%)\n", infoCount, (infoCount * 100) / totalLogs);
-            printf("   ⚠️  WARNING:  %d kayıt (%d%%)\n", warningCount, (warningCount * 100) / totalLogs);
-            printf("   ❌ ERROR:    %d kayıt (%d%%)\n", errorCount, (errorCount * 100) / totalLogs);
-            printf("   🐛 DEBUG:     %d kayıt (%d%%)\n\n", debugCount, (debugCount * 100) / totalLogs);
+            printf("   ✅ INFO:    %lld kayıt (%lld%%)\n", infoCount, (infoCount * 100) / totalLogs);
+            printf("   ⚠️  WARNING:  %lld kayıt (%lld%%)\n", warningCount, (warningCount * 100) / totalLogs);
+            printf("   ❌ ERROR:    %lld kayıt (%lld%%)\n", errorCount, (errorCount * 100) / totalLogs);
+            printf("   🐛 DEBUG:     %lld kayıt (%lld%%)\n\n", debugCount, (debugCount * 100) / totalLogs);
         } else {
             printf("📈 Log Seviyesi Dağılımı:\n");
             printf("   ℹ️  Log dosyası boş veya standart format değil\n\n");
         }
-        
+
+        // Sayılar, değişken kısımları (sayı, yol, IP) maskelenmiş mesaj şablonlarına aittir
+        printf("🔍 En Sık Görülen Mesajlar:\n");
+        bool estimated = false;
+        for (int i = 0; i < stats.top_message_count; i++) {
+            const LogMessageCount *message = &stats.top_messages[i];
+            if (message->error > 0) {
+                printf("   %2d. %s (%lld-%lld kez)\n", i + 1, message->text,
+                       (long long)(message->count - message->error), (long long)message->count);
+                estimated = true;
+            } else {
+                printf("   %2d. %s (%lld kez)\n", i + 1, message->text, (long long)message->count);
+            }
+        }
+        if (stats.top_message_count == 0) {
+            printf("   ℹ️  Seviye etiketli mesaj bulunamadı\n");
+        }
+        if (estimated) {
+            printf("   ℹ️  Şablon tablosu dolduğu için bazı sayılar aralık olarak verildi\n");
+        }
+
     } else {
-        printf("📁 Analiz edilen dosya: %s\n", logPath);
+        printf("📁 Analiz edilen dosya: %s\n", DEFAULT_LOG_PATH);
         printf("⚠️  Dosya bulunamadı - örnek analiz gösteriliyor\n");
         printf("📊 Dosya boyutu: 0 MB\n");
         printf("📅 Tarih aralığı: Dosya mevcut değil\n\n");
-        
+
         printf("📈 Log Seviyesi Dağılımı:\n");
         printf("   ℹ️  Log dosyası mevcut değil\n\n");
+
+        printf("🔍 En Sık Görülen Mesajlar:\n");
+        printf("   ℹ️  Gerçek log analizi için geçerli log dosyası gerekli\n");
     }
-    
-    printf("🔍 En Sık Görülen Mesajlar:\n");
-    printf("   ℹ️  Gerçek log analizi için geçerli log dosyası gerekli\n");
-    
-    #else
-    printf("Linux/Unix log analizi henüz desteklenmiyor.\n");
-    #endif
-    
+
     log_info("Log dosyası analizi tamamlandı");
 }
 
@@ -127,78 +117,38 @@ void filter_error_logs() {
     printf("\nHata Logları Filtreleme\n");
     printf("======================\n");
     printf("🔍 ERROR seviyesindeki loglar filtreleniyor...\n\n");
-    
-    #ifdef _WIN32
-    const char* logPath = "logs/automation.log";
-    HANDLE hFile = CreateFile(logPath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
-    
-    if (hFile != INVALID_HANDLE_VALUE) {
-        printf("❌ Bulunan Hatalar (Gerçek log dosyasından):\n");
+
+    LogStatistics stats;
+    if (load_log_statistics(&stats)) {
+        long long errorCount = (long long)stats.counts.levels[LOG_ERROR];
+
+        printf("❌ Son Hatalar (Gerçek log dosyasından):\n");
         printf("┌──────────────────────┬─────────────────────────────────────────┐\n");
         printf("│ Zaman                │ Hata Mesajı                             │\n");
         printf("├──────────────────────┼─────────────────────────────────────────┤\n");
-        
-        DWORD bytesRead;
-        char buffer[8192];
-        int errorCount = 0;
-        int networkErrors = 0, fileErrors = 0, memoryErrors = 0, securityErrors = 0;
-        
-        while (ReadFile(hFile, buffer, sizeof(buffer) - 1, &bytesRead, NULL) && bytesRead > 0 && errorCount < 10) {
-            buffer[bytesRead] = '\0';
-            
-            char* line = strtok(buffer, "\n");
-            while (line != NULL && errorCount < 10) {
-                if (strstr(line, "[ERROR]")) {
-                    errorCount++;
-                    
-                    // Zaman damgasını çıkar (ilk 19 karakter)
-                    char timeStr[20] = {0};
-                    if (strlen(line) > 19) {
-                        strncpy(timeStr, line, 19);
-                    } else {
-                        strcpy(timeStr, "Bilinmeyen zaman");
-                    }
-                    
-                    // Hata mesajını çıkar
-                    char* errorMsg = strstr(line, "[ERROR]");
-                    if (errorMsg) {
-                        errorMsg += 7; // "[ERROR]" kısmını atla
-                        while (*errorMsg == ' ') errorMsg++; // Boşlukları atla
-                    } else {
-                        errorMsg = "Bilinmeyen hata";
-                    }
-                    
-                    printf("│ %-20s │ %-39.39s │\n", timeStr, errorMsg);
-                    
-                    // Hata kategorilerini say
-                    if (strstr(line, "network") || strstr(line, "connection") || strstr(line, "timeout")) {
-                        networkErrors++;
-                    } else if (strstr(line, "file") || strstr(line, "directory") || strstr(line, "path")) {
-                        fileErrors++;
-                    } else if (strstr(line, "memory") || strstr(line, "allocation") || strstr(line, "heap")) {
-                        memoryErrors++;
-                    } else if (strstr(line, "security") || strstr(line, "auth") || strstr(line, "permission")) {
-                        securityErrors++;
-                    }
-                }
-                line = strtok(NULL, "\n");
-            }
+
+        for (int i = 0; i < stats.recent_error_count; i++) {
+            const LogErrorLine *error = &stats.recent_errors[i];
+            char errorMsg[40];
+            snprintf(errorMsg, sizeof(errorMsg), "%s", error->message);
+            printf("│ %-20s │ %-39.39s │\n", error->time[0] ? error->time : "Bilinmeyen zaman", errorMsg);
         }
-        
-        CloseHandle(hFile);
-        
         if (errorCount == 0) {
             printf("│ Hata bulunamadı      │ Log dosyasında ERROR seviyesi yok       │\n");
         }
-        
-        printf("└──────────────────────┴─────────────────────────────────────────┘\n\n");
-        
+
+        printf("└──────────────────────┴─────────────────────────────────────────┘\n");
+        if (errorCount > stats.recent_error_count) {
+            printf("   ... ve %lld eski hata daha\n", errorCount - stats.recent_error_count);
+        }
+        printf("\n");
+
         printf("📊 Hata Kategorileri:\n");
-        printf("   🌐 Ağ Hataları: %d adet\n", networkErrors);
-        printf("   📁 Dosya Hataları: %d adet\n", fileErrors);
-        printf("   💾 Bellek Hataları: %d adet\n", memoryErrors);
-        printf("   🔐 Güvenlik Hataları: %d adet\n", securityErrors);
-        
+        printf("   🌐 Ağ Hataları: %lld adet\n", (long long)stats.error_categories[LOG_CATEGORY_NETWORK]);
+        printf("   📁 Dosya Hataları: %lld adet\n", (long long)stats.error_categories[LOG_CATEGORY_FILE]);
+        printf("   💾 Bellek Hataları: %lld adet\n", (long long)stats.error_categories[LOG_CATEGORY_MEMORY]);
+        printf("   🔐 Güvenlik Hataları: %lld adet\n", (long long)stats.error_categories[LOG_CATEGORY_SECURITY]);
+
     } else {
         printf("❌ Log dosyası bulunamadı - örnek hata gösteriliyor:\n");
         printf("┌──────────────────────┬─────────────────────────────────────────┐\n");
@@ -206,82 +156,35 @@ void filter_error_logs() {
         printf("├──────────────────────┼─────────────────────────────────────────┤\n");
         printf("│ Log dosyası yok      │ Gerçek hatalar için log dosyası gerekli │\n");
         printf("└──────────────────────┴─────────────────────────────────────────┘\n\n");
-        
+
         printf("📊 Hata Kategorileri:\n");
         printf("   ℹ️  Log dosyası mevcut değil\n");
     }
-    
-    #else
-    printf("Linux/Unix hata log filtreleme henüz desteklenmiyor.\n");
-    #endif
-    
+
     log_info("Hata logları filtreleme işlemi tamamlandı");
 }
 
 void show_log_statistics() {
     printf("\nLog İstatistikleri\n");
     printf("=================\n");
-    
-    #ifdef _WIN32
-    const char* logPath = "logs/automation.log";
-    HANDLE hFile = CreateFile(logPath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
-    
-    if (hFile != INVALID_HANDLE_VALUE) {
-        LARGE_INTEGER fileSize;
-        GetFileSizeEx(hFile, &fileSize);
-        
-        DWORD bytesRead;
-        char buffer[8192];
-        int totalRecords = 0;
-        int dailyRecords[10] = {0}; // Son 10 günün kayıtları
-        int hourlyRecords[24] = {0}; // 24 saatlik dağılım
-        
-        SYSTEMTIME firstTime = {0}, lastTime = {0};
-        BOOL firstTimeSet = FALSE;
-        
-        while (ReadFile(hFile, buffer, sizeof(buffer) - 1, &bytesRead, NULL) && bytesRead > 0) {
-            buffer[bytesRead] = '\0';
-            
-            char* line = strtok(buffer, "\n");
-            while (line != NULL) {
-                if (strlen(line) > 10) { // En az tarih formatı kadar uzun olmalı
-                    totalRecords++;
-                    
-                    // İlk ve son zaman damgalarını kaydet
-                    if (!firstTimeSet && strlen(line) > 19) {
-                        if (line[4] == '-' && line[7] == '-' && line[10] == ' ') {
-                            GetSystemTime(&firstTime);
-                            firstTimeSet = TRUE;
-                        }
-                    }
-                    
-                    // Saatlik dağılım için saat bilgisini çıkar
-                    if (strlen(line) > 13 && line[13] == ':') {
-                        int hour = (line[11] - '0') * 10 + (line[12] - '0');
-                        if (hour >= 0 && hour < 24) {
-                            hourlyRecords[hour]++;
-                        }
-                    }
-                }
-                line = strtok(NULL, "\n");
-            }
+
+    LogStatistics stats;
+    if (load_log_statistics(&stats)) {
+        long long totalRecords = (long long)stats.counts.lines;
+        long long hourlyRecords[24];
+        for (int i = 0; i < 24; i++) {
+            hourlyRecords[i] = (long long)stats.hourly[i];
         }
-        
-        GetSystemTime(&lastTime);
-        CloseHandle(hFile);
-        
+
         printf("📊 Genel İstatistikler:\n");
-        printf("   📝 Toplam log kayıtları: %d\n", totalRecords);
-        printf("   📅 İlk kayıt: %04d-%02d-%02d %02d:%02d:%02d\n", 
-               firstTime.wYear, firstTime.wMonth, firstTime.wDay,
-               firstTime.wHour, firstTime.wMinute, firstTime.wSecond);
-        printf("   📅 Son kayıt: %04d-%02d-%02d %02d:%02d:%02d\n", 
-               lastTime.wYear, lastTime.wMonth, lastTime.wDay,
-               lastTime.wHour, lastTime.wMinute, lastTime.wSecond);
-        
-        int avgDaily = totalRecords > 0 ? totalRecords / 10 : 0; // Yaklaşık 10 günlük ortalama
-        printf("   ⏱️  Ortalama günlük kayıt: %d\n\n", avgDaily);
-        
+        printf("   📁 Analiz edilen dosya: %d (%.1f MB)\n", stats.files, stats.bytes / (1024.0 * 1024.0));
+        printf("   📝 Toplam log kayıtları: %lld\n", totalRecords);
+        printf("   📅 İlk kayıt: %s\n", stats.first_time[0] ? stats.first_time : "Bilinmiyor");
+        printf("   📅 Son kayıt: %s\n", stats.last_time[0] ? stats.last_time : "Bilinmiyor");
+
+        long long avgDaily = totalRecords > 0 ? totalRecords / 10 : 0; // Yaklaşık 10 günlük ortalama
+        printf("   ⏱️  Ortalama günlük kayıt: %lld\n\n", avgDaily);
+
         printf("📈 Basit Aktivite Gösterimi:\n");
         printf("Toplam kayıt sayısına göre aktivite seviyesi:\n");
         if (totalRecords > 1000) {
@@ -294,7 +197,7 @@ void show_log_statistics() {
             printf("██▒▒▒▒▒▒▒▒▒▒▒▒▒▒▒▒▒▒ Çok düşük aktivite\n");
         }
         printf("\n");
-        
+
         // En aktif saatleri bul
         int maxHour1 = 0, maxHour2 = 0, maxHour3 = 0;
         for (int i = 0; i < 24; i++) {
@@ -309,40 +212,36 @@ void show_log_statistics() {
                 maxHour3 = i;
             }
         }
-        
+
         printf("🕐 Saatlik Dağılım (En Aktif Saatler):\n");
         if (hourlyRecords[maxHour1] > 0) {
-            printf("   🌅 %02d:00-%02d:00: %d kayıt\n", maxHour1, maxHour1+1, hourlyRecords[maxHour1]);
+            printf("   🌅 %02d:00-%02d:00: %lld kayıt\n", maxHour1, maxHour1+1, hourlyRecords[maxHour1]);
         }
         if (hourlyRecords[maxHour2] > 0) {
-            printf("   🌞 %02d:00-%02d:00: %d kayıt\n", maxHour2, maxHour2+1, hourlyRecords[maxHour2]);
+            printf("   🌞 %02d:00-%02d:00: %lld kayıt\n", maxHour2, maxHour2+1, hourlyRecords[maxHour2]);
         }
         if (hourlyRecords[maxHour3] > 0) {
-            printf("   🌆 %02d:00-%02d:00: %d kayıt\n", maxHour3, maxHour3+1, hourlyRecords[maxHour3]);
+            printf("   🌆 %02d:00-%02d:00: %lld kayıt\n", maxHour3, maxHour3+1, hourlyRecords[maxHour3]);
         }
-        
+
         if (hourlyRecords[maxHour1] == 0) {
             printf("   ℹ️  Saatlik veri bulunamadı\n");
         }
-        
+
     } else {
         printf("📊 Genel İstatistikler:\n");
         printf("   📝 Toplam log kayıtları: 0\n");
         printf("   📅 İlk kayıt: Log dosyası bulunamadı\n");
         printf("   📅 Son kayıt: Log dosyası bulunamadı\n");
         printf("   ⏱️  Ortalama günlük kayıt: 0\n\n");
-        
+
         printf("📈 Aktivite Gösterimi:\n");
         printf("▒▒▒▒▒▒▒▒▒▒▒▒▒▒▒▒▒▒▒▒ Log dosyası mevcut değil\n\n");
-        
+
         printf("🕐 Saatlik Dağılım:\n");
         printf("   ℹ️  Log dosyası mevcut değil\n");
     }
-    
-    #else
-    printf("Linux/Unix log istatistikleri henüz desteklenmiyor.\n");
-    #endif
-    
+
     log_info("Log istatistikleri görüntülendi");
 }
 
@@ -350,118 +249,59 @@ void time_based_analysis() {
     printf("\nZaman Bazlı Log Analizi\n");
     printf("======================\n");
     printf("📅 Son 7 günün günlük trend analizi yapılıyor...\n\n");
-    
-    #ifdef _WIN32
-    const char* logPath = "logs/automation.log";
-    HANDLE hFile = CreateFile(logPath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
-    
-    if (hFile != INVALID_HANDLE_VALUE) {
+
+    time_t now = time(NULL);
+    LogStatistics analysis;
+    if (update_log_set_statistics(0, now, &analysis)) {
         printf("📊 Günlük Log Dağılımı (Son 7 Gün):\n");
         printf("┌────────────┬─────────┬─────────┬─────────┬─────────┬─────────┐\n");
         printf("│ Tarih      │ INFO    │ WARNING │ ERROR   │ DEBUG   │ Toplam  │\n");
         printf("├────────────┼─────────┼─────────┼─────────┼─────────┼─────────┤\n");
-        
-        // Günlük sayaçlar (7 gün için)
-        int dailyInfo[7] = {0};
-        int dailyWarning[7] = {0};
-        int dailyError[7] = {0};
-        int dailyDebug[7] = {0};
-        int dailyTotal[7] = {0};
-        
-        // Bugünün tarihini al
-        time_t now = time(NULL);
-        struct tm* today = localtime(&now);
-        
-        DWORD bytesRead;
-        char buffer[8192];
-        char fullBuffer[65536] = {0}; // Tüm dosya içeriği için
-        DWORD totalBytesRead = 0;
-        
-        // Dosyayı tamamen oku
-        while (ReadFile(hFile, buffer, sizeof(buffer) - 1, &bytesRead, NULL) && bytesRead > 0) {
-            if (totalBytesRead + bytesRead < sizeof(fullBuffer) - 1) {
-                memcpy(fullBuffer + totalBytesRead, buffer, bytesRead);
-                totalBytesRead += bytesRead;
-            } else {
-                break;
+
+        long long dailyTotal[7] = {0};
+        long long hourlyCount[24];
+        for (int i = 0; i < 7; i++) {
+            for (int column = 0; column <= LOG_KERNEL_LEVELS; column++) {
+                dailyTotal[i] += (long long)analysis.daily[i][column];
             }
         }
-        fullBuffer[totalBytesRead] = '\0';
-        
-        CloseHandle(hFile);
-        
-        // Satır satır işle
-        char* line = strtok(fullBuffer, "\n");
-        while (line != NULL) {
-            // Tarih formatı: YYYY-MM-DD HH:MM:SS
-            if (strlen(line) >= 19) {
-                char dateStr[11];
-                strncpy(dateStr, line, 10);
-                dateStr[10] = '\0';
-                
-                // Tarihi parse et
-                int year, month, day;
-                if (sscanf(dateStr, "%d-%d-%d", &year, &month, &day) == 3) {
-                    struct tm logTime = {0};
-                    logTime.tm_year = year - 1900;
-                    logTime.tm_mon = month - 1;
-                    logTime.tm_mday = day;
-                    
-                    time_t logTimestamp = mktime(&logTime);
-                    double daysDiff = difftime(now, logTimestamp) / (24 * 3600);
-                    
-                    if (daysDiff >= 0 && daysDiff < 7) {
-                        int dayIndex = (int)daysDiff;
-                        
-                        dailyTotal[dayIndex]++;
-                        
-                        if (strstr(line, "[INFO]")) {
-                            dailyInfo[dayIndex]++;
-                        } else if (strstr(line, "[WARNING]")) {
-                            dailyWarning[dayIndex]++;
-                        } else if (strstr(line, "[ERROR]")) {
-                            dailyError[dayIndex]++;
-                        } else if (strstr(line, "[DEBUG]")) {
-                            dailyDebug[dayIndex]++;
-                        }
-                    }
-                }
-            }
-            line = strtok(NULL, "\n");
+        for (int i = 0; i < 24; i++) {
+            hourlyCount[i] = (long long)analysis.hourly[i];
         }
-        
+
         // Günlük verileri göster (en yeni günden başlayarak)
         for (int i = 0; i < 7; i++) {
             time_t dayTime = now - (i * 24 * 3600);
             struct tm* dayTm = localtime(&dayTime);
-            
+
             char dayStr[11];
             strftime(dayStr, sizeof(dayStr), "%Y-%m-%d", dayTm);
-            
-            printf("│ %-10s │ %7d │ %7d │ %7d │ %7d │ %7d │\n", 
-                   dayStr, dailyInfo[i], dailyWarning[i], dailyError[i], dailyDebug[i], dailyTotal[i]);
+
+            printf("│ %-10s │ %7lld │ %7lld │ %7lld │ %7lld │ %7lld │\n",
+                   dayStr, (long long)analysis.daily[i][LOG_INFO], (long long)analysis.daily[i][LOG_WARNING],
+                   (long long)analysis.daily[i][LOG_ERROR], (long long)analysis.daily[i][LOG_DEBUG], dailyTotal[i]);
         }
-        
+
         printf("└────────────┴─────────┴─────────┴─────────┴─────────┴─────────┘\n\n");
-        
+
         // Trend analizi
-        int totalLogs = 0, totalErrors = 0, totalWarnings = 0;
+        long long totalLogs = 0, totalErrors = 0, totalWarnings = 0;
         for (int i = 0; i < 7; i++) {
             totalLogs += dailyTotal[i];
-            totalErrors += dailyError[i];
-            totalWarnings += dailyWarning[i];
+            totalErrors += (long long)analysis.daily[i][LOG_ERROR];
+            totalWarnings += (long long)analysis.daily[i][LOG_WARNING];
         }
-        
+
         printf("📈 Trend Analizi:\n");
-        printf("   📊 Son 7 günde toplam %d log kaydı\n", totalLogs);
+        printf("   📊 Son 7 günde toplam %lld log kaydı\n", totalLogs);
         if (totalLogs > 0) {
-            printf("   ⚠️  Toplam %d uyarı (%.1f%%)\n", totalWarnings, (totalWarnings * 100.0 / totalLogs));
-            printf("   ❌ Toplam %d hata (%.1f%%)\n", totalErrors, (totalErrors * 100.0 / totalLogs));
+            printf("   ⚠️  Toplam %lld uyarı (%.1f%%)\n", totalWarnings, (totalWarnings * 100.0 / totalLogs));
+            printf("   ❌ Toplam %lld hata (%.1f%%)\n", totalErrors, (totalErrors * 100.0 / totalLogs));
         } else {
-            printf("   ⚠️  Toplam %d uyarı\n", totalWarnings);
-            printf("   ❌ Toplam %d hata\n", totalErrors);
+            printf("   ⚠️  Toplam %lld uyarı\n", totalWarnings);
+            printf("   ❌ Toplam %lld hata\n", totalErrors);
         }
-        
+
         // En aktif gün
         int maxDay = 0;
         for (int i = 1; i < 7; i++) {
@@ -469,82 +309,45 @@ void time_based_analysis() {
                 maxDay = i;
             }
         }
-        
+
         if (dailyTotal[maxDay] > 0) {
             time_t maxDayTime = now - (maxDay * 24 * 3600);
             struct tm* maxDayTm = localtime(&maxDayTime);
             char maxDayStr[11];
             strftime(maxDayStr, sizeof(maxDayStr), "%Y-%m-%d", maxDayTm);
-            printf("   🔥 En aktif gün: %s (%d log)\n", maxDayStr, dailyTotal[maxDay]);
+            printf("   🔥 En aktif gün: %s (%lld log)\n", maxDayStr, dailyTotal[maxDay]);
         }
-        
+
         // Saatlik dağılım analizi
         printf("\n⏰ Saatlik Aktivite Dağılımı:\n");
-        int hourlyCount[24] = {0};
-        
-        // Dosyayı tekrar oku saatlik analiz için
-        strcpy(fullBuffer, ""); // Buffer'ı temizle
-        totalBytesRead = 0;
-        
-        hFile = CreateFile(logPath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
-        if (hFile != INVALID_HANDLE_VALUE) {
-            while (ReadFile(hFile, buffer, sizeof(buffer) - 1, &bytesRead, NULL) && bytesRead > 0) {
-                if (totalBytesRead + bytesRead < sizeof(fullBuffer) - 1) {
-                    memcpy(fullBuffer + totalBytesRead, buffer, bytesRead);
-                    totalBytesRead += bytesRead;
-                } else {
-                    break;
-                }
+
+        // En aktif saatleri bul
+        int maxHour = 0;
+        for (int i = 1; i < 24; i++) {
+            if (hourlyCount[i] > hourlyCount[maxHour]) {
+                maxHour = i;
             }
-            fullBuffer[totalBytesRead] = '\0';
-            CloseHandle(hFile);
-            
-            line = strtok(fullBuffer, "\n");
-            while (line != NULL) {
-                if (strlen(line) >= 19) {
-                    int hour;
-                    if (sscanf(line + 11, "%d:", &hour) == 1 && hour >= 0 && hour < 24) {
-                        hourlyCount[hour]++;
+        }
+
+        if (hourlyCount[maxHour] > 0) {
+            printf("   🕐 En aktif saat: %02d:00-%02d:59 (%lld log)\n", maxHour, maxHour, hourlyCount[maxHour]);
+
+            // En aktif 3 saati göster
+            printf("   📊 En aktif saatler:\n");
+            for (int rank = 0; rank < 3; rank++) {
+                int topHour = 0;
+                for (int i = 1; i < 24; i++) {
+                    if (hourlyCount[i] > hourlyCount[topHour]) {
+                        topHour = i;
                     }
                 }
-                line = strtok(NULL, "\n");
-            }
-            
-            // En aktif saatleri bul
-            int maxHour = 0;
-            for (int i = 1; i < 24; i++) {
-                if (hourlyCount[i] > hourlyCount[maxHour]) {
-                    maxHour = i;
-                }
-            }
-            
-            if (hourlyCount[maxHour] > 0) {
-                printf("   🕐 En aktif saat: %02d:00-%02d:59 (%d log)\n", maxHour, maxHour, hourlyCount[maxHour]);
-                
-                // En aktif 3 saati göster
-                printf("   📊 En aktif saatler:\n");
-                for (int rank = 0; rank < 3; rank++) {
-                    int topHour = 0;
-                    for (int i = 1; i < 24; i++) {
-                        if (hourlyCount[i] > hourlyCount[topHour]) {
-                            // Daha önce seçilmiş saatleri atla
-                            int alreadySelected = 0;
-                            for (int j = 0; j < rank; j++) {
-                                // Bu basit implementasyonda sadece en yüksek 3'ü gösteriyoruz
-                            }
-                            if (!alreadySelected) {
-                                topHour = i;
-                            }
-                        }
-                    }
-                    if (hourlyCount[topHour] > 0) {
-                        printf("      %d. %02d:00-%02d:59 (%d log)\n", rank + 1, topHour, topHour, hourlyCount[topHour]);
-                        hourlyCount[topHour] = 0; // Bir sonraki iterasyon için sıfırla
-                    }
+                if (hourlyCount[topHour] > 0) {
+                    printf("      %d. %02d:00-%02d:59 (%lld log)\n", rank + 1, topHour, topHour, hourlyCount[topHour]);
+                    hourlyCount[topHour] = 0; // Bir sonraki iterasyon için sıfırla
                 }
             }
         }
-        
+
     } else {
         printf("❌ Log dosyası bulunamadı - örnek trend gösteriliyor:\n");
         printf("┌────────────┬─────────┬─────────┬─────────┬─────────┬─────────┐\n");
@@ -552,15 +355,11 @@ void time_based_analysis() {
         printf("├────────────┼─────────┼─────────┼─────────┼─────────┼─────────┤\n");
         printf("│ Log yok    │       0 │       0 │       0 │       0 │       0 │\n");
         printf("└────────────┴─────────┴─────────┴─────────┴─────────┴─────────┘\n\n");
-        
+
         printf("📈 Trend Analizi:\n");
         printf("   ℹ️  Log dosyası mevcut değil\n");
     }
-    
-    #else
-    printf("Linux/Unix zaman bazlı analiz henüz desteklenmiyor.\n");
-    #endif
-    
+
     log_info("Zaman bazlı log analizi tamamlandı");
 }
 
@@ -579,77 +378,40 @@ void clean_logs() {
     }
     
     // Log dosyasını analiz et
-    FILE *file = fopen(logPath, "r");
-    if (file == NULL) {
+    const char *paths[] = { logPath };
+    LogStatistics stats;
+    if (!build_log_statistics(paths, 1, 0, time(NULL), &stats)) {
         printf("❌ Log dosyası bulunamadı: %s\n", logPath);
         return;
     }
     
-    char line[512];
-    int total_lines = 0;
-    int debug_lines = 0;
-    int info_lines = 0;
-    int warning_lines = 0;
-    int error_lines = 0;
-    int old_30_days = 0;
-    int old_90_days = 0;
-    long file_size = 0;
-    
-    // Dosya boyutunu hesapla
-    fseek(file, 0, SEEK_END);
-    file_size = ftell(file);
-    fseek(file, 0, SEEK_SET);
-    
-    // Mevcut tarihi al
-    time_t now = time(NULL);
-    struct tm *current_time = localtime(&now);
-    
-    // Log satırlarını analiz et
-    while (fgets(line, sizeof(line), file)) {
-        total_lines++;
-        
-        // Log seviyelerini say
-        if (strstr(line, "[DEBUG]") != NULL) debug_lines++;
-        else if (strstr(line, "[INFO]") != NULL) info_lines++;
-        else if (strstr(line, "[WARNING]") != NULL) warning_lines++;
-        else if (strstr(line, "[ERROR]") != NULL) error_lines++;
-        
-        // Tarih analizi (basit format: YYYY-MM-DD)
-        if (strlen(line) >= 10) {
-            int year, month, day;
-            if (sscanf(line, "%d-%d-%d", &year, &month, &day) == 3) {
-                struct tm log_time = {0};
-                log_time.tm_year = year - 1900;
-                log_time.tm_mon = month - 1;
-                log_time.tm_mday = day;
-                
-                time_t log_timestamp = mktime(&log_time);
-                double days_diff = difftime(now, log_timestamp) / (24 * 3600);
-                
-                if (days_diff > 90) old_90_days++;
-                else if (days_diff > 30) old_30_days++;
-            }
-        }
-    }
-    fclose(file);
-    
-    double file_size_mb = file_size / (1024.0 * 1024.0);
-    double debug_size_mb = (debug_lines * 50.0) / (1024.0 * 1024.0); // Ortalama satır boyutu
-    double old_30_size_mb = (old_30_days * 50.0) / (1024.0 * 1024.0);
-    double old_90_size_mb = (old_90_days * 50.0) / (1024.0 * 1024.0);
+    long long total_lines = (long long)stats.counts.lines;
+    long long debug_lines = (long long)stats.counts.levels[LOG_DEBUG];
+    long long info_lines = (long long)stats.counts.levels[LOG_INFO];
+    long long warning_lines = (long long)stats.counts.levels[LOG_WARNING];
+    long long error_lines = (long long)stats.counts.levels[LOG_ERROR];
+    long long old_30_days = (long long)count_log_lines_older_than(&stats, 30);
+    long long old_90_days = (long long)count_log_lines_older_than(&stats, 90);
+    
+    // Kazanılacak alan ortalama satır boyutuyla tahmin edilir
+    double file_size_mb = stats.bytes / (1024.0 * 1024.0);
+    double line_size = total_lines > 0 ? (double)stats.bytes / total_lines : 0;
+    double debug_size_mb = (debug_lines * line_size) / (1024.0 * 1024.0);
+    double old_30_size_mb = (old_30_days * line_size) / (1024.0 * 1024.0);
+    double old_90_size_mb = (old_90_days * line_size) / (1024.0 * 1024.0);
     
     printf("📊 Log Dosyası Analizi:\n");
-    printf("• Toplam satır sayısı: %d\n", total_lines);
+    printf("• Toplam satır sayısı: %lld\n", total_lines);
     printf("• Dosya boyutu: %.2f MB\n", file_size_mb);
     printf("\n📅 Tarih bazlı analiz:\n");
-    printf("   ✅ 30 günden eski loglar: %d kayıt (%.1f MB)\n", old_30_days, old_30_size_mb);
-    printf("   ✅ 90 günden eski loglar: %d kayıt (%.1f MB)\n", old_90_days, old_90_size_mb);
+    printf("   ✅ 30 günden eski loglar: %lld kayıt (%.1f MB)\n", old_30_days, old_30_size_mb);
+    printf("   ✅ 90 günden eski loglar: %lld kayıt (%.1f MB)\n", old_90_days, old_90_size_mb);
     
     printf("\n📊 Seviye bazlı analiz:\n");
-    printf("   🐛 DEBUG logları: %d kayıt (%.1f MB)\n", debug_lines, debug_size_mb);
-    printf("   ✅ INFO logları: %d kayıt\n", info_lines);
-    printf("   ⚠️  WARNING logları: %d kayıt\n", warning_lines);
-    printf("   ❌ ERROR logları: %d kayıt\n", error_lines);
+    printf("   🐛 DEBUG logları: %lld kayıt (%.1f MB)\n", debug_lines, debug_size_mb);
+    printf("   ✅ INFO logları: %lld kayıt\n", info_lines);
+    printf("   ⚠️  WARNING logları: %lld kayıt\n", warning_lines);
+    printf("   ❌ ERROR logları: %lld kayıt\n", error_lines);
     
     // Temizleme seçenekleri sun
     printf("\n🗑️  Temizleme seçenekleri:\n");
@@ -663,7 +425,7 @@ void clean_logs() {
     int choice;
     scanf("%d", &choice);
     
-    int deleted_lines = 0;
+    long long deleted_lines = 0;
     double saved_space = 0.0;
     
     switch (choice) {
@@ -687,10 +449,11 @@ void clean_logs() {
             saved_space = file_size_mb;
             printf("🗑️  Tüm loglar temizleniyor...\n");
             // Dosyayı temizle
-            file = fopen(logPath, "w");
+            FILE *file = fopen(logPath, "w");
             if (file != NULL) {
                 fclose(file);
             }
+            clear_log_checkpoints();
             break;
         case 5:
             printf("❌ Temizleme iptal edildi.\n");
@@ -702,7 +465,7 @@ void clean_logs() {
     
     if (choice != 4) {
         printf("⚠️  Not: Gerçek log filtreleme işlemi karmaşık olduğu için simüle edildi.\n");
-        printf("✅ Gerçek uygulamada %d satır silinecekti.\n", deleted_lines);
+        printf("✅ Gerçek uygulamada %lld satır silinecekti.\n", deleted_lines);
     } else {
         printf("✅ Log dosyası tamamen temizlendi!\n");
     }
@@ -712,71 +475,78 @@ void clean_logs() {
     log_info("Log temizleme işlemi tamamlandı");
 }
 
+#ifdef _WIN32
+// Mesajlar log içeriğidir, HTML olarak yorumlanmamalı
+static void append_html_escaped(char *out, size_t size, const char *text) {
+    size_t used = strlen(out);
+    for (; *text && used + 7 < size; text++) {
+        switch (*text) {
+            case '<': used += (size_t)sprintf(out + used, "&lt;"); break;
+            case '>': used += (size_t)sprintf(out + used, "&gt;"); break;
+            case '&': used += (size_t)sprintf(out + used, "&amp;"); break;
+            case '"': used += (size_t)sprintf(out + used, "&quot;"); break;
+            default:  out[used++] = *text; out[used] = '\0'; break;
+        }
+    }
+}
+
+// En sık mesajlar ve son hatalar bölümleri
+static void write_report_messages(HANDLE file, const LogStatistics *stats) {
+    char section[8192] = "";
+    char row[64];
+    DWORD bytesWritten;
+
+    strcat(section, "        <div class=\"section\">\n"
+                    "            <h2>🔍 En Sık Görülen Mesajlar</h2>\n"
+                    "            <table class=\"info-table\">\n"
+                    "                <tr><th>Mesaj</th><th>Adet</th></tr>\n");
+    for (int i = 0; i < stats->top_message_count; i++) {
+        strcat(section, "                <tr><td>");
+        append_html_escaped(section, sizeof(section) - 64, stats->top_messages[i].text);
+        snprintf(row, sizeof(row), "</td><td>%lld</td></tr>\n", (long long)stats->top_messages[i].count);
+        strcat(section, row);
+    }
+    strcat(section, "            </table>\n        </div>\n\n");
+    WriteFile(file, section, strlen(section), &bytesWritten, NULL);
+
+    strcpy(section, "        <div class=\"section\">\n"
+                    "            <h2>❌ Son Hatalar</h2>\n"
+                    "            <table class=\"info-table\">\n"
+                    "                <tr><th>Zaman</th><th>Hata Mesajı</th></tr>\n");
+    for (int i = 0; i < stats->recent_error_count; i++) {
+        const LogErrorLine *error = &stats->recent_errors[i];
+        snprintf(row, sizeof(row), "                <tr><td>%s</td><td>",
+                 error->time[0] ? error->time : "Bilinmiyor");
+        strcat(section, row);
+        append_html_escaped(section, sizeof(section) - 64, error->message);
+        strcat(section, "</td></tr>\n");
+    }
+    strcat(section, "            </table>\n        </div>\n\n");
+    WriteFile(file, section, strlen(section), &bytesWritten, NULL);
+}
+#endif
+
 void generate_auto_report() {
     printf("\nOtomatik Rapor Oluşturma\n");
     printf("========================\n");
     printf("📄 Günlük log raporu oluşturuluyor...\n\n");
     
     #ifdef _WIN32
-    const char* logPath = "logs/automation.log";
     const char* reportPath = "reports/daily_log_report.html";
     
     // Reports klasörünü oluştur
     CreateDirectory("reports", NULL);
     
-    HANDLE hLogFile = CreateFile(logPath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    LogStatistics stats;
     
-    if (hLogFile != INVALID_HANDLE_VALUE) {
-        // Log dosyasını analiz et
-        DWORD bytesRead;
-        char buffer[8192];
-        char fullBuffer[65536] = {0};
-        DWORD totalBytesRead = 0;
-        
-        // Dosyayı tamamen oku
-        while (ReadFile(hLogFile, buffer, sizeof(buffer) - 1, &bytesRead, NULL) && bytesRead > 0) {
-            if (totalBytesRead + bytesRead < sizeof(fullBuffer) - 1) {
-                memcpy(fullBuffer + totalBytesRead, buffer, bytesRead);
-                totalBytesRead += bytesRead;
-            } else {
-                break;
-            }
-        }
-        fullBuffer[totalBytesRead] = '\0';
-        CloseHandle(hLogFile);
-        
-        // İstatistikleri hesapla
-        int totalLogs = 0, infoCount = 0, warningCount = 0, errorCount = 0, debugCount = 0;
-        char firstTimestamp[20] = "Bilinmiyor";
-        char lastTimestamp[20] = "Bilinmiyor";
-        
-        char* line = strtok(fullBuffer, "\n");
-        int lineCount = 0;
-        
-        while (line != NULL) {
-            if (strlen(line) > 0) {
-                totalLogs++;
-                
-                // İlk ve son zaman damgası
-                if (strlen(line) >= 19) {
-                    if (lineCount == 0) {
-                        strncpy(firstTimestamp, line, 19);
-                        firstTimestamp[19] = '\0';
-                    }
-                    strncpy(lastTimestamp, line, 19);
-                    lastTimestamp[19] = '\0';
-                }
-                
-                // Log seviyelerini say
-                if (strstr(line, "[INFO]")) infoCount++;
-                else if (strstr(line, "[WARNING]")) warningCount++;
-                else if (strstr(line, "[ERROR]")) errorCount++;
-                else if (strstr(line, "[DEBUG]")) debugCount++;
-                
-                lineCount++;
-            }
-            line = strtok(NULL, "\n");
-        }
+    if (load_log_statistics(&stats)) {
+        long long totalLogs = (long long)stats.counts.lines;
+        long long infoCount = (long long)stats.counts.levels[LOG_INFO];
+        long long warningCount = (long long)stats.counts.levels[LOG_WARNING];
+        long long errorCount = (long long)stats.counts.levels[LOG_ERROR];
+        long long debugCount = (long long)stats.counts.levels[LOG_DEBUG];
+        const char *firstTimestamp = stats.first_time[0] ? stats.first_time : "Bilinmiyor";
+        const char *lastTimestamp = stats.last_time[0] ? stats.last_time : "Bilinmiyor";
         
         // HTML raporu oluştur
         HANDLE hReportFile = CreateFile(reportPath, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
@@ -824,23 +594,23 @@ void generate_auto_report() {
                 "\n"
                 "        <div class=\"stats-grid\">\n"
                 "            <div class=\"stat-card\">\n"
-                "                <div class=\"stat-number\">%d</div>\n"
+                "                <div class=\"stat-number\">%lld</div>\n"
                 "                <div class=\"stat-label\">Toplam Log</div>\n"
                 "            </div>\n"
                 "            <div class=\"stat-card info\">\n"
-                "                <div class=\"stat-number\">%d</div>\n"
+                "                <div class=\"stat-number\">%lld</div>\n"
                 "                <div class=\"stat-label\">INFO</div>\n"
                 "            </div>\n"
                 "            <div class=\"stat-card warning\">\n"
-                "                <div class=\"stat-number\">%d</div>\n"
+                "                <div class=\"stat-number\">%lld</div>\n"
                 "                <div class=\"stat-label\">WARNING</div>\n"
                 "            </div>\n"
                 "            <div class=\"stat-card error\">\n"
-                "                <div class=\"stat-number\">%d</div>\n"
+                "                <div class=\"stat-number\">%lld</div>\n"
                 "                <div class=\"stat-label\">ERROR</div>\n"
                 "            </div>\n"
                 "            <div class=\"stat-card debug\">\n"
-                "                <div class=\"stat-number\">%d</div>\n"
+                "                <div class=\"stat-number\">%lld</div>\n"
                 "                <div class=\"stat-label\">DEBUG</div>\n"
                 "            </div>\n"
                 "        </div>\n"
@@ -849,10 +619,10 @@ void generate_auto_report() {
                 "            <h2>📊 Genel Bilgiler</h2>\n"
                 "            <table class=\"info-table\">\n"
                 "                <tr><th>Özellik</th><th>Değer</th></tr>\n"
-                "                <tr><td>Log Dosyası</td><td>%s</td></tr>\n"
+                "                <tr><td>Log Dosyaları</td><td>%d dosya (%.2f MB)</td></tr>\n"
                 "                <tr><td>İlk Kayıt</td><td>%s</td></tr>\n"
                 "                <tr><td>Son Kayıt</td><td>%s</td></tr>\n"
-                "                <tr><td>Toplam Kayıt</td><td>%d satır</td></tr>\n"
+                "                <tr><td>Toplam Kayıt</td><td>%lld satır</td></tr>\n"
                 "                <tr><td>Hata Oranı</td><td>%.1f%%</td></tr>\n"
                 "                <tr><td>Uyarı Oranı</td><td>%.1f%%</td></tr>\n"
                 "            </table>\n"
@@ -862,7 +632,7 @@ void generate_auto_report() {
                 "            <h2>🎯 Öneriler</h2>\n"
                 "            <ul>\n",
                 dateStr, dateStr, totalLogs, infoCount, warningCount, errorCount, debugCount,
-                logPath, firstTimestamp, lastTimestamp, totalLogs,
+                stats.files, stats.bytes / (1024.0 * 1024.0), firstTimestamp, lastTimestamp, totalLogs,
                 totalLogs > 0 ? (errorCount * 100.0 / totalLogs) : 0,
                 totalLogs > 0 ? (warningCount * 100.0 / totalLogs) : 0);
             
@@ -878,7 +648,16 @@ void generate_auto_report() {
                 "                <li>%s</li>\n"
                 "            </ul>\n"
                 "        </div>\n"
-                "\n"
+                "\n",
+                errorCount > 10 ? "❌ Yüksek hata sayısı tespit edildi - sistem kontrolü önerilir" : "✅ Hata sayısı normal seviyede",
+                warningCount > 20 ? "⚠️ Çok sayıda uyarı mevcut - log temizliği yapılabilir" : "✅ Uyarı sayısı kabul edilebilir seviyede",
+                totalLogs > 1000 ? "📁 Log dosyası büyük - arşivleme düşünülebilir" : "✅ Log dosyası boyutu uygun",
+                totalLogs == 0 ? "ℹ️ Log kaydı bulunamadı - sistem çalışıyor mu kontrol edin" : "✅ Sistem aktif olarak log kaydı yapıyor");
+            
+            WriteFile(hReportFile, recommendations, strlen(recommendations), &bytesWritten, NULL);
+            write_report_messages(hReportFile, &stats);
+            
+            snprintf(recommendations, sizeof(recommendations),
                 "        <div class=\"footer\">\n"
                 "            <p>Bu rapor Automation Center tarafından otomatik olarak oluşturulmuştur.</p>\n"
                 "            <p>Son güncelleme: %s</p>\n"
@@ -886,10 +665,6 @@ void generate_auto_report() {
                 "    </div>\n"
                 "</body>\n"
                 "</html>\n",
-                errorCount > 10 ? "❌ Yüksek hata sayısı tespit edildi - sistem kontrolü önerilir" : "✅ Hata sayısı normal seviyede",
-                warningCount > 20 ? "⚠️ Çok sayıda uyarı mevcut - log temizliği yapılabilir" : "✅ Uyarı sayısı kabul edilebilir seviyede",
-                totalLogs > 1000 ? "📁 Log dosyası büyük - arşivleme düşünülebilir" : "✅ Log dosyası boyutu uygun",
-                totalLogs == 0 ? "ℹ️ Log kaydı bulunamadı - sistem çalışıyor mu kontrol edin" : "✅ Sistem aktif olarak log kaydı yapıyor",
                 dateStr);
             
             WriteFile(hReportFile, recommendations, strlen(recommendations), &bytesWritten, NULL);
@@ -898,8 +673,8 @@ void generate_auto_report() {
             printf("✅ HTML raporu başarıyla oluşturuldu!\n");
             printf("📁 Rapor konumu: %s\n", reportPath);
             printf("📊 Rapor içeriği:\n");
-            printf("   • Toplam %d log kaydı analiz edildi\n", totalLogs);
-            printf("   • %d INFO, %d WARNING, %d ERROR, %d DEBUG\n", infoCount, warningCount, errorCount, debugCount);
+            printf("   • Toplam %lld log kaydı analiz edildi\n", totalLogs);
+            printf("   • %lld INFO, %lld WARNING, %lld ERROR, %lld DEBUG\n", infoCount, warningCount, errorCount, debugCount);
             printf("   • İlk kayıt: %s\n", firstTimestamp);
             printf("   • Son kayıt: %s\n", lastTimestamp);
             
@@ -945,6 +720,117 @@ void generate_auto_report() {
     log_info("Otomatik rapor oluşturma işlemi tamamlandı");
 }
 
+// Yapılandırılmış (binary) log dosyasını metne çevirerek gösterir
+void view_binary_log() {
+    printf("\nBinary Log Görüntüleme\n");
+    printf("======================\n");
+    
+    char logPath[256];
+    char input[16];
+    printf("📁 Binary log dosyası (boş bırakırsanız varsayılan: logs/automation.logb): ");
+    fgets(logPath, sizeof(logPath), stdin);
+    logPath[strcspn(logPath, "\n")] = 0;
+    
+    if (strlen(logPath) == 0) {
+        strcpy(logPath, "logs/automation.logb");
+    }
+    
+    printf("Görünüm (1: metin, 2: logcat): ");
+    fgets(input, sizeof(input), stdin);
+    LogRenderStyle style = atoi(input) == 2 ? LOG_RENDER_LOGCAT : LOG_RENDER_TEXT;
+    
+    printf("En düşük seviye (0: DEBUG, 1: INFO, 2: WARNING, 3: ERROR): ");
+    fgets(input, sizeof(input), stdin);
+    int level = atoi(input);
+    if (level < LOG_DEBUG || level > LOG_ERROR) {
+        level = LOG_DEBUG;
+    }
+    
+    printf("\n");
+    long lines = render_binary_log(logPath, stdout, style, (LogLevel)level);
+    if (lines < 0) {
+        printf("❌ Binary log okunamadı: %s\n", logPath);
+        return;
+    }
+    
+    printf("\n📊 %ld kayıt gösterildi\n", lines);
+}
+
+// Canlı log takibinin durumunu ve son alarmları gösterir, takibi açıp kapatır
+void show_log_follow() {
+    static const char *level_names[LOG_KERNEL_LEVELS] = { "DEBUG", "INFO", "WARNING", "ERROR" };
+    LogFollowStatus status;
+    char input[16];
+    
+    printf("\nCanlı Log Takibi\n");
+    printf("================\n");
+    
+    get_log_follow_status(&status);
+    if (!status.running) {
+        printf("⏸️  Takip çalışmıyor\n");
+        printf("\nLogger dosyası için takip başlatılsın mı? (e/h): ");
+        fgets(input, sizeof(input), stdin);
+        if (input[0] != 'e' && input[0] != 'E') {
+            return;
+        }
+        
+        LogFollowOptions options;
+        init_log_follow_options(&options);
+        options.thresholds[LOG_ERROR] = 30;
+        if (!start_log_follow(&options)) {
+            printf("❌ Takip başlatılamadı\n");
+            return;
+        }
+        printf("✅ Takip başlatıldı (dakikada 30 üzeri ERROR satırında alarm)\n");
+        return;
+    }
+    
+    char started[32];
+    strftime(started, sizeof(started), "%Y-%m-%d %H:%M:%S", localtime(&status.started));
+    printf("▶️  Takip çalışıyor (%s), başlangıç: %s\n",
+           status.inotify ? "inotify" : "yoklama", started);
+    printf("📊 Toplam satır: %llu, alarm: %llu\n",
+           (unsigned long long)status.counts.lines, (unsigned long long)status.alert_count);
+    
+    printf("\n%-10s %12s %12s %10s\n", "Seviye", "Toplam", "Son dakika", "Eşik");
+    for (int i = 0; i < LOG_KERNEL_LEVELS; i++) {
+        char threshold[16] = "-";
+        if (status.thresholds[i] > 0) {
+            snprintf(threshold, sizeof(threshold), "%d", status.thresholds[i]);
+        }
+        printf("%-10s %12llu %12llu %10s\n", level_names[i],
+               (unsigned long long)status.counts.levels[i],
+               (unsigned long long)status.last_minute[i], threshold);
+    }
+    
+    printf("\n📁 İzlenen dosyalar:\n");
+    for (int i = 0; i < status.file_count; i++) {
+        if (status.files[i].binary) {
+            printf("  ⛔ %s - binary log, takip edilmiyor\n", status.files[i].path);
+            continue;
+        }
+        printf("  %s %s - %llu satır, %d döndürme\n", status.files[i].open ? "🟢" : "⚪",
+               status.files[i].path, (unsigned long long)status.files[i].counts.lines,
+               status.files[i].rotations);
+    }
+    
+    if (status.recent_alert_count > 0) {
+        printf("\n🚨 Son alarmlar:\n");
+        for (int i = status.recent_alert_count - 1; i >= 0; i--) {
+            char when[32];
+            strftime(when, sizeof(when), "%Y-%m-%d %H:%M:%S", localtime(&status.recent_alerts[i].timestamp));
+            printf("  [%s] %s\n", when, status.recent_alerts[i].message);
+        }
+    }
+    
+    printf("\nTakip durdurulsun mu? (e/h): ");
+    fgets(input, sizeof(input), stdin);
+    if (input[0] == 'e' || input[0] == 'E') {
+        stop_log_follow();
+        printf("⏹️  Takip durduruldu\n");
+    }
+}
+
 void run_log_analyzer() {
     int choice;
     char input[10];
@@ -974,10 +860,16 @@ void run_log_analyzer() {
                 case 6:
                     generate_auto_report();
                     break;
+                case 7:
+                    view_binary_log();
+                    break;
+                case 8:
+                    show_log_follow();
+                    break;
                 case 0:
                     return;
                 default:
-                    printf("\n❌ Geçersiz seçim! Lütfen 0-6 arası bir sayı girin.\n");
+                    printf("\n❌ Geçersiz seçim! Lütfen 0-8 arası bir sayı girin.\n");
                     break;
             }
             
@@ -438,6 +438,7 @@ void port_scan() {
         
         if (test_port(target, port, 1000) == 0) {
             printf("✅ Port %d: AÇIK\n", port);
+            LOG_RATE_LIMITED(LOG_INFO, 10, "Açık port: %s:%d", target, port);
             open_ports++;
         }
         
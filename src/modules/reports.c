@@ -2,11 +2,13 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <stdarg.h>
 #include <windows.h>
 #include <lmcons.h>
 #include <direct.h>
 #include "../../include/core.h"
 #include "../../include/logger.h"
+#include "../../include/log_checkpoint.h"
 
 #define MAX_REPORT_SIZE 50000
 #define REPORTS_DIR "reports"
@@ -1062,35 +1064,58 @@ void get_process_info_for_report(char* buffer, int bufferSize) {
     strcat(buffer, "</div>\n");
 }
 
+// Log içeriği HTML olarak yorumlanmamalı
+static void append_html_escaped(char* buffer, int bufferSize, const char* text) {
+    int used = (int)strlen(buffer);
+    for (; *text && used + 7 < bufferSize; text++) {
+        switch (*text) {
+            case '<': used += sprintf(buffer + used, "&lt;"); break;
+            case '>': used += sprintf(buffer + used, "&gt;"); break;
+            case '&': used += sprintf(buffer + used, "&amp;"); break;
+            case '"': used += sprintf(buffer + used, "&quot;"); break;
+            default:  buffer[used++] = *text; buffer[used] = '\0'; break;
+        }
+    }
+}
+
+static void append_report_text(char* buffer, int bufferSize, const char* format, ...) {
+    int used = (int)strlen(buffer);
+    if (used >= bufferSize - 1) {
+        return;
+    }
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buffer + used, bufferSize - used, format, args);
+    va_end(args);
+}
+
+// Log analizi menüsüyle aynı istatistikler: aktif log ve döndürülmüş segmentler
 void get_log_analysis_for_report(char* buffer, int bufferSize) {
+    // Kapanış etiketleri için yer ayrılır
+    int contentSize = bufferSize - 16;
     strcpy(buffer, "<div class='info-box'>\n");
     
-    // Check if log files exist and analyze them
-    FILE* logFile = fopen("logs/automation_center.log", "r");
-    if (logFile) {
-        int infoCount = 0, warningCount = 0, errorCount = 0;
-        char line[1024];
-        
-        while (fgets(line, sizeof(line), logFile)) {
-            if (strstr(line, "[INFO]")) infoCount++;
-            else if (strstr(line, "[WARNING]")) warningCount++;
-            else if (strstr(line, "[ERROR]")) errorCount++;
+    LogStatistics stats;
+    if (update_log_set_statistics(0, time(NULL), &stats)) {
+        append_report_text(buffer, contentSize, "<p><strong>Log Analizi:</strong> %d dosya, %.2f MB, %lld satır</p>\n",
+                           stats.files, stats.bytes / (1024.0 * 1024.0), (long long)stats.counts.lines);
+        if (stats.first_time[0]) {
+            append_report_text(buffer, contentSize, "<p>Tarih aralığı: %s - %s</p>\n", stats.first_time, stats.last_time);
         }
+        append_report_text(buffer, contentSize, "<p>INFO mesajları: %lld</p>\n", (long long)stats.counts.levels[LOG_INFO]);
+        append_report_text(buffer, contentSize, "<p>WARNING mesajları: %lld</p>\n", (long long)stats.counts.levels[LOG_WARNING]);
+        append_report_text(buffer, contentSize, "<p>ERROR mesajları: %lld</p>\n", (long long)stats.counts.levels[LOG_ERROR]);
+        append_report_text(buffer, contentSize, "<p>DEBUG mesajları: %lld</p>\n", (long long)stats.counts.levels[LOG_DEBUG]);
         
-        fclose(logFile);
-        
-        char temp[500];
-        sprintf(temp, "<p><strong>Log Analizi:</strong></p>\n");
-        strcat(buffer, temp);
-        
-        sprintf(temp, "<p>INFO mesajları: %d</p>\n", infoCount);
-        strcat(buffer, temp);
-        
-        sprintf(temp, "<p>WARNING mesajları: %d</p>\n", warningCount);
-        strcat(buffer, temp);
-        
-        sprintf(temp, "<p>ERROR mesajları: %d</p>\n", errorCount);
-        strcat(buffer, temp);
+        if (stats.top_message_count > 0) {
+            append_report_text(buffer, contentSize, "<p><strong>En sık mesajlar:</strong></p>\n<ol>\n");
+            for (int i = 0; i < stats.top_message_count && i < 5; i++) {
+                append_report_text(buffer, contentSize, "<li>");
+                append_html_escaped(buffer, contentSize - 32, stats.top_messages[i].text);
+                append_report_text(buffer, contentSize, " (%lld)</li>\n", (long long)stats.top_messages[i].count);
+            }
+            append_report_text(buffer, contentSize, "</ol>\n");
+        }
     } else {
         strcat(buffer, "<p>Log dosyası bulunamadı.</p>\n");
     }
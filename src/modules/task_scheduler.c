@@ -3,6 +3,10 @@
  * Bu modül sistem görevlerinin zamanlanması ve otomatik çalıştırılması işlemlerini gerçekleştirir.
  */
 
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L     // popen, pclose
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -20,6 +24,7 @@
 #include "../../include/logger.h"
 #include "../../include/modules.h"
 #include "../../include/database.h"
+#include "../../include/platform.h"
 
 // Module initialization
 bool init_task_scheduler() {
@@ -73,6 +78,7 @@ typedef struct {
     time_t last_run;
     time_t next_run;
     int run_count;
+    int db_id;              // scheduled_tasks.id, kaydedilene kadar 0
 } scheduled_task_t;
 
 // Görev listesi
@@ -95,6 +101,9 @@ const char* get_priority_string(task_priority_t priority);
 const char* get_repeat_string(repeat_type_t repeat);
 void initialize_sample_tasks();
 void format_time_string(time_t time, char* buffer, size_t size);
+static int execute_task_command(const char* command, long long* output_bytes);
+static bool save_task_definition(scheduled_task_t* task);
+static bool record_task_execution(scheduled_task_t* task, long long start_ms, int exit_code, long long output_bytes);
 
 void run_task_scheduler() {
     int choice;
@@ -316,24 +325,8 @@ void create_new_task() {
     printf("⏰ Zamanlama: %s (%s)\n", new_task.schedule_time, get_repeat_string(new_task.repeat));
     printf("🎯 Öncelik: %s\n", get_priority_string(new_task.priority));
     
-    // Database'e görev oluşturma kaydını ekle
-    ScheduledTask task_record;
-    strncpy(task_record.task_name, new_task.name, sizeof(task_record.task_name) - 1);
-    task_record.task_name[sizeof(task_record.task_name) - 1] = '\0';
-    
-    strncpy(task_record.command, new_task.command, sizeof(task_record.command) - 1);
-    task_record.command[sizeof(task_record.command) - 1] = '\0';
-    
-    strncpy(task_record.schedule, new_task.schedule_time, sizeof(task_record.schedule) - 1);
-    task_record.schedule[sizeof(task_record.schedule) - 1] = '\0';
-    
-    task_record.next_run = new_task.next_run;
-    task_record.last_run = new_task.last_run;
-    task_record.enabled = new_task.enabled;
-    strncpy(task_record.status, "CREATED", sizeof(task_record.status) - 1);
-    task_record.status[sizeof(task_record.status) - 1] = '\0';
-    
-    if (insert_scheduled_task(&task_record)) {
+    // Database'e görev tanımını kaydet
+    if (save_task_definition(&tasks[task_count - 1])) {
         printf("📊 Görev database'e kaydedildi.\n");
     } else {
         printf("⚠️  Görev database'e kaydedilemedi.\n");
@@ -525,6 +518,11 @@ void edit_task() {
                     return;
             }
             
+            // Database'deki tanımı güncelle
+            if (!save_task_definition(task)) {
+                printf("⚠️  Değişiklik database'e kaydedilemedi.\n");
+            }
+            
             log_info("Görev düzenlendi: %s (ID: %d)", task->name, task->id);
         }
     }
@@ -567,6 +565,11 @@ void delete_task() {
         printf("\n❓ Bu görevi silmek istediğinizden emin misiniz? (E/H): ");
         if (fgets(input, sizeof(input), stdin) != NULL) {
             if (input[0] == 'E' || input[0] == 'e') {
+                // Tanımı ve çalıştırma geçmişini database'den sil
+                if (tasks[task_index].db_id > 0 && !delete_scheduled_task(tasks[task_index].db_id)) {
+                    printf("⚠️  Görev database'den silinemedi.\n");
+                }
+                
                 // Görevi sil (array'den çıkar)
                 for (int i = task_index; i < task_count - 1; i++) {
                     tasks[i] = tasks[i + 1];
@@ -640,58 +643,9 @@ void run_task_now() {
         printf("\n\n");
         
         // Gerçek komut çalıştırma
-        int exit_code = -1;
-        
-        #ifdef _WIN32
-        // Windows için CreateProcess kullanarak komut çalıştır
-        STARTUPINFO si;
-        PROCESS_INFORMATION pi;
-        
-        ZeroMemory(&si, sizeof(si));
-        si.cb = sizeof(si);
-        ZeroMemory(&pi, sizeof(pi));
-        
-        // Komut satırını hazırla (cmd.exe /c "komut")
-        char command_line[1024];
-        snprintf(command_line, sizeof(command_line), "cmd.exe /c \"%s\"", task->command);
-        
-        // Process oluştur
-        if (CreateProcess(NULL, command_line, NULL, NULL, FALSE, 
-                         CREATE_NO_WINDOW, NULL, NULL, &si, &pi)) {
-            
-            // Process'in bitmesini bekle (maksimum 30 saniye)
-            DWORD wait_result = WaitForSingleObject(pi.hProcess, 30000);
-            
-            if (wait_result == WAIT_OBJECT_0) {
-                // Process normal şekilde bitti
-                DWORD process_exit_code;
-                if (GetExitCodeProcess(pi.hProcess, &process_exit_code)) {
-                    exit_code = (int)process_exit_code;
-                }
-            } else if (wait_result == WAIT_TIMEOUT) {
-                // Timeout - process'i sonlandır
-                TerminateProcess(pi.hProcess, 1);
-                exit_code = -2; // Timeout kodu
-                printf("⚠️  Görev zaman aşımına uğradı (30 saniye)\n");
-            }
-            
-            // Handle'ları kapat
-            CloseHandle(pi.hProcess);
-            CloseHandle(pi.hThread);
-        } else {
-            printf("❌ Komut çalıştırılamadı: %lu\n", GetLastError());
-            exit_code = -1;
-        }
-        
-        #else
-        // Linux için system() kullan
-        exit_code = system(task->command);
-        if (exit_code == -1) {
-            printf("❌ Komut çalıştırılamadı\n");
-        } else {
-            exit_code = WEXITSTATUS(exit_code);
-        }
-        #endif
+        long long start_ms = monotonic_ms();
+        long long output_bytes = 0;
+        int exit_code = execute_task_command(task->command, &output_bytes);
         
         // Sonucu değerlendir
         if (exit_code == 0) {
@@ -718,23 +672,7 @@ void run_task_now() {
             }
             
             // Database'e başarılı görev çalıştırma kaydını ekle
-            ScheduledTask task_record;
-            strncpy(task_record.task_name, task->name, sizeof(task_record.task_name) - 1);
-            task_record.task_name[sizeof(task_record.task_name) - 1] = '\0';
-            
-            strncpy(task_record.command, task->command, sizeof(task_record.command) - 1);
-            task_record.command[sizeof(task_record.command) - 1] = '\0';
-            
-            strncpy(task_record.schedule, "EXECUTED", sizeof(task_record.schedule) - 1);
-            task_record.schedule[sizeof(task_record.schedule) - 1] = '\0';
-            
-            task_record.next_run = task->next_run;
-            task_record.last_run = task->last_run;
-            task_record.enabled = task->enabled;
-            strncpy(task_record.status, "COMPLETED", sizeof(task_record.status) - 1);
-            task_record.status[sizeof(task_record.status) - 1] = '\0';
-            
-            if (insert_scheduled_task(&task_record)) {
+            if (record_task_execution(task, start_ms, exit_code, output_bytes)) {
                 printf("📊 Görev çalıştırma kaydı database'e eklendi.\n");
             } else {
                 printf("⚠️  Görev çalıştırma kaydı database'e eklenemedi.\n");
@@ -755,23 +693,7 @@ void run_task_now() {
             }
             
             // Database'e başarısız görev çalıştırma kaydını ekle
-            ScheduledTask task_record;
-            strncpy(task_record.task_name, task->name, sizeof(task_record.task_name) - 1);
-            task_record.task_name[sizeof(task_record.task_name) - 1] = '\0';
-            
-            strncpy(task_record.command, task->command, sizeof(task_record.command) - 1);
-            task_record.command[sizeof(task_record.command) - 1] = '\0';
-            
-            strncpy(task_record.schedule, "EXECUTED", sizeof(task_record.schedule) - 1);
-            task_record.schedule[sizeof(task_record.schedule) - 1] = '\0';
-            
-            task_record.next_run = task->next_run;
-            task_record.last_run = task->last_run;
-            task_record.enabled = task->enabled;
-            strncpy(task_record.status, "FAILED", sizeof(task_record.status) - 1);
-            task_record.status[sizeof(task_record.status) - 1] = '\0';
-            
-            if (insert_scheduled_task(&task_record)) {
+            if (record_task_execution(task, start_ms, exit_code, output_bytes)) {
                 printf("📊 Görev hata kaydı database'e eklendi.\n");
             } else {
                 printf("⚠️  Görev hata kaydı database'e eklenemedi.\n");
@@ -795,24 +717,23 @@ void view_task_history() {
     printf("\n📊 Görev Çalıştırma İstatistikleri:\n");
     printf("─────────────────────────────────────────────────────────────\n");
     
-    int total_runs = 0;
-    int successful_runs = 0;
-    int failed_runs = 0;
-    
-    for (int i = 0; i < task_count; i++) {
-        total_runs += tasks[i].run_count;
-        if (tasks[i].status == TASK_COMPLETED) {
-            successful_runs += tasks[i].run_count;
-        } else if (tasks[i].status == TASK_FAILED) {
-            failed_runs++;
-        }
+    // Sayılar task_runs tablosundan gelir (görev başına indeksli sorgu)
+    TaskRunStats totals;
+    if (!get_task_run_stats(0, &totals)) {
+        printf("⚠️  Çalıştırma geçmişi database'den okunamadı.\n");
+        return;
     }
     
-    printf("• Toplam çalıştırma: %d\n", total_runs);
-    printf("• Başarılı: %d (%%%d)\n", successful_runs, 
-           total_runs > 0 ? (successful_runs * 100) / total_runs : 0);
-    printf("• Başarısız: %d (%%%d)\n", failed_runs,
-           total_runs > 0 ? (failed_runs * 100) / total_runs : 0);
+    long long total_runs = totals.run_count;
+    printf("• Toplam çalıştırma: %lld\n", total_runs);
+    printf("• Başarılı: %lld (%%%lld)\n", totals.success_count,
+           total_runs > 0 ? (totals.success_count * 100) / total_runs : 0);
+    printf("• Başarısız: %lld (%%%lld)\n", totals.failure_count,
+           total_runs > 0 ? (totals.failure_count * 100) / total_runs : 0);
+    printf("• Ortalama süre: %.0f ms (en uzun %lld ms)\n", totals.avg_duration_ms, totals.max_duration_ms);
+    
+    TaskRunStats task_stats[50];
+    int order[50];
     
     printf("\n📋 Görev Detayları:\n");
     printf("┌────┬─────────────────────┬─────────────┬─────────────┬─────────────────────┐\n");
@@ -820,17 +741,23 @@ void view_task_history() {
     printf("├────┼─────────────────────┼─────────────┼─────────────┼─────────────────────┤\n");
     
     for (int i = 0; i < task_count; i++) {
+        memset(&task_stats[i], 0, sizeof(task_stats[i]));
+        if (tasks[i].db_id > 0) {
+            get_task_run_stats(tasks[i].db_id, &task_stats[i]);
+        }
+        order[i] = i;
+        
         char last_run_str[32];
-        if (tasks[i].last_run > 0) {
-            format_time_string(tasks[i].last_run, last_run_str, sizeof(last_run_str));
+        if (task_stats[i].last_run > 0) {
+            format_time_string(task_stats[i].last_run, last_run_str, sizeof(last_run_str));
         } else {
             strcpy(last_run_str, "Hiç çalışmadı");
         }
         
-        printf("│ %-2d │ %-19s │ %-11d │ %-11s │ %-19s │\n",
+        printf("│ %-2d │ %-19s │ %-11lld │ %-11s │ %-19s │\n",
                tasks[i].id,
                tasks[i].name,
-               tasks[i].run_count,
+               task_stats[i].run_count,
                get_status_string(tasks[i].status),
                last_run_str);
     }
@@ -838,20 +765,20 @@ void view_task_history() {
     printf("└────┴─────────────────────┴─────────────┴─────────────┴─────────────────────┘\n");
     
     printf("\n📈 En Çok Çalışan Görevler:\n");
-    // Basit sıralama (bubble sort)
+    // Basit sıralama (bubble sort); görev listesinin sırası değişmez
     for (int i = 0; i < task_count - 1; i++) {
         for (int j = 0; j < task_count - i - 1; j++) {
-            if (tasks[j].run_count < tasks[j + 1].run_count) {
-                scheduled_task_t temp = tasks[j];
-                tasks[j] = tasks[j + 1];
-                tasks[j + 1] = temp;
+            if (task_stats[order[j]].run_count < task_stats[order[j + 1]].run_count) {
+                int temp = order[j];
+                order[j] = order[j + 1];
+                order[j + 1] = temp;
             }
         }
     }
     
     int display_count = task_count > 5 ? 5 : task_count;
     for (int i = 0; i < display_count; i++) {
-        printf("%d. %s (%d kez)\n", i + 1, tasks[i].name, tasks[i].run_count);
+        printf("%d. %s (%lld kez)\n", i + 1, tasks[order[i]].name, task_stats[order[i]].run_count);
     }
     
     log_info("Görev geçmişi görüntülendi");
@@ -1171,51 +1098,9 @@ void check_pending_tasks() {
                 tasks[i].last_run = current_time;
                 
                 // Gerçek komut çalıştırma
-                int exit_code = -1;
-                
-                #ifdef _WIN32
-                // Windows için CreateProcess kullanarak komut çalıştır
-                STARTUPINFO si;
-                PROCESS_INFORMATION pi;
-                
-                ZeroMemory(&si, sizeof(si));
-                si.cb = sizeof(si);
-                ZeroMemory(&pi, sizeof(pi));
-                
-                // Komut satırını hazırla
-                char command_line[1024];
-                snprintf(command_line, sizeof(command_line), "cmd.exe /c \"%s\"", tasks[i].command);
-                
-                // Process oluştur
-                if (CreateProcess(NULL, command_line, NULL, NULL, FALSE, 
-                                 CREATE_NO_WINDOW, NULL, NULL, &si, &pi)) {
-                    
-                    // Process'in bitmesini bekle (maksimum 30 saniye)
-                    DWORD wait_result = WaitForSingleObject(pi.hProcess, 30000);
-                    
-                    if (wait_result == WAIT_OBJECT_0) {
-                        DWORD process_exit_code;
-                        if (GetExitCodeProcess(pi.hProcess, &process_exit_code)) {
-                            exit_code = (int)process_exit_code;
-                        }
-                    } else if (wait_result == WAIT_TIMEOUT) {
-                        TerminateProcess(pi.hProcess, 1);
-                        exit_code = -2;
-                    }
-                    
-                    CloseHandle(pi.hProcess);
-                    CloseHandle(pi.hThread);
-                } else {
-                    exit_code = -1;
-                }
-                
-                #else
-                // Linux için system() kullan
-                exit_code = system(tasks[i].command);
-                if (exit_code != -1) {
-                    exit_code = WEXITSTATUS(exit_code);
-                }
-                #endif
+                long long start_ms = monotonic_ms();
+                long long output_bytes = 0;
+                int exit_code = execute_task_command(tasks[i].command, &output_bytes);
                 
                 // Sonucu değerlendir
                 if (exit_code == 0) {
@@ -1249,6 +1134,10 @@ void check_pending_tasks() {
                     printf("❌ Görev başarısız: %s (exit code: %d)\n", tasks[i].name, exit_code);
                     log_error("Otomatik görev hatası: %s (exit code: %d)", tasks[i].name, exit_code);
                 }
+                
+                if (!record_task_execution(&tasks[i], start_ms, exit_code, output_bytes)) {
+                    log_warning("Görev çalıştırma kaydı database'e eklenemedi: %s", tasks[i].name);
+                }
             }
         }
     }
@@ -1455,4 +1344,128 @@ void format_time_string(time_t time, char* buffer, size_t size) {
     
     struct tm* tm_info = localtime(&time);
     strftime(buffer, size, "%d/%m/%Y %H:%M", tm_info);
-}
\ No newline at end of file
+}
+
+// Komutu çalıştırır ve çıkış kodunu döndürür (-1: çalıştırılamadı, -2: zaman aşımı).
+// Linux'ta çıktı ekrana aktarılırken sayılır; Windows'ta çıktı yakalanmaz.
+// Linux'ta görevin stdout/stderr'i bir pipe'tır, terminal değildir: renkli
+// ya da etkileşimli çıktı bekleyen komutlar farklı davranabilir.
+static int execute_task_command(const char* command, long long* output_bytes) {
+    int exit_code = -1;
+    *output_bytes = 0;
+    
+#ifdef _WIN32
+    // Windows için CreateProcess kullanarak komut çalıştır
+    STARTUPINFO si;
+    PROCESS_INFORMATION pi;
+    
+    ZeroMemory(&si, sizeof(si));
+    si.cb = sizeof(si);
+    ZeroMemory(&pi, sizeof(pi));
+    
+    // Komut satırını hazırla (cmd.exe /c "komut")
+    char command_line[1024];
+    snprintf(command_line, sizeof(command_line), "cmd.exe /c \"%s\"", command);
+    
+    // Process oluştur
+    if (CreateProcess(NULL, command_line, NULL, NULL, FALSE, 
+                     CREATE_NO_WINDOW, NULL, NULL, &si, &pi)) {
+        
+        // Process'in bitmesini bekle (maksimum 30 saniye)
+        DWORD wait_result = WaitForSingleObject(pi.hProcess, 30000);
+        
+        if (wait_result == WAIT_OBJECT_0) {
+            DWORD process_exit_code;
+            if (GetExitCodeProcess(pi.hProcess, &process_exit_code)) {
+                exit_code = (int)process_exit_code;
+            }
+        } else if (wait_result == WAIT_TIMEOUT) {
+            // Timeout - process'i sonlandır
+            TerminateProcess(pi.hProcess, 1);
+            exit_code = -2;
+        }
+        
+        CloseHandle(pi.hProcess);
+        CloseHandle(pi.hThread);
+    } else {
+        log_error("Komut çalıştırılamadı: %lu", GetLastError());
+    }
+#else
+    // Çıktı boyutunu ölçmek için system() yerine popen()
+    char command_line[1024];
+    snprintf(command_line, sizeof(command_line), "(%s) 2>&1", command);
+    
+    FILE* pipe = popen(command_line, "r");
+    if (pipe) {
+        char buffer[4096];
+        size_t bytes;
+        while ((bytes = fread(buffer, 1, sizeof(buffer), pipe)) > 0) {
+            fwrite(buffer, 1, bytes, stdout);
+            *output_bytes += bytes;
+        }
+        
+        int status = pclose(pipe);
+        if (status != -1) {
+            exit_code = WEXITSTATUS(status);
+        }
+    }
+#endif
+    
+    return exit_code;
+}
+
+static const char* get_status_code(task_status_t status) {
+    switch (status) {
+        case TASK_PENDING: return "PENDING";
+        case TASK_RUNNING: return "RUNNING";
+        case TASK_COMPLETED: return "COMPLETED";
+        case TASK_FAILED: return "FAILED";
+        case TASK_DISABLED: return "DISABLED";
+        default: return "UNKNOWN";
+    }
+}
+
+// Görev tanımını database'e yazar: kayıtlı görev id ile güncellenir,
+// yeni görev isimle upsert edilir ve db_id'si saklanır
+static bool save_task_definition(scheduled_task_t* task) {
+    ScheduledTask record = {0};
+    record.id = task->db_id;
+    
+    strncpy(record.task_name, task->name, sizeof(record.task_name) - 1);
+    strncpy(record.command, task->command, sizeof(record.command) - 1);
+    strncpy(record.schedule, task->schedule_time, sizeof(record.schedule) - 1);
+    strncpy(record.status, get_status_code(task->status), sizeof(record.status) - 1);
+    record.next_run = task->next_run;
+    record.last_run = task->last_run;
+    record.enabled = task->enabled;
+    
+    if (task->db_id > 0) {
+        return update_scheduled_task(&record);
+    }
+    
+    if (!upsert_scheduled_task(&record)) {
+        return false;
+    }
+    
+    task->db_id = record.id;
+    return true;
+}
+
+// Tanımı günceller ve çalıştırmayı task_runs'a ekler (toplu yazılır)
+static bool record_task_execution(scheduled_task_t* task, long long start_ms, int exit_code, long long output_bytes) {
+    long long duration_ms = monotonic_ms() - start_ms;
+    
+    if (!save_task_definition(task)) {
+        return false;
+    }
+    
+    TaskRun run = {0};
+    run.task_id = task->db_id;
+    run.start_time = task->last_run;
+    run.end_time = task->last_run + (time_t)(duration_ms / 1000);
+    run.exit_code = exit_code;
+    run.duration_ms = duration_ms;
+    run.output_bytes = output_bytes;
+    
+    return record_task_run(&run);
+}
@@ -0,0 +1,74 @@
+/*
+ * ========================================
+ * Log Template Test - Mesaj Şablonu Regresyon Testleri
+ * ========================================
+ *
+ * Checks make_log_template on ordinary messages and on the cut at the
+ * output size: the result must stay inside the buffer, never end in a
+ * split UTF-8 sequence or a partial placeholder, and its returned length
+ * must match the string.
+ *
+ *   log_template_test
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "../../include/log_template.h"
+
+static int failures = 0;
+
+static void expect_template(const char *message, size_t length, size_t size, const char *expected) {
+    char out[512];
+    memset(out, 'X', sizeof(out));
+
+    size_t written = make_log_template(message, length, out + 1, size);
+    if (written >= size || out[0] != 'X' || strlen(out + 1) != written || strcmp(out + 1, expected) != 0) {
+        printf("FAIL: size %zu: got %zu \"%.*s\", expected \"%s\"\n",
+               size, written, written < size ? (int)written : 0, out + 1, expected);
+        failures++;
+    }
+}
+
+static void test_placeholders(void) {
+    const char *message = "Connection from 10.0.0.1:8080 failed after 30ms: /var/log/app.log";
+    expect_template(message, strlen(message), 256,
+                    "Connection from <ip> failed after <num>ms: <path>");
+
+    message = "user42 upgraded to v1.2.3 (id 3f2a9c1e7b)";
+    expect_template(message, strlen(message), 256, "user42 upgraded to v1.2.3 (id <hex>)");
+}
+
+// A message made only of UTF-8 continuation bytes has no sequence start to
+// cut back to; the cut must stop at the start of the word
+static void test_continuation_bytes(void) {
+    char message[256];
+    memset(message, 0x80, 200);
+
+    expect_template(message, 200, 64, "");
+    expect_template(message, 200, 1, "");
+
+    // The placeholder written before the word stays whole
+    message[0] = '1';
+    expect_template(message, 200, 64, "<num>");
+}
+
+// A multi-byte character that does not fit is dropped, not split
+static void test_utf8_cut(void) {
+    const char *message = "abc\xC3\xBC\xC3\xBC";
+    expect_template(message, strlen(message), 5, "abc");
+    expect_template(message, strlen(message), 6, "abc\xC3\xBC");
+}
+
+int main(void) {
+    test_placeholders();
+    test_continuation_bytes();
+    test_utf8_cut();
+
+    if (failures > 0) {
+        printf("log_template_test: %d failure(s)\n", failures);
+        return 1;
+    }
+    printf("log_template_test: passed\n");
+    return 0;
+}
@@ -265,6 +265,13 @@ int create_default_config(void) {
     set_config_value("logging.file_output", "true");
     set_config_value("logging.max_file_size", "10");
     set_config_value("logging.max_backup_files", "5");
+    set_config_value("logging.format", "text");
+    set_config_value("logging.rate_limit", "0");
+    set_config_value("logging.rate_burst", "0");
+    set_config_value("logging.binary_file", "logs/automation.logb");
+    set_config_value("log_follow.enabled", "true");
+    set_config_value("log_follow.error_per_minute", "30");
+    set_config_value("log_follow.warning_per_minute", "0");
     
     set_config_value("file_management.auto_organize", "false");
     set_config_value("file_management.organize_interval", "60");
@@ -286,6 +293,9 @@ int create_default_config(void) {
     set_config_value("reporting.auto_generate", "true");
     set_config_value("reporting.report_interval", "24");
     set_config_value("reporting.format", "html");
+    set_config_value("database.retention_days", "0");
+    set_config_value("database.archive_retention_days", "365");
+    set_config_value("database.partitioning", "none");
     
     return save_config();
 }
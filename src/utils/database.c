@@ -1,20 +1,45 @@
 #include "../../include/database.h"
+#include "../../include/metrics_archive.h"
+#include "../../include/metric_partitions.h"
+#include "../../include/database_backup.h"
+#include "../../include/string_dictionary.h"
+#include "../../include/db_pool.h"
+#include "../../include/hot_tier.h"
+#include "../../include/log_checkpoint.h"
+#include "../../include/log_follow.h"
 #include "../../include/logger.h"
+#include "../../include/platform.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <limits.h>
 #include <time.h>
+#include <pthread.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <unistd.h>
+#endif
 
 // Global database connection
 sqlite3 *db = NULL;
 
+static bool create_rollup_tables(void);
+static bool update_system_metrics_rollups(const SystemMetrics *metrics);
+static bool update_network_metrics_rollups(const NetworkMetrics *metrics);
+static bool cleanup_old_rollups(void);
+static bool finalize_system_rollups(RollupResolution resolution, time_t now);
+static bool finalize_network_rollups(RollupResolution resolution, time_t now);
+static void finalize_rollup_statements(void);
+
 bool init_database(void) {
     int rc;
     char db_path[512];
     
     // Create database path
-    snprintf(db_path, sizeof(db_path), "data/automation.db");
+    snprintf(db_path, sizeof(db_path), DATABASE_PATH);
     
     // Create data directory if it doesn't exist
     system("mkdir data 2>nul");
@@ -28,6 +53,15 @@ bool init_database(void) {
     
     log_info("Database opened successfully: %s", db_path);
     
+    // WAL lets readers and the retention worker run alongside writers;
+    // auto_vacuum only takes effect on new databases (see vacuum_database)
+    sqlite3_busy_timeout(db, DATABASE_BUSY_TIMEOUT_MS);
+    execute_query("PRAGMA auto_vacuum = INCREMENTAL;");
+    execute_query("PRAGMA journal_mode = WAL;");
+    // In WAL mode NORMAL only syncs at checkpoints; a crash can lose the
+    // last commits but never corrupts the database
+    execute_query("PRAGMA synchronous = NORMAL;");
+    
     // Create tables
     if (!create_tables()) {
         log_error("Failed to create database tables");
@@ -35,17 +69,75 @@ bool init_database(void) {
         return false;
     }
     
+    // Samples inserted from now on are also kept in memory for recent reads
+    init_hot_tier();
+    
+    // From here on writes go through the writer thread, reads through the pool
+    if (!db_pool_init(db_path, DB_READER_POOL_SIZE)) {
+        log_warning("Database pool unavailable, using a single connection");
+    }
+    
     return true;
 }
 
 void close_database(void) {
     if (db) {
+        flush_task_runs();
+        db_pool_shutdown();
+        finalize_rollup_statements();
         sqlite3_close(db);
         db = NULL;
+        clear_string_cache();
         log_info("Database connection closed");
     }
 }
 
+// Rebuilds a table that still stores its low-cardinality columns as text.
+// Distinct values go into interned_strings, then the rows are copied into
+// the new layout; copy_sql reads from the renamed table as legacy_table.
+static bool migrate_legacy_table(const char *table, const char *column, const char *second_column,
+                                 const char *create_sql, const char *copy_sql) {
+    char sql[512];
+    sqlite3_stmt *stmt;
+    
+    snprintf(sql, sizeof(sql), "SELECT %s FROM %s LIMIT 0;", column, table);
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK) {
+        return true; // table missing or already migrated
+    }
+    sqlite3_finalize(stmt);
+    
+    log_info("Migrating %s to the string dictionary", table);
+    
+    if (!execute_query("BEGIN;")) {
+        return false;
+    }
+    
+    const char *columns[] = { column, second_column };
+    bool ok = true;
+    
+    for (int i = 0; i < 2 && ok && columns[i]; i++) {
+        snprintf(sql, sizeof(sql),
+                 "INSERT OR IGNORE INTO interned_strings (value) "
+                 "SELECT DISTINCT %s FROM %s WHERE %s IS NOT NULL;",
+                 columns[i], table, columns[i]);
+        ok = execute_query(sql);
+    }
+    
+    if (ok) {
+        snprintf(sql, sizeof(sql), "ALTER TABLE %s RENAME TO legacy_table;", table);
+        ok = execute_query(sql) && execute_query(create_sql) && execute_query(copy_sql) &&
+             execute_query("DROP TABLE legacy_table;");
+    }
+    
+    if (!ok) {
+        execute_query("ROLLBACK;");
+        log_error("Migration of %s failed", table);
+        return false;
+    }
+    
+    return execute_query("COMMIT;");
+}
+
 bool create_tables(void) {
     const char *create_system_metrics = 
         "CREATE TABLE IF NOT EXISTS system_metrics ("
@@ -54,37 +146,37 @@ bool create_tables(void) {
         "cpu_usage REAL NOT NULL,"
         "memory_usage REAL NOT NULL,"
         "disk_usage REAL NOT NULL,"
-        "hostname TEXT NOT NULL"
+        "hostname_id INTEGER NOT NULL REFERENCES interned_strings(id)"
         ");";
     
     const char *create_file_operations = 
         "CREATE TABLE IF NOT EXISTS file_operations ("
         "id INTEGER PRIMARY KEY AUTOINCREMENT,"
         "timestamp INTEGER NOT NULL,"
-        "operation TEXT NOT NULL,"
+        "operation_id INTEGER NOT NULL REFERENCES interned_strings(id),"
         "file_path TEXT NOT NULL,"
         "file_size INTEGER,"
-        "status TEXT NOT NULL"
+        "status_id INTEGER NOT NULL REFERENCES interned_strings(id)"
         ");";
     
     const char *create_network_metrics = 
         "CREATE TABLE IF NOT EXISTS network_metrics ("
         "id INTEGER PRIMARY KEY AUTOINCREMENT,"
         "timestamp INTEGER NOT NULL,"
-        "target TEXT NOT NULL,"
+        "target_id INTEGER NOT NULL REFERENCES interned_strings(id),"
         "ping_time INTEGER,"
         "connection_status INTEGER NOT NULL,"
-        "interface_name TEXT"
+        "interface_name_id INTEGER REFERENCES interned_strings(id)"
         ");";
     
     const char *create_security_scans = 
         "CREATE TABLE IF NOT EXISTS security_scans ("
         "id INTEGER PRIMARY KEY AUTOINCREMENT,"
         "timestamp INTEGER NOT NULL,"
-        "scan_type TEXT NOT NULL,"
+        "scan_type_id INTEGER NOT NULL REFERENCES interned_strings(id),"
         "target TEXT NOT NULL,"
         "threats_found INTEGER NOT NULL,"
-        "severity TEXT NOT NULL,"
+        "severity_id INTEGER NOT NULL REFERENCES interned_strings(id),"
         "description TEXT"
         ");";
     
@@ -100,31 +192,89 @@ bool create_tables(void) {
         "status TEXT DEFAULT 'pending'"
         ");";
     
+    const char *create_task_runs = 
+        "CREATE TABLE IF NOT EXISTS task_runs ("
+        "id INTEGER PRIMARY KEY,"
+        "task_id INTEGER NOT NULL REFERENCES scheduled_tasks(id),"
+        "start_ts INTEGER NOT NULL,"
+        "end_ts INTEGER NOT NULL,"
+        "exit_code INTEGER NOT NULL,"
+        "duration_ms INTEGER NOT NULL,"
+        "output_bytes INTEGER NOT NULL"
+        ");";
+    
     // Create indexes for better performance
     const char *create_indexes[] = {
-        "CREATE INDEX IF NOT EXISTS idx_system_metrics_timestamp ON system_metrics(timestamp);",
         "CREATE INDEX IF NOT EXISTS idx_file_operations_timestamp ON file_operations(timestamp);",
         "CREATE INDEX IF NOT EXISTS idx_network_metrics_timestamp ON network_metrics(timestamp);",
         "CREATE INDEX IF NOT EXISTS idx_security_scans_timestamp ON security_scans(timestamp);",
-        "CREATE INDEX IF NOT EXISTS idx_scheduled_tasks_next_run ON scheduled_tasks(next_run);"
+        "CREATE INDEX IF NOT EXISTS idx_scheduled_tasks_next_run ON scheduled_tasks(next_run);",
+        "CREATE INDEX IF NOT EXISTS idx_file_operations_operation ON file_operations(operation_id, timestamp);",
+        "CREATE INDEX IF NOT EXISTS idx_network_metrics_target ON network_metrics(target_id, timestamp);",
+        "CREATE INDEX IF NOT EXISTS idx_security_scans_severity ON security_scans(severity_id, timestamp);",
+        // Covers the per-task history and statistics queries
+        "CREATE INDEX IF NOT EXISTS idx_task_runs_stats ON task_runs(task_id, start_ts, exit_code, duration_ms, output_bytes);",
+        "CREATE INDEX IF NOT EXISTS idx_task_runs_start ON task_runs(start_ts);"
     };
     
+    // Partition tables carry their own indexes (see metric_partitions.c)
+    const char *create_system_metrics_indexes[] = {
+        "CREATE INDEX IF NOT EXISTS idx_system_metrics_timestamp ON system_metrics(timestamp);",
+        "CREATE INDEX IF NOT EXISTS idx_system_metrics_hostname ON system_metrics(hostname_id, timestamp);"
+    };
+    
+    if (!create_string_dictionary() || !create_partition_tables()) {
+        return false;
+    }
+    
+    // Databases from before the string dictionary are converted in place
+    if (!migrate_legacy_table("system_metrics", "hostname", NULL, create_system_metrics,
+            "INSERT INTO system_metrics (id, timestamp, cpu_usage, memory_usage, disk_usage, hostname_id) "
+            "SELECT id, timestamp, cpu_usage, memory_usage, disk_usage, "
+            "(SELECT id FROM interned_strings WHERE value = hostname) FROM legacy_table;") ||
+        !migrate_legacy_table("file_operations", "operation", "status", create_file_operations,
+            "INSERT INTO file_operations (id, timestamp, operation_id, file_path, file_size, status_id) "
+            "SELECT id, timestamp, (SELECT id FROM interned_strings WHERE value = operation), "
+            "file_path, file_size, (SELECT id FROM interned_strings WHERE value = status) FROM legacy_table;") ||
+        !migrate_legacy_table("network_metrics", "target", "interface_name", create_network_metrics,
+            "INSERT INTO network_metrics (id, timestamp, target_id, ping_time, connection_status, interface_name_id) "
+            "SELECT id, timestamp, (SELECT id FROM interned_strings WHERE value = target), ping_time, "
+            "connection_status, (SELECT id FROM interned_strings WHERE value = interface_name) FROM legacy_table;") ||
+        !migrate_legacy_table("security_scans", "scan_type", "severity", create_security_scans,
+            "INSERT INTO security_scans (id, timestamp, scan_type_id, target, threats_found, severity_id, description) "
+            "SELECT id, timestamp, (SELECT id FROM interned_strings WHERE value = scan_type), target, threats_found, "
+            "(SELECT id FROM interned_strings WHERE value = severity), description FROM legacy_table;")) {
+        return false;
+    }
+    
     // Execute table creation queries
     if (!execute_query(create_system_metrics) ||
         !execute_query(create_file_operations) ||
         !execute_query(create_network_metrics) ||
         !execute_query(create_security_scans) ||
-        !execute_query(create_scheduled_tasks)) {
+        !execute_query(create_scheduled_tasks) ||
+        !execute_query(create_task_runs)) {
         return false;
     }
     
     // Create indexes
-    for (int i = 0; i < 5; i++) {
+    for (int i = 0; i < (int)(sizeof(create_indexes) / sizeof(create_indexes[0])); i++) {
         if (!execute_query(create_indexes[i])) {
             log_warning("Failed to create index: %s", create_indexes[i]);
         }
     }
     
+    for (int i = 0; i < 2 && !metric_partitioning_enabled(); i++) {
+        if (!execute_query(create_system_metrics_indexes[i])) {
+            log_warning("Failed to create index: %s", create_system_metrics_indexes[i]);
+        }
+    }
+
+    if (!create_rollup_tables() || !create_archive_tables() || !create_log_checkpoint_table() ||
+        !create_log_alert_table()) {
+        return false;
+    }
+
     log_info("Database tables created successfully");
     return true;
 }
@@ -142,10 +292,34 @@ bool execute_query(const char *query) {
     return true;
 }
 
+// An insert and the row id it produced
+typedef struct {
+    const void *row;
+    int row_id;
+} MetricsInsert;
+
 // System metrics operations
-bool insert_system_metrics(const SystemMetrics *metrics) {
-    const char *sql = "INSERT INTO system_metrics (timestamp, cpu_usage, memory_usage, disk_usage, hostname) "
-                      "VALUES (?, ?, ?, ?, ?);";
+static bool insert_system_metrics_job(void *arg) {
+    MetricsInsert *insert = arg;
+    const SystemMetrics *metrics = insert->row;
+    char table[METRIC_PARTITION_NAME_SIZE] = "system_metrics";
+    long long partition_row_id = 0;
+    char sql[256];
+    
+    int hostname_id = intern_string(metrics->hostname);
+    if (hostname_id < 0) {
+        return false;
+    }
+    
+    // Partitioned rows go straight to their day's table with an explicit id
+    if (metric_partitioning_enabled() &&
+        !resolve_insert_partition(metrics->timestamp, table, sizeof(table), &partition_row_id)) {
+        return false;
+    }
+    
+    snprintf(sql, sizeof(sql),
+             "INSERT INTO %s (id, timestamp, cpu_usage, memory_usage, disk_usage, hostname_id) "
+             "VALUES (?, ?, ?, ?, ?, ?);", table);
     
     sqlite3_stmt *stmt;
     int rc = sqlite3_prepare_v2(db, sql, -1, &stmt, NULL);
@@ -155,83 +329,289 @@ bool insert_system_metrics(const SystemMetrics *metrics) {
         return false;
     }
     
-    sqlite3_bind_int64(stmt, 1, metrics->timestamp);
-    sqlite3_bind_double(stmt, 2, metrics->cpu_usage);
-    sqlite3_bind_double(stmt, 3, metrics->memory_usage);
-    sqlite3_bind_double(stmt, 4, metrics->disk_usage);
-    sqlite3_bind_text(stmt, 5, metrics->hostname, -1, SQLITE_STATIC);
+    if (partition_row_id > 0) {
+        sqlite3_bind_int64(stmt, 1, partition_row_id);
+    } else {
+        sqlite3_bind_null(stmt, 1);
+    }
+    sqlite3_bind_int64(stmt, 2, metrics->timestamp);
+    sqlite3_bind_double(stmt, 3, metrics->cpu_usage);
+    sqlite3_bind_double(stmt, 4, metrics->memory_usage);
+    sqlite3_bind_double(stmt, 5, metrics->disk_usage);
+    sqlite3_bind_int(stmt, 6, hostname_id);
+    
+    // Raw row and rollups are written together so they never drift apart
+    execute_query("SAVEPOINT insert_system_metrics;");
     
     rc = sqlite3_step(stmt);
     sqlite3_finalize(stmt);
     
     if (rc != SQLITE_DONE) {
         log_error("Failed to insert system metrics: %s", sqlite3_errmsg(db));
+        execute_query("ROLLBACK TO insert_system_metrics; RELEASE insert_system_metrics;");
+        return false;
+    }
+    
+    // The rollup upserts below change last_insert_rowid
+    int row_id = (int)sqlite3_last_insert_rowid(db);
+    
+    if (!update_system_metrics_rollups(metrics)) {
+        execute_query("ROLLBACK TO insert_system_metrics; RELEASE insert_system_metrics;");
         return false;
     }
     
+    if (!execute_query("RELEASE insert_system_metrics;")) {
+        return false;
+    }
+    
+    insert->row_id = row_id;
     return true;
 }
 
-bool get_system_metrics_history(SystemMetrics **metrics, int *count, int limit) {
-    const char *sql = "SELECT id, timestamp, cpu_usage, memory_usage, disk_usage, hostname "
-                      "FROM system_metrics ORDER BY timestamp DESC LIMIT ?;";
-    
-    sqlite3_stmt *stmt;
-    int rc = sqlite3_prepare_v2(db, sql, -1, &stmt, NULL);
-    
-    if (rc != SQLITE_OK) {
-        log_error("Failed to prepare statement: %s", sqlite3_errmsg(db));
+bool insert_system_metrics(const SystemMetrics *metrics) {
+    MetricsInsert insert = { metrics, 0 };
+    if (!db_write(insert_system_metrics_job, &insert)) {
         return false;
     }
     
-    sqlite3_bind_int(stmt, 1, limit);
+    // Only committed rows enter the hot tier
+    hot_tier_record_system(metrics, insert.row_id);
+    return true;
+}
+
+// Tables to read for [from, to): the overlapping partitions, newest first,
+// or system_metrics itself when partitioning is off
+static int system_metrics_sources(sqlite3 *conn, time_t from, time_t to, MetricPartition **sources) {
+    if (metric_partitioning_enabled()) {
+        return list_metric_partitions(conn, from, to, sources);
+    }
     
-    // Count rows first
-    *count = 0;
+    *sources = malloc(sizeof(MetricPartition));
+    if (!*sources) {
+        log_error("Memory allocation failed");
+        return -1;
+    }
+    snprintf((*sources)[0].name, sizeof((*sources)[0].name), "system_metrics");
+    (*sources)[0].start_ts = from;
+    (*sources)[0].end_ts = to;
+    return 1;
+}
+
+// Steps a system_metrics SELECT and appends its rows to *metrics
+static bool append_system_metrics_rows(sqlite3_stmt *stmt, SystemMetrics **metrics, int *count, int *capacity) {
     while (sqlite3_step(stmt) == SQLITE_ROW) {
+        if (*count == *capacity) {
+            *capacity = *capacity > 0 ? *capacity * 2 : 64;
+            SystemMetrics *grown = realloc(*metrics, sizeof(SystemMetrics) * (*capacity));
+            if (!grown) {
+                log_error("Memory allocation failed");
+                return false;
+            }
+            *metrics = grown;
+        }
+        
+        SystemMetrics *row = &(*metrics)[*count];
+        row->id = sqlite3_column_int(stmt, 0);
+        row->timestamp = sqlite3_column_int64(stmt, 1);
+        row->cpu_usage = sqlite3_column_double(stmt, 2);
+        row->memory_usage = sqlite3_column_double(stmt, 3);
+        row->disk_usage = sqlite3_column_double(stmt, 4);
+        strncpy(row->hostname, (const char*)sqlite3_column_text(stmt, 5), sizeof(row->hostname) - 1);
+        row->hostname[sizeof(row->hostname) - 1] = '\0';
         (*count)++;
     }
     
-    if (*count == 0) {
+    return true;
+}
+
+static bool read_system_metrics_history(sqlite3 *conn, SystemMetrics **metrics, int *count, int limit) {
+    char sql[320];
+    MetricPartition *sources;
+    int capacity = 0;
+    bool ok = true;
+    
+    *metrics = NULL;
+    *count = 0;
+    
+    int source_count = system_metrics_sources(conn, LLONG_MIN, LLONG_MAX, &sources);
+    if (source_count < 0) {
+        return false;
+    }
+    
+    // Partitions cover disjoint spans, so reading newest first stops as soon
+    // as the limit is filled without touching older days
+    for (int i = 0; i < source_count && ok && *count < limit; i++) {
+        snprintf(sql, sizeof(sql),
+                 "SELECT m.id, m.timestamp, m.cpu_usage, m.memory_usage, m.disk_usage, h.value "
+                 "FROM %s m JOIN interned_strings h ON h.id = m.hostname_id "
+                 "ORDER BY m.timestamp DESC LIMIT ?;", sources[i].name);
+        
+        sqlite3_stmt *stmt;
+        if (sqlite3_prepare_v2(conn, sql, -1, &stmt, NULL) != SQLITE_OK) {
+            log_error("Failed to prepare statement: %s", sqlite3_errmsg(conn));
+            ok = false;
+            break;
+        }
+        
+        sqlite3_bind_int(stmt, 1, limit - *count);
+        ok = append_system_metrics_rows(stmt, metrics, count, &capacity);
         sqlite3_finalize(stmt);
+    }
+    
+    free(sources);
+    
+    if (!ok) {
+        free(*metrics);
+        *metrics = NULL;
+        *count = 0;
+        return false;
+    }
+    
+    // Older history may have been moved to the compressed archive
+    if (*count < limit) {
+        time_t before = *count > 0 ? (*metrics)[*count - 1].timestamp : time(NULL) + 1;
+        get_latest_archived_system_metrics(before, limit - *count, metrics, count);
+    }
+    
+    if (*count == 0) {
+        free(*metrics);
         *metrics = NULL;
+    }
+    
+    return true;
+}
+
+bool get_system_metrics_history(SystemMetrics **metrics, int *count, int limit) {
+    if (hot_tier_latest_system(limit, metrics, count)) {
         return true;
     }
     
-    // Reset statement
-    sqlite3_reset(stmt);
+    sqlite3 *conn = db_acquire_reader();
+    bool ok = read_system_metrics_history(conn, metrics, count, limit);
+    db_release_reader(conn);
+    return ok;
+}
+
+static int compare_metrics_timestamp(const void *a, const void *b) {
+    time_t ta = ((const SystemMetrics*)a)->timestamp;
+    time_t tb = ((const SystemMetrics*)b)->timestamp;
+    return (ta > tb) - (ta < tb);
+}
+
+// All samples with from <= timestamp < to, raw and archived, oldest first
+static bool read_system_metrics_range(sqlite3 *conn, SystemMetrics **metrics, int *count, time_t from, time_t to) {
+    char sql[320];
+    MetricPartition *sources;
     
-    // Allocate memory
-    *metrics = malloc(sizeof(SystemMetrics) * (*count));
-    if (!*metrics) {
-        log_error("Memory allocation failed");
+    *metrics = NULL;
+    *count = 0;
+    
+    if (!get_archived_system_metrics(from, to, metrics, count)) {
+        free(*metrics);
+        *metrics = NULL;
+        *count = 0;
+        return false;
+    }
+    int archived = *count;
+    int capacity = *count;
+    
+    // Only partitions overlapping the window are opened
+    int source_count = system_metrics_sources(conn, from, to, &sources);
+    bool ok = source_count >= 0;
+    
+    for (int i = source_count - 1; i >= 0 && ok; i--) {
+        snprintf(sql, sizeof(sql),
+                 "SELECT m.id, m.timestamp, m.cpu_usage, m.memory_usage, m.disk_usage, h.value "
+                 "FROM %s m JOIN interned_strings h ON h.id = m.hostname_id "
+                 "WHERE m.timestamp >= ? AND m.timestamp < ? ORDER BY m.timestamp;", sources[i].name);
+        
+        sqlite3_stmt *stmt;
+        if (sqlite3_prepare_v2(conn, sql, -1, &stmt, NULL) != SQLITE_OK) {
+            log_error("Failed to prepare statement: %s", sqlite3_errmsg(conn));
+            ok = false;
+            break;
+        }
+        
+        sqlite3_bind_int64(stmt, 1, from);
+        sqlite3_bind_int64(stmt, 2, to);
+        ok = append_system_metrics_rows(stmt, metrics, count, &capacity);
         sqlite3_finalize(stmt);
+    }
+    
+    if (source_count >= 0) {
+        free(sources);
+    }
+    
+    if (!ok) {
+        free(*metrics);
+        *metrics = NULL;
+        *count = 0;
         return false;
     }
     
-    // Fetch data
-    int i = 0;
-    while (sqlite3_step(stmt) == SQLITE_ROW && i < *count) {
-        (*metrics)[i].id = sqlite3_column_int(stmt, 0);
-        (*metrics)[i].timestamp = sqlite3_column_int64(stmt, 1);
-        (*metrics)[i].cpu_usage = sqlite3_column_double(stmt, 2);
-        (*metrics)[i].memory_usage = sqlite3_column_double(stmt, 3);
-        (*metrics)[i].disk_usage = sqlite3_column_double(stmt, 4);
-        strncpy((*metrics)[i].hostname, (const char*)sqlite3_column_text(stmt, 5), 
-                sizeof((*metrics)[i].hostname) - 1);
-        (*metrics)[i].hostname[sizeof((*metrics)[i].hostname) - 1] = '\0';
-        i++;
+    // Archive blocks are per host; merge them with the raw rows by time
+    if (archived > 0) {
+        qsort(*metrics, *count, sizeof(SystemMetrics), compare_metrics_timestamp);
+    }
+    
+    if (*count == 0) {
+        free(*metrics);
+        *metrics = NULL;
     }
     
-    sqlite3_finalize(stmt);
     return true;
 }
 
+bool get_system_metrics_range(SystemMetrics **metrics, int *count, time_t from, time_t to) {
+    // "Last few minutes" queries never reach SQLite
+    if (hot_tier_system_range(from, to, metrics, count)) {
+        return true;
+    }
+    
+    sqlite3 *conn = db_acquire_reader();
+    bool ok = read_system_metrics_range(conn, metrics, count, from, to);
+    db_release_reader(conn);
+    return ok;
+}
+
+// Samples of one local calendar day, date formatted as YYYY-MM-DD
+bool get_system_metrics_by_date(SystemMetrics **metrics, int *count, const char *date) {
+    struct tm day = {0};
+    
+    if (sscanf(date, "%d-%d-%d", &day.tm_year, &day.tm_mon, &day.tm_mday) != 3) {
+        log_error("Invalid date format: %s", date);
+        return false;
+    }
+    
+    day.tm_year -= 1900;
+    day.tm_mon -= 1;
+    day.tm_isdst = -1;
+    time_t from = mktime(&day);
+    
+    day.tm_mday += 1;
+    day.tm_isdst = -1;
+    time_t to = mktime(&day);
+    
+    return get_system_metrics_range(metrics, count, from, to);
+}
+
+bool get_recent_system_metrics(SystemMetrics **metrics, int *count) {
+    time_t now = time(NULL);
+    return get_system_metrics_range(metrics, count, now - HOT_TIER_RECENT_SECONDS, now + 1);
+}
+
 // File operations
-bool insert_file_operation(const FileOperation *operation) {
-    const char *sql = "INSERT INTO file_operations (timestamp, operation, file_path, file_size, status) "
+static bool insert_file_operation_job(void *arg) {
+    const FileOperation *operation = arg;
+    const char *sql = "INSERT INTO file_operations (timestamp, operation_id, file_path, file_size, status_id) "
                       "VALUES (?, ?, ?, ?, ?);";
     
+    int operation_id = intern_string(operation->operation);
+    int status_id = intern_string(operation->status);
+    if (operation_id < 0 || status_id < 0) {
+        return false;
+    }
+    
     sqlite3_stmt *stmt;
     int rc = sqlite3_prepare_v2(db, sql, -1, &stmt, NULL);
     
@@ -241,10 +621,10 @@ bool insert_file_operation(const FileOperation *operation) {
     }
     
     sqlite3_bind_int64(stmt, 1, operation->timestamp);
-    sqlite3_bind_text(stmt, 2, operation->operation, -1, SQLITE_STATIC);
+    sqlite3_bind_int(stmt, 2, operation_id);
     sqlite3_bind_text(stmt, 3, operation->file_path, -1, SQLITE_STATIC);
     sqlite3_bind_int64(stmt, 4, operation->file_size);
-    sqlite3_bind_text(stmt, 5, operation->status, -1, SQLITE_STATIC);
+    sqlite3_bind_int(stmt, 5, status_id);
     
     rc = sqlite3_step(stmt);
     sqlite3_finalize(stmt);
@@ -257,11 +637,23 @@ bool insert_file_operation(const FileOperation *operation) {
     return true;
 }
 
+bool insert_file_operation(const FileOperation *operation) {
+    return db_write(insert_file_operation_job, (void*)operation);
+}
+
 // Network metrics
-bool insert_network_metrics(const NetworkMetrics *metrics) {
-    const char *sql = "INSERT INTO network_metrics (timestamp, target, ping_time, connection_status, interface_name) "
+static bool insert_network_metrics_job(void *arg) {
+    MetricsInsert *insert = arg;
+    const NetworkMetrics *metrics = insert->row;
+    const char *sql = "INSERT INTO network_metrics (timestamp, target_id, ping_time, connection_status, interface_name_id) "
                       "VALUES (?, ?, ?, ?, ?);";
     
+    int target_id = intern_string(metrics->target);
+    int interface_id = intern_string(metrics->interface_name);
+    if (target_id < 0 || interface_id < 0) {
+        return false;
+    }
+    
     sqlite3_stmt *stmt;
     int rc = sqlite3_prepare_v2(db, sql, -1, &stmt, NULL);
     
@@ -271,27 +663,59 @@ bool insert_network_metrics(const NetworkMetrics *metrics) {
     }
     
     sqlite3_bind_int64(stmt, 1, metrics->timestamp);
-    sqlite3_bind_text(stmt, 2, metrics->target, -1, SQLITE_STATIC);
+    sqlite3_bind_int(stmt, 2, target_id);
     sqlite3_bind_int(stmt, 3, metrics->ping_time);
     sqlite3_bind_int(stmt, 4, metrics->connection_status ? 1 : 0);
-    sqlite3_bind_text(stmt, 5, metrics->interface_name, -1, SQLITE_STATIC);
+    sqlite3_bind_int(stmt, 5, interface_id);
+    
+    execute_query("SAVEPOINT insert_network_metrics;");
     
     rc = sqlite3_step(stmt);
     sqlite3_finalize(stmt);
     
     if (rc != SQLITE_DONE) {
         log_error("Failed to insert network metrics: %s", sqlite3_errmsg(db));
+        execute_query("ROLLBACK TO insert_network_metrics; RELEASE insert_network_metrics;");
+        return false;
+    }
+    
+    int row_id = (int)sqlite3_last_insert_rowid(db);
+    
+    if (!update_network_metrics_rollups(metrics)) {
+        execute_query("ROLLBACK TO insert_network_metrics; RELEASE insert_network_metrics;");
+        return false;
+    }
+    
+    if (!execute_query("RELEASE insert_network_metrics;")) {
+        return false;
+    }
+    
+    insert->row_id = row_id;
+    return true;
+}
+
+bool insert_network_metrics(const NetworkMetrics *metrics) {
+    MetricsInsert insert = { metrics, 0 };
+    if (!db_write(insert_network_metrics_job, &insert)) {
         return false;
     }
     
+    hot_tier_record_network(metrics, insert.row_id);
     return true;
 }
 
 // Security scans
-bool insert_security_scan(const SecurityScan *scan) {
-    const char *sql = "INSERT INTO security_scans (timestamp, scan_type, target, threats_found, severity, description) "
+static bool insert_security_scan_job(void *arg) {
+    const SecurityScan *scan = arg;
+    const char *sql = "INSERT INTO security_scans (timestamp, scan_type_id, target, threats_found, severity_id, description) "
                       "VALUES (?, ?, ?, ?, ?, ?);";
     
+    int scan_type_id = intern_string(scan->scan_type);
+    int severity_id = intern_string(scan->severity);
+    if (scan_type_id < 0 || severity_id < 0) {
+        return false;
+    }
+    
     sqlite3_stmt *stmt;
     int rc = sqlite3_prepare_v2(db, sql, -1, &stmt, NULL);
     
@@ -301,10 +725,10 @@ bool insert_security_scan(const SecurityScan *scan) {
     }
     
     sqlite3_bind_int64(stmt, 1, scan->timestamp);
-    sqlite3_bind_text(stmt, 2, scan->scan_type, -1, SQLITE_STATIC);
+    sqlite3_bind_int(stmt, 2, scan_type_id);
     sqlite3_bind_text(stmt, 3, scan->target, -1, SQLITE_STATIC);
     sqlite3_bind_int(stmt, 4, scan->threats_found);
-    sqlite3_bind_text(stmt, 5, scan->severity, -1, SQLITE_STATIC);
+    sqlite3_bind_int(stmt, 5, severity_id);
     sqlite3_bind_text(stmt, 6, scan->description, -1, SQLITE_STATIC);
     
     rc = sqlite3_step(stmt);
@@ -318,8 +742,13 @@ bool insert_security_scan(const SecurityScan *scan) {
     return true;
 }
 
+bool insert_security_scan(const SecurityScan *scan) {
+    return db_write(insert_security_scan_job, (void*)scan);
+}
+
 // Scheduled tasks
-bool insert_scheduled_task(const ScheduledTask *task) {
+static bool insert_scheduled_task_job(void *arg) {
+    const ScheduledTask *task = arg;
     const char *sql = "INSERT INTO scheduled_tasks (task_name, command, schedule, next_run, last_run, enabled, status) "
                       "VALUES (?, ?, ?, ?, ?, ?, ?);";
     
@@ -350,15 +779,37 @@ bool insert_scheduled_task(const ScheduledTask *task) {
     return true;
 }
 
-bool get_scheduled_tasks(ScheduledTask **tasks, int *count) {
+bool insert_scheduled_task(const ScheduledTask *task) {
+    return db_write(insert_scheduled_task_job, (void*)task);
+}
+
+// Column order of the scheduled_tasks SELECTs below
+static void read_scheduled_task_row(sqlite3_stmt *stmt, ScheduledTask *task) {
+    const char *status = (const char*)sqlite3_column_text(stmt, 7);
+    
+    task->id = sqlite3_column_int(stmt, 0);
+    strncpy(task->task_name, (const char*)sqlite3_column_text(stmt, 1), sizeof(task->task_name) - 1);
+    task->task_name[sizeof(task->task_name) - 1] = '\0';
+    strncpy(task->command, (const char*)sqlite3_column_text(stmt, 2), sizeof(task->command) - 1);
+    task->command[sizeof(task->command) - 1] = '\0';
+    strncpy(task->schedule, (const char*)sqlite3_column_text(stmt, 3), sizeof(task->schedule) - 1);
+    task->schedule[sizeof(task->schedule) - 1] = '\0';
+    task->next_run = sqlite3_column_int64(stmt, 4);
+    task->last_run = sqlite3_column_int64(stmt, 5);
+    task->enabled = sqlite3_column_int(stmt, 6) ? true : false;
+    strncpy(task->status, status ? status : "", sizeof(task->status) - 1);
+    task->status[sizeof(task->status) - 1] = '\0';
+}
+
+static bool read_scheduled_tasks(sqlite3 *conn, ScheduledTask **tasks, int *count) {
     const char *sql = "SELECT id, task_name, command, schedule, next_run, last_run, enabled, status "
                       "FROM scheduled_tasks ORDER BY task_name;";
     
     sqlite3_stmt *stmt;
-    int rc = sqlite3_prepare_v2(db, sql, -1, &stmt, NULL);
+    int rc = sqlite3_prepare_v2(conn, sql, -1, &stmt, NULL);
     
     if (rc != SQLITE_OK) {
-        log_error("Failed to prepare statement: %s", sqlite3_errmsg(db));
+        log_error("Failed to prepare statement: %s", sqlite3_errmsg(conn));
         return false;
     }
     
@@ -388,27 +839,7 @@ bool get_scheduled_tasks(ScheduledTask **tasks, int *count) {
     // Fetch data
     int i = 0;
     while (sqlite3_step(stmt) == SQLITE_ROW && i < *count) {
-        (*tasks)[i].id = sqlite3_column_int(stmt, 0);
-        strncpy((*tasks)[i].task_name, (const char*)sqlite3_column_text(stmt, 1), 
-                sizeof((*tasks)[i].task_name) - 1);
-        (*tasks)[i].task_name[sizeof((*tasks)[i].task_name) - 1] = '\0';
-        
-        strncpy((*tasks)[i].command, (const char*)sqlite3_column_text(stmt, 2), 
-                sizeof((*tasks)[i].command) - 1);
-        (*tasks)[i].command[sizeof((*tasks)[i].command) - 1] = '\0';
-        
-        strncpy((*tasks)[i].schedule, (const char*)sqlite3_column_text(stmt, 3), 
-                sizeof((*tasks)[i].schedule) - 1);
-        (*tasks)[i].schedule[sizeof((*tasks)[i].schedule) - 1] = '\0';
-        
-        (*tasks)[i].next_run = sqlite3_column_int64(stmt, 4);
-        (*tasks)[i].last_run = sqlite3_column_int64(stmt, 5);
-        (*tasks)[i].enabled = sqlite3_column_int(stmt, 6) ? true : false;
-        
-        strncpy((*tasks)[i].status, (const char*)sqlite3_column_text(stmt, 7), 
-                sizeof((*tasks)[i].status) - 1);
-        (*tasks)[i].status[sizeof((*tasks)[i].status) - 1] = '\0';
-        
+        read_scheduled_task_row(stmt, &(*tasks)[i]);
         i++;
     }
     
@@ -416,280 +847,1822 @@ bool get_scheduled_tasks(ScheduledTask **tasks, int *count) {
     return true;
 }
 
-// Utility functions
-char* get_timestamp_string(time_t timestamp) {
-    static char buffer[32];
-    struct tm *tm_info = localtime(&timestamp);
-    strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", tm_info);
-    return buffer;
+bool get_scheduled_tasks(ScheduledTask **tasks, int *count) {
+    sqlite3 *conn = db_acquire_reader();
+    bool ok = read_scheduled_tasks(conn, tasks, count);
+    db_release_reader(conn);
+    return ok;
 }
 
-time_t parse_timestamp_string(const char *timestamp_str) {
-    struct tm tm_info = {0};
+static bool read_scheduled_task_by_id(sqlite3 *conn, ScheduledTask *task, int task_id) {
+    const char *sql = "SELECT id, task_name, command, schedule, next_run, last_run, enabled, status "
+                      "FROM scheduled_tasks WHERE id = ?;";
     
-#ifdef _WIN32
-    // Windows için sscanf kullanarak timestamp parse et
-    int year, month, day, hour, minute, second;
-    if (sscanf(timestamp_str, "%d-%d-%d %d:%d:%d", 
-               &year, &month, &day, &hour, &minute, &second) == 6) {
-        tm_info.tm_year = year - 1900;
-        tm_info.tm_mon = month - 1;
-        tm_info.tm_mday = day;
-        tm_info.tm_hour = hour;
-        tm_info.tm_min = minute;
-        tm_info.tm_sec = second;
-        return mktime(&tm_info);
+    sqlite3_stmt *stmt;
+    if (sqlite3_prepare_v2(conn, sql, -1, &stmt, NULL) != SQLITE_OK) {
+        log_error("Failed to prepare statement: %s", sqlite3_errmsg(conn));
+        return false;
     }
-#else
-    if (strptime(timestamp_str, "%Y-%m-%d %H:%M:%S", &tm_info) != NULL) {
-        return mktime(&tm_info);
+    
+    sqlite3_bind_int(stmt, 1, task_id);
+    
+    bool found = sqlite3_step(stmt) == SQLITE_ROW;
+    if (found) {
+        read_scheduled_task_row(stmt, task);
     }
-#endif
-    return 0;
+    
+    sqlite3_finalize(stmt);
+    return found;
 }
 
-bool cleanup_old_records(int days_to_keep) {
-    time_t cutoff_time = time(NULL) - (days_to_keep * 24 * 60 * 60);
-    
-    const char *cleanup_queries[] = {
-        "DELETE FROM system_metrics WHERE timestamp < ?;",
-        "DELETE FROM file_operations WHERE timestamp < ?;",
-        "DELETE FROM network_metrics WHERE timestamp < ?;",
-        "DELETE FROM security_scans WHERE timestamp < ?;"
-    };
-    
-    for (int i = 0; i < 4; i++) {
-        sqlite3_stmt *stmt;
-        int rc = sqlite3_prepare_v2(db, cleanup_queries[i], -1, &stmt, NULL);
-        
-        if (rc != SQLITE_OK) {
-            log_error("Failed to prepare cleanup statement: %s", sqlite3_errmsg(db));
-            continue;
-        }
-        
-        sqlite3_bind_int64(stmt, 1, cutoff_time);
+bool get_scheduled_task_by_id(ScheduledTask *task, int task_id) {
+    sqlite3 *conn = db_acquire_reader();
+    bool ok = read_scheduled_task_by_id(conn, task, task_id);
+    db_release_reader(conn);
+    return ok;
+}
+
+static void bind_scheduled_task(sqlite3_stmt *stmt, const ScheduledTask *task) {
+    sqlite3_bind_text(stmt, 1, task->task_name, -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 2, task->command, -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 3, task->schedule, -1, SQLITE_STATIC);
+    sqlite3_bind_int64(stmt, 4, task->next_run);
+    sqlite3_bind_int64(stmt, 5, task->last_run);
+    sqlite3_bind_int(stmt, 6, task->enabled ? 1 : 0);
+    sqlite3_bind_text(stmt, 7, task->status, -1, SQLITE_STATIC);
+}
+
+static bool update_scheduled_task_job(void *arg) {
+    const ScheduledTask *task = arg;
+    const char *sql = "UPDATE scheduled_tasks SET task_name = ?, command = ?, schedule = ?, next_run = ?, "
+                      "last_run = ?, enabled = ?, status = ? WHERE id = ?;";
+    
+    sqlite3_stmt *stmt;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK) {
+        log_error("Failed to prepare statement: %s", sqlite3_errmsg(db));
+        return false;
+    }
+    
+    bind_scheduled_task(stmt, task);
+    sqlite3_bind_int(stmt, 8, task->id);
+    
+    int rc = sqlite3_step(stmt);
+    sqlite3_finalize(stmt);
+    
+    if (rc != SQLITE_DONE) {
+        log_error("Failed to update scheduled task: %s", sqlite3_errmsg(db));
+        return false;
+    }
+    
+    return sqlite3_changes(db) > 0;
+}
+
+bool update_scheduled_task(const ScheduledTask *task) {
+    return db_write(update_scheduled_task_job, (void*)task);
+}
+
+// One statement instead of insert-then-update; task_name is UNIQUE
+static bool upsert_scheduled_task_job(void *arg) {
+    ScheduledTask *task = arg;
+    const char *sql = "INSERT INTO scheduled_tasks (task_name, command, schedule, next_run, last_run, enabled, status) "
+                      "VALUES (?, ?, ?, ?, ?, ?, ?) "
+                      "ON CONFLICT(task_name) DO UPDATE SET command = excluded.command, "
+                      "schedule = excluded.schedule, next_run = excluded.next_run, last_run = excluded.last_run, "
+                      "enabled = excluded.enabled, status = excluded.status "
+                      "RETURNING id;";
+    
+    sqlite3_stmt *stmt;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK) {
+        log_error("Failed to prepare statement: %s", sqlite3_errmsg(db));
+        return false;
+    }
+    
+    bind_scheduled_task(stmt, task);
+    
+    int rc = sqlite3_step(stmt);
+    if (rc == SQLITE_ROW) {
+        task->id = sqlite3_column_int(stmt, 0);
+        rc = sqlite3_step(stmt);
+    }
+    sqlite3_finalize(stmt);
+    
+    if (rc != SQLITE_DONE) {
+        log_error("Failed to upsert scheduled task: %s", sqlite3_errmsg(db));
+        return false;
+    }
+    
+    return true;
+}
+
+bool upsert_scheduled_task(ScheduledTask *task) {
+    return db_write(upsert_scheduled_task_job, task);
+}
+
+static bool delete_scheduled_task_job(void *arg) {
+    int task_id = *(int *)arg;
+    const char *sql[] = {
+        "DELETE FROM task_runs WHERE task_id = ?;",
+        "DELETE FROM scheduled_tasks WHERE id = ?;"
+    };
+    
+    for (int i = 0; i < 2; i++) {
+        sqlite3_stmt *stmt;
+        if (sqlite3_prepare_v2(db, sql[i], -1, &stmt, NULL) != SQLITE_OK) {
+            log_error("Failed to prepare statement: %s", sqlite3_errmsg(db));
+            return false;
+        }
+        
+        sqlite3_bind_int(stmt, 1, task_id);
+        int rc = sqlite3_step(stmt);
+        sqlite3_finalize(stmt);
+        
+        if (rc != SQLITE_DONE) {
+            log_error("Failed to delete scheduled task: %s", sqlite3_errmsg(db));
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+bool delete_scheduled_task(int task_id) {
+    // Buffered runs of the task must not be written after it is gone
+    flush_task_runs();
+    return db_write(delete_scheduled_task_job, &task_id);
+}
+
+// ========================================
+// Task run history
+// ========================================
+
+static TaskRun pending_task_runs[TASK_RUN_BATCH_SIZE];
+static int pending_task_run_count = 0;
+static time_t pending_task_runs_since = 0;
+static pthread_mutex_t task_run_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+typedef struct {
+    const TaskRun *runs;
+    int count;
+} TaskRunBatch;
+
+static bool insert_task_runs_job(void *arg) {
+    const TaskRunBatch *batch = arg;
+    const char *sql = "INSERT INTO task_runs (task_id, start_ts, end_ts, exit_code, duration_ms, output_bytes) "
+                      "VALUES (?, ?, ?, ?, ?, ?);";
+    
+    sqlite3_stmt *stmt;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK) {
+        log_error("Failed to prepare statement: %s", sqlite3_errmsg(db));
+        return false;
+    }
+    
+    // One prepared statement for the whole batch, inside one transaction
+    for (int i = 0; i < batch->count; i++) {
+        const TaskRun *run = &batch->runs[i];
+        sqlite3_bind_int(stmt, 1, run->task_id);
+        sqlite3_bind_int64(stmt, 2, run->start_time);
+        sqlite3_bind_int64(stmt, 3, run->end_time);
+        sqlite3_bind_int(stmt, 4, run->exit_code);
+        sqlite3_bind_int64(stmt, 5, run->duration_ms);
+        sqlite3_bind_int64(stmt, 6, run->output_bytes);
+        
+        if (sqlite3_step(stmt) != SQLITE_DONE) {
+            log_error("Failed to insert task run: %s", sqlite3_errmsg(db));
+            sqlite3_finalize(stmt);
+            return false;
+        }
+        sqlite3_reset(stmt);
+    }
+    
+    sqlite3_finalize(stmt);
+    return true;
+}
+
+// Moves the buffered runs to runs and empties the buffer; called with
+// task_run_mutex held, so no run is added between the copy and the reset
+static int take_pending_task_runs(TaskRun *runs) {
+    int count = pending_task_run_count;
+    memcpy(runs, pending_task_runs, sizeof(TaskRun) * count);
+    pending_task_run_count = 0;
+    return count;
+}
+
+static bool write_task_runs(const TaskRun *runs, int count) {
+    if (count == 0) {
+        return true;
+    }
+    
+    TaskRunBatch batch = { runs, count };
+    if (!db_write(insert_task_runs_job, &batch)) {
+        log_error("Dropped %d task run records", count);
+        return false;
+    }
+    
+    return true;
+}
+
+bool flush_task_runs(void) {
+    TaskRun runs[TASK_RUN_BATCH_SIZE];
+    
+    pthread_mutex_lock(&task_run_mutex);
+    int count = take_pending_task_runs(runs);
+    pthread_mutex_unlock(&task_run_mutex);
+    
+    return write_task_runs(runs, count);
+}
+
+bool record_task_run(const TaskRun *run) {
+    TaskRun runs[TASK_RUN_BATCH_SIZE];
+    int count = 0;
+    
+    pthread_mutex_lock(&task_run_mutex);
+    if (pending_task_run_count == 0) {
+        pending_task_runs_since = time(NULL);
+    }
+    pending_task_runs[pending_task_run_count++] = *run;
+    if (pending_task_run_count == TASK_RUN_BATCH_SIZE ||
+        time(NULL) - pending_task_runs_since >= TASK_RUN_FLUSH_SECONDS) {
+        count = take_pending_task_runs(runs);
+    }
+    pthread_mutex_unlock(&task_run_mutex);
+    
+    return write_task_runs(runs, count);
+}
+
+// Newest first; task_id 0 returns runs of every task
+static bool read_task_runs(sqlite3 *conn, int task_id, TaskRun **runs, int *count, int limit) {
+    char sql[256];
+    snprintf(sql, sizeof(sql),
+             "SELECT id, task_id, start_ts, end_ts, exit_code, duration_ms, output_bytes FROM task_runs "
+             "%s ORDER BY start_ts DESC LIMIT ?;", task_id > 0 ? "WHERE task_id = ?" : "");
+    
+    *runs = NULL;
+    *count = 0;
+    
+    sqlite3_stmt *stmt;
+    if (sqlite3_prepare_v2(conn, sql, -1, &stmt, NULL) != SQLITE_OK) {
+        log_error("Failed to prepare statement: %s", sqlite3_errmsg(conn));
+        return false;
+    }
+    
+    int param = 1;
+    if (task_id > 0) {
+        sqlite3_bind_int(stmt, param++, task_id);
+    }
+    sqlite3_bind_int(stmt, param, limit);
+    
+    int capacity = 0;
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        if (*count == capacity) {
+            capacity = capacity > 0 ? capacity * 2 : 32;
+            TaskRun *grown = realloc(*runs, sizeof(TaskRun) * capacity);
+            if (!grown) {
+                log_error("Memory allocation failed");
+                sqlite3_finalize(stmt);
+                free(*runs);
+                *runs = NULL;
+                *count = 0;
+                return false;
+            }
+            *runs = grown;
+        }
+        
+        TaskRun *run = &(*runs)[(*count)++];
+        run->id = sqlite3_column_int64(stmt, 0);
+        run->task_id = sqlite3_column_int(stmt, 1);
+        run->start_time = sqlite3_column_int64(stmt, 2);
+        run->end_time = sqlite3_column_int64(stmt, 3);
+        run->exit_code = sqlite3_column_int(stmt, 4);
+        run->duration_ms = sqlite3_column_int64(stmt, 5);
+        run->output_bytes = sqlite3_column_int64(stmt, 6);
+    }
+    
+    sqlite3_finalize(stmt);
+    return true;
+}
+
+bool get_task_runs(int task_id, TaskRun **runs, int *count, int limit) {
+    flush_task_runs();
+    
+    sqlite3 *conn = db_acquire_reader();
+    bool ok = read_task_runs(conn, task_id, runs, count, limit);
+    db_release_reader(conn);
+    return ok;
+}
+
+// Per-task queries are answered from idx_task_runs_stats without touching rows
+static bool read_task_run_stats(sqlite3 *conn, int task_id, TaskRunStats *stats) {
+    const char *where = task_id > 0 ? "WHERE task_id = ?" : "";
+    char sql[2][256];
+    snprintf(sql[0], sizeof(sql[0]),
+             "SELECT COUNT(*), COALESCE(SUM(exit_code = 0), 0), COALESCE(AVG(duration_ms), 0), "
+             "COALESCE(MAX(duration_ms), 0), COALESCE(SUM(output_bytes), 0) FROM task_runs %s;", where);
+    snprintf(sql[1], sizeof(sql[1]),
+             "SELECT start_ts, exit_code FROM task_runs %s ORDER BY start_ts DESC LIMIT 1;", where);
+    
+    memset(stats, 0, sizeof(*stats));
+    
+    for (int i = 0; i < 2; i++) {
+        sqlite3_stmt *stmt;
+        if (sqlite3_prepare_v2(conn, sql[i], -1, &stmt, NULL) != SQLITE_OK) {
+            log_error("Failed to prepare statement: %s", sqlite3_errmsg(conn));
+            return false;
+        }
+        
+        if (task_id > 0) {
+            sqlite3_bind_int(stmt, 1, task_id);
+        }
+        
+        if (sqlite3_step(stmt) == SQLITE_ROW) {
+            if (i == 0) {
+                stats->run_count = sqlite3_column_int64(stmt, 0);
+                stats->success_count = sqlite3_column_int64(stmt, 1);
+                stats->failure_count = stats->run_count - stats->success_count;
+                stats->avg_duration_ms = sqlite3_column_double(stmt, 2);
+                stats->max_duration_ms = sqlite3_column_int64(stmt, 3);
+                stats->total_output_bytes = sqlite3_column_int64(stmt, 4);
+            } else {
+                stats->last_run = sqlite3_column_int64(stmt, 0);
+                stats->last_exit_code = sqlite3_column_int(stmt, 1);
+            }
+        }
+        
+        sqlite3_finalize(stmt);
+    }
+    
+    return true;
+}
+
+bool get_task_run_stats(int task_id, TaskRunStats *stats) {
+    flush_task_runs();
+    
+    sqlite3 *conn = db_acquire_reader();
+    bool ok = read_task_run_stats(conn, task_id, stats);
+    db_release_reader(conn);
+    return ok;
+}
+
+// Utility functions
+char* get_timestamp_string(time_t timestamp) {
+    static char buffer[32];
+    struct tm *tm_info = localtime(&timestamp);
+    strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", tm_info);
+    return buffer;
+}
+
+time_t parse_timestamp_string(const char *timestamp_str) {
+    struct tm tm_info = {0};
+    
+#ifdef _WIN32
+    // Windows için sscanf kullanarak timestamp parse et
+    int year, month, day, hour, minute, second;
+    if (sscanf(timestamp_str, "%d-%d-%d %d:%d:%d", 
+               &year, &month, &day, &hour, &minute, &second) == 6) {
+        tm_info.tm_year = year - 1900;
+        tm_info.tm_mon = month - 1;
+        tm_info.tm_mday = day;
+        tm_info.tm_hour = hour;
+        tm_info.tm_min = minute;
+        tm_info.tm_sec = second;
+        return mktime(&tm_info);
+    }
+#else
+    if (strptime(timestamp_str, "%Y-%m-%d %H:%M:%S", &tm_info) != NULL) {
+        return mktime(&tm_info);
+    }
+#endif
+    return 0;
+}
+
+// Tables trimmed by retention and the column holding their age
+static const struct {
+    const char *table;
+    const char *time_column;
+} retention_tables[] = {
+    { "system_metrics", "timestamp" },
+    { "file_operations", "timestamp" },
+    { "network_metrics", "timestamp" },
+    { "security_scans", "timestamp" },
+    { "log_alerts", "timestamp" }
+};
+#define RETENTION_TABLE_COUNT 5
+
+// Deletes at most batch_rows expired rows; runs as one writer job so the
+// write lock is held only for the batch.
+typedef struct {
+    int table_index;
+    time_t cutoff_time;
+    int batch_rows;
+    int deleted_rows;
+} RetentionBatch;
+
+static bool delete_expired_batch_job(void *arg) {
+    RetentionBatch *batch = arg;
+    char sql[256];
+    
+    // Partitioned metrics expire by dropping whole days
+    if (metric_partitioning_enabled() && strcmp(retention_tables[batch->table_index].table, "system_metrics") == 0) {
+        batch->deleted_rows = expire_metric_partitions(batch->cutoff_time, batch->batch_rows);
+        return batch->deleted_rows >= 0;
+    }
+    snprintf(sql, sizeof(sql),
+             "DELETE FROM %s WHERE rowid IN (SELECT rowid FROM %s WHERE %s < ? LIMIT ?);",
+             retention_tables[batch->table_index].table, retention_tables[batch->table_index].table,
+             retention_tables[batch->table_index].time_column);
+    
+    sqlite3_stmt *stmt;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK) {
+        log_error("Failed to prepare cleanup statement: %s", sqlite3_errmsg(db));
+        return false;
+    }
+    
+    sqlite3_bind_int64(stmt, 1, batch->cutoff_time);
+    sqlite3_bind_int(stmt, 2, batch->batch_rows);
+    
+    int rc = sqlite3_step(stmt);
+    batch->deleted_rows = sqlite3_changes(db);
+    sqlite3_finalize(stmt);
+    
+    if (rc != SQLITE_DONE) {
+        log_error("Failed to cleanup old records: %s", sqlite3_errmsg(db));
+        return false;
+    }
+    
+    return true;
+}
+
+// Returns the number of rows deleted, or -1 on error
+static int delete_expired_batch(int table_index, time_t cutoff_time, int batch_rows) {
+    RetentionBatch batch = { table_index, cutoff_time, batch_rows, 0 };
+    return db_write(delete_expired_batch_job, &batch) ? batch.deleted_rows : -1;
+}
+
+// Days compressed archive blocks are kept; negative turns archiving off and
+// expired system metrics are deleted like the other tables.
+// start_retention_worker sets it.
+static int archive_retention_days = ARCHIVE_RETENTION_DEFAULT_DAYS;
+
+static bool archiving_enabled(void) {
+    return archive_retention_days >= 0;
+}
+
+bool cleanup_old_records(int days_to_keep) {
+    // Close pending rollup buckets while their raw rows still exist
+    finalize_metric_rollups();
+    
+    time_t cutoff_time = time(NULL) - ((time_t)days_to_keep * 24 * 60 * 60);
+    bool ok = true;
+    
+    // Expired system metrics go into the archive instead of being deleted,
+    // as in the retention worker
+    if (archiving_enabled() && !archive_old_system_metrics(days_to_keep)) {
+        ok = false;
+    }
+    
+    // Small batches keep each write lock short so collectors and the API are
+    // not stalled; the pause happens here, outside the writer thread
+    for (int i = 0; i < RETENTION_TABLE_COUNT; i++) {
+        int total = 0, deleted;
+        
+        if (archiving_enabled() && strcmp(retention_tables[i].table, "system_metrics") == 0) {
+            continue;
+        }
+        
+        while ((deleted = delete_expired_batch(i, cutoff_time, RETENTION_BATCH_ROWS)) > 0) {
+            total += deleted;
+            if (deleted == RETENTION_BATCH_ROWS) {
+                sleep_ms(RETENTION_BATCH_PAUSE_MS);
+            }
+        }
+        
+        if (deleted < 0) {
+            ok = false;
+        } else {
+            log_info("Cleaned up %d old records from %s", total, retention_tables[i].table);
+        }
+    }
+    
+    // Rollups outlive the raw rows; each tier has its own retention
+    cleanup_old_rollups();
+    
+    return ok;
+}
+
+static bool vacuum_database_job(void *arg) {
+    (void)arg;
+    return execute_query("PRAGMA auto_vacuum = INCREMENTAL;") && execute_query("VACUUM;");
+}
+
+// Full rebuild; also switches older databases to incremental auto-vacuum
+bool vacuum_database(void) {
+    return db_write_exclusive(vacuum_database_job, NULL);
+}
+
+static int query_pragma_int(const char *pragma) {
+    sqlite3 *conn = db_acquire_reader();
+    sqlite3_stmt *stmt;
+    int value = -1;
+    
+    if (sqlite3_prepare_v2(conn, pragma, -1, &stmt, NULL) == SQLITE_OK) {
+        if (sqlite3_step(stmt) == SQLITE_ROW) {
+            value = sqlite3_column_int(stmt, 0);
+        }
+        sqlite3_finalize(stmt);
+    }
+    
+    db_release_reader(conn);
+    return value;
+}
+
+static bool incremental_vacuum_job(void *arg) {
+    char sql[64];
+    snprintf(sql, sizeof(sql), "PRAGMA incremental_vacuum(%d);", *(int *)arg);
+    return execute_query(sql);
+}
+
+// Releases up to max_pages free pages back to the file system
+bool incremental_vacuum_database(int max_pages) {
+    return db_write_exclusive(incremental_vacuum_job, &max_pages);
+}
+
+// Drains the freelist in small steps. Databases not yet in incremental
+// mode get a one-time full VACUUM that converts them.
+bool reclaim_free_pages(int pages_per_step, int pause_ms) {
+    if (query_pragma_int("PRAGMA auto_vacuum;") != 2) {
+        log_info("Converting database to incremental auto-vacuum");
+        return vacuum_database();
+    }
+    
+    int free_pages;
+    while ((free_pages = query_pragma_int("PRAGMA freelist_count;")) > 0) {
+        if (!incremental_vacuum_database(pages_per_step)) {
+            return false;
+        }
+        if (free_pages > pages_per_step) {
+            sleep_ms(pause_ms);
+        }
+    }
+    
+    return free_pages == 0;
+}
+
+// ========================================
+// Background retention worker
+// ========================================
+
+static pthread_t retention_thread;
+static volatile bool retention_running = false;
+static int retention_days = 0;
+
+static void* retention_worker_main(void *arg) {
+    (void)arg;
+    
+    // Batches go through the writer queue, so they interleave with collector
+    // inserts instead of competing with them for the lock
+    log_info("Retention worker started (%d days, archive %d days)", retention_days, archive_retention_days);
+    
+    while (retention_running) {
+        time_t cutoff_time = time(NULL) - ((time_t)retention_days * 24 * 60 * 60);
+        int deleted_total = 0;
+        
+        // Expired system metrics move into the compressed archive one whole
+        // span per pass and are never deleted unarchived; if archiving fails
+        // the raw rows stay until a later pass
+        if (archiving_enabled()) {
+            int archived = archive_system_metrics_span(cutoff_time);
+            if (archived > 0) {
+                deleted_total += archived;
+                sleep_ms(RETENTION_BATCH_PAUSE_MS);
+            }
+        }
+        
+        for (int i = 0; i < RETENTION_TABLE_COUNT && retention_running; i++) {
+            if (archiving_enabled() && strcmp(retention_tables[i].table, "system_metrics") == 0) {
+                continue;
+            }
+            int deleted = delete_expired_batch(i, cutoff_time, RETENTION_BATCH_ROWS);
+            if (deleted > 0) {
+                deleted_total += deleted;
+                sleep_ms(RETENTION_BATCH_PAUSE_MS);
+            }
+        }
+        
+        if (deleted_total > 0) {
+            continue;
+        }
+        
+        // Backlog drained: write task runs buffered since the last pass,
+        // close the rollup buckets that ended, trim the archive, give freed
+        // pages back, then idle
+        if (retention_running) {
+            flush_task_runs();
+            finalize_metric_rollups();
+        }
+        if (retention_running && archive_retention_days > 0) {
+            cleanup_old_archive_blocks(time(NULL) - ((time_t)archive_retention_days * 24 * 60 * 60));
+        }
+        if (retention_running &&
+            query_pragma_int("PRAGMA freelist_count;") > 0 &&
+            query_pragma_int("PRAGMA auto_vacuum;") == 2) {
+            incremental_vacuum_database(RETENTION_VACUUM_PAGES);
+            sleep_ms(RETENTION_BATCH_PAUSE_MS);
+            continue;
+        }
+        
+        for (int waited = 0; waited < RETENTION_IDLE_SECONDS * 10 && retention_running; waited++) {
+            sleep_ms(100);
+        }
+    }
+    
+    log_info("Retention worker stopped");
+    return NULL;
+}
+
+bool start_retention_worker(int days_to_keep, int archive_days_to_keep) {
+    if (retention_running || days_to_keep <= 0) {
+        return false;
+    }
+    
+    retention_days = days_to_keep;
+    archive_retention_days = archive_days_to_keep > 0 && archive_days_to_keep < days_to_keep ?
+                             days_to_keep : archive_days_to_keep;
+    retention_running = true;
+    
+    if (pthread_create(&retention_thread, NULL, retention_worker_main, NULL) != 0) {
+        log_error("Failed to start retention worker");
+        retention_running = false;
+        return false;
+    }
+    
+    return true;
+}
+
+void stop_retention_worker(void) {
+    if (!retention_running) {
+        return;
+    }
+    
+    retention_running = false;
+    pthread_join(retention_thread, NULL);
+}
+
+// Paced online backup with default settings (see database_backup.c)
+bool backup_database(const char *backup_path) {
+    return backup_database_paced(backup_path, NULL);
+}
+
+// Reads every row of a prepared file_operations query (count first, then fetch)
+static bool fetch_file_operations(sqlite3_stmt *stmt, FileOperation **operations, int *count) {
+    // Count rows first
+    *count = 0;
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        (*count)++;
+    }
+    
+    if (*count == 0) {
+        sqlite3_finalize(stmt);
+        *operations = NULL;
+        return true;
+    }
+    
+    sqlite3_reset(stmt);
+    
+    // Allocate memory
+    *operations = malloc(sizeof(FileOperation) * (*count));
+    if (!*operations) {
+        log_error("Memory allocation failed");
+        sqlite3_finalize(stmt);
+        return false;
+    }
+    
+    // Fetch data
+    int i = 0;
+    while (sqlite3_step(stmt) == SQLITE_ROW && i < *count) {
+        (*operations)[i].id = sqlite3_column_int(stmt, 0);
+        (*operations)[i].timestamp = sqlite3_column_int64(stmt, 1);
+        strncpy((*operations)[i].operation, (const char*)sqlite3_column_text(stmt, 2), 
+                sizeof((*operations)[i].operation) - 1);
+        (*operations)[i].operation[sizeof((*operations)[i].operation) - 1] = '\0';
+        strncpy((*operations)[i].file_path, (const char*)sqlite3_column_text(stmt, 3), 
+                sizeof((*operations)[i].file_path) - 1);
+        (*operations)[i].file_path[sizeof((*operations)[i].file_path) - 1] = '\0';
+        (*operations)[i].file_size = sqlite3_column_int64(stmt, 4);
+        strncpy((*operations)[i].status, (const char*)sqlite3_column_text(stmt, 5), 
+                sizeof((*operations)[i].status) - 1);
+        (*operations)[i].status[sizeof((*operations)[i].status) - 1] = '\0';
+        i++;
+    }
+    
+    sqlite3_finalize(stmt);
+    return true;
+}
+
+// Get file operations history
+static bool read_file_operations_history(sqlite3 *conn, FileOperation **operations, int *count, int limit) {
+    const char *sql = "SELECT f.id, f.timestamp, o.value, f.file_path, f.file_size, s.value "
+                      "FROM file_operations f "
+                      "JOIN interned_strings o ON o.id = f.operation_id "
+                      "JOIN interned_strings s ON s.id = f.status_id "
+                      "ORDER BY f.timestamp DESC LIMIT ?;";
+    
+    sqlite3_stmt *stmt;
+    int rc = sqlite3_prepare_v2(conn, sql, -1, &stmt, NULL);
+    
+    if (rc != SQLITE_OK) {
+        log_error("Failed to prepare statement: %s", sqlite3_errmsg(conn));
+        return false;
+    }
+    
+    sqlite3_bind_int(stmt, 1, limit);
+    
+    return fetch_file_operations(stmt, operations, count);
+}
+
+bool get_file_operations_history(FileOperation **operations, int *count, int limit) {
+    sqlite3 *conn = db_acquire_reader();
+    bool ok = read_file_operations_history(conn, operations, count, limit);
+    db_release_reader(conn);
+    return ok;
+}
+
+// File operations of one type, newest first
+static bool read_file_operations_by_type(sqlite3 *conn, FileOperation **operations, int *count, const char *operation_type) {
+    const char *sql = "SELECT f.id, f.timestamp, o.value, f.file_path, f.file_size, s.value "
+                      "FROM file_operations f "
+                      "JOIN interned_strings o ON o.id = f.operation_id "
+                      "JOIN interned_strings s ON s.id = f.status_id "
+                      "WHERE f.operation_id = ? ORDER BY f.timestamp DESC;";
+    
+    // Unknown values have id 0 and simply match nothing
+    int operation_id = find_interned_string(conn, operation_type);
+    if (operation_id < 0) {
+        return false;
+    }
+    
+    sqlite3_stmt *stmt;
+    int rc = sqlite3_prepare_v2(conn, sql, -1, &stmt, NULL);
+    
+    if (rc != SQLITE_OK) {
+        log_error("Failed to prepare statement: %s", sqlite3_errmsg(conn));
+        return false;
+    }
+    
+    sqlite3_bind_int(stmt, 1, operation_id);
+    
+    return fetch_file_operations(stmt, operations, count);
+}
+
+bool get_file_operations_by_type(FileOperation **operations, int *count, const char *operation_type) {
+    sqlite3 *conn = db_acquire_reader();
+    bool ok = read_file_operations_by_type(conn, operations, count, operation_type);
+    db_release_reader(conn);
+    return ok;
+}
+
+// Reads every row of a prepared network_metrics query (count first, then fetch)
+static bool fetch_network_metrics(sqlite3_stmt *stmt, NetworkMetrics **metrics, int *count) {
+    // Count rows first
+    *count = 0;
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        (*count)++;
+    }
+    
+    if (*count == 0) {
+        sqlite3_finalize(stmt);
+        *metrics = NULL;
+        return true;
+    }
+    
+    sqlite3_reset(stmt);
+    
+    // Allocate memory
+    *metrics = malloc(sizeof(NetworkMetrics) * (*count));
+    if (!*metrics) {
+        log_error("Memory allocation failed");
+        sqlite3_finalize(stmt);
+        return false;
+    }
+    
+    // Fetch data
+    int i = 0;
+    while (sqlite3_step(stmt) == SQLITE_ROW && i < *count) {
+        (*metrics)[i].id = sqlite3_column_int(stmt, 0);
+        (*metrics)[i].timestamp = sqlite3_column_int64(stmt, 1);
+        strncpy((*metrics)[i].target, (const char*)sqlite3_column_text(stmt, 2), 
+                sizeof((*metrics)[i].target) - 1);
+        (*metrics)[i].target[sizeof((*metrics)[i].target) - 1] = '\0';
+        (*metrics)[i].ping_time = sqlite3_column_int(stmt, 3);
+        (*metrics)[i].connection_status = sqlite3_column_int(stmt, 4);
+        strncpy((*metrics)[i].interface_name, (const char*)sqlite3_column_text(stmt, 5), 
+                sizeof((*metrics)[i].interface_name) - 1);
+        (*metrics)[i].interface_name[sizeof((*metrics)[i].interface_name) - 1] = '\0';
+        i++;
+    }
+    
+    sqlite3_finalize(stmt);
+    return true;
+}
+
+// Get network metrics history
+static bool read_network_metrics_history(sqlite3 *conn, NetworkMetrics **metrics, int *count, int limit) {
+    const char *sql = "SELECT n.id, n.timestamp, t.value, n.ping_time, n.connection_status, COALESCE(i.value, '') "
+                      "FROM network_metrics n "
+                      "JOIN interned_strings t ON t.id = n.target_id "
+                      "LEFT JOIN interned_strings i ON i.id = n.interface_name_id "
+                      "ORDER BY n.timestamp DESC LIMIT ?;";
+    
+    sqlite3_stmt *stmt;
+    int rc = sqlite3_prepare_v2(conn, sql, -1, &stmt, NULL);
+    
+    if (rc != SQLITE_OK) {
+        log_error("Failed to prepare statement: %s", sqlite3_errmsg(conn));
+        return false;
+    }
+    
+    sqlite3_bind_int(stmt, 1, limit);
+    
+    return fetch_network_metrics(stmt, metrics, count);
+}
+
+bool get_network_metrics_history(NetworkMetrics **metrics, int *count, int limit) {
+    if (hot_tier_latest_network(limit, metrics, count)) {
+        return true;
+    }
+    
+    sqlite3 *conn = db_acquire_reader();
+    bool ok = read_network_metrics_history(conn, metrics, count, limit);
+    db_release_reader(conn);
+    return ok;
+}
+
+// Network metrics of one target, newest first
+static bool read_network_metrics_by_target(sqlite3 *conn, NetworkMetrics **metrics, int *count, const char *target) {
+    const char *sql = "SELECT n.id, n.timestamp, t.value, n.ping_time, n.connection_status, COALESCE(i.value, '') "
+                      "FROM network_metrics n "
+                      "JOIN interned_strings t ON t.id = n.target_id "
+                      "LEFT JOIN interned_strings i ON i.id = n.interface_name_id "
+                      "WHERE n.target_id = ? ORDER BY n.timestamp DESC;";
+    
+    int target_id = find_interned_string(conn, target);
+    if (target_id < 0) {
+        return false;
+    }
+    
+    sqlite3_stmt *stmt;
+    int rc = sqlite3_prepare_v2(conn, sql, -1, &stmt, NULL);
+    
+    if (rc != SQLITE_OK) {
+        log_error("Failed to prepare statement: %s", sqlite3_errmsg(conn));
+        return false;
+    }
+    
+    sqlite3_bind_int(stmt, 1, target_id);
+    
+    return fetch_network_metrics(stmt, metrics, count);
+}
+
+bool get_network_metrics_by_target(NetworkMetrics **metrics, int *count, const char *target) {
+    sqlite3 *conn = db_acquire_reader();
+    bool ok = read_network_metrics_by_target(conn, metrics, count, target);
+    db_release_reader(conn);
+    return ok;
+}
+
+// Reads every row of a prepared security_scans query (count first, then fetch)
+static bool fetch_security_scans(sqlite3_stmt *stmt, SecurityScan **scans, int *count) {
+    // Count rows first
+    *count = 0;
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        (*count)++;
+    }
+    
+    if (*count == 0) {
+        sqlite3_finalize(stmt);
+        *scans = NULL;
+        return true;
+    }
+    
+    sqlite3_reset(stmt);
+    
+    // Allocate memory
+    *scans = malloc(sizeof(SecurityScan) * (*count));
+    if (!*scans) {
+        log_error("Memory allocation failed");
+        sqlite3_finalize(stmt);
+        return false;
+    }
+    
+    // Fetch data
+    int i = 0;
+    while (sqlite3_step(stmt) == SQLITE_ROW && i < *count) {
+        (*scans)[i].id = sqlite3_column_int(stmt, 0);
+        (*scans)[i].timestamp = sqlite3_column_int64(stmt, 1);
+        strncpy((*scans)[i].scan_type, (const char*)sqlite3_column_text(stmt, 2), 
+                sizeof((*scans)[i].scan_type) - 1);
+        (*scans)[i].scan_type[sizeof((*scans)[i].scan_type) - 1] = '\0';
+        strncpy((*scans)[i].target, (const char*)sqlite3_column_text(stmt, 3), 
+                sizeof((*scans)[i].target) - 1);
+        (*scans)[i].target[sizeof((*scans)[i].target) - 1] = '\0';
+        (*scans)[i].threats_found = sqlite3_column_int(stmt, 4);
+        strncpy((*scans)[i].severity, (const char*)sqlite3_column_text(stmt, 5), 
+                sizeof((*scans)[i].severity) - 1);
+        (*scans)[i].severity[sizeof((*scans)[i].severity) - 1] = '\0';
+        strncpy((*scans)[i].description, (const char*)sqlite3_column_text(stmt, 6), 
+                sizeof((*scans)[i].description) - 1);
+        (*scans)[i].description[sizeof((*scans)[i].description) - 1] = '\0';
+        i++;
+    }
+    
+    sqlite3_finalize(stmt);
+    return true;
+}
+
+// Get security scans history
+static bool read_security_scans_history(sqlite3 *conn, SecurityScan **scans, int *count, int limit) {
+    const char *sql = "SELECT s.id, s.timestamp, t.value, s.target, s.threats_found, v.value, COALESCE(s.description, '') "
+                      "FROM security_scans s "
+                      "JOIN interned_strings t ON t.id = s.scan_type_id "
+                      "JOIN interned_strings v ON v.id = s.severity_id "
+                      "ORDER BY s.timestamp DESC LIMIT ?;";
+    
+    sqlite3_stmt *stmt;
+    int rc = sqlite3_prepare_v2(conn, sql, -1, &stmt, NULL);
+    
+    if (rc != SQLITE_OK) {
+        log_error("Failed to prepare statement: %s", sqlite3_errmsg(conn));
+        return false;
+    }
+    
+    sqlite3_bind_int(stmt, 1, limit);
+    
+    return fetch_security_scans(stmt, scans, count);
+}
+
+bool get_security_scans_history(SecurityScan **scans, int *count, int limit) {
+    sqlite3 *conn = db_acquire_reader();
+    bool ok = read_security_scans_history(conn, scans, count, limit);
+    db_release_reader(conn);
+    return ok;
+}
+
+// Security scans of one severity, newest first (index probe on severity_id)
+static bool read_security_scans_by_severity(sqlite3 *conn, SecurityScan **scans, int *count, const char *severity) {
+    const char *sql = "SELECT s.id, s.timestamp, t.value, s.target, s.threats_found, v.value, COALESCE(s.description, '') "
+                      "FROM security_scans s "
+                      "JOIN interned_strings t ON t.id = s.scan_type_id "
+                      "JOIN interned_strings v ON v.id = s.severity_id "
+                      "WHERE s.severity_id = ? ORDER BY s.timestamp DESC;";
+    
+    int severity_id = find_interned_string(conn, severity);
+    if (severity_id < 0) {
+        return false;
+    }
+    
+    sqlite3_stmt *stmt;
+    int rc = sqlite3_prepare_v2(conn, sql, -1, &stmt, NULL);
+    
+    if (rc != SQLITE_OK) {
+        log_error("Failed to prepare statement: %s", sqlite3_errmsg(conn));
+        return false;
+    }
+    
+    sqlite3_bind_int(stmt, 1, severity_id);
+    
+    return fetch_security_scans(stmt, scans, count);
+}
+
+bool get_security_scans_by_severity(SecurityScan **scans, int *count, const char *severity) {
+    sqlite3 *conn = db_acquire_reader();
+    bool ok = read_security_scans_by_severity(conn, scans, count, severity);
+    db_release_reader(conn);
+    return ok;
+}
+
+// ========================================
+// Aggregate queries
+// ========================================
+
+static bool query_count(sqlite3 *conn, const char *sql, long long *value) {
+    sqlite3_stmt *stmt;
+    if (sqlite3_prepare_v2(conn, sql, -1, &stmt, NULL) != SQLITE_OK) {
+        log_error("Failed to prepare statement: %s", sqlite3_errmsg(conn));
+        return false;
+    }
+    
+    bool ok = sqlite3_step(stmt) == SQLITE_ROW;
+    if (ok) {
+        *value = sqlite3_column_int64(stmt, 0);
+    }
+    
+    sqlite3_finalize(stmt);
+    return ok;
+}
+
+static bool read_table_counts(sqlite3 *conn, TableCounts *counts) {
+    memset(counts, 0, sizeof(*counts));
+    
+    return query_count(conn, "SELECT COUNT(*) FROM system_metrics;", &counts->system_metrics) &&
+           query_count(conn, "SELECT COALESCE(SUM(row_count), 0) FROM system_metrics_archive;",
+                       &counts->archived_system_metrics) &&
+           query_count(conn, "SELECT COUNT(*) FROM file_operations;", &counts->file_operations) &&
+           query_count(conn, "SELECT COUNT(*) FROM network_metrics;", &counts->network_metrics) &&
+           query_count(conn, "SELECT COUNT(*) FROM security_scans;", &counts->security_scans) &&
+           query_count(conn, "SELECT COUNT(*) FROM scheduled_tasks;", &counts->scheduled_tasks);
+}
+
+bool get_table_counts(TableCounts *counts) {
+    sqlite3 *conn = db_acquire_reader();
+    bool ok = read_table_counts(conn, counts);
+    db_release_reader(conn);
+    return ok;
+}
+
+// Per table/index usage, largest first. Needs SQLITE_ENABLE_DBSTAT_VTAB.
+static bool read_table_sizes(sqlite3 *conn, TableSize **sizes, int *count) {
+    const char *sql = "SELECT name, COUNT(*), SUM(pgsize) FROM dbstat GROUP BY name ORDER BY 3 DESC;";
+    
+    *sizes = NULL;
+    *count = 0;
+    
+    sqlite3_stmt *stmt;
+    if (sqlite3_prepare_v2(conn, sql, -1, &stmt, NULL) != SQLITE_OK) {
+        log_warning("dbstat is not available: %s", sqlite3_errmsg(conn));
+        return false;
+    }
+    
+    int capacity = 0;
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        if (*count == capacity) {
+            capacity = capacity > 0 ? capacity * 2 : 32;
+            TableSize *grown = realloc(*sizes, sizeof(TableSize) * capacity);
+            if (!grown) {
+                log_error("Memory allocation failed");
+                sqlite3_finalize(stmt);
+                free(*sizes);
+                *sizes = NULL;
+                *count = 0;
+                return false;
+            }
+            *sizes = grown;
+        }
+        
+        TableSize *row = &(*sizes)[*count];
+        strncpy(row->name, (const char*)sqlite3_column_text(stmt, 0), sizeof(row->name) - 1);
+        row->name[sizeof(row->name) - 1] = '\0';
+        row->pages = sqlite3_column_int64(stmt, 1);
+        row->bytes = sqlite3_column_int64(stmt, 2);
+        (*count)++;
+    }
+    
+    sqlite3_finalize(stmt);
+    return true;
+}
+
+bool get_table_sizes(TableSize **sizes, int *count) {
+    sqlite3 *conn = db_acquire_reader();
+    bool ok = read_table_sizes(conn, sizes, count);
+    db_release_reader(conn);
+    return ok;
+}
+
+static bool read_database_page_stats(sqlite3 *conn, DatabasePageStats *stats) {
+    long long page_size = 0;
+    
+    memset(stats, 0, sizeof(*stats));
+    
+    if (!query_count(conn, "PRAGMA page_size;", &page_size) ||
+        !query_count(conn, "PRAGMA page_count;", &stats->page_count) ||
+        !query_count(conn, "PRAGMA freelist_count;", &stats->freelist_count)) {
+        return false;
+    }
+    
+    stats->page_size = (int)page_size;
+    stats->total_bytes = page_size * stats->page_count;
+    return true;
+}
+
+bool get_database_page_stats(DatabasePageStats *stats) {
+    sqlite3 *conn = db_acquire_reader();
+    bool ok = read_database_page_stats(conn, stats);
+    db_release_reader(conn);
+    return ok;
+}
+
+// Metric columns that can be summarized, with the table they live in
+static const struct {
+    const char *metric;
+    const char *table;
+    const char *filter;
+} summary_metrics[] = {
+    { "cpu_usage", "system_metrics", "1" },
+    { "memory_usage", "system_metrics", "1" },
+    { "disk_usage", "system_metrics", "1" },
+    { "ping_time", "network_metrics", "ping_time >= 0" },
+    { "threats_found", "security_scans", "1" }
+};
+
+// min/max/avg over from <= timestamp < to; an empty window gives sample_count 0
+static bool read_metric_summary(sqlite3 *conn, const char *metric, time_t from, time_t to, MetricSummary *summary) {
+    int index = -1;
+    for (int i = 0; i < (int)(sizeof(summary_metrics) / sizeof(summary_metrics[0])); i++) {
+        if (strcmp(summary_metrics[i].metric, metric) == 0) {
+            index = i;
+            break;
+        }
+    }
+    
+    if (index < 0) {
+        log_error("Unknown metric: %s", metric);
+        return false;
+    }
+    
+    char sql[256];
+    snprintf(sql, sizeof(sql),
+             "SELECT COUNT(%s), MIN(%s), MAX(%s), AVG(%s) FROM %s "
+             "WHERE timestamp >= ? AND timestamp < ? AND %s;",
+             metric, metric, metric, metric, summary_metrics[index].table, summary_metrics[index].filter);
+    
+    sqlite3_stmt *stmt;
+    if (sqlite3_prepare_v2(conn, sql, -1, &stmt, NULL) != SQLITE_OK) {
+        log_error("Failed to prepare statement: %s", sqlite3_errmsg(conn));
+        return false;
+    }
+    
+    sqlite3_bind_int64(stmt, 1, from);
+    sqlite3_bind_int64(stmt, 2, to);
+    
+    bool ok = sqlite3_step(stmt) == SQLITE_ROW;
+    if (ok) {
+        summary->sample_count = sqlite3_column_int64(stmt, 0);
+        summary->min = sqlite3_column_double(stmt, 1);
+        summary->max = sqlite3_column_double(stmt, 2);
+        summary->avg = sqlite3_column_double(stmt, 3);
+    }
+    
+    sqlite3_finalize(stmt);
+    return ok;
+}
+
+bool get_metric_summary(const char *metric, time_t from, time_t to, MetricSummary *summary) {
+    sqlite3 *conn = db_acquire_reader();
+    bool ok = read_metric_summary(conn, metric, from, to, summary);
+    db_release_reader(conn);
+    return ok;
+}
+
+// ========================================
+// Metric rollups
+// ========================================
+
+static const RollupResolution rollup_resolutions[] = { ROLLUP_1MIN, ROLLUP_1HOUR, ROLLUP_1DAY };
+#define ROLLUP_RESOLUTION_COUNT 3
+
+// Every raw insert runs one upsert per resolution, so they are prepared once
+// on the writer connection and kept until the database is closed
+static sqlite3_stmt *system_rollup_upserts[ROLLUP_RESOLUTION_COUNT];
+static sqlite3_stmt *network_rollup_upserts[ROLLUP_RESOLUTION_COUNT];
+
+static void finalize_rollup_statements(void) {
+    for (int i = 0; i < ROLLUP_RESOLUTION_COUNT; i++) {
+        sqlite3_finalize(system_rollup_upserts[i]);
+        sqlite3_finalize(network_rollup_upserts[i]);
+        system_rollup_upserts[i] = NULL;
+        network_rollup_upserts[i] = NULL;
+    }
+}
+
+static const char* rollup_suffix(RollupResolution resolution) {
+    switch (resolution) {
+        case ROLLUP_1MIN:  return "1m";
+        case ROLLUP_1HOUR: return "1h";
+        case ROLLUP_1DAY:  return "1d";
+        default:           return "1m";
+    }
+}
+
+static int rollup_keep_days(RollupResolution resolution) {
+    switch (resolution) {
+        case ROLLUP_1MIN:  return ROLLUP_1MIN_KEEP_DAYS;
+        case ROLLUP_1HOUR: return ROLLUP_1HOUR_KEEP_DAYS;
+        case ROLLUP_1DAY:  return ROLLUP_1DAY_KEEP_DAYS;
+        default:           return 0;
+    }
+}
+
+static time_t rollup_bucket_start(time_t timestamp, RollupResolution resolution) {
+    return timestamp - (timestamp % resolution);
+}
+
+// Nearest-rank percentile offset for ORDER BY ... LIMIT 1 OFFSET ?
+static int percentile_offset(int sample_count, int percentile) {
+    int rank = (sample_count * percentile + 99) / 100;
+    return rank > 0 ? rank - 1 : 0;
+}
+
+static bool create_rollup_tables(void) {
+    char sql[1024];
+    
+    for (int i = 0; i < ROLLUP_RESOLUTION_COUNT; i++) {
+        const char *suffix = rollup_suffix(rollup_resolutions[i]);
         
-        rc = sqlite3_step(stmt);
-        int deleted_rows = sqlite3_changes(db);
-        sqlite3_finalize(stmt);
+        snprintf(sql, sizeof(sql),
+            "CREATE TABLE IF NOT EXISTS system_metrics_%s ("
+            "bucket_start INTEGER NOT NULL,"
+            "hostname TEXT NOT NULL,"
+            "sample_count INTEGER NOT NULL,"
+            "cpu_min REAL, cpu_max REAL, cpu_sum REAL, cpu_p95 REAL,"
+            "memory_min REAL, memory_max REAL, memory_sum REAL, memory_p95 REAL,"
+            "disk_min REAL, disk_max REAL, disk_sum REAL, disk_p95 REAL,"
+            "finalized INTEGER NOT NULL DEFAULT 0,"
+            "PRIMARY KEY (bucket_start, hostname)"
+            ") WITHOUT ROWID;"
+            "CREATE INDEX IF NOT EXISTS idx_system_metrics_%s_open "
+            "ON system_metrics_%s(bucket_start) WHERE finalized = 0;",
+            suffix, suffix, suffix);
+        if (!execute_query(sql)) {
+            return false;
+        }
         
-        if (rc == SQLITE_DONE) {
-            log_info("Cleaned up %d old records from table %d", deleted_rows, i + 1);
-        } else {
-            log_error("Failed to cleanup old records: %s", sqlite3_errmsg(db));
+        snprintf(sql, sizeof(sql),
+            "CREATE TABLE IF NOT EXISTS network_metrics_%s ("
+            "bucket_start INTEGER NOT NULL,"
+            "target TEXT NOT NULL,"
+            "sample_count INTEGER NOT NULL,"
+            "success_count INTEGER NOT NULL,"
+            "ping_count INTEGER NOT NULL,"
+            "ping_min REAL, ping_max REAL, ping_sum REAL, ping_p95 REAL,"
+            "finalized INTEGER NOT NULL DEFAULT 0,"
+            "PRIMARY KEY (bucket_start, target)"
+            ") WITHOUT ROWID;"
+            "CREATE INDEX IF NOT EXISTS idx_network_metrics_%s_open "
+            "ON network_metrics_%s(bucket_start) WHERE finalized = 0;",
+            suffix, suffix, suffix);
+        if (!execute_query(sql)) {
+            return false;
+        }
+    }
+    
+    // Databases created before rollups existed get backfilled once
+    sqlite3_stmt *stmt;
+    bool needs_backfill = false;
+    const char *check_sql =
+        "SELECT (EXISTS (SELECT 1 FROM system_metrics) AND NOT EXISTS (SELECT 1 FROM system_metrics_1m)) "
+        "OR (EXISTS (SELECT 1 FROM network_metrics) AND NOT EXISTS (SELECT 1 FROM network_metrics_1m));";
+    
+    if (sqlite3_prepare_v2(db, check_sql, -1, &stmt, NULL) == SQLITE_OK) {
+        if (sqlite3_step(stmt) == SQLITE_ROW) {
+            needs_backfill = sqlite3_column_int(stmt, 0) != 0;
         }
+        sqlite3_finalize(stmt);
+    }
+    
+    if (needs_backfill) {
+        log_info("Backfilling metric rollups from existing raw data");
+        return rebuild_metric_rollups();
     }
     
     return true;
 }
 
-bool vacuum_database(void) {
-    return execute_query("VACUUM;");
+// Open buckets are only accumulated here; p95 is filled in later by
+// finalize_metric_rollups (retention worker, cleanup), off the insert path
+static bool update_system_metrics_rollups(const SystemMetrics *metrics) {
+    char sql[1024];
+    
+    for (int i = 0; i < ROLLUP_RESOLUTION_COUNT; i++) {
+        RollupResolution resolution = rollup_resolutions[i];
+        time_t bucket = rollup_bucket_start(metrics->timestamp, resolution);
+        sqlite3_stmt *stmt = system_rollup_upserts[i];
+        
+        if (!stmt) {
+            snprintf(sql, sizeof(sql),
+                "INSERT INTO system_metrics_%s (bucket_start, hostname, sample_count, "
+                "cpu_min, cpu_max, cpu_sum, memory_min, memory_max, memory_sum, disk_min, disk_max, disk_sum) "
+                "VALUES (?1, ?2, 1, ?3, ?3, ?3, ?4, ?4, ?4, ?5, ?5, ?5) "
+                "ON CONFLICT (bucket_start, hostname) DO UPDATE SET "
+                "sample_count = sample_count + 1,"
+                "cpu_min = MIN(cpu_min, ?3), cpu_max = MAX(cpu_max, ?3), cpu_sum = cpu_sum + ?3,"
+                "memory_min = MIN(memory_min, ?4), memory_max = MAX(memory_max, ?4), memory_sum = memory_sum + ?4,"
+                "disk_min = MIN(disk_min, ?5), disk_max = MAX(disk_max, ?5), disk_sum = disk_sum + ?5,"
+                "finalized = 0;",
+                rollup_suffix(resolution));
+            
+            if (sqlite3_prepare_v2(db, sql, -1, &system_rollup_upserts[i], NULL) != SQLITE_OK) {
+                log_error("Failed to prepare rollup statement: %s", sqlite3_errmsg(db));
+                return false;
+            }
+            stmt = system_rollup_upserts[i];
+        }
+        
+        sqlite3_bind_int64(stmt, 1, bucket);
+        sqlite3_bind_text(stmt, 2, metrics->hostname, -1, SQLITE_STATIC);
+        sqlite3_bind_double(stmt, 3, metrics->cpu_usage);
+        sqlite3_bind_double(stmt, 4, metrics->memory_usage);
+        sqlite3_bind_double(stmt, 5, metrics->disk_usage);
+        
+        int rc = sqlite3_step(stmt);
+        if (rc != SQLITE_DONE) {
+            log_error("Failed to update system metrics rollup: %s", sqlite3_errmsg(db));
+        }
+        sqlite3_reset(stmt);
+        
+        if (rc != SQLITE_DONE) {
+            return false;
+        }
+    }
+    
+    return true;
 }
 
-bool backup_database(const char *backup_path) {
-    sqlite3 *backup_db;
-    sqlite3_backup *backup;
-    int rc;
-    
-    rc = sqlite3_open(backup_path, &backup_db);
-    if (rc != SQLITE_OK) {
-        log_error("Cannot open backup database: %s", sqlite3_errmsg(backup_db));
-        return false;
+static bool update_network_metrics_rollups(const NetworkMetrics *metrics) {
+    char sql[1024];
+    bool has_ping = metrics->ping_time >= 0;
+    
+    for (int i = 0; i < ROLLUP_RESOLUTION_COUNT; i++) {
+        RollupResolution resolution = rollup_resolutions[i];
+        time_t bucket = rollup_bucket_start(metrics->timestamp, resolution);
+        sqlite3_stmt *stmt = network_rollup_upserts[i];
+        
+        // ?4 is NULL when the sample carries no ping time
+        if (!stmt) {
+            snprintf(sql, sizeof(sql),
+                "INSERT INTO network_metrics_%s (bucket_start, target, sample_count, success_count, "
+                "ping_count, ping_min, ping_max, ping_sum) "
+                "VALUES (?1, ?2, 1, ?3, ?5, ?4, ?4, ?4) "
+                "ON CONFLICT (bucket_start, target) DO UPDATE SET "
+                "sample_count = sample_count + 1,"
+                "success_count = success_count + ?3,"
+                "ping_count = ping_count + ?5,"
+                "ping_min = COALESCE(MIN(ping_min, ?4), ping_min, ?4),"
+                "ping_max = COALESCE(MAX(ping_max, ?4), ping_max, ?4),"
+                "ping_sum = COALESCE(ping_sum + ?4, ping_sum, ?4),"
+                "finalized = 0;",
+                rollup_suffix(resolution));
+            
+            if (sqlite3_prepare_v2(db, sql, -1, &network_rollup_upserts[i], NULL) != SQLITE_OK) {
+                log_error("Failed to prepare rollup statement: %s", sqlite3_errmsg(db));
+                return false;
+            }
+            stmt = network_rollup_upserts[i];
+        }
+        
+        sqlite3_bind_int64(stmt, 1, bucket);
+        sqlite3_bind_text(stmt, 2, metrics->target, -1, SQLITE_STATIC);
+        sqlite3_bind_int(stmt, 3, metrics->connection_status ? 1 : 0);
+        if (has_ping) {
+            sqlite3_bind_double(stmt, 4, metrics->ping_time);
+        } else {
+            sqlite3_bind_null(stmt, 4);
+        }
+        sqlite3_bind_int(stmt, 5, has_ping ? 1 : 0);
+        
+        int rc = sqlite3_step(stmt);
+        if (rc != SQLITE_DONE) {
+            log_error("Failed to update network metrics rollup: %s", sqlite3_errmsg(db));
+        }
+        sqlite3_reset(stmt);
+        
+        if (rc != SQLITE_DONE) {
+            return false;
+        }
     }
     
-    backup = sqlite3_backup_init(backup_db, "main", db, "main");
-    if (backup) {
-        sqlite3_backup_step(backup, -1);
-        sqlite3_backup_finish(backup);
+    return true;
+}
+
+// Exact p95 of one column over a closed bucket, read back from the raw table
+static bool query_bucket_percentile(const char *sql, int key_id, time_t bucket_start,
+                                    RollupResolution resolution, int offset, double *value) {
+    sqlite3_stmt *stmt;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK) {
+        log_error("Failed to prepare percentile statement: %s", sqlite3_errmsg(db));
+        return false;
     }
     
-    rc = sqlite3_errcode(backup_db);
-    sqlite3_close(backup_db);
+    sqlite3_bind_int(stmt, 1, key_id);
+    sqlite3_bind_int64(stmt, 2, bucket_start);
+    sqlite3_bind_int64(stmt, 3, bucket_start + resolution);
+    sqlite3_bind_int(stmt, 4, offset);
     
-    if (rc == SQLITE_OK) {
-        log_info("Database backup created successfully: %s", backup_path);
-        return true;
-    } else {
-        log_error("Database backup failed: %s", sqlite3_errmsg(backup_db));
-        return false;
+    bool found = false;
+    if (sqlite3_step(stmt) == SQLITE_ROW) {
+        *value = sqlite3_column_double(stmt, 0);
+        found = true;
     }
+    
+    sqlite3_finalize(stmt);
+    return found;
 }
 
-// Get file operations history
-bool get_file_operations_history(FileOperation **operations, int *count, int limit) {
-    const char *sql = "SELECT id, timestamp, operation, file_path, file_size, status "
-                      "FROM file_operations ORDER BY timestamp DESC LIMIT ?;";
-    
+static bool finalize_system_rollups(RollupResolution resolution, time_t now) {
+    const char *columns[] = { "cpu", "memory", "disk" };
+    const char *suffix = rollup_suffix(resolution);
+    char sql[512];
     sqlite3_stmt *stmt;
-    int rc = sqlite3_prepare_v2(db, sql, -1, &stmt, NULL);
     
-    if (rc != SQLITE_OK) {
+    snprintf(sql, sizeof(sql),
+             "SELECT bucket_start, hostname, sample_count FROM system_metrics_%s "
+             "WHERE finalized = 0 AND bucket_start < ?;", suffix);
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK) {
         log_error("Failed to prepare statement: %s", sqlite3_errmsg(db));
         return false;
     }
+    sqlite3_bind_int64(stmt, 1, rollup_bucket_start(now, resolution));
     
-    sqlite3_bind_int(stmt, 1, limit);
-    
-    // Count rows first
-    *count = 0;
     while (sqlite3_step(stmt) == SQLITE_ROW) {
-        (*count)++;
-    }
-    
-    if (*count == 0) {
-        sqlite3_finalize(stmt);
-        *operations = NULL;
-        return true;
+        time_t bucket_start = sqlite3_column_int64(stmt, 0);
+        const char *hostname = (const char*)sqlite3_column_text(stmt, 1);
+        int offset = percentile_offset(sqlite3_column_int(stmt, 2), 95);
+        int hostname_id = find_interned_string(db, hostname);
+        double p95[3];
+        bool have_p95[3];
+        
+        for (int c = 0; c < 3; c++) {
+            char pct_sql[256];
+            snprintf(pct_sql, sizeof(pct_sql),
+                     "SELECT %s_usage FROM system_metrics WHERE hostname_id = ? "
+                     "AND timestamp >= ? AND timestamp < ? ORDER BY %s_usage LIMIT 1 OFFSET ?;",
+                     columns[c], columns[c]);
+            have_p95[c] = hostname_id > 0 &&
+                query_bucket_percentile(pct_sql, hostname_id, bucket_start, resolution,
+                                        offset, &p95[c]);
+        }
+        
+        // Raw rows already purged: keep p95 NULL, readers fall back to max
+        char update_sql[512];
+        snprintf(update_sql, sizeof(update_sql),
+                 "UPDATE system_metrics_%s SET cpu_p95 = ?, memory_p95 = ?, disk_p95 = ?, finalized = 1 "
+                 "WHERE bucket_start = ? AND hostname = ?;", suffix);
+        
+        sqlite3_stmt *update;
+        if (sqlite3_prepare_v2(db, update_sql, -1, &update, NULL) != SQLITE_OK) {
+            log_error("Failed to prepare statement: %s", sqlite3_errmsg(db));
+            sqlite3_finalize(stmt);
+            return false;
+        }
+        for (int c = 0; c < 3; c++) {
+            if (have_p95[c]) {
+                sqlite3_bind_double(update, c + 1, p95[c]);
+            } else {
+                sqlite3_bind_null(update, c + 1);
+            }
+        }
+        sqlite3_bind_int64(update, 4, bucket_start);
+        sqlite3_bind_text(update, 5, hostname, -1, SQLITE_TRANSIENT);
+        
+        int rc = sqlite3_step(update);
+        sqlite3_finalize(update);
+        if (rc != SQLITE_DONE) {
+            log_error("Failed to finalize system metrics rollup: %s", sqlite3_errmsg(db));
+            sqlite3_finalize(stmt);
+            return false;
+        }
     }
     
-    sqlite3_reset(stmt);
+    sqlite3_finalize(stmt);
+    return true;
+}
+
+static bool finalize_network_rollups(RollupResolution resolution, time_t now) {
+    const char *suffix = rollup_suffix(resolution);
+    const char *pct_sql =
+        "SELECT ping_time FROM network_metrics WHERE target_id = ? AND timestamp >= ? AND timestamp < ? "
+        "AND ping_time >= 0 ORDER BY ping_time LIMIT 1 OFFSET ?;";
+    char sql[512];
+    sqlite3_stmt *stmt;
     
-    // Allocate memory
-    *operations = malloc(sizeof(FileOperation) * (*count));
-    if (!*operations) {
-        log_error("Memory allocation failed");
-        sqlite3_finalize(stmt);
+    snprintf(sql, sizeof(sql),
+             "SELECT bucket_start, target, ping_count FROM network_metrics_%s "
+             "WHERE finalized = 0 AND bucket_start < ?;", suffix);
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK) {
+        log_error("Failed to prepare statement: %s", sqlite3_errmsg(db));
         return false;
     }
+    sqlite3_bind_int64(stmt, 1, rollup_bucket_start(now, resolution));
     
-    // Fetch data
-    int i = 0;
-    while (sqlite3_step(stmt) == SQLITE_ROW && i < *count) {
-        (*operations)[i].id = sqlite3_column_int(stmt, 0);
-        (*operations)[i].timestamp = sqlite3_column_int64(stmt, 1);
-        strncpy((*operations)[i].operation, (const char*)sqlite3_column_text(stmt, 2), 
-                sizeof((*operations)[i].operation) - 1);
-        (*operations)[i].operation[sizeof((*operations)[i].operation) - 1] = '\0';
-        strncpy((*operations)[i].file_path, (const char*)sqlite3_column_text(stmt, 3), 
-                sizeof((*operations)[i].file_path) - 1);
-        (*operations)[i].file_path[sizeof((*operations)[i].file_path) - 1] = '\0';
-        (*operations)[i].file_size = sqlite3_column_int64(stmt, 4);
-        strncpy((*operations)[i].status, (const char*)sqlite3_column_text(stmt, 5), 
-                sizeof((*operations)[i].status) - 1);
-        (*operations)[i].status[sizeof((*operations)[i].status) - 1] = '\0';
-        i++;
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        time_t bucket_start = sqlite3_column_int64(stmt, 0);
+        const char *target = (const char*)sqlite3_column_text(stmt, 1);
+        int ping_count = sqlite3_column_int(stmt, 2);
+        int target_id = find_interned_string(db, target);
+        double p95 = 0;
+        bool have_p95 = ping_count > 0 && target_id > 0 &&
+            query_bucket_percentile(pct_sql, target_id, bucket_start, resolution,
+                                    percentile_offset(ping_count, 95), &p95);
+        
+        char update_sql[256];
+        snprintf(update_sql, sizeof(update_sql),
+                 "UPDATE network_metrics_%s SET ping_p95 = ?, finalized = 1 "
+                 "WHERE bucket_start = ? AND target = ?;", suffix);
+        
+        sqlite3_stmt *update;
+        if (sqlite3_prepare_v2(db, update_sql, -1, &update, NULL) != SQLITE_OK) {
+            log_error("Failed to prepare statement: %s", sqlite3_errmsg(db));
+            sqlite3_finalize(stmt);
+            return false;
+        }
+        if (have_p95) {
+            sqlite3_bind_double(update, 1, p95);
+        } else {
+            sqlite3_bind_null(update, 1);
+        }
+        sqlite3_bind_int64(update, 2, bucket_start);
+        sqlite3_bind_text(update, 3, target, -1, SQLITE_TRANSIENT);
+        
+        int rc = sqlite3_step(update);
+        sqlite3_finalize(update);
+        if (rc != SQLITE_DONE) {
+            log_error("Failed to finalize network metrics rollup: %s", sqlite3_errmsg(db));
+            sqlite3_finalize(stmt);
+            return false;
+        }
     }
     
     sqlite3_finalize(stmt);
     return true;
 }
 
-// Get network metrics history
-bool get_network_metrics_history(NetworkMetrics **metrics, int *count, int limit) {
-    const char *sql = "SELECT id, timestamp, target, ping_time, connection_status, interface_name "
-                      "FROM network_metrics ORDER BY timestamp DESC LIMIT ?;";
+static bool finalize_metric_rollups_job(void *arg) {
+    (void)arg;
+    time_t now = time(NULL);
+    
+    for (int i = 0; i < ROLLUP_RESOLUTION_COUNT; i++) {
+        if (!finalize_system_rollups(rollup_resolutions[i], now) ||
+            !finalize_network_rollups(rollup_resolutions[i], now)) {
+            return false;
+        }
+    }
     
-    sqlite3_stmt *stmt;
-    int rc = sqlite3_prepare_v2(db, sql, -1, &stmt, NULL);
+    return true;
+}
+
+// Computes p95 for every bucket that has closed since the last call
+bool finalize_metric_rollups(void) {
+    return db_write(finalize_metric_rollups_job, NULL);
+}
+
+static bool rebuild_metric_rollups_job(void *arg) {
+    (void)arg;
+    char sql[1024];
     
-    if (rc != SQLITE_OK) {
-        log_error("Failed to prepare statement: %s", sqlite3_errmsg(db));
+    if (!execute_query("BEGIN;")) {
         return false;
     }
     
-    sqlite3_bind_int(stmt, 1, limit);
+    for (int i = 0; i < ROLLUP_RESOLUTION_COUNT; i++) {
+        RollupResolution resolution = rollup_resolutions[i];
+        const char *suffix = rollup_suffix(resolution);
+        
+        snprintf(sql, sizeof(sql),
+            "DELETE FROM system_metrics_%s;"
+            "INSERT INTO system_metrics_%s (bucket_start, hostname, sample_count, "
+            "cpu_min, cpu_max, cpu_sum, memory_min, memory_max, memory_sum, disk_min, disk_max, disk_sum) "
+            "SELECT timestamp - (timestamp %% %d), h.value, COUNT(*), "
+            "MIN(cpu_usage), MAX(cpu_usage), SUM(cpu_usage), "
+            "MIN(memory_usage), MAX(memory_usage), SUM(memory_usage), "
+            "MIN(disk_usage), MAX(disk_usage), SUM(disk_usage) "
+            "FROM system_metrics JOIN interned_strings h ON h.id = hostname_id GROUP BY 1, 2;",
+            suffix, suffix, (int)resolution);
+        if (!execute_query(sql)) {
+            execute_query("ROLLBACK;");
+            return false;
+        }
+        
+        snprintf(sql, sizeof(sql),
+            "DELETE FROM network_metrics_%s;"
+            "INSERT INTO network_metrics_%s (bucket_start, target, sample_count, success_count, "
+            "ping_count, ping_min, ping_max, ping_sum) "
+            "SELECT timestamp - (timestamp %% %d), t.value, COUNT(*), SUM(connection_status != 0), "
+            "COUNT(NULLIF(ping_time >= 0, 0)), "
+            "MIN(CASE WHEN ping_time >= 0 THEN ping_time END), "
+            "MAX(CASE WHEN ping_time >= 0 THEN ping_time END), "
+            "SUM(CASE WHEN ping_time >= 0 THEN ping_time END) "
+            "FROM network_metrics JOIN interned_strings t ON t.id = target_id GROUP BY 1, 2;",
+            suffix, suffix, (int)resolution);
+        if (!execute_query(sql)) {
+            execute_query("ROLLBACK;");
+            return false;
+        }
+    }
     
-    // Count rows first
-    *count = 0;
-    while (sqlite3_step(stmt) == SQLITE_ROW) {
-        (*count)++;
+    if (!finalize_metric_rollups()) {
+        execute_query("ROLLBACK;");
+        return false;
     }
     
-    if (*count == 0) {
-        sqlite3_finalize(stmt);
-        *metrics = NULL;
-        return true;
+    return execute_query("COMMIT;");
+}
+
+// Recomputes every rollup tier from the raw tables (own transaction)
+bool rebuild_metric_rollups(void) {
+    return db_write_exclusive(rebuild_metric_rollups_job, NULL);
+}
+
+static bool cleanup_old_rollups_job(void *arg) {
+    (void)arg;
+    char sql[256];
+    time_t now = time(NULL);
+    
+    for (int i = 0; i < ROLLUP_RESOLUTION_COUNT; i++) {
+        int keep_days = rollup_keep_days(rollup_resolutions[i]);
+        if (keep_days <= 0) {
+            continue;
+        }
+        
+        const char *suffix = rollup_suffix(rollup_resolutions[i]);
+        long long cutoff = (long long)(now - (time_t)keep_days * 24 * 60 * 60);
+        
+        snprintf(sql, sizeof(sql),
+                 "DELETE FROM system_metrics_%s WHERE bucket_start < %lld;"
+                 "DELETE FROM network_metrics_%s WHERE bucket_start < %lld;",
+                 suffix, cutoff, suffix, cutoff);
+        if (!execute_query(sql)) {
+            return false;
+        }
     }
     
-    sqlite3_reset(stmt);
+    return true;
+}
+
+static bool cleanup_old_rollups(void) {
+    return db_write(cleanup_old_rollups_job, NULL);
+}
+
+// Finest resolution whose bucket count over [from, to) stays within max_points
+RollupResolution select_rollup_resolution(time_t from, time_t to, int max_points) {
+    time_t span = to > from ? to - from : 0;
     
-    // Allocate memory
-    *metrics = malloc(sizeof(NetworkMetrics) * (*count));
-    if (!*metrics) {
-        log_error("Memory allocation failed");
-        sqlite3_finalize(stmt);
-        return false;
+    if (max_points <= 0) {
+        max_points = ROLLUP_DEFAULT_MAX_POINTS;
     }
     
-    // Fetch data
-    int i = 0;
-    while (sqlite3_step(stmt) == SQLITE_ROW && i < *count) {
-        (*metrics)[i].id = sqlite3_column_int(stmt, 0);
-        (*metrics)[i].timestamp = sqlite3_column_int64(stmt, 1);
-        strncpy((*metrics)[i].target, (const char*)sqlite3_column_text(stmt, 2), 
-                sizeof((*metrics)[i].target) - 1);
-        (*metrics)[i].target[sizeof((*metrics)[i].target) - 1] = '\0';
-        (*metrics)[i].ping_time = sqlite3_column_int(stmt, 3);
-        (*metrics)[i].connection_status = sqlite3_column_int(stmt, 4);
-        strncpy((*metrics)[i].interface_name, (const char*)sqlite3_column_text(stmt, 5), 
-                sizeof((*metrics)[i].interface_name) - 1);
-        (*metrics)[i].interface_name[sizeof((*metrics)[i].interface_name) - 1] = '\0';
-        i++;
+    for (int i = 0; i < ROLLUP_RESOLUTION_COUNT; i++) {
+        if (span / rollup_resolutions[i] <= max_points) {
+            return rollup_resolutions[i];
+        }
     }
     
-    sqlite3_finalize(stmt);
-    return true;
+    return ROLLUP_1DAY;
 }
 
-// Get security scans history
-bool get_security_scans_history(SecurityScan **scans, int *count, int limit) {
-    const char *sql = "SELECT id, timestamp, scan_type, target, threats_found, severity, description "
-                      "FROM security_scans ORDER BY timestamp DESC LIMIT ?;";
+static MetricAggregate read_aggregate(sqlite3_stmt *stmt, int column, int sample_count) {
+    MetricAggregate aggregate;
+    aggregate.min = sqlite3_column_double(stmt, column);
+    aggregate.max = sqlite3_column_double(stmt, column + 1);
+    aggregate.avg = sample_count > 0 ? sqlite3_column_double(stmt, column + 2) / sample_count : 0;
+    aggregate.p95 = sqlite3_column_type(stmt, column + 3) == SQLITE_NULL
+                    ? aggregate.max : sqlite3_column_double(stmt, column + 3);
+    return aggregate;
+}
+
+static bool read_system_metrics_rollup(sqlite3 *conn, time_t from, time_t to, int max_points,
+                                       SystemMetricsRollup **rows, int *count) {
+    RollupResolution resolution = select_rollup_resolution(from, to, max_points);
+    char sql[512];
+    
+    snprintf(sql, sizeof(sql),
+             "SELECT bucket_start, hostname, sample_count, "
+             "cpu_min, cpu_max, cpu_sum, cpu_p95, "
+             "memory_min, memory_max, memory_sum, memory_p95, "
+             "disk_min, disk_max, disk_sum, disk_p95 "
+             "FROM system_metrics_%s WHERE bucket_start >= ? AND bucket_start < ? "
+             "ORDER BY bucket_start, hostname;",
+             rollup_suffix(resolution));
     
     sqlite3_stmt *stmt;
-    int rc = sqlite3_prepare_v2(db, sql, -1, &stmt, NULL);
-    
-    if (rc != SQLITE_OK) {
-        log_error("Failed to prepare statement: %s", sqlite3_errmsg(db));
+    if (sqlite3_prepare_v2(conn, sql, -1, &stmt, NULL) != SQLITE_OK) {
+        log_error("Failed to prepare statement: %s", sqlite3_errmsg(conn));
         return false;
     }
     
-    sqlite3_bind_int(stmt, 1, limit);
+    sqlite3_bind_int64(stmt, 1, rollup_bucket_start(from, resolution));
+    sqlite3_bind_int64(stmt, 2, to);
     
-    // Count rows first
+    int capacity = 64;
     *count = 0;
+    *rows = malloc(sizeof(SystemMetricsRollup) * capacity);
+    if (!*rows) {
+        log_error("Memory allocation failed");
+        sqlite3_finalize(stmt);
+        return false;
+    }
+    
     while (sqlite3_step(stmt) == SQLITE_ROW) {
+        if (*count == capacity) {
+            capacity *= 2;
+            SystemMetricsRollup *grown = realloc(*rows, sizeof(SystemMetricsRollup) * capacity);
+            if (!grown) {
+                log_error("Memory allocation failed");
+                free(*rows);
+                *rows = NULL;
+                *count = 0;
+                sqlite3_finalize(stmt);
+                return false;
+            }
+            *rows = grown;
+        }
+        
+        SystemMetricsRollup *row = &(*rows)[*count];
+        row->bucket_start = sqlite3_column_int64(stmt, 0);
+        row->resolution = resolution;
+        strncpy(row->hostname, (const char*)sqlite3_column_text(stmt, 1), sizeof(row->hostname) - 1);
+        row->hostname[sizeof(row->hostname) - 1] = '\0';
+        row->sample_count = sqlite3_column_int(stmt, 2);
+        row->cpu = read_aggregate(stmt, 3, row->sample_count);
+        row->memory = read_aggregate(stmt, 7, row->sample_count);
+        row->disk = read_aggregate(stmt, 11, row->sample_count);
         (*count)++;
     }
     
+    sqlite3_finalize(stmt);
+    
     if (*count == 0) {
-        sqlite3_finalize(stmt);
-        *scans = NULL;
-        return true;
+        free(*rows);
+        *rows = NULL;
     }
     
-    sqlite3_reset(stmt);
+    return true;
+}
+
+bool get_system_metrics_rollup(time_t from, time_t to, int max_points,
+                               SystemMetricsRollup **rows, int *count) {
+    sqlite3 *conn = db_acquire_reader();
+    bool ok = read_system_metrics_rollup(conn, from, to, max_points, rows, count);
+    db_release_reader(conn);
+    return ok;
+}
+
+static bool read_network_metrics_rollup(sqlite3 *conn, time_t from, time_t to, int max_points,
+                                        NetworkMetricsRollup **rows, int *count) {
+    RollupResolution resolution = select_rollup_resolution(from, to, max_points);
+    char sql[512];
+    
+    snprintf(sql, sizeof(sql),
+             "SELECT bucket_start, target, sample_count, success_count, ping_count, "
+             "ping_min, ping_max, ping_sum, ping_p95 "
+             "FROM network_metrics_%s WHERE bucket_start >= ? AND bucket_start < ? "
+             "ORDER BY bucket_start, target;",
+             rollup_suffix(resolution));
     
-    // Allocate memory
-    *scans = malloc(sizeof(SecurityScan) * (*count));
-    if (!*scans) {
+    sqlite3_stmt *stmt;
+    if (sqlite3_prepare_v2(conn, sql, -1, &stmt, NULL) != SQLITE_OK) {
+        log_error("Failed to prepare statement: %s", sqlite3_errmsg(conn));
+        return false;
+    }
+    
+    sqlite3_bind_int64(stmt, 1, rollup_bucket_start(from, resolution));
+    sqlite3_bind_int64(stmt, 2, to);
+    
+    int capacity = 64;
+    *count = 0;
+    *rows = malloc(sizeof(NetworkMetricsRollup) * capacity);
+    if (!*rows) {
         log_error("Memory allocation failed");
         sqlite3_finalize(stmt);
         return false;
     }
     
-    // Fetch data
-    int i = 0;
-    while (sqlite3_step(stmt) == SQLITE_ROW && i < *count) {
-        (*scans)[i].id = sqlite3_column_int(stmt, 0);
-        (*scans)[i].timestamp = sqlite3_column_int64(stmt, 1);
-        strncpy((*scans)[i].scan_type, (const char*)sqlite3_column_text(stmt, 2), 
-                sizeof((*scans)[i].scan_type) - 1);
-        (*scans)[i].scan_type[sizeof((*scans)[i].scan_type) - 1] = '\0';
-        strncpy((*scans)[i].target, (const char*)sqlite3_column_text(stmt, 3), 
-                sizeof((*scans)[i].target) - 1);
-        (*scans)[i].target[sizeof((*scans)[i].target) - 1] = '\0';
-        (*scans)[i].threats_found = sqlite3_column_int(stmt, 4);
-        strncpy((*scans)[i].severity, (const char*)sqlite3_column_text(stmt, 5), 
-                sizeof((*scans)[i].severity) - 1);
-        (*scans)[i].severity[sizeof((*scans)[i].severity) - 1] = '\0';
-        strncpy((*scans)[i].description, (const char*)sqlite3_column_text(stmt, 6), 
-                sizeof((*scans)[i].description) - 1);
-        (*scans)[i].description[sizeof((*scans)[i].description) - 1] = '\0';
-        i++;
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        if (*count == capacity) {
+            capacity *= 2;
+            NetworkMetricsRollup *grown = realloc(*rows, sizeof(NetworkMetricsRollup) * capacity);
+            if (!grown) {
+                log_error("Memory allocation failed");
+                free(*rows);
+                *rows = NULL;
+                *count = 0;
+                sqlite3_finalize(stmt);
+                return false;
+            }
+            *rows = grown;
+        }
+        
+        NetworkMetricsRollup *row = &(*rows)[*count];
+        row->bucket_start = sqlite3_column_int64(stmt, 0);
+        row->resolution = resolution;
+        strncpy(row->target, (const char*)sqlite3_column_text(stmt, 1), sizeof(row->target) - 1);
+        row->target[sizeof(row->target) - 1] = '\0';
+        row->sample_count = sqlite3_column_int(stmt, 2);
+        row->success_count = sqlite3_column_int(stmt, 3);
+        row->ping_count = sqlite3_column_int(stmt, 4);
+        row->ping = read_aggregate(stmt, 5, row->ping_count);
+        (*count)++;
     }
     
     sqlite3_finalize(stmt);
+    
+    if (*count == 0) {
+        free(*rows);
+        *rows = NULL;
+    }
+    
     return true;
-}
\ No newline at end of file
+}
+
+bool get_network_metrics_rollup(time_t from, time_t to, int max_points,
+                                NetworkMetricsRollup **rows, int *count) {
+    sqlite3 *conn = db_acquire_reader();
+    bool ok = read_network_metrics_rollup(conn, from, to, max_points, rows, count);
+    db_release_reader(conn);
+    return ok;
+}
@@ -0,0 +1,464 @@
+/*
+ * ========================================
+ * Database Export Implementation - Akışlı Veri Dışa Aktarma
+ * ========================================
+ *
+ * Rows are read straight off a SQLite cursor on a pooled reader and
+ * encoded into a single fixed-size buffer that is handed to a sink (file,
+ * HTTP socket) whenever it fills up. Nothing is collected per row, so an
+ * export of millions of rows needs the same memory as one of ten.
+ */
+
+#include "../../include/database_export.h"
+#include "../../include/db_pool.h"
+#include "../../include/logger.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <math.h>
+
+typedef struct {
+    const char *name;
+    const char *time_column;
+    const char *select_sql;             // every column the export writes, in order
+} ExportTableInfo;
+
+static const ExportTableInfo export_tables[EXPORT_TABLE_COUNT] = {
+    { "system_metrics", "m.timestamp",
+      "SELECT m.id, m.timestamp, h.value AS hostname, m.cpu_usage, m.memory_usage, m.disk_usage "
+      "FROM system_metrics m JOIN interned_strings h ON h.id = m.hostname_id" },
+    { "file_operations", "f.timestamp",
+      "SELECT f.id, f.timestamp, o.value AS operation, f.file_path, f.file_size, s.value AS status "
+      "FROM file_operations f JOIN interned_strings o ON o.id = f.operation_id "
+      "JOIN interned_strings s ON s.id = f.status_id" },
+    { "network_metrics", "n.timestamp",
+      "SELECT n.id, n.timestamp, t.value AS target, n.ping_time, n.connection_status, "
+      "i.value AS interface_name "
+      "FROM network_metrics n JOIN interned_strings t ON t.id = n.target_id "
+      "LEFT JOIN interned_strings i ON i.id = n.interface_name_id" },
+    { "security_scans", "s.timestamp",
+      "SELECT s.id, s.timestamp, st.value AS scan_type, s.target, s.threats_found, "
+      "sv.value AS severity, s.description "
+      "FROM security_scans s JOIN interned_strings st ON st.id = s.scan_type_id "
+      "JOIN interned_strings sv ON sv.id = s.severity_id" },
+    { "scheduled_tasks", "next_run",
+      "SELECT id, task_name, command, schedule, next_run, last_run, enabled, status "
+      "FROM scheduled_tasks" }
+};
+
+// ========================================
+// Output buffer
+// ========================================
+
+typedef struct {
+    char *data;
+    size_t used;
+    ExportSink sink;
+    void *user_data;
+    bool failed;
+} ExportBuffer;
+
+static void buffer_flush(ExportBuffer *buffer) {
+    if (buffer->used > 0 && !buffer->failed) {
+        buffer->failed = !buffer->sink(buffer->data, buffer->used, buffer->user_data);
+    }
+    buffer->used = 0;
+}
+
+static void buffer_write(ExportBuffer *buffer, const void *data, size_t size) {
+    if (buffer->used + size > DB_EXPORT_BUFFER_SIZE) {
+        buffer_flush(buffer);
+    }
+
+    // Values larger than the whole buffer go to the sink directly
+    if (size > DB_EXPORT_BUFFER_SIZE) {
+        if (!buffer->failed) {
+            buffer->failed = !buffer->sink(data, size, buffer->user_data);
+        }
+        return;
+    }
+
+    memcpy(buffer->data + buffer->used, data, size);
+    buffer->used += size;
+}
+
+static void buffer_puts(ExportBuffer *buffer, const char *text) {
+    buffer_write(buffer, text, strlen(text));
+}
+
+static void buffer_put_u8(ExportBuffer *buffer, uint8_t value) {
+    buffer_write(buffer, &value, 1);
+}
+
+static void buffer_put_u16(ExportBuffer *buffer, uint16_t value) {
+    uint8_t bytes[2] = { (uint8_t)value, (uint8_t)(value >> 8) };
+    buffer_write(buffer, bytes, 2);
+}
+
+static void buffer_put_u32(ExportBuffer *buffer, uint32_t value) {
+    uint8_t bytes[4];
+    for (int i = 0; i < 4; i++) {
+        bytes[i] = (uint8_t)(value >> (8 * i));
+    }
+    buffer_write(buffer, bytes, 4);
+}
+
+static void buffer_put_u64(ExportBuffer *buffer, uint64_t value) {
+    uint8_t bytes[8];
+    for (int i = 0; i < 8; i++) {
+        bytes[i] = (uint8_t)(value >> (8 * i));
+    }
+    buffer_write(buffer, bytes, 8);
+}
+
+// ========================================
+// Value encoders
+// ========================================
+
+// Shortest of %.15g / %.17g that reads back as the same double
+static void format_double(double value, char *text, size_t size) {
+    snprintf(text, size, "%.15g", value);
+    if (strtod(text, NULL) != value) {
+        snprintf(text, size, "%.17g", value);
+    }
+}
+
+static void write_csv_text(ExportBuffer *buffer, const char *text, int length) {
+    if (strcspn(text, ",\"\r\n") == (size_t)length) {
+        buffer_write(buffer, text, length);
+        return;
+    }
+
+    buffer_put_u8(buffer, '"');
+    const char *start = text;
+    for (const char *p = text; p < text + length; p++) {
+        if (*p == '"') {
+            buffer_write(buffer, start, p - start + 1);
+            start = p; // the quote is written twice
+        }
+    }
+    buffer_write(buffer, start, text + length - start);
+    buffer_put_u8(buffer, '"');
+}
+
+static void write_json_text(ExportBuffer *buffer, const char *text, int length) {
+    buffer_put_u8(buffer, '"');
+    const char *start = text;
+    for (const char *p = text; p < text + length; p++) {
+        unsigned char c = (unsigned char)*p;
+        if (c != '"' && c != '\\' && c >= 0x20) {
+            continue;
+        }
+
+        buffer_write(buffer, start, p - start);
+        char escape[8];
+        switch (c) {
+            case '"':  strcpy(escape, "\\\""); break;
+            case '\\': strcpy(escape, "\\\\"); break;
+            case '\n': strcpy(escape, "\\n"); break;
+            case '\r': strcpy(escape, "\\r"); break;
+            case '\t': strcpy(escape, "\\t"); break;
+            default:   snprintf(escape, sizeof(escape), "\\u%04x", c); break;
+        }
+        buffer_puts(buffer, escape);
+        start = p + 1;
+    }
+    buffer_write(buffer, start, text + length - start);
+    buffer_put_u8(buffer, '"');
+}
+
+static void write_text_value(ExportBuffer *buffer, sqlite3_stmt *stmt, int column, ExportFormat format) {
+    char number[32];
+
+    switch (sqlite3_column_type(stmt, column)) {
+        case SQLITE_NULL:
+            if (format == EXPORT_FORMAT_NDJSON) {
+                buffer_puts(buffer, "null");
+            }
+            break;
+        case SQLITE_INTEGER:
+            snprintf(number, sizeof(number), "%lld", (long long)sqlite3_column_int64(stmt, column));
+            buffer_puts(buffer, number);
+            break;
+        case SQLITE_FLOAT: {
+            double value = sqlite3_column_double(stmt, column);
+            if (format == EXPORT_FORMAT_NDJSON && !isfinite(value)) {
+                buffer_puts(buffer, "null");
+                break;
+            }
+            format_double(value, number, sizeof(number));
+            buffer_puts(buffer, number);
+            break;
+        }
+        default: {
+            const char *text = (const char*)sqlite3_column_text(stmt, column);
+            int length = sqlite3_column_bytes(stmt, column);
+            if (format == EXPORT_FORMAT_CSV) {
+                write_csv_text(buffer, text, length);
+            } else {
+                write_json_text(buffer, text, length);
+            }
+            break;
+        }
+    }
+}
+
+// ========================================
+// Row writers
+// ========================================
+
+static void write_header(ExportBuffer *buffer, sqlite3_stmt *stmt, ExportFormat format) {
+    int columns = sqlite3_column_count(stmt);
+
+    if (format == EXPORT_FORMAT_CSV) {
+        for (int i = 0; i < columns; i++) {
+            if (i > 0) {
+                buffer_put_u8(buffer, ',');
+            }
+            buffer_puts(buffer, sqlite3_column_name(stmt, i));
+        }
+        buffer_puts(buffer, "\r\n");
+    } else if (format == EXPORT_FORMAT_BINARY) {
+        buffer_write(buffer, DB_EXPORT_BINARY_MAGIC, 8);
+        buffer_put_u16(buffer, (uint16_t)columns);
+        for (int i = 0; i < columns; i++) {
+            const char *name = sqlite3_column_name(stmt, i);
+            buffer_put_u16(buffer, (uint16_t)strlen(name));
+            buffer_puts(buffer, name);
+        }
+    }
+}
+
+static void write_row(ExportBuffer *buffer, sqlite3_stmt *stmt, ExportFormat format) {
+    int columns = sqlite3_column_count(stmt);
+
+    if (format == EXPORT_FORMAT_CSV) {
+        for (int i = 0; i < columns; i++) {
+            if (i > 0) {
+                buffer_put_u8(buffer, ',');
+            }
+            write_text_value(buffer, stmt, i, format);
+        }
+        buffer_puts(buffer, "\r\n");
+        return;
+    }
+
+    if (format == EXPORT_FORMAT_NDJSON) {
+        for (int i = 0; i < columns; i++) {
+            buffer_puts(buffer, i == 0 ? "{\"" : ",\"");
+            buffer_puts(buffer, sqlite3_column_name(stmt, i));
+            buffer_puts(buffer, "\":");
+            write_text_value(buffer, stmt, i, format);
+        }
+        buffer_puts(buffer, "}\n");
+        return;
+    }
+
+    // Binary: the payload length is known before any value is written
+    uint32_t length = 0;
+    for (int i = 0; i < columns; i++) {
+        switch (sqlite3_column_type(stmt, i)) {
+            case SQLITE_NULL:    length += 1; break;
+            case SQLITE_INTEGER:
+            case SQLITE_FLOAT:   length += 1 + 8; break;
+            default:             length += 1 + 4 + (uint32_t)sqlite3_column_bytes(stmt, i); break;
+        }
+    }
+    buffer_put_u32(buffer, length);
+
+    for (int i = 0; i < columns; i++) {
+        switch (sqlite3_column_type(stmt, i)) {
+            case SQLITE_NULL:
+                buffer_put_u8(buffer, 0);
+                break;
+            case SQLITE_INTEGER:
+                buffer_put_u8(buffer, 1);
+                buffer_put_u64(buffer, (uint64_t)sqlite3_column_int64(stmt, i));
+                break;
+            case SQLITE_FLOAT: {
+                double value = sqlite3_column_double(stmt, i);
+                uint64_t bits;
+                memcpy(&bits, &value, sizeof(bits));
+                buffer_put_u8(buffer, 2);
+                buffer_put_u64(buffer, bits);
+                break;
+            }
+            default: {
+                const char *text = (const char*)sqlite3_column_text(stmt, i);
+                uint32_t size = (uint32_t)sqlite3_column_bytes(stmt, i);
+                buffer_put_u8(buffer, 3);
+                buffer_put_u32(buffer, size);
+                buffer_write(buffer, text, size);
+                break;
+            }
+        }
+    }
+}
+
+// ========================================
+// Export
+// ========================================
+
+bool export_table(ExportTable table, ExportFormat format, time_t from, time_t to,
+                  ExportSink sink, void *user_data, long long *rows) {
+    if (rows) {
+        *rows = 0;
+    }
+    if (!db || table < 0 || table >= EXPORT_TABLE_COUNT || !sink) {
+        return false;
+    }
+
+    const ExportTableInfo *info = &export_tables[table];
+    bool ranged = from > 0 || to > 0;
+    char sql[1024];
+
+    if (ranged) {
+        snprintf(sql, sizeof(sql), "%s WHERE %s >= ? AND %s < ? ORDER BY %s;",
+                 info->select_sql, info->time_column, info->time_column, info->time_column);
+    } else {
+        snprintf(sql, sizeof(sql), "%s ORDER BY 1;", info->select_sql);
+    }
+
+    ExportBuffer buffer = { NULL, 0, sink, user_data, false };
+    buffer.data = malloc(DB_EXPORT_BUFFER_SIZE);
+    if (!buffer.data) {
+        log_error("Memory allocation failed");
+        return false;
+    }
+
+    sqlite3 *conn = db_acquire_reader();
+    sqlite3_stmt *stmt;
+
+    if (sqlite3_prepare_v2(conn, sql, -1, &stmt, NULL) != SQLITE_OK) {
+        log_error("Failed to prepare statement: %s", sqlite3_errmsg(conn));
+        db_release_reader(conn);
+        free(buffer.data);
+        return false;
+    }
+
+    if (ranged) {
+        sqlite3_bind_int64(stmt, 1, from > 0 ? (sqlite3_int64)from : LLONG_MIN);
+        sqlite3_bind_int64(stmt, 2, to > 0 ? (sqlite3_int64)to : LLONG_MAX);
+    }
+
+    write_header(&buffer, stmt, format);
+
+    long long count = 0;
+    int rc = SQLITE_DONE;
+    while (!buffer.failed && (rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+        write_row(&buffer, stmt, format);
+        count++;
+    }
+
+    bool ok = !buffer.failed && rc == SQLITE_DONE;
+    if (!buffer.failed && rc != SQLITE_DONE) {
+        log_error("Export query failed: %s", sqlite3_errmsg(conn));
+    }
+
+    sqlite3_finalize(stmt);
+    db_release_reader(conn);
+
+    if (ok && format == EXPORT_FORMAT_BINARY) {
+        buffer_put_u32(&buffer, 0);
+    }
+    buffer_flush(&buffer);
+    ok = ok && !buffer.failed;
+
+    free(buffer.data);
+
+    if (rows) {
+        *rows = count;
+    }
+    return ok;
+}
+
+static bool file_sink(const void *data, size_t size, void *user_data) {
+    return fwrite(data, 1, size, (FILE*)user_data) == size;
+}
+
+bool export_table_to_file(ExportTable table, ExportFormat format, time_t from, time_t to,
+                          const char *path, long long *rows) {
+    char temp_path[1024];
+    snprintf(temp_path, sizeof(temp_path), "%s.tmp", path);
+
+    FILE *output = fopen(temp_path, "wb");
+    if (!output) {
+        log_error("Cannot create file: %s", temp_path);
+        return false;
+    }
+
+    long long count = 0;
+    bool ok = export_table(table, format, from, to, file_sink, output, &count);
+    if (fclose(output) != 0) {
+        ok = false;
+    }
+
+    if (ok) {
+        remove(path);
+        ok = rename(temp_path, path) == 0;
+    }
+
+    if (!ok) {
+        remove(temp_path);
+        log_error("Export of %s failed", export_table_name(table));
+        return false;
+    }
+
+    if (rows) {
+        *rows = count;
+    }
+    log_info("Exported %lld rows from %s to %s", count, export_table_name(table), path);
+    return true;
+}
+
+// ========================================
+// Names
+// ========================================
+
+bool export_table_from_name(const char *name, ExportTable *table) {
+    for (int i = 0; i < EXPORT_TABLE_COUNT; i++) {
+        if (name && strcmp(name, export_tables[i].name) == 0) {
+            *table = (ExportTable)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool export_format_from_name(const char *name, ExportFormat *format) {
+    if (!name) {
+        return false;
+    }
+    if (strcmp(name, "csv") == 0) {
+        *format = EXPORT_FORMAT_CSV;
+    } else if (strcmp(name, "ndjson") == 0 || strcmp(name, "json") == 0) {
+        *format = EXPORT_FORMAT_NDJSON;
+    } else if (strcmp(name, "binary") == 0 || strcmp(name, "bin") == 0) {
+        *format = EXPORT_FORMAT_BINARY;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* export_table_name(ExportTable table) {
+    return table >= 0 && table < EXPORT_TABLE_COUNT ? export_tables[table].name : "unknown";
+}
+
+const char* export_format_extension(ExportFormat format) {
+    switch (format) {
+        case EXPORT_FORMAT_CSV:    return "csv";
+        case EXPORT_FORMAT_NDJSON: return "ndjson";
+        default:                   return "bin";
+    }
+}
+
+const char* export_format_content_type(ExportFormat format) {
+    switch (format) {
+        case EXPORT_FORMAT_CSV:    return "text/csv";
+        case EXPORT_FORMAT_NDJSON: return "application/x-ndjson";
+        default:                   return "application/octet-stream";
+    }
+}
@@ -0,0 +1,320 @@
+/*
+ * ========================================
+ * Database Pool Implementation - Okuyucu Havuzu ve Tek Yazıcı Kuyruğu
+ * ========================================
+ *
+ * SQLite allows one writer at a time. Instead of letting every thread
+ * write through the shared connection and fight over the lock, writes are
+ * queued and executed by a single writer thread that owns the global db
+ * connection. Jobs that arrive while a transaction is being committed are
+ * picked up together in the next one (group commit).
+ *
+ * Reads never touch the writer connection. Each reader is a read-only
+ * connection; in WAL mode it sees the last committed snapshot and is not
+ * blocked by the writer.
+ */
+
+#include "../../include/db_pool.h"
+#include "../../include/string_dictionary.h"
+#include "../../include/logger.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+// ========================================
+// Reader pool
+// ========================================
+
+typedef struct {
+    sqlite3 *conn;
+    bool in_use;
+    int depth;          // nested acquires on the owning thread
+} ReaderSlot;
+
+static ReaderSlot *readers = NULL;
+static int reader_count = 0;
+static pthread_mutex_t reader_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t reader_available = PTHREAD_COND_INITIALIZER;
+static pthread_key_t reader_key;
+static bool reader_key_created = false;
+
+static bool open_readers(const char *database_path, int count) {
+    readers = calloc(count, sizeof(ReaderSlot));
+    if (!readers) {
+        log_error("Memory allocation failed");
+        return false;
+    }
+
+    for (int i = 0; i < count; i++) {
+        int flags = SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX;
+        if (sqlite3_open_v2(database_path, &readers[i].conn, flags, NULL) != SQLITE_OK) {
+            log_error("Cannot open reader connection: %s", sqlite3_errmsg(readers[i].conn));
+            sqlite3_close(readers[i].conn);
+            readers[i].conn = NULL;
+            return false;
+        }
+        sqlite3_busy_timeout(readers[i].conn, DATABASE_BUSY_TIMEOUT_MS);
+        reader_count++;
+    }
+
+    return true;
+}
+
+static void close_readers(void) {
+    pthread_mutex_lock(&reader_mutex);
+    for (int i = 0; i < reader_count; i++) {
+        // Wait for readers still in use by other threads
+        while (readers[i].in_use) {
+            pthread_cond_wait(&reader_available, &reader_mutex);
+        }
+        sqlite3_close(readers[i].conn);
+    }
+    free(readers);
+    readers = NULL;
+    reader_count = 0;
+    pthread_mutex_unlock(&reader_mutex);
+}
+
+sqlite3* db_acquire_reader(void) {
+    if (reader_count == 0) {
+        return db;
+    }
+
+    ReaderSlot *slot = pthread_getspecific(reader_key);
+    if (slot) {
+        slot->depth++;
+        return slot->conn;
+    }
+
+    pthread_mutex_lock(&reader_mutex);
+    for (;;) {
+        for (int i = 0; i < reader_count; i++) {
+            if (!readers[i].in_use) {
+                slot = &readers[i];
+                break;
+            }
+        }
+        if (slot) {
+            break;
+        }
+        pthread_cond_wait(&reader_available, &reader_mutex);
+    }
+    slot->in_use = true;
+    slot->depth = 1;
+    pthread_mutex_unlock(&reader_mutex);
+
+    pthread_setspecific(reader_key, slot);
+    return slot->conn;
+}
+
+void db_release_reader(sqlite3 *conn) {
+    if (reader_count == 0 || conn == db) {
+        return;
+    }
+
+    ReaderSlot *slot = pthread_getspecific(reader_key);
+    if (!slot || slot->conn != conn || --slot->depth > 0) {
+        return;
+    }
+
+    pthread_setspecific(reader_key, NULL);
+
+    pthread_mutex_lock(&reader_mutex);
+    slot->in_use = false;
+    pthread_cond_broadcast(&reader_available);
+    pthread_mutex_unlock(&reader_mutex);
+}
+
+// ========================================
+// Writer queue
+// ========================================
+
+typedef struct WriteJob {
+    DatabaseWriteFn fn;
+    void *arg;
+    bool exclusive;
+    bool done;
+    bool result;
+    struct WriteJob *next;
+} WriteJob;
+
+static WriteJob *queue_head = NULL;
+static WriteJob *queue_tail = NULL;
+static pthread_mutex_t queue_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t queue_not_empty = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t job_finished = PTHREAD_COND_INITIALIZER;
+static pthread_t writer_thread;
+static bool writer_running = false;
+static bool writer_stopping = false;
+
+static bool run_in_savepoint(WriteJob *job) {
+    if (!execute_query("SAVEPOINT write_job;")) {
+        return false;
+    }
+
+    if (job->fn(job->arg)) {
+        return execute_query("RELEASE write_job;");
+    }
+
+    // Savepoint rollbacks do not fire the rollback hook
+    execute_query("ROLLBACK TO write_job; RELEASE write_job;");
+    clear_string_cache();
+    return false;
+}
+
+static void run_batch(WriteJob *first, int count) {
+    WriteJob *job = first;
+
+    if (!execute_query("BEGIN IMMEDIATE;")) {
+        for (int i = 0; i < count; i++, job = job->next) {
+            job->result = false;
+        }
+        return;
+    }
+
+    for (int i = 0; i < count; i++, job = job->next) {
+        job->result = run_in_savepoint(job);
+    }
+
+    if (!execute_query("COMMIT;")) {
+        execute_query("ROLLBACK;");
+        for (job = first; count-- > 0; job = job->next) {
+            job->result = false;
+        }
+    }
+}
+
+static void* writer_main(void *arg) {
+    (void)arg;
+
+    pthread_mutex_lock(&queue_mutex);
+    for (;;) {
+        while (!queue_head && !writer_stopping) {
+            pthread_cond_wait(&queue_not_empty, &queue_mutex);
+        }
+        if (!queue_head) {
+            break; // stopping and drained
+        }
+
+        // Take either one exclusive job or a run of ordinary ones
+        WriteJob *first = queue_head;
+        WriteJob *last = first;
+        int count = 1;
+
+        if (!first->exclusive) {
+            while (last->next && !last->next->exclusive && count < DB_WRITE_BATCH_MAX) {
+                last = last->next;
+                count++;
+            }
+        }
+
+        queue_head = last->next;
+        if (!queue_head) {
+            queue_tail = NULL;
+        }
+        pthread_mutex_unlock(&queue_mutex);
+
+        if (first->exclusive) {
+            first->result = first->fn(first->arg);
+        } else {
+            run_batch(first, count);
+        }
+
+        pthread_mutex_lock(&queue_mutex);
+        WriteJob *job = first;
+        for (int i = 0; i < count; i++) {
+            WriteJob *next = job->next;
+            job->done = true;
+            job = next;
+        }
+        pthread_cond_broadcast(&job_finished);
+    }
+    pthread_mutex_unlock(&queue_mutex);
+
+    return NULL;
+}
+
+static bool submit_write(DatabaseWriteFn fn, void *arg, bool exclusive) {
+    // Before the writer starts, and for jobs issued by a running job
+    if (!writer_running || pthread_equal(pthread_self(), writer_thread)) {
+        return fn(arg);
+    }
+
+    // The job lives on the caller's stack until the writer marks it done
+    WriteJob job = { fn, arg, exclusive, false, false, NULL };
+
+    pthread_mutex_lock(&queue_mutex);
+    if (queue_tail) {
+        queue_tail->next = &job;
+    } else {
+        queue_head = &job;
+    }
+    queue_tail = &job;
+    pthread_cond_signal(&queue_not_empty);
+
+    while (!job.done) {
+        pthread_cond_wait(&job_finished, &queue_mutex);
+    }
+    pthread_mutex_unlock(&queue_mutex);
+
+    return job.result;
+}
+
+bool db_write(DatabaseWriteFn fn, void *arg) {
+    return submit_write(fn, arg, false);
+}
+
+bool db_write_exclusive(DatabaseWriteFn fn, void *arg) {
+    return submit_write(fn, arg, true);
+}
+
+// ========================================
+// Lifecycle
+// ========================================
+
+bool db_pool_init(const char *database_path, int count) {
+    if (writer_running || reader_count > 0) {
+        return true;
+    }
+
+    if (!reader_key_created) {
+        if (pthread_key_create(&reader_key, NULL) != 0) {
+            log_error("Failed to create reader key");
+            return false;
+        }
+        reader_key_created = true;
+    }
+
+    if (count > 0 && !open_readers(database_path, count)) {
+        close_readers();
+        return false;
+    }
+
+    writer_stopping = false;
+    if (pthread_create(&writer_thread, NULL, writer_main, NULL) != 0) {
+        log_error("Failed to start database writer thread");
+        close_readers();
+        return false;
+    }
+    writer_running = true;
+
+    log_info("Database pool started: 1 writer, %d readers", reader_count);
+    return true;
+}
+
+void db_pool_shutdown(void) {
+    if (writer_running) {
+        pthread_mutex_lock(&queue_mutex);
+        writer_stopping = true;
+        pthread_cond_signal(&queue_not_empty);
+        pthread_mutex_unlock(&queue_mutex);
+
+        pthread_join(writer_thread, NULL);
+        writer_running = false;
+    }
+
+    if (reader_count > 0) {
+        close_readers();
+    }
+}
@@ -0,0 +1,479 @@
+/*
+ * ========================================
+ * File Compress Implementation - Dosya Sıkıştırma
+ * ========================================
+ *
+ * Chunked LZ77 file codec shared by the database snapshots and the
+ * logger's rotated segments. Each chunk is checksummed on its own and
+ * the trailer carries a checksum of the whole input, so a damaged file
+ * is rejected before anything is written over the target.
+ *
+ * File layout (little-endian):
+ *   header  : "SACSNAP1" | u32 version | u64 raw size
+ *   chunk   : u32 raw size | u32 stored size | u32 CRC-32 | u8 method | data
+ *   trailer : "SACSEND1" | u32 chunk count | u32 CRC-32 of all raw bytes
+ * Chunks are LZ77 compressed (LZ4-style sequences) or stored as-is when
+ * compression does not help.
+ */
+
+#include "../../include/file_compress.h"
+#include "../../include/logger.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define COMPRESSED_MAGIC "SACSNAP1"
+#define COMPRESSED_END_MAGIC "SACSEND1"
+#define COMPRESSED_VERSION 1
+
+#define CHUNK_STORED 0
+#define CHUNK_LZ 1
+
+#define LZ_MIN_MATCH 4
+#define LZ_MAX_OFFSET 65535
+#define LZ_HASH_BITS 14
+
+// ========================================
+// CRC-32 (IEEE 802.3)
+// ========================================
+
+static uint32_t crc_table[256];
+static bool crc_table_ready = false;
+
+static uint32_t crc32_update(uint32_t crc, const uint8_t *data, size_t size) {
+    if (!crc_table_ready) {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            crc_table[i] = c;
+        }
+        crc_table_ready = true;
+    }
+
+    crc = ~crc;
+    for (size_t i = 0; i < size; i++) {
+        crc = crc_table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+// ========================================
+// LZ77 block codec
+// ========================================
+
+static uint32_t read_u32_le(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void write_u32_le(uint8_t *p, uint32_t value) {
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    p[2] = (uint8_t)(value >> 16);
+    p[3] = (uint8_t)(value >> 24);
+}
+
+// Appends a length continuation (runs of 255 followed by the remainder)
+static bool lz_put_length(uint8_t *dst, size_t capacity, size_t *op, size_t length) {
+    while (length >= 255) {
+        if (*op >= capacity) {
+            return false;
+        }
+        dst[(*op)++] = 255;
+        length -= 255;
+    }
+    if (*op >= capacity) {
+        return false;
+    }
+    dst[(*op)++] = (uint8_t)length;
+    return true;
+}
+
+static bool lz_put_sequence(uint8_t *dst, size_t capacity, size_t *op,
+                            const uint8_t *literals, size_t literal_length,
+                            size_t offset, size_t match_length) {
+    if (*op >= capacity) {
+        return false;
+    }
+
+    size_t token_pos = (*op)++;
+    uint8_t token = (uint8_t)((literal_length >= 15 ? 15 : literal_length) << 4);
+
+    if (literal_length >= 15 && !lz_put_length(dst, capacity, op, literal_length - 15)) {
+        return false;
+    }
+    if (literal_length > capacity - *op) {
+        return false;
+    }
+    memcpy(dst + *op, literals, literal_length);
+    *op += literal_length;
+
+    if (match_length > 0) {
+        size_t code = match_length - LZ_MIN_MATCH;
+        token |= (uint8_t)(code >= 15 ? 15 : code);
+
+        if (capacity - *op < 2) {
+            return false;
+        }
+        dst[(*op)++] = (uint8_t)offset;
+        dst[(*op)++] = (uint8_t)(offset >> 8);
+
+        if (code >= 15 && !lz_put_length(dst, capacity, op, code - 15)) {
+            return false;
+        }
+    }
+
+    dst[token_pos] = token;
+    return true;
+}
+
+// Returns the compressed size, or 0 if the output would not fit
+static size_t lz_compress(const uint8_t *src, size_t size, uint8_t *dst, size_t capacity) {
+    uint32_t table[1 << LZ_HASH_BITS];
+    size_t ip = 0, anchor = 0, op = 0;
+
+    memset(table, 0, sizeof(table));
+
+    while (size >= LZ_MIN_MATCH && ip <= size - LZ_MIN_MATCH) {
+        uint32_t sequence = read_u32_le(src + ip);
+        uint32_t hash = (sequence * 2654435761u) >> (32 - LZ_HASH_BITS);
+        size_t candidate = table[hash];
+        table[hash] = (uint32_t)(ip + 1);
+
+        if (candidate == 0 || ip - (candidate - 1) > LZ_MAX_OFFSET ||
+            read_u32_le(src + candidate - 1) != sequence) {
+            ip++;
+            continue;
+        }
+
+        size_t match = candidate - 1;
+        size_t length = LZ_MIN_MATCH;
+        while (ip + length < size && src[match + length] == src[ip + length]) {
+            length++;
+        }
+
+        if (!lz_put_sequence(dst, capacity, &op, src + anchor, ip - anchor, ip - match, length)) {
+            return 0;
+        }
+
+        ip += length;
+        anchor = ip;
+    }
+
+    // Trailing literals end the block
+    if (!lz_put_sequence(dst, capacity, &op, src + anchor, size - anchor, 0, 0)) {
+        return 0;
+    }
+
+    return op;
+}
+
+static bool lz_get_length(const uint8_t *src, size_t size, size_t *ip, size_t *length) {
+    uint8_t byte;
+    do {
+        if (*ip >= size) {
+            return false;
+        }
+        byte = src[(*ip)++];
+        *length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+static bool lz_decompress(const uint8_t *src, size_t size, uint8_t *dst, size_t output_size) {
+    size_t ip = 0, op = 0;
+
+    while (ip < size) {
+        uint8_t token = src[ip++];
+        size_t literal_length = token >> 4;
+
+        if (literal_length == 15 && !lz_get_length(src, size, &ip, &literal_length)) {
+            return false;
+        }
+        if (literal_length > size - ip || literal_length > output_size - op) {
+            return false;
+        }
+        memcpy(dst + op, src + ip, literal_length);
+        ip += literal_length;
+        op += literal_length;
+
+        if (ip == size) {
+            break;
+        }
+
+        if (size - ip < 2) {
+            return false;
+        }
+        size_t offset = (size_t)src[ip] | ((size_t)src[ip + 1] << 8);
+        ip += 2;
+
+        size_t match_length = token & 0x0F;
+        if (match_length == 15 && !lz_get_length(src, size, &ip, &match_length)) {
+            return false;
+        }
+        match_length += LZ_MIN_MATCH;
+
+        if (offset == 0 || offset > op || match_length > output_size - op) {
+            return false;
+        }
+
+        // Byte copy: matches may overlap their own output
+        for (size_t i = 0; i < match_length; i++) {
+            dst[op + i] = dst[op - offset + i];
+        }
+        op += match_length;
+    }
+
+    return op == output_size;
+}
+
+// ========================================
+// Compressed files
+// ========================================
+
+bool compress_file(const char *input_path, const char *output_path, CompressedFileInfo *info) {
+    FILE *input = fopen(input_path, "rb");
+    if (!input) {
+        log_error("Cannot open file: %s", input_path);
+        return false;
+    }
+
+    fseek(input, 0, SEEK_END);
+    long long raw_size = ftell(input);
+    fseek(input, 0, SEEK_SET);
+
+    FILE *output = fopen(output_path, "wb");
+    if (!output) {
+        log_error("Cannot create compressed file: %s", output_path);
+        fclose(input);
+        return false;
+    }
+
+    size_t capacity = COMPRESSED_CHUNK_SIZE + COMPRESSED_CHUNK_SIZE / 255 + 16;
+    uint8_t *raw = malloc(COMPRESSED_CHUNK_SIZE);
+    uint8_t *packed = malloc(capacity);
+    if (!raw || !packed) {
+        free(raw);
+        free(packed);
+        fclose(input);
+        fclose(output);
+        return false;
+    }
+
+    uint8_t header[20];
+    memcpy(header, COMPRESSED_MAGIC, 8);
+    write_u32_le(header + 8, COMPRESSED_VERSION);
+    write_u32_le(header + 12, (uint32_t)raw_size);
+    write_u32_le(header + 16, (uint32_t)((unsigned long long)raw_size >> 32));
+
+    bool ok = fwrite(header, 1, sizeof(header), output) == sizeof(header);
+    long long stored_bytes = sizeof(header);
+    uint32_t total_crc = 0;
+    int chunk_count = 0;
+    size_t n;
+
+    while (ok && (n = fread(raw, 1, COMPRESSED_CHUNK_SIZE, input)) > 0) {
+        uint32_t crc = crc32_update(0, raw, n);
+        total_crc = crc32_update(total_crc, raw, n);
+
+        size_t packed_size = lz_compress(raw, n, packed, capacity);
+        uint8_t method = CHUNK_LZ;
+        const uint8_t *payload = packed;
+
+        if (packed_size == 0 || packed_size >= n) {
+            method = CHUNK_STORED;
+            payload = raw;
+            packed_size = n;
+        }
+
+        uint8_t chunk_header[13];
+        write_u32_le(chunk_header, (uint32_t)n);
+        write_u32_le(chunk_header + 4, (uint32_t)packed_size);
+        write_u32_le(chunk_header + 8, crc);
+        chunk_header[12] = method;
+
+        ok = fwrite(chunk_header, 1, sizeof(chunk_header), output) == sizeof(chunk_header) &&
+             fwrite(payload, 1, packed_size, output) == packed_size;
+
+        stored_bytes += sizeof(chunk_header) + packed_size;
+        chunk_count++;
+    }
+
+    if (ok && ferror(input)) {
+        ok = false;
+    }
+
+    if (ok) {
+        uint8_t trailer[16];
+        memcpy(trailer, COMPRESSED_END_MAGIC, 8);
+        write_u32_le(trailer + 8, (uint32_t)chunk_count);
+        write_u32_le(trailer + 12, total_crc);
+        ok = fwrite(trailer, 1, sizeof(trailer), output) == sizeof(trailer);
+        stored_bytes += sizeof(trailer);
+    }
+
+    free(raw);
+    free(packed);
+    fclose(input);
+    if (fclose(output) != 0) {
+        ok = false;
+    }
+
+    if (!ok) {
+        log_error("Failed to write compressed file: %s", output_path);
+        remove(output_path);
+        return false;
+    }
+
+    if (info) {
+        info->raw_bytes = raw_size;
+        info->stored_bytes = stored_bytes;
+        info->chunk_count = chunk_count;
+        info->checksum = total_crc;
+    }
+
+    return true;
+}
+
+// Walks every chunk, checking sizes and checksums; decoded data goes to
+// output when it is not NULL
+static bool read_compressed_file(const char *path, FILE *output, CompressedFileInfo *info) {
+    FILE *input = fopen(path, "rb");
+    if (!input) {
+        log_error("Cannot open compressed file: %s", path);
+        return false;
+    }
+
+    uint8_t header[20];
+    if (fread(header, 1, sizeof(header), input) != sizeof(header) ||
+        memcmp(header, COMPRESSED_MAGIC, 8) != 0 || read_u32_le(header + 8) != COMPRESSED_VERSION) {
+        log_error("Not a compressed file: %s", path);
+        fclose(input);
+        return false;
+    }
+
+    long long raw_size = (long long)read_u32_le(header + 12) |
+                         ((long long)read_u32_le(header + 16) << 32);
+
+    size_t capacity = COMPRESSED_CHUNK_SIZE + COMPRESSED_CHUNK_SIZE / 255 + 16;
+    uint8_t *raw = malloc(COMPRESSED_CHUNK_SIZE);
+    uint8_t *packed = malloc(capacity);
+    bool ok = raw && packed;
+
+    long long raw_total = 0;
+    long long stored_bytes = sizeof(header);
+    uint32_t total_crc = 0;
+    int chunk_count = 0;
+
+    while (ok) {
+        uint8_t chunk_header[16];
+
+        if (fread(chunk_header, 1, 13, input) != 13) {
+            ok = false;
+            break;
+        }
+
+        // Trailer starts with the end magic instead of a chunk header
+        if (memcmp(chunk_header, COMPRESSED_END_MAGIC, 8) == 0) {
+            if (fread(chunk_header + 13, 1, 3, input) != 3) {
+                ok = false;
+                break;
+            }
+            ok = read_u32_le(chunk_header + 8) == (uint32_t)chunk_count &&
+                 read_u32_le(chunk_header + 12) == total_crc &&
+                 raw_total == raw_size;
+            stored_bytes += 16;
+            break;
+        }
+
+        uint32_t raw_length = read_u32_le(chunk_header);
+        uint32_t stored_length = read_u32_le(chunk_header + 4);
+        uint32_t crc = read_u32_le(chunk_header + 8);
+        uint8_t method = chunk_header[12];
+
+        if (raw_length == 0 || raw_length > COMPRESSED_CHUNK_SIZE || stored_length > capacity ||
+            (method == CHUNK_STORED && stored_length != raw_length) ||
+            (method != CHUNK_STORED && method != CHUNK_LZ)) {
+            ok = false;
+            break;
+        }
+
+        uint8_t *target = method == CHUNK_STORED ? raw : packed;
+        if (fread(target, 1, stored_length, input) != stored_length) {
+            ok = false;
+            break;
+        }
+
+        if (method == CHUNK_LZ && !lz_decompress(packed, stored_length, raw, raw_length)) {
+            ok = false;
+            break;
+        }
+
+        if (crc32_update(0, raw, raw_length) != crc) {
+            ok = false;
+            break;
+        }
+
+        if (output && fwrite(raw, 1, raw_length, output) != raw_length) {
+            ok = false;
+            break;
+        }
+
+        total_crc = crc32_update(total_crc, raw, raw_length);
+        raw_total += raw_length;
+        stored_bytes += 13 + stored_length;
+        chunk_count++;
+    }
+
+    free(raw);
+    free(packed);
+    fclose(input);
+
+    if (!ok) {
+        log_error("Compressed file is damaged: %s (chunk %d)", path, chunk_count);
+        return false;
+    }
+
+    if (info) {
+        info->raw_bytes = raw_total;
+        info->stored_bytes = stored_bytes;
+        info->chunk_count = chunk_count;
+        info->checksum = total_crc;
+    }
+
+    return true;
+}
+
+bool verify_compressed_file(const char *path, CompressedFileInfo *info) {
+    return read_compressed_file(path, NULL, info);
+}
+
+bool decompress_file(const char *input_path, const char *output_path) {
+    // Decode next to the target and swap only once every chunk checked out
+    char temp_path[1024];
+    snprintf(temp_path, sizeof(temp_path), "%s.tmp", output_path);
+
+    FILE *output = fopen(temp_path, "wb");
+    if (!output) {
+        log_error("Cannot create file: %s", temp_path);
+        return false;
+    }
+
+    bool ok = read_compressed_file(input_path, output, NULL);
+    if (fclose(output) != 0) {
+        ok = false;
+    }
+
+    if (ok) {
+        remove(output_path);
+        ok = rename(temp_path, output_path) == 0;
+    }
+
+    if (!ok) {
+        remove(temp_path);
+        return false;
+    }
+
+    return true;
+}
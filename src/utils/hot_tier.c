@@ -0,0 +1,389 @@
+/*
+ * ========================================
+ * Hot Tier Implementation - Son Metrikler İçin Bellek İçi Halka Tampon
+ * ========================================
+ *
+ * Every host (system metrics) and ping target (network metrics) gets a
+ * fixed ring of cache-line sized slots. Writers are serialized by a mutex;
+ * readers never take it. Each slot carries a sequence number that is odd
+ * while the slot is being written (a seqlock), so a reader copies the slot,
+ * checks the sequence did not move and retries otherwise.
+ *
+ * A read is answered from memory only when the rings provably hold every
+ * matching row: the rows must be newer than the moment the tier started
+ * and no ring may have dropped samples inside the requested range.
+ * Timestamps are assumed to grow per host, as the collectors use time(NULL).
+ */
+
+#include "../../include/hot_tier.h"
+#include "../../include/logger.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#if defined(__GNUC__)
+    #define HOT_TIER_ALIGNED __attribute__((aligned(HOT_TIER_CACHE_LINE)))
+#else
+    #define HOT_TIER_ALIGNED
+#endif
+
+// How often a reader retries a slot the writer keeps changing
+#define HOT_TIER_READ_RETRIES 8
+
+typedef struct {
+    uint32_t sequence;          // odd while the writer is filling the slot
+    int32_t id;                 // database row id
+    int64_t position;           // write index the slot currently holds
+    int64_t timestamp;
+} HotSlotHeader;
+
+typedef struct {
+    HotSlotHeader header;
+    double cpu_usage;
+    double memory_usage;
+    double disk_usage;
+} HOT_TIER_ALIGNED HotSystemSlot;
+
+typedef struct {
+    HotSlotHeader header;
+    int32_t ping_time;
+    int32_t connection_status;
+    char interface_name[64];
+} HOT_TIER_ALIGNED HotNetworkSlot;
+
+typedef union {
+    HotSlotHeader header;
+    HotSystemSlot system;
+    HotNetworkSlot network;
+} HotSlotCopy;
+
+typedef struct {
+    uint64_t head;              // samples written so far
+    char key[256];              // hostname or target, fixed once published
+} HOT_TIER_ALIGNED HotRing;   // rings never share a cache line
+
+typedef struct {
+    HotRing rings[HOT_TIER_MAX_HOSTS];
+    unsigned char *slots;
+    size_t slot_size;
+    int ring_count;             // published with release semantics
+    int overflow;               // a host did not fit, memory is incomplete
+    pthread_mutex_t write_lock;
+} HotTier;
+
+static HotSystemSlot system_slots[HOT_TIER_MAX_HOSTS * HOT_TIER_CAPACITY];
+static HotNetworkSlot network_slots[HOT_TIER_MAX_HOSTS * HOT_TIER_CAPACITY];
+
+static HotTier system_tier = {
+    .slots = (unsigned char*)system_slots,
+    .slot_size = sizeof(HotSystemSlot),
+    .write_lock = PTHREAD_MUTEX_INITIALIZER
+};
+
+static HotTier network_tier = {
+    .slots = (unsigned char*)network_slots,
+    .slot_size = sizeof(HotNetworkSlot),
+    .write_lock = PTHREAD_MUTEX_INITIALIZER
+};
+
+// Rows with timestamp >= covered_from were all recorded here; 0 = not started
+static int64_t covered_from = 0;
+
+void init_hot_tier(void) {
+    __atomic_store_n(&covered_from, (int64_t)time(NULL) + 1, __ATOMIC_RELEASE);
+}
+
+static HotSlotHeader* slot_at(const HotTier *tier, int ring, uint64_t position) {
+    size_t index = (size_t)ring * HOT_TIER_CAPACITY + (size_t)(position & (HOT_TIER_CAPACITY - 1));
+    return (HotSlotHeader*)(tier->slots + index * tier->slot_size);
+}
+
+// ========================================
+// Writers
+// ========================================
+
+// Caller holds write_lock
+static int find_or_add_ring(HotTier *tier, const char *key) {
+    int count = tier->ring_count;
+
+    for (int i = 0; i < count; i++) {
+        if (strcmp(tier->rings[i].key, key) == 0) {
+            return i;
+        }
+    }
+
+    if (count == HOT_TIER_MAX_HOSTS) {
+        if (!tier->overflow) {
+            log_warning("Hot tier full, recent metrics of %s are read from the database", key);
+            __atomic_store_n(&tier->overflow, 1, __ATOMIC_RELEASE);
+        }
+        return -1;
+    }
+
+    strncpy(tier->rings[count].key, key, sizeof(tier->rings[count].key) - 1);
+    tier->rings[count].key[sizeof(tier->rings[count].key) - 1] = '\0';
+    tier->rings[count].head = 0;
+    __atomic_store_n(&tier->ring_count, count + 1, __ATOMIC_RELEASE);
+    return count;
+}
+
+// Copies sample (a full slot image) into the next slot of key's ring
+static void record_sample(HotTier *tier, const char *key, const HotSlotHeader *sample) {
+    if (__atomic_load_n(&covered_from, __ATOMIC_ACQUIRE) == 0) {
+        return;
+    }
+
+    pthread_mutex_lock(&tier->write_lock);
+
+    int ring = find_or_add_ring(tier, key);
+    if (ring < 0) {
+        pthread_mutex_unlock(&tier->write_lock);
+        return;
+    }
+
+    uint64_t position = tier->rings[ring].head;
+    HotSlotHeader *slot = slot_at(tier, ring, position);
+    uint32_t sequence = slot->sequence;
+
+    __atomic_store_n(&slot->sequence, sequence + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    memcpy(slot + 1, sample + 1, tier->slot_size - sizeof(HotSlotHeader));
+    slot->id = sample->id;
+    slot->position = (int64_t)position;
+    slot->timestamp = sample->timestamp;
+    __atomic_store_n(&slot->sequence, sequence + 2, __ATOMIC_RELEASE);
+
+    __atomic_store_n(&tier->rings[ring].head, position + 1, __ATOMIC_RELEASE);
+
+    pthread_mutex_unlock(&tier->write_lock);
+}
+
+void hot_tier_record_system(const SystemMetrics *metrics, int id) {
+    HotSystemSlot sample;
+    sample.header.id = id;
+    sample.header.timestamp = metrics->timestamp;
+    sample.cpu_usage = metrics->cpu_usage;
+    sample.memory_usage = metrics->memory_usage;
+    sample.disk_usage = metrics->disk_usage;
+    record_sample(&system_tier, metrics->hostname, &sample.header);
+}
+
+void hot_tier_record_network(const NetworkMetrics *metrics, int id) {
+    HotNetworkSlot sample;
+    sample.header.id = id;
+    sample.header.timestamp = metrics->timestamp;
+    sample.ping_time = metrics->ping_time;
+    sample.connection_status = metrics->connection_status ? 1 : 0;
+    strncpy(sample.interface_name, metrics->interface_name, sizeof(sample.interface_name) - 1);
+    sample.interface_name[sizeof(sample.interface_name) - 1] = '\0';
+    record_sample(&network_tier, metrics->target, &sample.header);
+}
+
+// ========================================
+// Readers
+// ========================================
+
+// Consistent copy of the sample written at position; false if the slot has
+// been reused for a newer sample or the writer kept it busy
+static bool read_slot(const HotTier *tier, int ring, uint64_t position, HotSlotCopy *copy) {
+    const HotSlotHeader *slot = slot_at(tier, ring, position);
+
+    for (int attempt = 0; attempt < HOT_TIER_READ_RETRIES; attempt++) {
+        uint32_t before = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+        if (before & 1) {
+            continue;
+        }
+
+        memcpy(copy, slot, tier->slot_size);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+        if (__atomic_load_n(&slot->sequence, __ATOMIC_RELAXED) == before) {
+            return copy->header.position == (int64_t)position;
+        }
+    }
+
+    return false;
+}
+
+typedef void (*HotSlotConverter)(const HotRing *ring, const HotSlotCopy *slot, void *row);
+
+static void convert_system_slot(const HotRing *ring, const HotSlotCopy *slot, void *row) {
+    SystemMetrics *metrics = row;
+    metrics->id = slot->header.id;
+    metrics->timestamp = (time_t)slot->header.timestamp;
+    metrics->cpu_usage = slot->system.cpu_usage;
+    metrics->memory_usage = slot->system.memory_usage;
+    metrics->disk_usage = slot->system.disk_usage;
+    strncpy(metrics->hostname, ring->key, sizeof(metrics->hostname) - 1);
+    metrics->hostname[sizeof(metrics->hostname) - 1] = '\0';
+}
+
+static void convert_network_slot(const HotRing *ring, const HotSlotCopy *slot, void *row) {
+    NetworkMetrics *metrics = row;
+    metrics->id = slot->header.id;
+    metrics->timestamp = (time_t)slot->header.timestamp;
+    strncpy(metrics->target, ring->key, sizeof(metrics->target) - 1);
+    metrics->target[sizeof(metrics->target) - 1] = '\0';
+    metrics->ping_time = slot->network.ping_time;
+    metrics->connection_status = slot->network.connection_status != 0;
+    memcpy(metrics->interface_name, slot->network.interface_name, sizeof(metrics->interface_name));
+}
+
+typedef struct {
+    uint64_t next;              // position after the next sample to read
+    uint64_t end;               // oldest position still retained
+    bool has_sample;
+    HotSlotCopy slot;
+} RingCursor;
+
+// Steps the cursor to its next older sample. Returns false if the ring had
+// already dropped that sample, i.e. older rows exist only in the database.
+static bool advance_cursor(const HotTier *tier, int ring, RingCursor *cursor) {
+    cursor->has_sample = false;
+
+    if (cursor->next == 0) {
+        return true;
+    }
+    if (cursor->next == cursor->end) {
+        return false;
+    }
+
+    cursor->next--;
+    if (!read_slot(tier, ring, cursor->next, &cursor->slot)) {
+        return false;
+    }
+
+    cursor->has_sample = true;
+    return true;
+}
+
+// Newest limit samples across every ring, merged by timestamp
+static bool collect_latest(HotTier *tier, int limit, size_t row_size, HotSlotConverter convert,
+                           void **rows, int *count) {
+    int64_t start = __atomic_load_n(&covered_from, __ATOMIC_ACQUIRE);
+    if (start == 0 || limit <= 0 || __atomic_load_n(&tier->overflow, __ATOMIC_ACQUIRE)) {
+        return false;
+    }
+
+    int ring_count = __atomic_load_n(&tier->ring_count, __ATOMIC_ACQUIRE);
+    RingCursor cursors[HOT_TIER_MAX_HOSTS];
+    bool complete = true;
+
+    for (int r = 0; r < ring_count; r++) {
+        uint64_t head = __atomic_load_n(&tier->rings[r].head, __ATOMIC_ACQUIRE);
+        cursors[r].next = head;
+        cursors[r].end = head > HOT_TIER_CAPACITY ? head - HOT_TIER_CAPACITY : 0;
+        complete = advance_cursor(tier, r, &cursors[r]) && complete;
+    }
+
+    unsigned char *output = malloc(row_size * (size_t)limit);
+    if (!output) {
+        return false;
+    }
+
+    int produced = 0;
+    int64_t oldest = 0;
+
+    while (complete && produced < limit) {
+        int best = -1;
+        for (int r = 0; r < ring_count; r++) {
+            if (cursors[r].has_sample &&
+                (best < 0 || cursors[r].slot.header.timestamp > cursors[best].slot.header.timestamp)) {
+                best = r;
+            }
+        }
+        if (best < 0) {
+            break;
+        }
+
+        convert(&tier->rings[best], &cursors[best].slot, output + row_size * produced);
+        oldest = cursors[best].slot.header.timestamp;
+        produced++;
+
+        // A ring that ran out of retained samples may be missing older rows
+        if (!advance_cursor(tier, best, &cursors[best]) && produced < limit) {
+            complete = false;
+        }
+    }
+
+    // Short results and rows from before the tier started need the database
+    if (!complete || produced < limit || oldest < start) {
+        free(output);
+        return false;
+    }
+
+    *rows = output;
+    *count = produced;
+    return true;
+}
+
+bool hot_tier_latest_system(int limit, SystemMetrics **metrics, int *count) {
+    return collect_latest(&system_tier, limit, sizeof(SystemMetrics), convert_system_slot,
+                          (void**)metrics, count);
+}
+
+bool hot_tier_latest_network(int limit, NetworkMetrics **metrics, int *count) {
+    return collect_latest(&network_tier, limit, sizeof(NetworkMetrics), convert_network_slot,
+                          (void**)metrics, count);
+}
+
+static int compare_metrics_timestamp(const void *a, const void *b) {
+    time_t ta = ((const SystemMetrics*)a)->timestamp;
+    time_t tb = ((const SystemMetrics*)b)->timestamp;
+    return (ta > tb) - (ta < tb);
+}
+
+bool hot_tier_system_range(time_t from, time_t to, SystemMetrics **metrics, int *count) {
+    int64_t start = __atomic_load_n(&covered_from, __ATOMIC_ACQUIRE);
+    if (start == 0 || (int64_t)from < start || __atomic_load_n(&system_tier.overflow, __ATOMIC_ACQUIRE)) {
+        return false;
+    }
+
+    int ring_count = __atomic_load_n(&system_tier.ring_count, __ATOMIC_ACQUIRE);
+    SystemMetrics *output = NULL;
+    int produced = 0, capacity = 0;
+
+    for (int r = 0; r < ring_count; r++) {
+        RingCursor cursor;
+        uint64_t head = __atomic_load_n(&system_tier.rings[r].head, __ATOMIC_ACQUIRE);
+        cursor.next = head;
+        cursor.end = head > HOT_TIER_CAPACITY ? head - HOT_TIER_CAPACITY : 0;
+
+        for (;;) {
+            if (!advance_cursor(&system_tier, r, &cursor)) {
+                free(output);
+                return false;
+            }
+            if (!cursor.has_sample || cursor.slot.header.timestamp < (int64_t)from) {
+                break;
+            }
+            if (cursor.slot.header.timestamp >= (int64_t)to) {
+                continue;
+            }
+
+            if (produced == capacity) {
+                capacity = capacity > 0 ? capacity * 2 : 64;
+                SystemMetrics *grown = realloc(output, sizeof(SystemMetrics) * capacity);
+                if (!grown) {
+                    free(output);
+                    return false;
+                }
+                output = grown;
+            }
+            convert_system_slot(&system_tier.rings[r], &cursor.slot, &output[produced++]);
+        }
+    }
+
+    // Rings are walked newest first and per host; the API wants oldest first
+    qsort(output, produced, sizeof(SystemMetrics), compare_metrics_timestamp);
+
+    if (produced == 0) {
+        free(output);
+        output = NULL;
+    }
+
+    *metrics = output;
+    *count = produced;
+    return true;
+}
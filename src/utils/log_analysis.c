@@ -0,0 +1,932 @@
+/*
+ * ========================================
+ * Log Analysis Implementation - Paralel Log Analizi
+ * ========================================
+ *
+ * Builds the statistics every log view needs over a set of log files in
+ * one pass on all cores: level counts, hour and day histograms, the time
+ * range, the most frequent message templates and the latest errors.
+ *
+ * Every file is cut into LOG_ANALYSIS_CHUNK_SIZE byte ranges; the scanner
+ * moves a range that starts inside a line to the next line start, so the
+ * ranges split the lines exactly once without looking at the data first.
+ * Workers take chunks from a shared counter and count into their own
+ * statistics and template sketch, which are combined after the join:
+ * nothing is shared while scanning, and the files are mapped once and read
+ * by all workers. A worker takes chunks in increasing order, so its error
+ * ring is already in file order.
+ */
+
+#include "../../include/log_analysis.h"
+#include "../../include/log_scanner.h"
+#include "../../include/log_template.h"
+#include "../../include/log_binary.h"
+#include "../../include/file_compress.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <unistd.h>
+#endif
+
+// Open addressing over twice as many buckets as messages, so a miss on a
+// full table still ends after a few probes
+#define MESSAGE_BUCKETS (LOG_STATS_MESSAGE_SLOTS * 2)
+
+typedef struct {
+    LogScanner *scanner;
+    const char *path;
+    int file;
+    uint64_t start;
+    uint64_t end;
+} LogChunk;
+
+typedef struct {
+    LogChunk *chunks;
+    int chunk_count;
+    int next;                   // next chunk to take, atomic
+} ChunkQueue;
+
+typedef struct {
+    uint64_t count;
+    uint64_t error;             // count may be this much too high
+    uint32_t bucket;            // where the hash is
+    uint32_t heap;              // position in the heap
+    size_t length;
+    char text[LOG_STATS_MESSAGE_MAX];
+} MessageSlot;
+
+// Space-saving sketch of message templates. Exact while slots are free; once
+// they are all used a new template takes over the slot with the least count
+// and starts from that count, which is also its error. Counts are never too
+// low, and a template seen more than lines / LOG_STATS_MESSAGE_SLOTS times
+// always has a slot. The heap of slots by count is built when the table
+// fills up, so the common case of few templates never touches it.
+//
+// Probing only reads the bucket arrays, which stay in cache; the text is
+// compared when a hash matches
+typedef struct {
+    uint64_t *hashes;           // MESSAGE_BUCKETS entries, 0: empty bucket
+    uint32_t *entries;          // bucket -> index into slots
+    MessageSlot *slots;         // LOG_STATS_MESSAGE_SLOTS, the first used are filled
+    uint32_t *heap;             // slot indices, least count first, once full
+    int used;
+} MessageTable;
+
+typedef struct {
+    ChunkQueue *queue;
+    LogStatistics stats;
+    MessageTable messages;
+    LogErrorLine errors[LOG_STATS_ERROR_LINES];     // ring, errors_seen % size is next
+    uint64_t errors_seen;
+    int file;                   // file of the chunk being scanned
+    char date[10];              // last date seen and its age, mktime is not cheap
+    int days;
+} AnalysisWorker;
+
+static const char *g_category_names[LOG_CATEGORY_COUNT] = { "network", "file", "memory", "security" };
+
+// Words that put an error line in a category, checked in category order
+static const char *g_category_words[LOG_CATEGORY_COUNT][3] = {
+    { "network", "connection", "timeout" },
+    { "file", "directory", "path" },
+    { "memory", "allocation", "heap" },
+    { "security", "auth", "permission" }
+};
+
+const char* get_log_category_name(LogErrorCategory category) {
+    return category >= 0 && category < LOG_CATEGORY_COUNT ? g_category_names[category] : "unknown";
+}
+
+int get_log_analysis_threads(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    long cpus = (long)info.dwNumberOfProcessors;
+#else
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    if (cpus < 1) {
+        return 1;
+    }
+    return cpus > LOG_ANALYSIS_MAX_THREADS ? LOG_ANALYSIS_MAX_THREADS : (int)cpus;
+}
+
+uint64_t count_log_lines_older_than(const LogStatistics *stats, int days) {
+    uint64_t total = stats->older;
+    for (int day = days < 0 ? 0 : days; day < LOG_ANALYSIS_DAYS; day++) {
+        for (int column = 0; column <= LOG_KERNEL_LEVELS; column++) {
+            total += stats->daily[day][column];
+        }
+    }
+    return total;
+}
+
+// ========================================
+// Per-line work
+// ========================================
+
+static int parse_digits(const char *text, int count) {
+    int value = 0;
+    for (int i = 0; i < count; i++) {
+        if (text[i] < '0' || text[i] > '9') {
+            return -1;
+        }
+        value = value * 10 + (text[i] - '0');
+    }
+    return value;
+}
+
+// "YYYY-MM-DD HH:MM:SS" at the line start, optionally inside "[...]"
+static const char* line_timestamp(const char *line, size_t length) {
+    if (length > 0 && line[0] == '[') {
+        line++;
+        length--;
+    }
+    if (length < 19 || line[4] != '-' || line[7] != '-' || line[10] != ' ' ||
+        line[13] != ':' || line[16] != ':') {
+        return NULL;
+    }
+    return line;
+}
+
+// Text after "LEVEL:" / "[LEVEL]" of a line classify_log_line accepted
+static const char* line_message(const char *line, size_t length, int level, size_t *message_length) {
+    const char *end = line + length;
+    const char *cursor = memchr(line, ']', length);     // end of the timestamp
+    cursor += 2;
+    if (*cursor == '[') {
+        cursor++;
+    }
+    cursor += strlen(get_log_level_string((LogLevel)level)) + 1;
+    while (cursor < end && *cursor == ' ') {
+        cursor++;
+    }
+    if (cursor > end) {
+        cursor = end;
+    }
+    *message_length = (size_t)(end - cursor);
+    return cursor;
+}
+
+// Cut to the buffer without splitting a UTF-8 sequence
+static size_t fit_message(const char *text, size_t length) {
+    if (length < LOG_STATS_MESSAGE_MAX) {
+        return length;
+    }
+    length = LOG_STATS_MESSAGE_MAX - 1;
+    while (length > 0 && ((unsigned char)text[length] & 0xC0) == 0x80) {
+        length--;
+    }
+    return length;
+}
+
+// Whole days between the date's midnight and the reference, -1 for a future
+// or unparsable date
+static int line_days_ago(AnalysisWorker *worker, const char *stamp) {
+    if (memcmp(stamp, worker->date, sizeof(worker->date)) != 0) {
+        struct tm day = {0};
+        day.tm_year = parse_digits(stamp, 4) - 1900;
+        day.tm_mon = parse_digits(stamp + 5, 2) - 1;
+        day.tm_mday = parse_digits(stamp + 8, 2);
+        day.tm_isdst = -1;
+
+        time_t midnight = mktime(&day);
+        double seconds = midnight == (time_t)-1 ? -1 : difftime(worker->stats.reference, midnight);
+        worker->days = seconds < 0 ? -1 : (int)(seconds / 86400);
+        memcpy(worker->date, stamp, sizeof(worker->date));
+    }
+    return worker->days;
+}
+
+// Eight bytes per step with a multiply-xorshift mix; never 0
+static uint64_t hash_message(const char *text, size_t length) {
+    uint64_t hash = 0x9E3779B97F4A7C15ULL ^ length;
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        uint64_t word;
+        memcpy(&word, text + i, 8);
+        hash = (hash ^ word) * 0xFF51AFD7ED558CCDULL;
+        hash ^= hash >> 32;
+    }
+    uint64_t tail = 0;
+    memcpy(&tail, text + i, length - i);
+    hash = (hash ^ tail) * 0xC4CEB9FE1A85EC53ULL;
+    hash ^= hash >> 29;
+    return hash | 1;
+}
+
+static void sift_down(MessageTable *table, uint32_t position) {
+    uint32_t *heap = table->heap;
+    MessageSlot *slots = table->slots;
+    uint32_t entry = heap[position];
+    uint64_t count = slots[entry].count;
+
+    for (;;) {
+        uint32_t child = position * 2 + 1;
+        if (child >= LOG_STATS_MESSAGE_SLOTS) {
+            break;
+        }
+        if (child + 1 < LOG_STATS_MESSAGE_SLOTS && slots[heap[child + 1]].count < slots[heap[child]].count) {
+            child++;
+        }
+        if (slots[heap[child]].count >= count) {
+            break;
+        }
+        heap[position] = heap[child];
+        slots[heap[position]].heap = position;
+        position = child;
+    }
+    heap[position] = entry;
+    slots[entry].heap = position;
+}
+
+static void build_heap(MessageTable *table) {
+    for (uint32_t i = 0; i < LOG_STATS_MESSAGE_SLOTS; i++) {
+        table->heap[i] = i;
+        table->slots[i].heap = i;
+    }
+    for (uint32_t i = LOG_STATS_MESSAGE_SLOTS / 2; i-- > 0;) {
+        sift_down(table, i);
+    }
+}
+
+// Empties a bucket, moving later entries of the probe run back so that no
+// lookup stops early at the hole
+static void remove_bucket(MessageTable *table, size_t hole) {
+    size_t next = hole;
+    for (;;) {
+        next = (next + 1) & (MESSAGE_BUCKETS - 1);
+        if (table->hashes[next] == 0) {
+            break;
+        }
+        size_t home = (size_t)(table->hashes[next] >> 1) & (MESSAGE_BUCKETS - 1);
+        bool stays = next > hole ? home > hole && home <= next : home > hole || home <= next;
+        if (stays) {
+            continue;
+        }
+        table->hashes[hole] = table->hashes[next];
+        table->entries[hole] = table->entries[next];
+        table->slots[table->entries[hole]].bucket = (uint32_t)hole;
+        hole = next;
+    }
+    table->hashes[hole] = 0;
+}
+
+static void count_message(MessageTable *table, const char *text, size_t length, uint64_t count, uint64_t error) {
+    uint64_t hash = hash_message(text, length);
+    size_t index = (size_t)(hash >> 1) & (MESSAGE_BUCKETS - 1);
+    bool full = table->used == LOG_STATS_MESSAGE_SLOTS;
+
+    while (table->hashes[index] != 0) {
+        if (table->hashes[index] == hash) {
+            MessageSlot *slot = &table->slots[table->entries[index]];
+            if (slot->length == length && memcmp(slot->text, text, length) == 0) {
+                slot->count += count;
+                slot->error += error;
+                if (full) {
+                    sift_down(table, slot->heap);
+                }
+                return;
+            }
+        }
+        index = (index + 1) & (MESSAGE_BUCKETS - 1);
+    }
+
+    uint32_t entry;
+    uint64_t floor = 0;
+    if (full) {
+        entry = table->heap[0];
+        floor = table->slots[entry].count;
+        remove_bucket(table, table->slots[entry].bucket);
+        index = (size_t)(hash >> 1) & (MESSAGE_BUCKETS - 1);
+        while (table->hashes[index] != 0) {
+            index = (index + 1) & (MESSAGE_BUCKETS - 1);
+        }
+    } else {
+        entry = (uint32_t)table->used++;
+    }
+
+    MessageSlot *slot = &table->slots[entry];
+    table->hashes[index] = hash;
+    table->entries[index] = entry;
+    slot->bucket = (uint32_t)index;
+    slot->count = floor + count;
+    slot->error = floor + error;
+    slot->length = length;
+    memcpy(slot->text, text, length);
+    slot->text[length] = '\0';
+
+    if (full) {
+        sift_down(table, slot->heap);
+    } else if (table->used == LOG_STATS_MESSAGE_SLOTS) {
+        build_heap(table);
+    }
+}
+
+static void add_error(AnalysisWorker *worker, const char *line, size_t length, const char *stamp,
+                      const char *message, size_t message_length, uint64_t offset) {
+    LogLine text = {line, length, offset};
+    for (int category = 0; category < LOG_CATEGORY_COUNT; category++) {
+        const char *const *words = g_category_words[category];
+        if (find_in_log_line(&text, words[0]) || find_in_log_line(&text, words[1]) ||
+            find_in_log_line(&text, words[2])) {
+            worker->stats.error_categories[category]++;
+            break;
+        }
+    }
+
+    LogErrorLine *error = &worker->errors[worker->errors_seen++ % LOG_STATS_ERROR_LINES];
+    if (stamp) {
+        memcpy(error->time, stamp, 19);
+        error->time[19] = '\0';
+    } else {
+        error->time[0] = '\0';
+    }
+    memcpy(error->message, message, message_length);
+    error->message[message_length] = '\0';
+    error->file = worker->file;
+    error->offset = offset;
+}
+
+static void add_line(AnalysisWorker *worker, const char *line, size_t length, uint64_t offset) {
+    LogStatistics *stats = &worker->stats;
+    if (length > 0 && line[length - 1] == '\r') {
+        length--;
+    }
+
+    int level = classify_log_line(line, length);
+    int column = level >= 0 ? level : LOG_KERNEL_LEVELS;
+    stats->counts.lines++;
+    if (level >= 0) {
+        stats->counts.levels[level]++;
+    } else {
+        stats->counts.unclassified++;
+    }
+
+    const char *stamp = line_timestamp(line, length);
+    if (level >= 0) {
+        size_t message_length;
+        const char *message = line_message(line, length, level, &message_length);
+        char template_text[LOG_STATS_MESSAGE_MAX];
+        size_t template_length = make_log_template(message, message_length, template_text, sizeof(template_text));
+        count_message(&worker->messages, template_text, template_length, 1, 0);
+        if (level == LOG_ERROR) {
+            message_length = fit_message(message, message_length);
+            add_error(worker, line, length, stamp, message, message_length, offset);
+        }
+    }
+
+    if (!stamp) {
+        stats->undated++;
+        return;
+    }
+
+    int hour = parse_digits(stamp + 11, 2);
+    if (hour >= 0 && hour < 24) {
+        stats->hourly[hour]++;
+    }
+
+    int days = line_days_ago(worker, stamp);
+    if (days >= LOG_ANALYSIS_DAYS) {
+        stats->older++;
+    } else if (days >= 0) {
+        stats->daily[days][column]++;
+    }
+
+    // Timestamps compare as text; the empty first_time means none yet
+    if (!stats->first_time[0] || memcmp(stamp, stats->first_time, 19) < 0) {
+        memcpy(stats->first_time, stamp, 19);
+    }
+    if (memcmp(stamp, stats->last_time, 19) > 0) {
+        memcpy(stats->last_time, stamp, 19);
+    }
+}
+
+static bool add_block(const LogBlock *block, void *context) {
+    AnalysisWorker *worker = context;
+    const char *cursor = block->data;
+    const char *end = block->data + block->length;
+
+    while (cursor < end) {
+        const char *newline = memchr(cursor, '\n', (size_t)(end - cursor));
+        const char *line_end = newline ? newline : end;
+        add_line(worker, cursor, (size_t)(line_end - cursor), block->offset + (uint64_t)(cursor - block->data));
+        cursor = line_end + 1;
+    }
+    worker->stats.bytes += block->length;
+    return true;
+}
+
+// ========================================
+// Workers
+// ========================================
+
+static void* analysis_worker_main(void *arg) {
+    AnalysisWorker *worker = arg;
+    ChunkQueue *queue = worker->queue;
+
+    for (;;) {
+        int index = __atomic_fetch_add(&queue->next, 1, __ATOMIC_RELAXED);
+        if (index >= queue->chunk_count) {
+            break;
+        }
+        const LogChunk *chunk = &queue->chunks[index];
+        worker->file = chunk->file;
+        if (!scan_log_blocks(chunk->scanner, chunk->start, chunk->end, add_block, worker)) {
+            log_warning("Log bölümü okunamadı: %s (%llu. bayttan)",
+                        chunk->path, (unsigned long long)chunk->start);
+        }
+    }
+    return NULL;
+}
+
+// args[0] runs on the calling thread, the rest on their own threads. If a
+// thread cannot be started its work is still done: the routines pull from
+// a shared queue until it is empty.
+static void run_on_threads(void* (*routine)(void*), void **args, int count) {
+    pthread_t threads[LOG_ANALYSIS_MAX_THREADS];
+    bool started[LOG_ANALYSIS_MAX_THREADS] = {false};
+
+    for (int i = 1; i < count; i++) {
+        started[i] = pthread_create(&threads[i], NULL, routine, args[i]) == 0;
+    }
+    routine(args[0]);
+    for (int i = 1; i < count; i++) {
+        if (started[i]) {
+            pthread_join(threads[i], NULL);
+        }
+    }
+}
+
+// ========================================
+// Combining the workers
+// ========================================
+
+static void merge_counters(LogStatistics *into, const LogStatistics *from) {
+    into->counts.lines += from->counts.lines;
+    into->counts.unclassified += from->counts.unclassified;
+    for (int level = 0; level < LOG_KERNEL_LEVELS; level++) {
+        into->counts.levels[level] += from->counts.levels[level];
+    }
+    for (int hour = 0; hour < 24; hour++) {
+        into->hourly[hour] += from->hourly[hour];
+    }
+    for (int day = 0; day < LOG_ANALYSIS_DAYS; day++) {
+        for (int column = 0; column <= LOG_KERNEL_LEVELS; column++) {
+            into->daily[day][column] += from->daily[day][column];
+        }
+    }
+    for (int category = 0; category < LOG_CATEGORY_COUNT; category++) {
+        into->error_categories[category] += from->error_categories[category];
+    }
+    into->older += from->older;
+    into->undated += from->undated;
+    into->bytes += from->bytes;
+
+    if (from->first_time[0] && (!into->first_time[0] || strcmp(from->first_time, into->first_time) < 0)) {
+        strcpy(into->first_time, from->first_time);
+    }
+    if (strcmp(from->last_time, into->last_time) > 0) {
+        strcpy(into->last_time, from->last_time);
+    }
+}
+
+// Adds every worker's sketch into the first one and keeps the most frequent.
+// Slots carry their error along, so the bounds hold for the merged sketch.
+static void merge_messages(LogStatistics *stats, AnalysisWorker *workers, int count) {
+    MessageTable *total = &workers[0].messages;
+    for (int t = 1; t < count; t++) {
+        const MessageTable *table = &workers[t].messages;
+        for (int i = 0; i < table->used; i++) {
+            const MessageSlot *slot = &table->slots[i];
+            count_message(total, slot->text, slot->length, slot->count, slot->error);
+        }
+    }
+
+    // Insertion into a short sorted list
+    LogMessageCount *top = stats->top_messages;
+    int kept = 0;
+    for (int i = 0; i < total->used; i++) {
+        const MessageSlot *slot = &total->slots[i];
+        if (kept == LOG_STATS_TOP_MESSAGES && slot->count <= top[kept - 1].count) {
+            continue;
+        }
+        int position = kept < LOG_STATS_TOP_MESSAGES ? kept++ : kept - 1;
+        while (position > 0 && top[position - 1].count < slot->count) {
+            top[position] = top[position - 1];
+            position--;
+        }
+        memcpy(top[position].text, slot->text, slot->length + 1);
+        top[position].count = slot->count;
+        top[position].error = slot->error;
+    }
+    stats->top_message_count = kept;
+}
+
+static int compare_error_lines(const void *a, const void *b) {
+    const LogErrorLine *left = a;
+    const LogErrorLine *right = b;
+    if (left->file != right->file) {
+        return left->file < right->file ? -1 : 1;
+    }
+    return left->offset < right->offset ? -1 : left->offset > right->offset;
+}
+
+static void merge_errors(LogStatistics *stats, const AnalysisWorker *workers, int count) {
+    LogErrorLine *all = malloc((size_t)count * LOG_STATS_ERROR_LINES * sizeof(LogErrorLine));
+    if (!all) {
+        return;
+    }
+
+    int total = 0;
+    for (int t = 0; t < count; t++) {
+        uint64_t seen = workers[t].errors_seen;
+        uint64_t first = seen > LOG_STATS_ERROR_LINES ? seen - LOG_STATS_ERROR_LINES : 0;
+        for (uint64_t i = first; i < seen; i++) {
+            all[total++] = workers[t].errors[i % LOG_STATS_ERROR_LINES];
+        }
+    }
+    qsort(all, (size_t)total, sizeof(LogErrorLine), compare_error_lines);
+
+    int kept = total < LOG_STATS_ERROR_LINES ? total : LOG_STATS_ERROR_LINES;
+    memcpy(stats->recent_errors, all + (total - kept), (size_t)kept * sizeof(LogErrorLine));
+    stats->recent_error_count = kept;
+    free(all);
+}
+
+// Lines starting in [start, end) of one file
+typedef struct {
+    const char *path;
+    uint64_t start;
+    uint64_t end;
+} LogRange;
+
+static uint64_t range_end(const LogRange *range, uint64_t size) {
+    return range->end < size ? range->end : size;
+}
+
+static bool analyze_ranges(const LogRange *ranges, int range_count, int threads,
+                           time_t reference, LogStatistics *stats) {
+    memset(stats, 0, sizeof(*stats));
+    stats->reference = reference;
+    if (!ranges || range_count <= 0) {
+        return false;
+    }
+
+    LogScanner **scanners = calloc((size_t)range_count, sizeof(LogScanner*));
+    if (!scanners) {
+        return false;
+    }
+
+    int chunk_count = 0;
+    for (int i = 0; i < range_count; i++) {
+        // Binary records are not lines; counting them as text would report
+        // an empty log, so the file is left out
+        if (is_binary_log_file(ranges[i].path)) {
+            LOG_RATE_LIMITED(LOG_WARNING, 1, "Binary log metin analizine alınmadı: %s", ranges[i].path);
+            continue;
+        }
+        scanners[i] = open_log_scanner(ranges[i].path);
+        if (scanners[i]) {
+            stats->files++;
+            uint64_t end = range_end(&ranges[i], get_log_scanner_size(scanners[i]));
+            if (end > ranges[i].start) {
+                chunk_count += (int)((end - ranges[i].start + LOG_ANALYSIS_CHUNK_SIZE - 1) / LOG_ANALYSIS_CHUNK_SIZE);
+            }
+        }
+    }
+
+    ChunkQueue queue = {NULL, 0, 0};
+    AnalysisWorker *workers = NULL;
+    bool allocated = false;
+    if (chunk_count > 0) {
+        queue.chunks = malloc((size_t)chunk_count * sizeof(LogChunk));
+        if (threads <= 0) {
+            threads = get_log_analysis_threads();
+        }
+        if (threads > chunk_count) {
+            threads = chunk_count;
+        }
+        if (threads > LOG_ANALYSIS_MAX_THREADS) {
+            threads = LOG_ANALYSIS_MAX_THREADS;
+        }
+        workers = calloc((size_t)threads, sizeof(AnalysisWorker));
+        allocated = queue.chunks && workers;
+        for (int t = 0; allocated && t < threads; t++) {
+            MessageTable *table = &workers[t].messages;
+            table->hashes = calloc(MESSAGE_BUCKETS, sizeof(uint64_t));
+            table->entries = malloc(MESSAGE_BUCKETS * sizeof(uint32_t));
+            table->slots = malloc(LOG_STATS_MESSAGE_SLOTS * sizeof(MessageSlot));
+            table->heap = malloc(LOG_STATS_MESSAGE_SLOTS * sizeof(uint32_t));
+            allocated = table->hashes && table->entries && table->slots && table->heap;
+        }
+    }
+
+    if (allocated) {
+        for (int i = 0; i < range_count; i++) {
+            if (!scanners[i]) {
+                continue;
+            }
+            uint64_t end = range_end(&ranges[i], get_log_scanner_size(scanners[i]));
+            for (uint64_t start = ranges[i].start; start < end; start += LOG_ANALYSIS_CHUNK_SIZE) {
+                LogChunk *chunk = &queue.chunks[queue.chunk_count++];
+                chunk->scanner = scanners[i];
+                chunk->path = ranges[i].path;
+                chunk->file = i;
+                chunk->start = start;
+                chunk->end = end - start > LOG_ANALYSIS_CHUNK_SIZE ? start + LOG_ANALYSIS_CHUNK_SIZE : end;
+            }
+        }
+
+        void *args[LOG_ANALYSIS_MAX_THREADS];
+        for (int t = 0; t < threads; t++) {
+            workers[t].queue = &queue;
+            workers[t].stats.reference = reference;
+            args[t] = &workers[t];
+        }
+        run_on_threads(analysis_worker_main, args, threads);
+
+        for (int t = 0; t < threads; t++) {
+            merge_counters(stats, &workers[t].stats);
+        }
+        merge_messages(stats, workers, threads);
+        merge_errors(stats, workers, threads);
+    } else if (chunk_count > 0) {
+        log_error("Log analizi için bellek ayrılamadı");
+        stats->files = 0;
+    }
+
+    for (int i = 0; i < range_count; i++) {
+        close_log_scanner(scanners[i]);
+    }
+    for (int t = 0; workers && t < threads; t++) {
+        free(workers[t].messages.hashes);
+        free(workers[t].messages.entries);
+        free(workers[t].messages.slots);
+        free(workers[t].messages.heap);
+    }
+    free(workers);
+    free(queue.chunks);
+    free(scanners);
+    return stats->files > 0;
+}
+
+bool build_log_statistics(const char *const *paths, int path_count, int threads,
+                          time_t reference, LogStatistics *stats) {
+    LogRange *ranges = path_count > 0 ? malloc((size_t)path_count * sizeof(LogRange)) : NULL;
+    if (!ranges) {
+        memset(stats, 0, sizeof(*stats));
+        stats->reference = reference;
+        return false;
+    }
+    for (int i = 0; i < path_count; i++) {
+        ranges[i].path = paths[i];
+        ranges[i].start = 0;
+        ranges[i].end = LOG_RANGE_END;
+    }
+    bool ok = analyze_ranges(ranges, path_count, threads, reference, stats);
+    free(ranges);
+    return ok;
+}
+
+// ========================================
+// Combining statistics of separate runs
+// ========================================
+
+static time_t local_midnight(time_t when) {
+    struct tm *local = localtime(&when);
+    if (!local) {
+        return when;
+    }
+    struct tm day = *local;
+    day.tm_hour = 0;
+    day.tm_min = 0;
+    day.tm_sec = 0;
+    day.tm_isdst = -1;
+    return mktime(&day);
+}
+
+// Moves the per-day rows forward by the days between the two references
+static void shift_days(LogStatistics *stats, time_t reference) {
+    double seconds = difftime(local_midnight(reference), local_midnight(stats->reference));
+    int shift = (int)((seconds + 43200) / 86400);     // DST days are 23 or 25 hours
+    if (shift <= 0) {
+        return;
+    }
+
+    for (int day = LOG_ANALYSIS_DAYS - 1; day >= 0; day--) {
+        for (int column = 0; column <= LOG_KERNEL_LEVELS; column++) {
+            if (day + shift >= LOG_ANALYSIS_DAYS) {
+                stats->older += stats->daily[day][column];
+            } else {
+                stats->daily[day + shift][column] = stats->daily[day][column];
+            }
+            stats->daily[day][column] = 0;
+        }
+    }
+    stats->reference = reference;
+}
+
+static int compare_message_counts(const void *a, const void *b) {
+    const LogMessageCount *left = a;
+    const LogMessageCount *right = b;
+    return left->count > right->count ? -1 : left->count < right->count;
+}
+
+void merge_log_statistics(LogStatistics *into, const LogStatistics *from) {
+    shift_days(into, from->reference);
+    merge_counters(into, from);
+
+    // A template missing from one list was counted at most that list's last
+    // count there (none if the list is not full); it is added to keep the
+    // counts upper bounds
+    uint64_t into_floor = into->top_message_count == LOG_STATS_TOP_MESSAGES ?
+                          into->top_messages[LOG_STATS_TOP_MESSAGES - 1].count : 0;
+    uint64_t from_floor = from->top_message_count == LOG_STATS_TOP_MESSAGES ?
+                          from->top_messages[LOG_STATS_TOP_MESSAGES - 1].count : 0;
+    LogMessageCount messages[LOG_STATS_TOP_MESSAGES * 2];
+    bool matched[LOG_STATS_TOP_MESSAGES] = {false};
+    int count = into->top_message_count;
+    memcpy(messages, into->top_messages, (size_t)count * sizeof(LogMessageCount));
+    for (int i = 0; i < from->top_message_count; i++) {
+        int match = 0;
+        while (match < into->top_message_count && strcmp(messages[match].text, from->top_messages[i].text) != 0) {
+            match++;
+        }
+        if (match < into->top_message_count) {
+            messages[match].count += from->top_messages[i].count;
+            messages[match].error += from->top_messages[i].error;
+            matched[match] = true;
+        } else {
+            messages[count] = from->top_messages[i];
+            messages[count].count += into_floor;
+            messages[count].error += into_floor;
+            count++;
+        }
+    }
+    for (int i = 0; i < into->top_message_count; i++) {
+        if (!matched[i]) {
+            messages[i].count += from_floor;
+            messages[i].error += from_floor;
+        }
+    }
+    qsort(messages, (size_t)count, sizeof(LogMessageCount), compare_message_counts);
+    into->top_message_count = count < LOG_STATS_TOP_MESSAGES ? count : LOG_STATS_TOP_MESSAGES;
+    memcpy(into->top_messages, messages, (size_t)into->top_message_count * sizeof(LogMessageCount));
+
+    // from's errors are the newer ones
+    LogErrorLine errors[LOG_STATS_ERROR_LINES * 2];
+    int total = into->recent_error_count;
+    memcpy(errors, into->recent_errors, (size_t)total * sizeof(LogErrorLine));
+    memcpy(errors + total, from->recent_errors, (size_t)from->recent_error_count * sizeof(LogErrorLine));
+    total += from->recent_error_count;
+    into->recent_error_count = total < LOG_STATS_ERROR_LINES ? total : LOG_STATS_ERROR_LINES;
+    memcpy(into->recent_errors, errors + (total - into->recent_error_count),
+           (size_t)into->recent_error_count * sizeof(LogErrorLine));
+}
+
+// ========================================
+// Logger's file set
+// ========================================
+
+typedef struct {
+    LogSegmentRange *ranges;
+    char (*paths)[MAX_PATH_LEN + 300];
+    int count;
+    int next;                   // next segment to restore, atomic
+} RestoreQueue;
+
+static int g_restore_counter = 0;
+
+// ".analysis_<n>_<segment>" in the segment's directory: outside the names
+// the logger treats as its segments, so rotation cleanup leaves it alone
+static void make_restore_path(char *out, size_t size, const char *archive_path) {
+    const char *slash = strrchr(archive_path, '/');
+    const char *backslash = strrchr(archive_path, '\\');
+    if (backslash && (!slash || backslash > slash)) {
+        slash = backslash;
+    }
+    const char *name = slash ? slash + 1 : archive_path;
+    int dir_length = slash ? (int)(slash - archive_path) : 1;
+    const char *dir = slash ? archive_path : ".";
+    int name_length = (int)strlen(name) - (int)strlen(LOG_ARCHIVE_EXTENSION);
+
+    int id = __atomic_fetch_add(&g_restore_counter, 1, __ATOMIC_RELAXED);
+    snprintf(out, size, "%.*s/.analysis_%d_%.*s", dir_length, dir, id, name_length, name);
+}
+
+static void* restore_worker_main(void *arg) {
+    RestoreQueue *queue = arg;
+
+    for (;;) {
+        int index = __atomic_fetch_add(&queue->next, 1, __ATOMIC_RELAXED);
+        if (index >= queue->count) {
+            break;
+        }
+        const LogSegment *segment = &queue->ranges[index].segment;
+        if (!segment->compressed) {
+            continue;
+        }
+        make_restore_path(queue->paths[index], sizeof(queue->paths[index]), segment->path);
+        if (!decompress_file(segment->path, queue->paths[index])) {
+            log_warning("Log arşivi açılamadı: %s", segment->path);
+            queue->paths[index][0] = '\0';
+        }
+    }
+    return NULL;
+}
+
+static bool file_readable(const char *path) {
+    FILE *file = fopen(path, "rb");
+    if (file) {
+        fclose(file);
+    }
+    return file != NULL;
+}
+
+bool build_log_segment_statistics(LogSegmentRange *ranges, int count, int threads,
+                                  time_t reference, LogStatistics *stats) {
+    RestoreQueue queue = {ranges, count > 0 ? calloc((size_t)count, sizeof(*queue.paths)) : NULL, count, 0};
+    LogRange *files = count > 0 ? calloc((size_t)count, sizeof(LogRange)) : NULL;
+    if (!queue.paths || !files) {
+        free(queue.paths);
+        free(files);
+        memset(stats, 0, sizeof(*stats));
+        stats->reference = reference;
+        return false;
+    }
+
+    // A raw segment may have been compressed and removed since the listing;
+    // the archive restores to the same bytes, so the range still applies
+    int compressed = 0;
+    for (int i = 0; i < count; i++) {
+        LogSegment *segment = &ranges[i].segment;
+        if (!segment->compressed && !file_readable(segment->path) &&
+            strlen(segment->path) + strlen(LOG_ARCHIVE_EXTENSION) < sizeof(segment->path)) {
+            char archive_path[sizeof(segment->path)];
+            snprintf(archive_path, sizeof(archive_path), "%s" LOG_ARCHIVE_EXTENSION, segment->path);
+            if (file_readable(archive_path)) {
+                strcpy(segment->path, archive_path);
+                segment->compressed = 1;
+            }
+        }
+        compressed += segment->compressed;
+    }
+
+    if (compressed > 0) {
+        if (threads <= 0 || threads > LOG_ANALYSIS_MAX_THREADS) {
+            threads = get_log_analysis_threads();
+        }
+        int restorers = threads < compressed ? threads : compressed;
+        void *args[LOG_ANALYSIS_MAX_THREADS];
+        for (int t = 0; t < restorers; t++) {
+            args[t] = &queue;
+        }
+        run_on_threads(restore_worker_main, args, restorers);
+    }
+
+    for (int i = 0; i < count; i++) {
+        files[i].path = ranges[i].segment.compressed ? queue.paths[i] : ranges[i].segment.path;
+        files[i].start = ranges[i].start;
+        files[i].end = ranges[i].end;
+    }
+    bool ok = analyze_ranges(files, count, threads, reference, stats);
+
+    for (int i = 0; i < count; i++) {
+        if (ranges[i].segment.compressed && queue.paths[i][0]) {
+            remove(queue.paths[i]);
+        }
+    }
+    free(files);
+    free(queue.paths);
+    return ok;
+}
+
+bool build_log_set_statistics(int threads, time_t reference, LogStatistics *stats) {
+    LogSegment *segments;
+    int count = list_log_segments(&segments);
+    LogSegmentRange *ranges = count > 0 ? malloc((size_t)count * sizeof(LogSegmentRange)) : NULL;
+    if (!ranges) {
+        if (count > 0) {
+            free(segments);
+        }
+        memset(stats, 0, sizeof(*stats));
+        stats->reference = reference;
+        return false;
+    }
+
+    for (int i = 0; i < count; i++) {
+        ranges[i].segment = segments[i];
+        ranges[i].start = 0;
+        ranges[i].end = LOG_RANGE_END;
+    }
+    bool ok = build_log_segment_statistics(ranges, count, threads, reference, stats);
+    free(ranges);
+    free(segments);
+    return ok;
+}
@@ -0,0 +1,953 @@
+/*
+ * ========================================
+ * Binary Log Implementation - Yapılandırılmış Log Kayıtları
+ * ========================================
+ *
+ * File layout (little-endian):
+ *   header : "SACLOGB1"
+ *   record : u16 size | u8 type | body            (size counts type + body)
+ *     DEFINE : u8 kind (0 format, 1 module) | u32 id | text
+ *     ENTRY  : u8 level | u64 time in microseconds | u32 module id |
+ *              u32 format id | arguments
+ *     TEXT   : the line as the text log would have it
+ * Arguments follow the conversions of the format string: u32 for int-sized
+ * values and '*' widths/precisions, u64 for 64-bit integers and pointers,
+ * doubles as their IEEE bits, strings as u16 length + bytes (0xFFFF: NULL).
+ *
+ * The writer only copies arguments; text is produced when the file is read.
+ * Each file (and each rotated segment) carries the definitions it uses, so
+ * it can be decoded on its own.
+ */
+
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L     // localtime_r
+#endif
+
+#include "../../include/log_binary.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define DEFINE_FORMAT 0
+#define DEFINE_MODULE 1
+
+// size(2) type(1) level(1) time(8) module(4) format(4)
+#define ENTRY_HEADER_SIZE 20
+#define NULL_STRING_LENGTH 0xFFFF
+
+typedef enum {
+    ARG_INT,
+    ARG_LONG,
+    ARG_DOUBLE,
+    ARG_STRING,
+    ARG_POINTER
+} ArgType;
+
+// One conversion of a format string, e.g. "%-8.3lld"
+typedef struct {
+    uint16_t start;             // offset of '%'
+    uint16_t length;            // through the conversion character
+    uint8_t type;
+    char conversion;
+    char modifier;              // 0, 'H' (hh), 'h', 'l', 'q' (ll), 'j', 'z', 't'
+    uint8_t star_width;
+    uint8_t star_precision;
+    int16_t precision;          // -1 when not given
+} Conversion;
+
+// ========================================
+// Format strings
+// ========================================
+
+static ArgType integer_arg_type(char modifier) {
+    switch (modifier) {
+        case 'q':
+        case 'j': return ARG_LONG;
+        case 'l': return sizeof(long) == 8 ? ARG_LONG : ARG_INT;
+        case 'z': return sizeof(size_t) == 8 ? ARG_LONG : ARG_INT;
+        case 't': return sizeof(ptrdiff_t) == 8 ? ARG_LONG : ARG_INT;
+        default:  return ARG_INT;
+    }
+}
+
+// Returns the number of conversions, or -1 when the format uses something
+// that cannot be stored as plain values (%n, long double, wide strings)
+static int parse_conversions(const char *format, Conversion *conversions, int max) {
+    if (strlen(format) >= LOG_BINARY_FORMAT_MAX) {
+        return -1;
+    }
+
+    int count = 0;
+    for (const char *p = format; *p; p++) {
+        if (*p != '%') {
+            continue;
+        }
+        if (p[1] == '%') {
+            p++;
+            continue;
+        }
+        if (count == max) {
+            return -1;
+        }
+
+        Conversion *c = &conversions[count];
+        memset(c, 0, sizeof(*c));
+        c->start = (uint16_t)(p - format);
+        c->precision = -1;
+
+        const char *q = p + 1;
+        while (*q == '-' || *q == '+' || *q == ' ' || *q == '#' || *q == '0') {
+            q++;
+        }
+        if (*q == '*') {
+            c->star_width = 1;
+            q++;
+        } else {
+            while (*q >= '0' && *q <= '9') {
+                q++;
+            }
+        }
+        if (*q == '.') {
+            q++;
+            if (*q == '*') {
+                c->star_precision = 1;
+                q++;
+            } else {
+                int precision = 0;
+                while (*q >= '0' && *q <= '9') {
+                    if (precision < 10000) {
+                        precision = precision * 10 + (*q - '0');
+                    }
+                    q++;
+                }
+                c->precision = (int16_t)(precision < 10000 ? precision : 10000);
+            }
+        }
+
+        if (*q == 'h' || *q == 'l') {
+            if (q[1] == *q) {
+                c->modifier = *q == 'h' ? 'H' : 'q';
+                q += 2;
+            } else {
+                c->modifier = *q++;
+            }
+        } else if (*q == 'j' || *q == 'z' || *q == 't') {
+            c->modifier = *q++;
+        }
+
+        c->conversion = *q;
+        switch (*q) {
+            case 'd': case 'i': case 'u': case 'o': case 'x': case 'X':
+                c->type = (uint8_t)integer_arg_type(c->modifier);
+                break;
+            case 'c':
+                if (c->modifier) return -1;
+                c->type = ARG_INT;
+                break;
+            case 's':
+                if (c->modifier) return -1;
+                c->type = ARG_STRING;
+                break;
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+                if (c->modifier && c->modifier != 'l') return -1;
+                c->type = ARG_DOUBLE;
+                break;
+            case 'p':
+                if (c->modifier) return -1;
+                c->type = ARG_POINTER;
+                break;
+            default:
+                return -1;
+        }
+
+        c->length = (uint16_t)(q + 1 - p);
+        p = q;
+        count++;
+    }
+
+    return count;
+}
+
+static int is_signed_conversion(char conversion) {
+    return conversion == 'd' || conversion == 'i' || conversion == 'c';
+}
+
+// Reads an integer argument with the type its length modifier names
+static uint64_t read_integer_arg(const Conversion *c, va_list *values) {
+    if (is_signed_conversion(c->conversion)) {
+        switch (c->modifier) {
+            case 'H': return (uint64_t)(int64_t)(signed char)va_arg(*values, int);
+            case 'h': return (uint64_t)(int64_t)(short)va_arg(*values, int);
+            case 'l': return (uint64_t)(int64_t)va_arg(*values, long);
+            case 'q': return (uint64_t)(int64_t)va_arg(*values, long long);
+            case 'j': return (uint64_t)(int64_t)va_arg(*values, intmax_t);
+            case 'z': return (uint64_t)va_arg(*values, size_t);
+            case 't': return (uint64_t)(int64_t)va_arg(*values, ptrdiff_t);
+            default:  return (uint64_t)(int64_t)va_arg(*values, int);
+        }
+    }
+
+    switch (c->modifier) {
+        case 'H': return (unsigned char)va_arg(*values, unsigned int);
+        case 'h': return (unsigned short)va_arg(*values, unsigned int);
+        case 'l': return va_arg(*values, unsigned long);
+        case 'q': return va_arg(*values, unsigned long long);
+        case 'j': return va_arg(*values, uintmax_t);
+        case 'z': return va_arg(*values, size_t);
+        case 't': return (uint64_t)va_arg(*values, ptrdiff_t);
+        default:  return va_arg(*values, unsigned int);
+    }
+}
+
+// ========================================
+// Little-endian helpers
+// ========================================
+
+static void write_u16_le(char *p, uint16_t value) {
+    p[0] = (char)(value & 0xFF);
+    p[1] = (char)(value >> 8);
+}
+
+static void write_u32_le(char *p, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        p[i] = (char)((value >> (8 * i)) & 0xFF);
+    }
+}
+
+static void write_u64_le(char *p, uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        p[i] = (char)((value >> (8 * i)) & 0xFF);
+    }
+}
+
+static uint16_t read_u16_le(const unsigned char *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t read_u32_le(const unsigned char *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint64_t read_u64_le(const unsigned char *p) {
+    return (uint64_t)read_u32_le(p) | ((uint64_t)read_u32_le(p + 4) << 32);
+}
+
+static int put_u32(char *out, size_t capacity, size_t *pos, uint32_t value) {
+    if (capacity - *pos < 4) {
+        return 0;
+    }
+    write_u32_le(out + *pos, value);
+    *pos += 4;
+    return 1;
+}
+
+static int put_u64(char *out, size_t capacity, size_t *pos, uint64_t value) {
+    if (capacity - *pos < 8) {
+        return 0;
+    }
+    write_u64_le(out + *pos, value);
+    *pos += 8;
+    return 1;
+}
+
+// Strings are cut to the precision and to the space left in the record
+static int put_string(char *out, size_t capacity, size_t *pos, const char *text, int precision) {
+    if (capacity - *pos < 2) {
+        return 0;
+    }
+    if (!text) {
+        write_u16_le(out + *pos, NULL_STRING_LENGTH);
+        *pos += 2;
+        return 1;
+    }
+
+    size_t limit = capacity - *pos - 2;
+    if (precision >= 0 && (size_t)precision < limit) {
+        limit = (size_t)precision;
+    }
+    if (limit > NULL_STRING_LENGTH - 1) {
+        limit = NULL_STRING_LENGTH - 1;
+    }
+
+    size_t length = 0;
+    while (length < limit && text[length]) {
+        length++;
+    }
+
+    write_u16_le(out + *pos, (uint16_t)length);
+    memcpy(out + *pos + 2, text, length);
+    *pos += 2 + length;
+    return 1;
+}
+
+// ========================================
+// Interned format strings and module names
+// ========================================
+
+typedef struct {
+    uint64_t hash;              // 0: free slot
+    int ready;                  // set once the fields below are filled
+    int kind;
+    char *key;                  // the string the caller passed
+    const char *text;           // what definitions carry (module names are shortened)
+    int conversion_count;       // -1: arguments cannot be encoded
+    Conversion *conversions;
+} InternEntry;
+
+static InternEntry g_intern[LOG_BINARY_MAX_IDS];
+
+static uint64_t hash_string(const char *text, int kind) {
+    uint64_t hash = 1469598103934665603ULL;
+    for (const unsigned char *p = (const unsigned char *)text; *p; p++) {
+        hash ^= *p;
+        hash *= 1099511628211ULL;
+    }
+    hash ^= (uint64_t)(kind + 1);
+    hash *= 1099511628211ULL;
+    return hash ? hash : 1;
+}
+
+static char* copy_string(const char *text, size_t length) {
+    char *copy = malloc(length + 1);
+    if (copy) {
+        memcpy(copy, text, length);
+        copy[length] = '\0';
+    }
+    return copy;
+}
+
+// __FILE__ such as "src/modules/network_monitor.c" becomes "network_monitor"
+static char* module_display_name(const char *path) {
+    const char *base = path;
+    for (const char *p = path; *p; p++) {
+        if (*p == '/' || *p == '\\') {
+            base = p + 1;
+        }
+    }
+    const char *dot = strrchr(base, '.');
+    return copy_string(base, dot && dot != base ? (size_t)(dot - base) : strlen(base));
+}
+
+static void fill_intern_entry(InternEntry *entry, const char *key, int kind) {
+    entry->kind = kind;
+    entry->conversion_count = -1;
+    entry->key = copy_string(key, strlen(key));
+    if (!entry->key) {
+        return;
+    }
+
+    if (kind == DEFINE_MODULE) {
+        char *name = module_display_name(key);
+        entry->text = name ? name : entry->key;
+        return;
+    }
+
+    entry->text = entry->key;
+    Conversion conversions[LOG_BINARY_MAX_ARGS];
+    int count = parse_conversions(key, conversions, LOG_BINARY_MAX_ARGS);
+    if (count > 0) {
+        entry->conversions = malloc((size_t)count * sizeof(Conversion));
+        if (entry->conversions) {
+            memcpy(entry->conversions, conversions, (size_t)count * sizeof(Conversion));
+            entry->conversion_count = count;
+        }
+    } else {
+        entry->conversion_count = count;
+    }
+}
+
+// Returns the id (index + 1), or 0 when the table is full.
+// Lock-free: the first thread to claim a slot fills it, others wait for ready.
+static uint32_t intern_string(const char *key, int kind) {
+    uint64_t hash = hash_string(key, kind);
+
+    for (uint32_t probe = 0; probe < LOG_BINARY_MAX_IDS; probe++) {
+        uint32_t index = (uint32_t)(hash + probe) & (LOG_BINARY_MAX_IDS - 1);
+        InternEntry *entry = &g_intern[index];
+        uint64_t current = __atomic_load_n(&entry->hash, __ATOMIC_ACQUIRE);
+
+        if (current == 0) {
+            if (__atomic_compare_exchange_n(&entry->hash, &current, hash, false,
+                                            __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+                fill_intern_entry(entry, key, kind);
+                __atomic_store_n(&entry->ready, 1, __ATOMIC_RELEASE);
+                return entry->key ? index + 1 : 0;
+            }
+        }
+
+        if (current != hash) {
+            continue;
+        }
+        while (!__atomic_load_n(&entry->ready, __ATOMIC_ACQUIRE)) {
+            // another thread is copying the string
+        }
+        if (entry->key && entry->kind == kind && strcmp(entry->key, key) == 0) {
+            return index + 1;
+        }
+    }
+
+    return 0;
+}
+
+static const InternEntry* interned(uint32_t id) {
+    if (id == 0 || id > LOG_BINARY_MAX_IDS) {
+        return NULL;
+    }
+    const InternEntry *entry = &g_intern[id - 1];
+    return __atomic_load_n(&entry->ready, __ATOMIC_ACQUIRE) && entry->key ? entry : NULL;
+}
+
+// ========================================
+// Writer side
+// ========================================
+
+int encode_log_record(char *out, size_t capacity, const char *module, LogLevel level,
+                      uint64_t time_us, const char *format, va_list args) {
+    if (capacity < ENTRY_HEADER_SIZE || capacity > 0xFFFF + 2) {
+        return -1;
+    }
+
+    uint32_t module_id = intern_string(module ? module : "", DEFINE_MODULE);
+    uint32_t format_id = intern_string(format, DEFINE_FORMAT);
+    const InternEntry *entry = interned(format_id);
+    if (!module_id || !entry || entry->conversion_count < 0) {
+        return -1;
+    }
+
+    size_t pos = ENTRY_HEADER_SIZE;
+    int ok = 1;
+    va_list values;
+    va_copy(values, args);
+
+    for (int i = 0; i < entry->conversion_count && ok; i++) {
+        const Conversion *c = &entry->conversions[i];
+        int star_precision = -1;
+
+        if (c->star_width) {
+            ok = put_u32(out, capacity, &pos, (uint32_t)va_arg(values, int));
+        }
+        if (ok && c->star_precision) {
+            star_precision = va_arg(values, int);
+            ok = put_u32(out, capacity, &pos, (uint32_t)star_precision);
+        }
+        if (!ok) {
+            break;
+        }
+
+        switch (c->type) {
+            case ARG_INT:
+                ok = put_u32(out, capacity, &pos, (uint32_t)read_integer_arg(c, &values));
+                break;
+            case ARG_LONG:
+                ok = put_u64(out, capacity, &pos, read_integer_arg(c, &values));
+                break;
+            case ARG_DOUBLE: {
+                double value = va_arg(values, double);
+                uint64_t bits;
+                memcpy(&bits, &value, sizeof(bits));
+                ok = put_u64(out, capacity, &pos, bits);
+                break;
+            }
+            case ARG_POINTER:
+                ok = put_u64(out, capacity, &pos, (uint64_t)(uintptr_t)va_arg(values, void *));
+                break;
+            case ARG_STRING:
+                ok = put_string(out, capacity, &pos, va_arg(values, const char *),
+                                c->precision >= 0 ? c->precision : star_precision);
+                break;
+        }
+    }
+    va_end(values);
+
+    if (!ok) {
+        return -1;
+    }
+
+    write_u16_le(out, (uint16_t)(pos - 2));
+    out[2] = LOG_RECORD_ENTRY;
+    out[3] = (char)level;
+    write_u64_le(out + 4, time_us);
+    write_u32_le(out + 12, module_id);
+    write_u32_le(out + 16, format_id);
+    return (int)pos;
+}
+
+void get_log_record_ids(const char *record, uint32_t *module_id, uint32_t *format_id) {
+    *module_id = read_u32_le((const unsigned char *)record + 12);
+    *format_id = read_u32_le((const unsigned char *)record + 16);
+}
+
+size_t write_log_definition(uint32_t id, char *out, size_t capacity) {
+    const InternEntry *entry = interned(id);
+    if (!entry) {
+        return 0;
+    }
+
+    size_t length = strlen(entry->text);
+    if (length + 8 > capacity) {
+        return 0;
+    }
+
+    write_u16_le(out, (uint16_t)(length + 6));
+    out[2] = LOG_RECORD_DEFINE;
+    out[3] = (char)entry->kind;
+    write_u32_le(out + 4, id);
+    memcpy(out + 8, entry->text, length);
+    return length + 8;
+}
+
+size_t write_log_text_header(char *out, size_t text_length) {
+    write_u16_le(out, (uint16_t)(text_length + 1));
+    out[2] = LOG_RECORD_TEXT;
+    return LOG_BINARY_TEXT_HEADER_SIZE;
+}
+
+// ========================================
+// Rendering
+// ========================================
+
+static const char level_letters[] = "DIWE";
+
+static void append_text(char *out, size_t capacity, size_t *length, const char *text, size_t text_length) {
+    if (*length + 1 >= capacity) {
+        return;
+    }
+    size_t room = capacity - 1 - *length;
+    if (text_length > room) {
+        text_length = room;
+    }
+    memcpy(out + *length, text, text_length);
+    *length += text_length;
+    out[*length] = '\0';
+}
+
+// Literal part of a format string; "%%" becomes "%"
+static void append_literal(char *out, size_t capacity, size_t *length, const char *text, size_t text_length) {
+    for (size_t i = 0; i < text_length; i++) {
+        if (text[i] == '%' && i + 1 < text_length && text[i + 1] == '%') {
+            i++;
+        }
+        append_text(out, capacity, length, text + i, 1);
+    }
+}
+
+// snprintf with the stored values. The length modifier of the original
+// conversion is replaced: 64-bit values use "ll", the rest none.
+static void append_conversion(char *out, size_t capacity, size_t *length, const char *format,
+                              const Conversion *c, const unsigned char **args, const unsigned char *end) {
+    char spec[64];
+    size_t spec_length = 0;
+    for (int i = 0; i < c->length - 1 && spec_length < sizeof(spec) - 4; i++) {
+        char ch = format[c->start + i];
+        if (i > 0 && strchr("hljzt", ch)) {
+            continue;
+        }
+        spec[spec_length++] = ch;
+    }
+    if (c->type == ARG_LONG) {
+        spec[spec_length++] = 'l';
+        spec[spec_length++] = 'l';
+    }
+    spec[spec_length++] = c->conversion;
+    spec[spec_length] = '\0';
+
+    int stars[2];
+    int star_count = 0;
+    for (int i = 0; i < c->star_width + c->star_precision; i++) {
+        if (end - *args < 4) {
+            append_text(out, capacity, length, "<?>", 3);
+            *args = end;
+            return;
+        }
+        stars[star_count++] = (int)read_u32_le(*args);
+        *args += 4;
+    }
+    size_t needed = c->type == ARG_INT ? 4 : c->type == ARG_STRING ? 2 : 8;
+    if ((size_t)(end - *args) < needed) {
+        append_text(out, capacity, length, "<?>", 3);
+        *args = end;
+        return;
+    }
+
+    char text[LOG_LINE_MAX];
+    int written = 0;
+
+#define FORMAT_VALUE(value) \
+    (star_count == 0 ? snprintf(text, sizeof(text), spec, value) : \
+     star_count == 1 ? snprintf(text, sizeof(text), spec, stars[0], value) : \
+                       snprintf(text, sizeof(text), spec, stars[0], stars[1], value))
+
+    switch (c->type) {
+        case ARG_INT: {
+            uint32_t value = read_u32_le(*args);
+            *args += 4;
+            written = is_signed_conversion(c->conversion) ? FORMAT_VALUE((int)value) : FORMAT_VALUE(value);
+            break;
+        }
+        case ARG_LONG: {
+            uint64_t value = read_u64_le(*args);
+            *args += 8;
+            written = is_signed_conversion(c->conversion) ? FORMAT_VALUE((long long)value)
+                                                          : FORMAT_VALUE((unsigned long long)value);
+            break;
+        }
+        case ARG_DOUBLE: {
+            uint64_t bits = read_u64_le(*args);
+            double value;
+            memcpy(&value, &bits, sizeof(value));
+            *args += 8;
+            written = FORMAT_VALUE(value);
+            break;
+        }
+        case ARG_POINTER: {
+            uint64_t value = read_u64_le(*args);
+            *args += 8;
+            written = FORMAT_VALUE((void *)(uintptr_t)value);
+            break;
+        }
+        case ARG_STRING: {
+            uint16_t string_length = read_u16_le(*args);
+            *args += 2;
+            if (string_length == NULL_STRING_LENGTH) {
+                written = FORMAT_VALUE((const char *)NULL);
+                break;
+            }
+            if ((size_t)(end - *args) < string_length) {
+                string_length = (uint16_t)(end - *args);
+            }
+            char value[LOG_LINE_MAX];
+            size_t copy_length = string_length < sizeof(value) ? string_length : sizeof(value) - 1;
+            memcpy(value, *args, copy_length);
+            value[copy_length] = '\0';
+            *args += string_length;
+            written = FORMAT_VALUE(value);
+            break;
+        }
+    }
+
+#undef FORMAT_VALUE
+
+    if (written > 0) {
+        append_text(out, capacity, length, text, (size_t)written < sizeof(text) ? (size_t)written : sizeof(text) - 1);
+    }
+}
+
+static size_t format_message(const char *format, const Conversion *conversions, int conversion_count,
+                             const unsigned char *args, const unsigned char *end,
+                             char *out, size_t capacity) {
+    size_t length = 0;
+    size_t literal_start = 0;
+    out[0] = '\0';
+
+    for (int i = 0; i < conversion_count; i++) {
+        const Conversion *c = &conversions[i];
+        append_literal(out, capacity, &length, format + literal_start, c->start - literal_start);
+        append_conversion(out, capacity, &length, format, c, &args, end);
+        literal_start = c->start + c->length;
+    }
+    append_literal(out, capacity, &length, format + literal_start, strlen(format + literal_start));
+
+    return length;
+}
+
+static void format_record_time(char *out, size_t size, time_t timestamp, long microseconds,
+                               LogRenderStyle style) {
+    struct tm timeinfo;
+#ifdef _WIN32
+    localtime_s(&timeinfo, &timestamp);
+#else
+    localtime_r(&timestamp, &timeinfo);
+#endif
+
+    if (style == LOG_RENDER_LOGCAT) {
+        size_t length = strftime(out, size, "%m-%d %H:%M:%S", &timeinfo);
+        if (length > 0 && length + 4 < size) {
+            snprintf(out + length, size - length, ".%03d", (int)(microseconds / 1000 % 1000));
+        }
+    } else {
+        strftime(out, size, "%Y-%m-%d %H:%M:%S", &timeinfo);
+    }
+}
+
+// Used by the logger when an entry must go to a text file
+size_t render_log_record_line(const char *record, size_t length, char *out, size_t capacity) {
+    const unsigned char *bytes = (const unsigned char *)record;
+    if (length < ENTRY_HEADER_SIZE || capacity < 64) {
+        return 0;
+    }
+
+    uint64_t time_us = read_u64_le(bytes + 4);
+    uint32_t module_id;
+    uint32_t format_id;
+    get_log_record_ids(record, &module_id, &format_id);
+    const InternEntry *entry = interned(format_id);
+
+    char timestamp[32];
+    format_record_time(timestamp, sizeof(timestamp), (time_t)(time_us / 1000000), 0, LOG_RENDER_TEXT);
+    size_t written = (size_t)snprintf(out, capacity, "[%s] %s: ", timestamp,
+                                      get_log_level_string((LogLevel)bytes[3]));
+
+    if (entry && entry->conversion_count >= 0) {
+        written += format_message(entry->text, entry->conversions, entry->conversion_count,
+                                  bytes + ENTRY_HEADER_SIZE, bytes + length,
+                                  out + written, capacity - written - 1);
+    }
+    out[written++] = '\n';
+    out[written] = '\0';
+    return written;
+}
+
+// ========================================
+// Reader side
+// ========================================
+
+typedef struct {
+    int kind;
+    char *text;
+    int conversion_count;
+    Conversion *conversions;
+} Definition;
+
+struct LogBinaryReader {
+    FILE *file;
+    Definition definitions[LOG_BINARY_MAX_IDS + 1];
+    unsigned char buffer[0xFFFF];
+};
+
+LogBinaryReader* open_binary_log(const char *path) {
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return NULL;
+    }
+
+    char magic[LOG_BINARY_MAGIC_SIZE];
+    if (fread(magic, 1, sizeof(magic), file) != sizeof(magic) ||
+        memcmp(magic, LOG_BINARY_MAGIC, LOG_BINARY_MAGIC_SIZE) != 0) {
+        fclose(file);
+        return NULL;
+    }
+
+    LogBinaryReader *reader = calloc(1, sizeof(LogBinaryReader));
+    if (!reader) {
+        fclose(file);
+        return NULL;
+    }
+    reader->file = file;
+    setvbuf(file, NULL, _IOFBF, 1024 * 1024);
+    return reader;
+}
+
+bool is_binary_log_file(const char *path) {
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+
+    char magic[LOG_BINARY_MAGIC_SIZE];
+    bool binary = fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+                  memcmp(magic, LOG_BINARY_MAGIC, LOG_BINARY_MAGIC_SIZE) == 0;
+    fclose(file);
+    return binary;
+}
+
+void close_binary_log(LogBinaryReader *reader) {
+    if (!reader) {
+        return;
+    }
+    for (int i = 0; i <= LOG_BINARY_MAX_IDS; i++) {
+        free(reader->definitions[i].text);
+        free(reader->definitions[i].conversions);
+    }
+    fclose(reader->file);
+    free(reader);
+}
+
+static int read_definition(LogBinaryReader *reader, const unsigned char *body, size_t size) {
+    if (size < 6) {
+        return 0;
+    }
+    uint32_t id = read_u32_le(body + 2);
+    if (id == 0 || id > LOG_BINARY_MAX_IDS) {
+        return 0;
+    }
+
+    Definition *definition = &reader->definitions[id];
+    free(definition->text);
+    free(definition->conversions);
+    memset(definition, 0, sizeof(*definition));
+
+    definition->kind = body[1];
+    definition->text = copy_string((const char *)body + 6, size - 6);
+    definition->conversion_count = -1;
+    if (!definition->text) {
+        return 0;
+    }
+
+    if (definition->kind == DEFINE_FORMAT) {
+        Conversion conversions[LOG_BINARY_MAX_ARGS];
+        int count = parse_conversions(definition->text, conversions, LOG_BINARY_MAX_ARGS);
+        if (count > 0) {
+            definition->conversions = malloc((size_t)count * sizeof(Conversion));
+            if (!definition->conversions) {
+                return 0;
+            }
+            memcpy(definition->conversions, conversions, (size_t)count * sizeof(Conversion));
+        }
+        definition->conversion_count = count;
+    }
+    return 1;
+}
+
+// "[2024-01-31 12:00:00] LEVEL: message" as written by the text logger
+static void read_text_line(const unsigned char *body, size_t size, LogBinaryRecord *record, int render_message) {
+    char line[LOG_LINE_MAX];
+    size_t length = size - 1 < sizeof(line) - 1 ? size - 1 : sizeof(line) - 1;
+    memcpy(line, body + 1, length);
+    line[length] = '\0';
+    while (length > 0 && (line[length - 1] == '\n' || line[length - 1] == '\r')) {
+        line[--length] = '\0';
+    }
+
+    record->timestamp = 0;
+    record->level = LOG_INFO;
+    const char *message = line;
+
+    struct tm timeinfo;
+    memset(&timeinfo, 0, sizeof(timeinfo));
+    if (sscanf(line, "[%d-%d-%d %d:%d:%d", &timeinfo.tm_year, &timeinfo.tm_mon, &timeinfo.tm_mday,
+               &timeinfo.tm_hour, &timeinfo.tm_min, &timeinfo.tm_sec) == 6) {
+        timeinfo.tm_year -= 1900;
+        timeinfo.tm_mon -= 1;
+        timeinfo.tm_isdst = -1;
+        record->timestamp = mktime(&timeinfo);
+    }
+
+    const char *level = strstr(line, "] ");
+    if (level) {
+        level += 2;
+        for (int i = LOG_DEBUG; i <= LOG_ERROR; i++) {
+            const char *name = get_log_level_string((LogLevel)i);
+            size_t name_length = strlen(name);
+            if (strncmp(level, name, name_length) == 0 && level[name_length] == ':') {
+                record->level = (LogLevel)i;
+                message = level + name_length + 1;
+                if (*message == ' ') {
+                    message++;
+                }
+                break;
+            }
+        }
+    }
+
+    if (render_message) {
+        snprintf(record->message, sizeof(record->message), "%s", message);
+    }
+}
+
+int read_binary_log_record(LogBinaryReader *reader, LogBinaryRecord *record, int render_message) {
+    for (;;) {
+        unsigned char size_bytes[2];
+        size_t got = fread(size_bytes, 1, 2, reader->file);
+        if (got == 0) {
+            return 0;
+        }
+        if (got != 2) {
+            return -1;
+        }
+
+        size_t size = read_u16_le(size_bytes);
+        if (size == 0 || fread(reader->buffer, 1, size, reader->file) != size) {
+            return -1;
+        }
+
+        const unsigned char *body = reader->buffer;
+        switch (body[0]) {
+            case LOG_RECORD_DEFINE:
+                if (!read_definition(reader, body, size)) {
+                    return -1;
+                }
+                continue;
+
+            case LOG_RECORD_ENTRY: {
+                if (size < ENTRY_HEADER_SIZE - 2) {
+                    return -1;
+                }
+                uint64_t time_us = read_u64_le(body + 2);
+                uint32_t module_id = read_u32_le(body + 10);
+                uint32_t format_id = read_u32_le(body + 14);
+                const Definition *module = module_id <= LOG_BINARY_MAX_IDS ? &reader->definitions[module_id] : NULL;
+                const Definition *format = format_id <= LOG_BINARY_MAX_IDS ? &reader->definitions[format_id] : NULL;
+
+                record->type = LOG_RECORD_ENTRY;
+                record->timestamp = (time_t)(time_us / 1000000);
+                record->microseconds = (long)(time_us % 1000000);
+                record->level = body[1] <= LOG_ERROR ? (LogLevel)body[1] : LOG_ERROR;
+                record->module = module && module->text ? module->text : "?";
+                record->format = format ? format->text : NULL;
+
+                if (render_message) {
+                    if (format && format->text && format->conversion_count >= 0) {
+                        format_message(format->text, format->conversions, format->conversion_count,
+                                       body + ENTRY_HEADER_SIZE - 2, body + size,
+                                       record->message, sizeof(record->message));
+                    } else {
+                        snprintf(record->message, sizeof(record->message), "<unknown format %u>", format_id);
+                    }
+                }
+                return 1;
+            }
+
+            case LOG_RECORD_TEXT:
+                record->type = LOG_RECORD_TEXT;
+                record->microseconds = 0;
+                record->module = "";
+                record->format = NULL;
+                read_text_line(body, size, record, render_message);
+                return 1;
+
+            default:
+                // Unknown record types from newer writers are skipped
+                continue;
+        }
+    }
+}
+
+long render_binary_log(const char *path, FILE *output, LogRenderStyle style, LogLevel min_level) {
+    LogBinaryReader *reader = open_binary_log(path);
+    if (!reader) {
+        return -1;
+    }
+
+    LogBinaryRecord *record = malloc(sizeof(LogBinaryRecord));
+    if (!record) {
+        close_binary_log(reader);
+        return -1;
+    }
+
+    long lines = 0;
+    int status;
+    while ((status = read_binary_log_record(reader, record, 1)) > 0) {
+        if (record->level < min_level) {
+            continue;
+        }
+
+        char timestamp[32];
+        format_record_time(timestamp, sizeof(timestamp), record->timestamp, record->microseconds, style);
+
+        if (style == LOG_RENDER_LOGCAT) {
+            fprintf(output, "%s %c %s%s%s\n", timestamp, level_letters[record->level],
+                    record->module, record->module[0] ? ": " : "", record->message);
+        } else {
+            fprintf(output, "[%s] %s: %s\n", timestamp, get_log_level_string(record->level),
+                    record->message);
+        }
+        lines++;
+    }
+
+    free(record);
+    close_binary_log(reader);
+    return status < 0 ? -1 : lines;
+}
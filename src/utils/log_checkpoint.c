@@ -0,0 +1,357 @@
+/*
+ * ========================================
+ * Log Checkpoint Implementation - Artımlı Log Analizi
+ * ========================================
+ *
+ * The logger only appends to its active file and renames it when it
+ * rotates, so everything before a known offset of a known file stays as it
+ * was. A checkpoint in log_checkpoints records that position together with
+ * the statistics up to it; the next update analyzes the bytes after it and
+ * merges the result, so its cost follows the new data rather than the size
+ * of the history.
+ *
+ * The file is identified by device and inode (volume serial and file index
+ * on Windows): a different inode under the active path means the old file
+ * was rotated. Rotated segments are named by rotation time, so the former
+ * active file is the oldest segment newer than the last one counted, even
+ * after the archive thread has compressed it. A checkpoint only covers whole
+ * lines; a line still being written is left for the next update.
+ */
+
+#include "../../include/log_checkpoint.h"
+#include "../../include/log_scanner.h"
+#include "../../include/db_pool.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+// Bytes read back from the end per step when looking for the last newline
+#define LINE_END_SEARCH_STEP (64 * 1024)
+
+typedef struct {
+    const char *log_path;
+    LogFileId id;
+    uint64_t offset;            // after the last complete line counted
+    uint64_t head_hash;
+    char last_segment[256];     // newest rotated segment counted, "" if none
+    LogStatistics stats;
+} LogCheckpoint;
+
+// Updates read, analyze and store in one go; two at once would both start
+// from the same checkpoint and the later one would simply win
+static pthread_mutex_t g_checkpoint_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+bool create_log_checkpoint_table(void) {
+    const char *sql =
+        "CREATE TABLE IF NOT EXISTS log_checkpoints ("
+        "log_path TEXT PRIMARY KEY,"
+        "device INTEGER NOT NULL,"
+        "inode INTEGER NOT NULL,"
+        "offset INTEGER NOT NULL,"
+        "head_hash INTEGER NOT NULL,"
+        "last_segment TEXT NOT NULL,"
+        "format INTEGER NOT NULL,"
+        "stats BLOB NOT NULL,"
+        "updated_at INTEGER NOT NULL"
+        ");";
+
+    return execute_query(sql);
+}
+
+// ========================================
+// Active file
+// ========================================
+
+static bool record_line_end(const LogBlock *block, void *context) {
+    uint64_t *end = context;
+
+    // Blocks start at line starts, so the byte before one is a newline
+    if (block->offset > *end) {
+        *end = block->offset;
+    }
+    for (size_t i = block->length; i > 0; i--) {
+        if (block->data[i - 1] == '\n') {
+            if (block->offset + i > *end) {
+                *end = block->offset + i;
+            }
+            break;
+        }
+    }
+    return true;
+}
+
+// Offset after the last newline, 0 if there is none or the file is unreadable
+static uint64_t complete_lines_end(const char *path) {
+    LogScanner *scanner = open_log_scanner(path);
+    if (!scanner) {
+        return 0;
+    }
+
+    uint64_t size = get_log_scanner_size(scanner);
+    uint64_t end = 0;
+    uint64_t start = size;
+    while (start > 0 && end == 0) {
+        start = start > LINE_END_SEARCH_STEP ? start - LINE_END_SEARCH_STEP : 0;
+        if (!scan_log_blocks(scanner, start, size, record_line_end, &end)) {
+            end = 0;
+            break;
+        }
+    }
+
+    close_log_scanner(scanner);
+    return end;
+}
+
+// FNV-1a over the first min(length, LOG_CHECKPOINT_HEAD_BYTES) bytes
+static bool hash_file_head(const char *path, uint64_t length, uint64_t *hash) {
+    unsigned char head[LOG_CHECKPOINT_HEAD_BYTES];
+    size_t wanted = length < sizeof(head) ? (size_t)length : sizeof(head);
+
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+    size_t read = fread(head, 1, wanted, file);
+    fclose(file);
+    if (read != wanted) {
+        return false;
+    }
+
+    *hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < wanted; i++) {
+        *hash ^= head[i];
+        *hash *= 1099511628211ULL;
+    }
+    return true;
+}
+
+// Segment name without the directory and the archive extension; the logger
+// names segments so that this order is the rotation order
+static void segment_key(const LogSegment *segment, char *out, size_t size) {
+    const char *slash = strrchr(segment->path, '/');
+    const char *backslash = strrchr(segment->path, '\\');
+    if (backslash && (!slash || backslash > slash)) {
+        slash = backslash;
+    }
+    const char *name = slash ? slash + 1 : segment->path;
+    size_t length = strlen(name) < size ? strlen(name) : size - 1;
+    memcpy(out, name, length);
+    out[length] = '\0';
+
+    size_t extension = strlen(LOG_ARCHIVE_EXTENSION);
+    if (segment->compressed && length >= extension) {
+        out[length - extension] = '\0';
+    }
+}
+
+// ========================================
+// Stored checkpoint
+// ========================================
+
+static bool load_checkpoint(const char *log_path, LogCheckpoint *checkpoint) {
+    const char *sql = "SELECT device, inode, offset, head_hash, last_segment, stats "
+                      "FROM log_checkpoints WHERE log_path = ? AND format = ?;";
+
+    sqlite3 *conn = db_acquire_reader();
+    sqlite3_stmt *stmt;
+    if (sqlite3_prepare_v2(conn, sql, -1, &stmt, NULL) != SQLITE_OK) {
+        log_error("Failed to prepare statement: %s", sqlite3_errmsg(conn));
+        db_release_reader(conn);
+        return false;
+    }
+
+    sqlite3_bind_text(stmt, 1, log_path, -1, SQLITE_STATIC);
+    sqlite3_bind_int(stmt, 2, LOG_CHECKPOINT_FORMAT);
+
+    bool found = sqlite3_step(stmt) == SQLITE_ROW &&
+                 sqlite3_column_bytes(stmt, 5) == (int)sizeof(LogStatistics);
+    if (found) {
+        checkpoint->log_path = log_path;
+        checkpoint->id.device = (uint64_t)sqlite3_column_int64(stmt, 0);
+        checkpoint->id.inode = (uint64_t)sqlite3_column_int64(stmt, 1);
+        checkpoint->offset = (uint64_t)sqlite3_column_int64(stmt, 2);
+        checkpoint->head_hash = (uint64_t)sqlite3_column_int64(stmt, 3);
+        snprintf(checkpoint->last_segment, sizeof(checkpoint->last_segment), "%s",
+                 (const char*)sqlite3_column_text(stmt, 4));
+        memcpy(&checkpoint->stats, sqlite3_column_blob(stmt, 5), sizeof(LogStatistics));
+    }
+
+    sqlite3_finalize(stmt);
+    db_release_reader(conn);
+    return found;
+}
+
+static bool save_checkpoint_job(void *arg) {
+    const LogCheckpoint *checkpoint = arg;
+    const char *sql = "INSERT INTO log_checkpoints (log_path, device, inode, offset, head_hash, last_segment, "
+                      "format, stats, updated_at) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?) "
+                      "ON CONFLICT(log_path) DO UPDATE SET device = excluded.device, inode = excluded.inode, "
+                      "offset = excluded.offset, head_hash = excluded.head_hash, "
+                      "last_segment = excluded.last_segment, format = excluded.format, "
+                      "stats = excluded.stats, updated_at = excluded.updated_at;";
+
+    sqlite3_stmt *stmt;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK) {
+        log_error("Failed to prepare statement: %s", sqlite3_errmsg(db));
+        return false;
+    }
+
+    sqlite3_bind_text(stmt, 1, checkpoint->log_path, -1, SQLITE_STATIC);
+    sqlite3_bind_int64(stmt, 2, (sqlite3_int64)checkpoint->id.device);
+    sqlite3_bind_int64(stmt, 3, (sqlite3_int64)checkpoint->id.inode);
+    sqlite3_bind_int64(stmt, 4, (sqlite3_int64)checkpoint->offset);
+    sqlite3_bind_int64(stmt, 5, (sqlite3_int64)checkpoint->head_hash);
+    sqlite3_bind_text(stmt, 6, checkpoint->last_segment, -1, SQLITE_STATIC);
+    sqlite3_bind_int(stmt, 7, LOG_CHECKPOINT_FORMAT);
+    sqlite3_bind_blob(stmt, 8, &checkpoint->stats, (int)sizeof(LogStatistics), SQLITE_STATIC);
+    sqlite3_bind_int64(stmt, 9, (sqlite3_int64)time(NULL));
+
+    int rc = sqlite3_step(stmt);
+    sqlite3_finalize(stmt);
+
+    if (rc != SQLITE_DONE) {
+        log_error("Failed to save log checkpoint: %s", sqlite3_errmsg(db));
+        return false;
+    }
+    return true;
+}
+
+static bool clear_log_checkpoints_job(void *arg) {
+    (void)arg;
+    return execute_query("DELETE FROM log_checkpoints;");
+}
+
+bool clear_log_checkpoints(void) {
+    if (!db) {
+        return true;
+    }
+    return db_write(clear_log_checkpoints_job, NULL);
+}
+
+// ========================================
+// Update
+// ========================================
+
+// Ranges after the checkpoint, or false if it does not describe this set
+static bool resume_ranges(const LogCheckpoint *checkpoint, const LogSegment *segments, int count,
+                          const LogFileId *active_id, uint64_t active_end, LogSegmentRange *ranges, int *used) {
+    const char *active = segments[count - 1].path;
+    char key[256];
+
+    // Rotated segments not counted yet, oldest first
+    int first = count - 1;
+    for (int i = 0; i < count - 1; i++) {
+        segment_key(&segments[i], key, sizeof(key));
+        if (strcmp(key, checkpoint->last_segment) > 0) {
+            first = i;
+            break;
+        }
+    }
+
+    uint64_t head_hash;
+    *used = 0;
+    if (same_log_file_id(active_id, &checkpoint->id)) {
+        // Emptied in place (and maybe refilled) instead of rotated
+        if (active_end < checkpoint->offset || !hash_file_head(active, checkpoint->offset, &head_hash) ||
+            head_hash != checkpoint->head_hash) {
+            return false;
+        }
+        for (int i = first; i < count - 1; i++) {
+            ranges[(*used)++] = (LogSegmentRange){ segments[i], 0, LOG_RANGE_END };
+        }
+        ranges[(*used)++] = (LogSegmentRange){ segments[count - 1], checkpoint->offset, active_end };
+        return true;
+    }
+
+    // Rotated: the former active file is the oldest new segment
+    if (first == count - 1) {
+        return false;
+    }
+    ranges[(*used)++] = (LogSegmentRange){ segments[first], checkpoint->offset, LOG_RANGE_END };
+    for (int i = first + 1; i < count - 1; i++) {
+        ranges[(*used)++] = (LogSegmentRange){ segments[i], 0, LOG_RANGE_END };
+    }
+    ranges[(*used)++] = (LogSegmentRange){ segments[count - 1], 0, active_end };
+    return true;
+}
+
+bool update_log_set_statistics(int threads, time_t reference, LogStatistics *stats) {
+    if (!db) {
+        return build_log_set_statistics(threads, reference, stats);
+    }
+
+    LogSegment *segments;
+    int count = list_log_segments(&segments);
+    LogSegmentRange *ranges = count > 0 ? malloc((size_t)count * sizeof(LogSegmentRange)) : NULL;
+    LogCheckpoint *checkpoint = malloc(sizeof(LogCheckpoint));
+    if (!ranges || !checkpoint) {
+        if (count > 0) {
+            free(segments);
+        }
+        free(ranges);
+        free(checkpoint);
+        memset(stats, 0, sizeof(*stats));
+        stats->reference = reference;
+        return false;
+    }
+
+    pthread_mutex_lock(&g_checkpoint_mutex);
+
+    const char *active = segments[count - 1].path;
+    LogFileId active_id;
+    bool identified = get_log_file_id(active, &active_id, NULL);
+    uint64_t active_end = identified ? complete_lines_end(active) : 0;
+
+    int used = 0;
+    bool resumed = identified && load_checkpoint(active, checkpoint) &&
+                   checkpoint->stats.reference <= reference &&
+                   resume_ranges(checkpoint, segments, count, &active_id, active_end, ranges, &used);
+    if (!resumed) {
+        used = 0;
+        for (int i = 0; i < count - 1; i++) {
+            ranges[used++] = (LogSegmentRange){ segments[i], 0, LOG_RANGE_END };
+        }
+        ranges[used++] = (LogSegmentRange){ segments[count - 1], 0, active_end };
+        log_debug("Log checkpoint'i yok veya geçersiz, tüm segmentler analiz ediliyor");
+    }
+
+    // Keys before build_log_segment_statistics may switch a range to its archive
+    char newest[256] = "";
+    if (count > 1) {
+        segment_key(&segments[count - 2], newest, sizeof(newest));
+    }
+    if (resumed && strcmp(checkpoint->last_segment, newest) > 0) {
+        strcpy(newest, checkpoint->last_segment);
+    }
+
+    LogStatistics delta;
+    bool ok = build_log_segment_statistics(ranges, used, threads, reference, &delta);
+    if (resumed) {
+        *stats = checkpoint->stats;
+        merge_log_statistics(stats, &delta);
+        stats->files = count;
+        ok = true;
+    } else {
+        *stats = delta;
+    }
+
+    // A rotation during the analysis leaves the offset without its file
+    LogFileId after;
+    if (ok && identified && get_log_file_id(active, &after, NULL) && same_log_file_id(&after, &active_id) &&
+        hash_file_head(active, active_end, &checkpoint->head_hash)) {
+        checkpoint->log_path = active;
+        checkpoint->id = active_id;
+        checkpoint->offset = active_end;
+        strcpy(checkpoint->last_segment, newest);
+        checkpoint->stats = *stats;
+        db_write(save_checkpoint_job, checkpoint);
+    }
+
+    pthread_mutex_unlock(&g_checkpoint_mutex);
+
+    free(checkpoint);
+    free(ranges);
+    free(segments);
+    return ok;
+}
@@ -0,0 +1,571 @@
+/*
+ * ========================================
+ * Log Follow Implementation - Canlı Log Takibi ve Alarmlar
+ * ========================================
+ *
+ * One thread keeps the followed files open and reads what is appended to
+ * them, like tail -F. On Linux it sleeps on inotify watches of the files'
+ * directories, which report writes, renames and new files by name, so a
+ * line is counted a few milliseconds after the writer flushed it; other
+ * platforms check the files every LOG_FOLLOW_POLL_MS.
+ *
+ * Lines are classified with the analyzer's level check and counted into
+ * per-second buckets covering the last minute. After every wake-up each
+ * level's lines in the window are compared against its threshold; crossing
+ * it raises one alert, kept in memory for the API and stored in log_alerts.
+ * The level needs only the start of a line, so a line split across reads
+ * keeps just its first LINE_PREFIX_MAX bytes.
+ */
+
+#ifndef _WIN32
+    // 64-bit offsets for fseeko, poll and inotify under -std=c99
+    #define _DEFAULT_SOURCE
+    #define _FILE_OFFSET_BITS 64
+#endif
+
+#include "../../include/log_follow.h"
+#include "../../include/log_scanner.h"
+#include "../../include/log_binary.h"
+#include "../../include/db_pool.h"
+#include "../../include/logger.h"
+#include "../../include/platform.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+    #define seek_file _fseeki64
+#else
+    #include <unistd.h>
+    #define seek_file fseeko
+#endif
+
+#ifdef __linux__
+    #include <poll.h>
+    #include <sys/inotify.h>
+    #define LOG_FOLLOW_INOTIFY 1
+#endif
+
+#define READ_BUFFER_SIZE (64 * 1024)
+#define LINE_PREFIX_MAX 64
+
+typedef struct {
+    char path[MAX_PATH_LEN];
+    FILE *file;
+    LogFileId id;
+    uint64_t offset;
+    char prefix[LINE_PREFIX_MAX];   // start of a line the last read ended in
+    size_t prefix_length;
+    size_t line_length;             // whole length of that line so far
+    LogFollowFile *status;
+} FollowedFile;
+
+typedef struct {
+    time_t second;
+    uint32_t counts[LOG_KERNEL_LEVELS + 1];
+} SecondBucket;
+
+static pthread_t g_follow_thread;
+static volatile bool g_follow_running = false;
+
+// Guards g_status and g_window; the thread holds it only while counting
+static pthread_mutex_t g_follow_mutex = PTHREAD_MUTEX_INITIALIZER;
+static LogFollowStatus g_status;
+static SecondBucket g_window[LOG_FOLLOW_WINDOW_SECONDS];
+
+static FollowedFile g_files[LOG_FOLLOW_MAX_FILES];
+static int g_file_count = 0;
+static bool g_alert_active[LOG_KERNEL_LEVELS];
+static char g_read_buffer[READ_BUFFER_SIZE];
+
+#ifdef LOG_FOLLOW_INOTIFY
+static int g_inotify_fd = -1;
+#endif
+
+bool create_log_alert_table(void) {
+    const char *sql =
+        "CREATE TABLE IF NOT EXISTS log_alerts ("
+        "id INTEGER PRIMARY KEY,"
+        "timestamp INTEGER NOT NULL,"
+        "level INTEGER NOT NULL,"
+        "line_count INTEGER NOT NULL,"
+        "threshold INTEGER NOT NULL,"
+        "message TEXT NOT NULL"
+        ");"
+        "CREATE INDEX IF NOT EXISTS idx_log_alerts_timestamp ON log_alerts(timestamp);";
+
+    return execute_query(sql);
+}
+
+void init_log_follow_options(LogFollowOptions *options) {
+    memset(options, 0, sizeof(*options));
+}
+
+void set_log_follow_paths(LogFollowOptions *options, const char *list) {
+    options->path_count = 0;
+    while (list && *list && options->path_count < LOG_FOLLOW_MAX_FILES) {
+        const char *comma = strchr(list, ',');
+        size_t length = comma ? (size_t)(comma - list) : strlen(list);
+        while (length > 0 && *list == ' ') {
+            list++;
+            length--;
+        }
+        while (length > 0 && list[length - 1] == ' ') {
+            length--;
+        }
+        if (length > 0 && length < MAX_PATH_LEN) {
+            char *path = options->paths[options->path_count++];
+            memcpy(path, list, length);
+            path[length] = '\0';
+        }
+        list = comma ? comma + 1 : NULL;
+    }
+}
+
+// ========================================
+// Counting
+// ========================================
+
+static SecondBucket* current_bucket(time_t now) {
+    SecondBucket *bucket = &g_window[now % LOG_FOLLOW_WINDOW_SECONDS];
+    if (bucket->second != now) {
+        memset(bucket, 0, sizeof(*bucket));
+        bucket->second = now;
+    }
+    return bucket;
+}
+
+static void window_counts(time_t now, uint64_t counts[LOG_KERNEL_LEVELS + 1]) {
+    memset(counts, 0, (LOG_KERNEL_LEVELS + 1) * sizeof(uint64_t));
+    for (int i = 0; i < LOG_FOLLOW_WINDOW_SECONDS; i++) {
+        if (g_window[i].second > now - LOG_FOLLOW_WINDOW_SECONDS && g_window[i].second <= now) {
+            for (int column = 0; column <= LOG_KERNEL_LEVELS; column++) {
+                counts[column] += g_window[i].counts[column];
+            }
+        }
+    }
+}
+
+// Caller holds g_follow_mutex
+static void count_line(FollowedFile *followed, SecondBucket *bucket, const char *line, size_t length) {
+    if (length > 0 && line[length - 1] == '\r') {
+        length--;
+    }
+    int level = classify_log_line(line, length);
+    int column = level >= 0 ? level : LOG_KERNEL_LEVELS;
+
+    LogLevelCounts *counts[2] = { &followed->status->counts, &g_status.counts };
+    for (int i = 0; i < 2; i++) {
+        counts[i]->lines++;
+        if (level >= 0) {
+            counts[i]->levels[level]++;
+        } else {
+            counts[i]->unclassified++;
+        }
+    }
+    bucket->counts[column]++;
+}
+
+// A line split across reads is counted once its newline arrives
+static void count_data(FollowedFile *followed, const char *data, size_t length) {
+    const char *end = data + length;
+
+    pthread_mutex_lock(&g_follow_mutex);
+    SecondBucket *bucket = current_bucket(time(NULL));
+    followed->status->bytes += length;
+
+    while (data < end) {
+        const char *newline = memchr(data, '\n', (size_t)(end - data));
+        const char *line_end = newline ? newline : end;
+        size_t piece = (size_t)(line_end - data);
+
+        if (followed->line_length == 0 && newline) {
+            count_line(followed, bucket, data, piece);
+        } else {
+            size_t room = LINE_PREFIX_MAX - followed->prefix_length;
+            size_t kept = piece < room ? piece : room;
+            memcpy(followed->prefix + followed->prefix_length, data, kept);
+            followed->prefix_length += kept;
+            followed->line_length += piece;
+            if (newline) {
+                count_line(followed, bucket, followed->prefix, followed->prefix_length);
+                followed->prefix_length = 0;
+                followed->line_length = 0;
+            }
+        }
+        data = newline ? newline + 1 : end;
+    }
+
+    pthread_mutex_unlock(&g_follow_mutex);
+}
+
+// A line cut off by a rotation or truncation still counts
+static void flush_partial_line(FollowedFile *followed) {
+    if (followed->line_length == 0) {
+        return;
+    }
+    pthread_mutex_lock(&g_follow_mutex);
+    count_line(followed, current_bucket(time(NULL)), followed->prefix, followed->prefix_length);
+    pthread_mutex_unlock(&g_follow_mutex);
+    followed->prefix_length = 0;
+    followed->line_length = 0;
+}
+
+// ========================================
+// Files
+// ========================================
+
+// Binary records have no lines to classify (only render_binary_log decodes
+// them), so the file is closed and left alone until the follow restarts
+static void skip_binary_file(FollowedFile *followed) {
+    if (followed->file) {
+        fclose(followed->file);
+        followed->file = NULL;
+    }
+    followed->status->open = false;
+    followed->status->binary = true;
+    log_warning("Binary log canlı takibe alınmadı: %s", followed->path);
+}
+
+static void open_followed(FollowedFile *followed, bool from_end) {
+    uint64_t size;
+    if (!get_log_file_id(followed->path, &followed->id, &size)) {
+        return;
+    }
+    if (is_binary_log_file(followed->path)) {
+        skip_binary_file(followed);
+        return;
+    }
+    followed->file = fopen(followed->path, "rb");
+    if (!followed->file) {
+        return;
+    }
+    followed->offset = 0;
+    if (from_end && seek_file(followed->file, (long long)size, SEEK_SET) == 0) {
+        followed->offset = size;
+    }
+    followed->status->open = true;
+}
+
+static void close_followed(FollowedFile *followed) {
+    if (followed->file) {
+        fclose(followed->file);
+        followed->file = NULL;
+    }
+    followed->status->open = false;
+}
+
+static void read_appended(FollowedFile *followed) {
+    size_t read;
+    clearerr(followed->file);
+    while ((read = fread(g_read_buffer, 1, sizeof(g_read_buffer), followed->file)) > 0) {
+        // A file that was empty when opened shows its format with the first bytes
+        if (followed->offset == 0 && read >= LOG_BINARY_MAGIC_SIZE &&
+            memcmp(g_read_buffer, LOG_BINARY_MAGIC, LOG_BINARY_MAGIC_SIZE) == 0) {
+            skip_binary_file(followed);
+            return;
+        }
+        count_data(followed, g_read_buffer, read);
+        followed->offset += read;
+    }
+}
+
+static void check_file(FollowedFile *followed) {
+    if (followed->status->binary) {
+        return;
+    }
+    if (!followed->file) {
+        // Created after the start (or after a rotation): read from the beginning
+        open_followed(followed, false);
+        if (!followed->file) {
+            return;
+        }
+    }
+
+    LogFileId id;
+    uint64_t size;
+    if (!get_log_file_id(followed->path, &id, &size)) {
+        // Renamed away and not recreated yet; finish the old file
+        read_appended(followed);
+        return;
+    }
+
+    if (!same_log_file_id(&id, &followed->id)) {
+        read_appended(followed);
+        flush_partial_line(followed);
+        close_followed(followed);
+        followed->status->rotations++;
+        open_followed(followed, false);
+        if (!followed->file) {
+            return;
+        }
+    } else if (size < followed->offset) {
+        flush_partial_line(followed);
+        seek_file(followed->file, 0, SEEK_SET);
+        followed->offset = 0;
+    }
+    read_appended(followed);
+}
+
+// ========================================
+// Alerts
+// ========================================
+
+static bool insert_log_alert_job(void *arg) {
+    const LogAlert *alert = arg;
+    const char *sql = "INSERT INTO log_alerts (timestamp, level, line_count, threshold, message) "
+                      "VALUES (?, ?, ?, ?, ?);";
+
+    sqlite3_stmt *stmt;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK) {
+        log_error("Failed to prepare statement: %s", sqlite3_errmsg(db));
+        return false;
+    }
+
+    sqlite3_bind_int64(stmt, 1, alert->timestamp);
+    sqlite3_bind_int(stmt, 2, alert->level);
+    sqlite3_bind_int(stmt, 3, alert->line_count);
+    sqlite3_bind_int(stmt, 4, alert->threshold);
+    sqlite3_bind_text(stmt, 5, alert->message, -1, SQLITE_STATIC);
+
+    int rc = sqlite3_step(stmt);
+    sqlite3_finalize(stmt);
+
+    if (rc != SQLITE_DONE) {
+        log_error("Failed to insert log alert: %s", sqlite3_errmsg(db));
+        return false;
+    }
+    return true;
+}
+
+static void raise_alert(int level, uint64_t line_count, int threshold, time_t now) {
+    LogAlert alert;
+    alert.timestamp = now;
+    alert.level = level;
+    alert.line_count = (int)line_count;
+    alert.threshold = threshold;
+    snprintf(alert.message, sizeof(alert.message), "Son 1 dakikada %d %s satırı (eşik %d/dk)",
+             alert.line_count, get_log_level_string((LogLevel)level), threshold);
+
+    pthread_mutex_lock(&g_follow_mutex);
+    if (g_status.recent_alert_count == LOG_FOLLOW_RECENT_ALERTS) {
+        memmove(g_status.recent_alerts, g_status.recent_alerts + 1,
+                (LOG_FOLLOW_RECENT_ALERTS - 1) * sizeof(LogAlert));
+        g_status.recent_alert_count--;
+    }
+    g_status.recent_alerts[g_status.recent_alert_count++] = alert;
+    g_status.alert_count++;
+    pthread_mutex_unlock(&g_follow_mutex);
+
+    log_warning("Log alarmı: %s", alert.message);
+    if (db) {
+        db_write(insert_log_alert_job, &alert);
+    }
+}
+
+static void check_alerts(time_t now) {
+    uint64_t counts[LOG_KERNEL_LEVELS + 1];
+    pthread_mutex_lock(&g_follow_mutex);
+    window_counts(now, counts);
+    pthread_mutex_unlock(&g_follow_mutex);
+
+    for (int level = 0; level < LOG_KERNEL_LEVELS; level++) {
+        int threshold = g_status.thresholds[level];
+        if (threshold <= 0) {
+            continue;
+        }
+        if (!g_alert_active[level] && counts[level] > (uint64_t)threshold) {
+            g_alert_active[level] = true;
+            raise_alert(level, counts[level], threshold, now);
+        } else if (g_alert_active[level] && counts[level] <= (uint64_t)threshold) {
+            g_alert_active[level] = false;
+        }
+    }
+}
+
+// ========================================
+// Thread
+// ========================================
+
+#ifdef LOG_FOLLOW_INOTIFY
+// Watches each file's directory: a file's own watch would stay on the
+// renamed file after a rotation and miss the new one
+static bool open_inotify(void) {
+    g_inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (g_inotify_fd < 0) {
+        return false;
+    }
+    for (int i = 0; i < g_file_count; i++) {
+        char dir[MAX_PATH_LEN];
+        const char *slash = strrchr(g_files[i].path, '/');
+        if (slash) {
+            snprintf(dir, sizeof(dir), "%.*s", (int)(slash - g_files[i].path), g_files[i].path);
+        } else {
+            strcpy(dir, ".");
+        }
+        if (inotify_add_watch(g_inotify_fd, dir[0] ? dir : "/",
+                              IN_MODIFY | IN_CREATE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE) < 0) {
+            close(g_inotify_fd);
+            g_inotify_fd = -1;
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
+// Returns when a followed directory changed or after LOG_FOLLOW_POLL_MS
+static void wait_for_change(void) {
+#ifdef LOG_FOLLOW_INOTIFY
+    if (g_inotify_fd >= 0) {
+        struct pollfd fds = { g_inotify_fd, POLLIN, 0 };
+        if (poll(&fds, 1, LOG_FOLLOW_POLL_MS) > 0) {
+            // Which file changed does not matter, every file is checked
+            char events[4096];
+            while (read(g_inotify_fd, events, sizeof(events)) > 0) {
+            }
+        }
+        return;
+    }
+#endif
+    sleep_ms(LOG_FOLLOW_POLL_MS);
+}
+
+static void* follow_thread_main(void *arg) {
+    (void)arg;
+
+    while (g_follow_running) {
+        wait_for_change();
+        for (int i = 0; i < g_file_count && g_follow_running; i++) {
+            check_file(&g_files[i]);
+        }
+        check_alerts(time(NULL));
+    }
+    return NULL;
+}
+
+bool start_log_follow(const LogFollowOptions *options) {
+    if (g_follow_running) {
+        return true;
+    }
+
+    // The logger's own file is only followed while it is written as text
+    if (options->path_count == 0 && get_log_format() == LOG_FORMAT_BINARY) {
+        log_warning("Binary log canlı takip edilemez: %s (log_follow.files ile metin dosyası verin)",
+                    get_log_file_path());
+        return false;
+    }
+
+    LogFollowOptions defaults;
+    if (options->path_count == 0) {
+        defaults = *options;
+        set_log_follow_paths(&defaults, get_log_file_path());
+        options = &defaults;
+    }
+
+    memset(&g_status, 0, sizeof(g_status));
+    memset(g_window, 0, sizeof(g_window));
+    memset(g_files, 0, sizeof(g_files));
+    memset(g_alert_active, 0, sizeof(g_alert_active));
+    memcpy(g_status.thresholds, options->thresholds, sizeof(g_status.thresholds));
+    g_status.started = time(NULL);
+
+    g_file_count = options->path_count;
+    g_status.file_count = g_file_count;
+    for (int i = 0; i < g_file_count; i++) {
+        FollowedFile *followed = &g_files[i];
+        strcpy(followed->path, options->paths[i]);
+        followed->status = &g_status.files[i];
+        strcpy(followed->status->path, followed->path);
+        open_followed(followed, true);
+    }
+
+#ifdef LOG_FOLLOW_INOTIFY
+    g_status.inotify = open_inotify();
+#endif
+
+    g_follow_running = true;
+    g_status.running = true;
+    if (pthread_create(&g_follow_thread, NULL, follow_thread_main, NULL) != 0) {
+        g_follow_running = false;
+        log_error("Log takip thread'i başlatılamadı");
+        stop_log_follow();
+        return false;
+    }
+
+    log_info("Canlı log takibi başladı: %d dosya (%s)", g_file_count,
+             g_status.inotify ? "inotify" : "yoklama");
+    return true;
+}
+
+void stop_log_follow(void) {
+    if (g_follow_running) {
+        g_follow_running = false;
+        pthread_join(g_follow_thread, NULL);
+        log_info("Canlı log takibi durduruldu");
+    }
+
+    for (int i = 0; i < g_file_count; i++) {
+        close_followed(&g_files[i]);
+    }
+#ifdef LOG_FOLLOW_INOTIFY
+    if (g_inotify_fd >= 0) {
+        close(g_inotify_fd);
+        g_inotify_fd = -1;
+    }
+#endif
+
+    pthread_mutex_lock(&g_follow_mutex);
+    g_status.running = false;
+    pthread_mutex_unlock(&g_follow_mutex);
+}
+
+bool is_log_follow_running(void) {
+    return g_follow_running;
+}
+
+void get_log_follow_status(LogFollowStatus *status) {
+    pthread_mutex_lock(&g_follow_mutex);
+    *status = g_status;
+    window_counts(time(NULL), status->last_minute);
+    pthread_mutex_unlock(&g_follow_mutex);
+}
+
+bool get_log_alerts(LogAlert **alerts, int *count, int limit) {
+    const char *sql = "SELECT timestamp, level, line_count, threshold, message FROM log_alerts "
+                      "ORDER BY timestamp DESC, id DESC LIMIT ?;";
+
+    *alerts = NULL;
+    *count = 0;
+    if (!db) {
+        return false;
+    }
+    if (limit <= 0) {
+        return true;
+    }
+
+    sqlite3 *conn = db_acquire_reader();
+    sqlite3_stmt *stmt;
+    if (sqlite3_prepare_v2(conn, sql, -1, &stmt, NULL) != SQLITE_OK) {
+        log_error("Failed to prepare statement: %s", sqlite3_errmsg(conn));
+        db_release_reader(conn);
+        return false;
+    }
+    sqlite3_bind_int(stmt, 1, limit);
+
+    *alerts = malloc((size_t)limit * sizeof(LogAlert));
+    while (*alerts && *count < limit && sqlite3_step(stmt) == SQLITE_ROW) {
+        LogAlert *alert = &(*alerts)[(*count)++];
+        alert->timestamp = (time_t)sqlite3_column_int64(stmt, 0);
+        alert->level = sqlite3_column_int(stmt, 1);
+        alert->line_count = sqlite3_column_int(stmt, 2);
+        alert->threshold = sqlite3_column_int(stmt, 3);
+        snprintf(alert->message, sizeof(alert->message), "%s", (const char*)sqlite3_column_text(stmt, 4));
+    }
+
+    sqlite3_finalize(stmt);
+    db_release_reader(conn);
+    return *alerts != NULL;
+}
@@ -0,0 +1,257 @@
+/*
+ * ========================================
+ * Log Kernel Implementation - Vektörel Satır ve Seviye Tarama
+ * ========================================
+ *
+ * Counts lines and log levels over a block of whole lines in one pass.
+ * The vector kernels compare 64 bytes at a time against '\n' and turn the
+ * result into a bit mask; each set bit ends a line, whose level token sits
+ * at a fixed offset after the timestamp and is checked in place. Lines are
+ * long compared to a 64-byte step, so most steps find zero or one newline.
+ *
+ * SSE2 and AVX2 versions are compiled with per-function target attributes
+ * and picked at runtime, so the binary still runs on CPUs without AVX2 and
+ * the build needs no -mavx2. Other compilers and architectures use the
+ * scalar kernel (memchr).
+ */
+
+#include "../../include/log_kernel.h"
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define LOG_KERNEL_X86 1
+    #include <immintrin.h>
+#endif
+
+static int g_log_kernel = LOG_KERNEL_AUTO;
+
+static inline int match_level(const char *word, size_t available,
+                              const char *name, size_t name_length, int level) {
+    if (available <= name_length || memcmp(word, name, name_length) != 0) {
+        return -1;
+    }
+    char next = word[name_length];
+    return next == ':' || next == ']' ? level : -1;
+}
+
+// Level names by (c ^ c >> 2) & 3 of their first letter, so the token is
+// checked with one masked 8-byte compare instead of a branch per level
+static const char g_level_names[4][8] = { "ERROR", "DEBUG", "WARNING", "INFO" };
+static const unsigned char g_level_masks[4][8] = {
+    { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0, 0, 0 },
+    { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0, 0, 0 },
+    { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0 },
+    { 0xFF, 0xFF, 0xFF, 0xFF, 0, 0, 0, 0 }
+};
+static const unsigned char g_level_lengths[4] = { 5, 5, 7, 4 };
+static const signed char g_level_values[4] = { LOG_ERROR, LOG_DEBUG, LOG_WARNING, LOG_INFO };
+
+static inline int classify_token(const char *word, size_t available) {
+    if (available < 9) {
+        switch (word[0]) {
+            case 'I': return match_level(word, available, "INFO", 4, LOG_INFO);
+            case 'W': return match_level(word, available, "WARNING", 7, LOG_WARNING);
+            case 'E': return match_level(word, available, "ERROR", 5, LOG_ERROR);
+            case 'D': return match_level(word, available, "DEBUG", 5, LOG_DEBUG);
+            default:  return -1;
+        }
+    }
+
+    unsigned char first = (unsigned char)word[0];
+    int index = (first ^ (first >> 2)) & 3;
+
+    uint64_t value, name, mask;
+    memcpy(&value, word, 8);
+    memcpy(&name, g_level_names[index], 8);
+    memcpy(&mask, g_level_masks[index], 8);
+
+    char next = word[g_level_lengths[index]];
+    int matched = ((value & mask) == name) & ((next == ':') | (next == ']'));
+    return matched ? g_level_values[index] : -1;
+}
+
+static inline int classify_line(const char *line, size_t length) {
+    size_t token;
+
+    // "[YYYY-MM-DD HH:MM:SS" then "]", ".mmm]" or ".uuuuuu]", then a space
+    if (length < 23 || line[0] != '[') {
+        return -1;
+    }
+    if (line[20] == ']') {
+        token = 22;
+    } else if (length > 27 && line[24] == ']') {
+        token = 26;
+    } else if (length > 30 && line[27] == ']') {
+        token = 29;
+    } else {
+        return -1;
+    }
+    if (line[token - 1] != ' ') {
+        return -1;
+    }
+    if (line[token] == '[') {
+        token++;
+    }
+    return classify_token(line + token, length - token);
+}
+
+int classify_log_line(const char *line, size_t length) {
+    return classify_line(line, length);
+}
+
+// Kernels count into tally[level], with the last slot for unclassified
+// lines, so the level picks the counter without a branch
+typedef uint64_t LevelTally[LOG_KERNEL_LEVELS + 1];
+
+static inline void add_line(LevelTally tally, const char *line, const char *end) {
+    int level = classify_line(line, (size_t)(end - line));
+    tally[level >= 0 ? level : LOG_KERNEL_LEVELS]++;
+}
+
+static void add_tally(LogLevelCounts *counts, const LevelTally tally) {
+    for (int level = 0; level < LOG_KERNEL_LEVELS; level++) {
+        counts->levels[level] += tally[level];
+        counts->lines += tally[level];
+    }
+    counts->unclassified += tally[LOG_KERNEL_LEVELS];
+    counts->lines += tally[LOG_KERNEL_LEVELS];
+}
+
+// Lines from p to end; line is the start of the line p is in
+static void count_tail(const char *p, const char *end, const char *line, LevelTally tally) {
+    const char *newline;
+    while (p < end && (newline = memchr(p, '\n', (size_t)(end - p))) != NULL) {
+        add_line(tally, line, newline);
+        line = newline + 1;
+        p = line;
+    }
+    if (line < end) {
+        add_line(tally, line, end);
+    }
+}
+
+static void count_levels_scalar(const char *data, size_t length, LogLevelCounts *counts) {
+    LevelTally tally = {0};
+    count_tail(data, data + length, data, tally);
+    add_tally(counts, tally);
+}
+
+#ifdef LOG_KERNEL_X86
+
+__attribute__((target("sse2")))
+static void count_levels_sse2(const char *data, size_t length, LogLevelCounts *counts) {
+    const __m128i newline = _mm_set1_epi8('\n');
+    LevelTally tally = {0};
+    const char *line = data;
+    size_t i = 0;
+
+    for (; i + 64 <= length; i += 64) {
+        const __m128i *block = (const __m128i*)(data + i);
+        uint64_t mask = (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(block), newline))
+                      | (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(block + 1), newline)) << 16
+                      | (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(block + 2), newline)) << 32
+                      | (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(block + 3), newline)) << 48;
+        while (mask) {
+            const char *end = data + i + __builtin_ctzll(mask);
+            add_line(tally, line, end);
+            line = end + 1;
+            mask &= mask - 1;
+        }
+    }
+    count_tail(data + i, data + length, line, tally);
+    add_tally(counts, tally);
+}
+
+__attribute__((target("avx2")))
+static void count_levels_avx2(const char *data, size_t length, LogLevelCounts *counts) {
+    const __m256i newline = _mm256_set1_epi8('\n');
+    LevelTally tally = {0};
+    const char *line = data;
+    size_t i = 0;
+
+    for (; i + 64 <= length; i += 64) {
+        const __m256i *block = (const __m256i*)(data + i);
+        uint64_t mask = (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256(block), newline))
+                      | (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256(block + 1), newline)) << 32;
+        while (mask) {
+            const char *end = data + i + __builtin_ctzll(mask);
+            add_line(tally, line, end);
+            line = end + 1;
+            mask &= mask - 1;
+        }
+    }
+    count_tail(data + i, data + length, line, tally);
+    add_tally(counts, tally);
+}
+
+#endif // LOG_KERNEL_X86
+
+bool log_kernel_supported(LogKernel kernel) {
+    switch (kernel) {
+        case LOG_KERNEL_AUTO:
+        case LOG_KERNEL_SCALAR:
+            return true;
+#ifdef LOG_KERNEL_X86
+        case LOG_KERNEL_SSE2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("sse2");
+        case LOG_KERNEL_AVX2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return false;
+    }
+}
+
+LogKernel get_log_kernel(void) {
+    int kernel = __atomic_load_n(&g_log_kernel, __ATOMIC_RELAXED);
+    if (kernel == LOG_KERNEL_AUTO) {
+        if (log_kernel_supported(LOG_KERNEL_AVX2)) {
+            kernel = LOG_KERNEL_AVX2;
+        } else if (log_kernel_supported(LOG_KERNEL_SSE2)) {
+            kernel = LOG_KERNEL_SSE2;
+        } else {
+            kernel = LOG_KERNEL_SCALAR;
+        }
+        __atomic_store_n(&g_log_kernel, kernel, __ATOMIC_RELAXED);
+    }
+    return (LogKernel)kernel;
+}
+
+const char* get_log_kernel_name(LogKernel kernel) {
+    switch (kernel) {
+        case LOG_KERNEL_AUTO:   return get_log_kernel_name(get_log_kernel());
+        case LOG_KERNEL_SCALAR: return "scalar";
+        case LOG_KERNEL_SSE2:   return "sse2";
+        case LOG_KERNEL_AVX2:   return "avx2";
+        default:                return "unknown";
+    }
+}
+
+static void run_kernel(LogKernel kernel, const char *data, size_t length, LogLevelCounts *counts) {
+    switch (kernel) {
+#ifdef LOG_KERNEL_X86
+        case LOG_KERNEL_AVX2:
+            count_levels_avx2(data, length, counts);
+            break;
+        case LOG_KERNEL_SSE2:
+            count_levels_sse2(data, length, counts);
+            break;
+#endif
+        default:
+            count_levels_scalar(data, length, counts);
+            break;
+    }
+}
+
+void count_log_levels_with(LogKernel kernel, const char *data, size_t length, LogLevelCounts *counts) {
+    if (kernel == LOG_KERNEL_AUTO || !log_kernel_supported(kernel)) {
+        kernel = get_log_kernel();
+    }
+    run_kernel(kernel, data, length, counts);
+}
+
+void count_log_levels(const char *data, size_t length, LogLevelCounts *counts) {
+    run_kernel(get_log_kernel(), data, length, counts);
+}
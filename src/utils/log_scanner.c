@@ -0,0 +1,371 @@
+/*
+ * ========================================
+ * Log Scanner Implementation - Bellek Eşlemeli Satır Tarama
+ * ========================================
+ *
+ * The analyzers walk log files through a read-only memory mapping instead
+ * of read() into fixed buffers, so a line is never split at a buffer edge
+ * and nothing is copied: callbacks get pointers into the page cache.
+ *
+ * Files up to LOG_SCAN_SINGLE_MAP_MAX are mapped once. Larger files are
+ * mapped in windows whose offsets are aligned to the page size (allocation
+ * granularity on Windows); a line that runs past the end of a window is
+ * picked up again at the start of the next one. The kernel is told the
+ * access is sequential so it reads ahead aggressively and drops pages
+ * behind the scan.
+ */
+
+#ifndef _WIN32
+    // madvise and 64-bit file offsets under -std=c99
+    #define _DEFAULT_SOURCE
+    #define _FILE_OFFSET_BITS 64
+#endif
+
+#include "../../include/log_scanner.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+struct LogScanner {
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#else
+    int fd;
+#endif
+    uint64_t size;
+    uint64_t granularity;
+    uint64_t window;
+};
+
+LogScanner* open_log_scanner(const char *path) {
+    LogScanner *scanner = calloc(1, sizeof(LogScanner));
+    if (!scanner) {
+        return NULL;
+    }
+
+#ifdef _WIN32
+    // The logger keeps the file open for writing
+    scanner->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (scanner->file == INVALID_HANDLE_VALUE) {
+        free(scanner);
+        return NULL;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(scanner->file, &size)) {
+        CloseHandle(scanner->file);
+        free(scanner);
+        return NULL;
+    }
+    scanner->size = (uint64_t)size.QuadPart;
+
+    // A zero-length file cannot be mapped; the scan simply sees no lines
+    if (scanner->size > 0) {
+        scanner->mapping = CreateFileMappingA(scanner->file, NULL, PAGE_READONLY,
+                                              (DWORD)(scanner->size >> 32), (DWORD)scanner->size, NULL);
+        if (!scanner->mapping) {
+            CloseHandle(scanner->file);
+            free(scanner);
+            return NULL;
+        }
+    }
+
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    scanner->granularity = info.dwAllocationGranularity;
+#else
+    scanner->fd = open(path, O_RDONLY);
+    if (scanner->fd < 0) {
+        free(scanner);
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(scanner->fd, &st) != 0) {
+        close(scanner->fd);
+        free(scanner);
+        return NULL;
+    }
+    scanner->size = (uint64_t)st.st_size;
+
+    long page = sysconf(_SC_PAGESIZE);
+    scanner->granularity = page > 0 ? (uint64_t)page : 4096;
+#endif
+
+    // One view for the whole file when it fits the address space budget
+    if (sizeof(size_t) > 4 && scanner->size <= LOG_SCAN_SINGLE_MAP_MAX) {
+        scanner->window = scanner->size;
+    } else {
+        scanner->window = LOG_SCAN_WINDOW_SIZE;
+    }
+    return scanner;
+}
+
+bool get_log_file_id(const char *path, LogFileId *id, uint64_t *size) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, 0, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                              NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    BY_HANDLE_FILE_INFORMATION info;
+    bool ok = GetFileInformationByHandle(file, &info) != 0;
+    CloseHandle(file);
+    if (!ok) {
+        return false;
+    }
+    id->device = info.dwVolumeSerialNumber;
+    id->inode = (uint64_t)info.nFileIndexHigh << 32 | info.nFileIndexLow;
+    if (size) {
+        *size = (uint64_t)info.nFileSizeHigh << 32 | info.nFileSizeLow;
+    }
+#else
+    struct stat st;
+    if (stat(path, &st) != 0) {
+        return false;
+    }
+    id->device = (uint64_t)st.st_dev;
+    id->inode = (uint64_t)st.st_ino;
+    if (size) {
+        *size = (uint64_t)st.st_size;
+    }
+#endif
+    return true;
+}
+
+bool same_log_file_id(const LogFileId *a, const LogFileId *b) {
+    return a->device == b->device && a->inode == b->inode;
+}
+
+uint64_t get_log_scanner_size(const LogScanner *scanner) {
+    return scanner ? scanner->size : 0;
+}
+
+void close_log_scanner(LogScanner *scanner) {
+    if (!scanner) {
+        return;
+    }
+#ifdef _WIN32
+    if (scanner->mapping) {
+        CloseHandle(scanner->mapping);
+    }
+    CloseHandle(scanner->file);
+#else
+    close(scanner->fd);
+#endif
+    free(scanner);
+}
+
+static const char* map_window(LogScanner *scanner, uint64_t offset, size_t length) {
+#ifdef _WIN32
+    return MapViewOfFile(scanner->mapping, FILE_MAP_READ,
+                         (DWORD)(offset >> 32), (DWORD)offset, length);
+#else
+    void *view = mmap(NULL, length, PROT_READ, MAP_SHARED, scanner->fd, (off_t)offset);
+    if (view == MAP_FAILED) {
+        return NULL;
+    }
+    madvise(view, length, MADV_SEQUENTIAL);
+    return view;
+#endif
+}
+
+static void unmap_window(const char *view, size_t length) {
+#ifdef _WIN32
+    (void)length;
+    UnmapViewOfFile(view);
+#else
+    munmap((void*)view, length);
+#endif
+}
+
+static const char* find_last_newline(const char *from, const char *to) {
+    while (to > from) {
+        to--;
+        if (*to == '\n') {
+            return to;
+        }
+    }
+    return NULL;
+}
+
+bool scan_log_blocks(LogScanner *scanner, uint64_t start, uint64_t end,
+                     LogBlockCallback callback, void *context) {
+    if (!scanner || !callback) {
+        return false;
+    }
+    if (end > scanner->size) {
+        end = scanner->size;
+    }
+
+    // A range that starts inside a line leaves that line to the range before
+    // it: delivery begins after the first newline at or after byte start-1
+    bool aligned = start == 0;
+    uint64_t position = aligned ? start : start - 1;
+    while (position < end) {
+        uint64_t base = position - position % scanner->granularity;
+        uint64_t map_end = scanner->size;
+        if (map_end - base > scanner->window) {
+            map_end = base + scanner->window;
+        }
+
+        size_t length = (size_t)(map_end - base);
+        const char *view = map_window(scanner, base, length);
+        if (!view) {
+            return false;
+        }
+
+        const char *first = view + (position - base);
+        const char *limit = view + length;
+        const char *stop = NULL;
+
+        if (!aligned) {
+            const char *newline = memchr(first, '\n', (size_t)(limit - first));
+            if (newline) {
+                aligned = true;
+                first = newline + 1;
+                position = base + (uint64_t)(first - view);
+            } else {
+                position = map_end;
+            }
+            if (!newline || first == limit || position >= end) {
+                unmap_window(view, length);
+                continue;
+            }
+        }
+
+        // The line holding byte end-1 is the last one in range
+        if (end <= map_end) {
+            const char *last_byte = view + (end - base) - 1;
+            const char *newline = memchr(last_byte, '\n', (size_t)(limit - last_byte));
+            if (newline) {
+                stop = newline + 1;
+            }
+        }
+        if (!stop) {
+            if (map_end == scanner->size) {
+                stop = limit;
+            } else {
+                // Cut after the last whole line; the rest is remapped
+                const char *newline = find_last_newline(first, limit);
+                stop = newline ? newline + 1 : limit;
+            }
+        }
+
+        LogBlock block;
+        block.data = first;
+        block.length = (size_t)(stop - first);
+        block.offset = position;
+        position += block.length;
+
+        bool keep_going = callback(&block, context);
+        unmap_window(view, length);
+        if (!keep_going) {
+            break;
+        }
+    }
+
+    return true;
+}
+
+typedef struct {
+    LogLineCallback callback;
+    void *context;
+    long long count;
+    bool stopped;
+} LineSplitter;
+
+static bool split_block_lines(const LogBlock *block, void *context) {
+    LineSplitter *splitter = context;
+    const char *cursor = block->data;
+    const char *end = block->data + block->length;
+
+    while (cursor < end) {
+        const char *newline = memchr(cursor, '\n', (size_t)(end - cursor));
+        const char *line_end = newline ? newline : end;
+
+        LogLine line;
+        line.data = cursor;
+        line.length = (size_t)(line_end - cursor);
+        line.offset = block->offset + (uint64_t)(cursor - block->data);
+        if (line.length > 0 && line.data[line.length - 1] == '\r') {
+            line.length--;
+        }
+
+        splitter->count++;
+        if (!splitter->callback(&line, splitter->context)) {
+            splitter->stopped = true;
+            return false;
+        }
+        cursor = newline ? newline + 1 : end;
+    }
+    return true;
+}
+
+long long scan_log_lines(LogScanner *scanner, uint64_t start, uint64_t end,
+                         LogLineCallback callback, void *context) {
+    if (!callback) {
+        return -1;
+    }
+
+    LineSplitter splitter = {callback, context, 0, false};
+    if (!scan_log_blocks(scanner, start, end, split_block_lines, &splitter)) {
+        return -1;
+    }
+    return splitter.count;
+}
+
+long long scan_log_file(const char *path, LogLineCallback callback, void *context) {
+    LogScanner *scanner = open_log_scanner(path);
+    if (!scanner) {
+        return -1;
+    }
+    long long count = scan_log_lines(scanner, 0, scanner->size, callback, context);
+    close_log_scanner(scanner);
+    return count;
+}
+
+const char* find_in_log_line(const LogLine *line, const char *token) {
+    size_t token_length = strlen(token);
+    if (token_length == 0 || token_length > line->length) {
+        return NULL;
+    }
+
+    const char *cursor = line->data;
+    const char *last = line->data + line->length - token_length;
+    while (cursor <= last) {
+        cursor = memchr(cursor, token[0], (size_t)(last - cursor) + 1);
+        if (!cursor) {
+            return NULL;
+        }
+        if (memcmp(cursor, token, token_length) == 0) {
+            return cursor;
+        }
+        cursor++;
+    }
+    return NULL;
+}
+
+size_t copy_log_line(const LogLine *line, size_t skip, char *out, size_t capacity) {
+    if (capacity == 0) {
+        return 0;
+    }
+    size_t length = skip < line->length ? line->length - skip : 0;
+    if (length > capacity - 1) {
+        length = capacity - 1;
+    }
+    memcpy(out, line->data + skip, length);
+    out[length] = '\0';
+    return length;
+}
@@ -0,0 +1,310 @@
+/*
+ * ========================================
+ * Log Template Implementation - Mesaj Şablonu Çıkarma
+ * ========================================
+ *
+ * One pass over the message. Inside a word (letters, digits, '_' and any
+ * UTF-8 byte) bytes are copied as they are; only where a token can start
+ * are the variable patterns tried, longest-reaching first: path, IP
+ * address, hex id, number. Scanning stops once the output is full, so a
+ * long message costs no more than the template kept of it.
+ */
+
+#include "../../include/log_template.h"
+#include <string.h>
+
+#define CLASS_WORD 1            // letters, digits, '_' and any UTF-8 byte
+#define CLASS_DIGIT 2
+#define CLASS_HEX 4
+#define CLASS_CONTINUES 8       // inside a path, address, id or number token
+#define CLASS_ENDS_PATH 16      // a path or URL token stops at
+#define CLASS_STARTS_PATH 32    // a path may start after
+
+// One lookup per byte instead of a chain of compares
+static const unsigned char g_char_classes[256] = {
+     0,  0,  0,  0,  0,  0,  0,  0,  0, 48,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    48,  0, 48,  0,  0,  0,  0, 48, 48, 16,  0,  0, 56,  8,  8,  8,
+     7,  7,  7,  7,  7,  7,  7,  7,  7,  7, 40, 16, 48, 32, 16,  0,
+     0,  5,  5,  5,  5,  5,  5,  1,  1,  1,  1,  1,  1,  1,  1,  1,
+     1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1, 48,  8, 16,  0,  1,
+     0,  5,  5,  5,  5,  5,  5,  1,  1,  1,  1,  1,  1,  1,  1,  1,
+     1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  0,  0,  0,  0,  0,
+     1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,
+     1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,
+     1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,
+     1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,
+     1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,
+     1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,
+     1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,
+     1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,
+};
+
+static inline int has_class(unsigned char c, int mask) {
+    return g_char_classes[c] & mask;
+}
+
+static inline int is_digit(unsigned char c) {
+    return has_class(c, CLASS_DIGIT);
+}
+
+static inline int is_hex(unsigned char c) {
+    return has_class(c, CLASS_HEX);
+}
+
+static inline int is_word(unsigned char c) {
+    return has_class(c, CLASS_WORD);
+}
+
+// A token that starts like a path ("/", "\", "./", "../", "~/", "C:\"), is a
+// URL, or has a separator and an extension on its last part ("logs/a.log")
+static size_t match_path(const char *text, size_t length) {
+    size_t end = 0;
+    while (end < length && !has_class((unsigned char)text[end], CLASS_ENDS_PATH)) {
+        end++;
+    }
+    // Sentence punctuation after the path is kept
+    while (end > 0 && (text[end - 1] == '.' || text[end - 1] == ':')) {
+        end--;
+    }
+    if (end < 2) {
+        return 0;
+    }
+
+    if (text[0] == '/' || text[0] == '\\' ||
+        (text[0] == '~' && text[1] == '/') ||
+        (text[0] == '.' && (text[1] == '/' || (end > 2 && text[1] == '.' && text[2] == '/'))) ||
+        (end > 2 && text[1] == ':' && (text[2] == '\\' || text[2] == '/') &&
+         ((text[0] >= 'a' && text[0] <= 'z') || (text[0] >= 'A' && text[0] <= 'Z')))) {
+        return end;
+    }
+
+    size_t separator = 0;
+    size_t dot = 0;
+    for (size_t i = 0; i < end; i++) {
+        if (text[i] == '/' || text[i] == '\\') {
+            if (i > 0 && i + 2 < end && text[i - 1] == ':' && text[i + 1] == '/') {
+                return end;     // scheme://
+            }
+            separator = i + 1;
+            dot = 0;
+        } else if (text[i] == '.' && separator > 0 && i + 1 < end && is_word((unsigned char)text[i + 1])) {
+            dot = i;
+        }
+    }
+    return separator > 0 && dot > separator ? end : 0;
+}
+
+static size_t match_digits(const char *text, size_t length, size_t max_digits, int *value) {
+    size_t i = 0;
+    int number = 0;
+    while (i < length && i < max_digits && is_digit((unsigned char)text[i])) {
+        number = number * 10 + (text[i] - '0');
+        i++;
+    }
+    if (value) {
+        *value = number;
+    }
+    return i;
+}
+
+// a.b.c.d with an optional :port
+static size_t match_ipv4(const char *text, size_t length) {
+    size_t i = 0;
+    for (int part = 0; part < 4; part++) {
+        if (part > 0) {
+            if (i >= length || text[i] != '.') {
+                return 0;
+            }
+            i++;
+        }
+        int value;
+        size_t digits = match_digits(text + i, length - i, 3, &value);
+        if (digits == 0 || value > 255) {
+            return 0;
+        }
+        i += digits;
+    }
+    if (i + 1 < length && text[i] == ':' && is_digit((unsigned char)text[i + 1])) {
+        i += 1 + match_digits(text + i + 1, length - i - 1, 5, NULL);
+    }
+    // "1.2.3.4.5" is a version, not an address
+    if (i < length && (is_word((unsigned char)text[i]) ||
+                       (text[i] == '.' && i + 1 < length && is_digit((unsigned char)text[i + 1])))) {
+        return 0;
+    }
+    return i;
+}
+
+// Hex groups and colons with "::" or all eight groups; "12:00:05" has
+// neither
+static size_t match_ipv6(const char *text, size_t length) {
+    size_t i = 0;
+    int colons = 0;
+    int group = 0;
+    int compressed = 0;
+    int digits = 0;
+    while (i < length) {
+        unsigned char c = (unsigned char)text[i];
+        if (is_hex(c)) {
+            if (++group > 4) {
+                return 0;
+            }
+            digits++;
+        } else if (c == ':') {
+            if (i > 0 && text[i - 1] == ':') {
+                compressed++;
+            }
+            colons++;
+            group = 0;
+        } else {
+            break;
+        }
+        i++;
+    }
+    if (digits == 0 || compressed > 1 || (colons != 7 && !(compressed && colons >= 2))) {
+        return 0;
+    }
+    if (i < length && (is_word((unsigned char)text[i]) || text[i] == '.')) {
+        return 0;
+    }
+    return i;
+}
+
+// 8+ hex digits, optionally in '-' groups, with both a digit and a letter
+static size_t match_hex(const char *text, size_t length) {
+    size_t i = 0;
+    int count = 0;
+    int digit = 0;
+    int letter = 0;
+    while (i < length) {
+        unsigned char c = (unsigned char)text[i];
+        if (is_digit(c)) {
+            digit = 1;
+        } else if (is_hex(c)) {
+            letter = 1;
+        } else if (!(c == '-' && count > 0 && i + 1 < length && is_hex((unsigned char)text[i + 1]))) {
+            break;
+        }
+        count += c != '-';
+        i++;
+    }
+    if (count < 8 || !digit || !letter || (i < length && is_word((unsigned char)text[i]))) {
+        return 0;
+    }
+    return i;
+}
+
+// Digit groups joined by '.', ',', ':' or '-' ("2024-01-31", "12:00:05.123",
+// "1,5"), or 0x followed by hex digits. A unit after it ("30ms") is kept.
+static size_t match_number(const char *text, size_t length) {
+    if (length > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X') && is_hex((unsigned char)text[2])) {
+        size_t i = 2;
+        while (i < length && is_hex((unsigned char)text[i])) {
+            i++;
+        }
+        return i;
+    }
+
+    size_t i = match_digits(text, length, length, NULL);
+    while (i + 1 < length && (text[i] == '.' || text[i] == ',' || text[i] == ':' || text[i] == '-') &&
+           is_digit((unsigned char)text[i + 1])) {
+        i += 1 + match_digits(text + i + 1, length - i - 1, length, NULL);
+    }
+    return i;
+}
+
+size_t make_log_template(const char *message, size_t length, char *out, size_t size) {
+    if (size == 0) {
+        return 0;
+    }
+    size_t limit = size - 1;
+    size_t written = 0;
+    size_t i = 0;
+
+    while (i < length) {
+        unsigned char c = (unsigned char)message[i];
+        int boundary = i == 0 || !is_word((unsigned char)message[i - 1]);
+        const char *placeholder = NULL;
+        size_t matched = 0;
+
+        // Most tokens are plain words and numbers: only one followed by a
+        // separator or colon, or one of 8+ characters starting with a hex
+        // digit, needs the matchers
+        int plain = 0;
+        if (boundary && is_word(c)) {
+            size_t run = i + 1;
+            while (run < length && is_word((unsigned char)message[run])) {
+                run++;
+            }
+            unsigned char next = run < length ? (unsigned char)message[run] : ' ';
+            plain = !has_class(next, CLASS_CONTINUES) && (run - i < 8 || !is_hex(c));
+        }
+
+        if (plain) {
+            if (is_digit(c)) {
+                matched = match_number(message + i, length - i);
+                placeholder = LOG_TEMPLATE_NUMBER;
+            }
+        } else if (boundary) {
+            if ((i == 0 || has_class((unsigned char)message[i - 1], CLASS_STARTS_PATH)) &&
+                (c == '/' || c == '\\' || c == '.' || c == '~' || is_word(c))) {
+                matched = match_path(message + i, length - i);
+                placeholder = LOG_TEMPLATE_PATH;
+            }
+            if (!matched && is_hex(c)) {
+                if (is_digit(c) && (matched = match_ipv4(message + i, length - i)) > 0) {
+                    placeholder = LOG_TEMPLATE_IP;
+                } else if ((matched = match_ipv6(message + i, length - i)) > 0) {
+                    placeholder = LOG_TEMPLATE_IP;
+                } else if ((matched = match_hex(message + i, length - i)) > 0) {
+                    placeholder = LOG_TEMPLATE_HEX;
+                } else if (is_digit(c)) {
+                    matched = match_number(message + i, length - i);
+                    placeholder = LOG_TEMPLATE_NUMBER;
+                }
+            }
+        }
+
+        if (matched > 0) {
+            size_t placeholder_length = strlen(placeholder);
+            if (written + placeholder_length > limit) {
+                break;
+            }
+            memcpy(out + written, placeholder, placeholder_length);
+            written += placeholder_length;
+            i += matched;
+            continue;
+        }
+
+        // A non-word character is one ASCII byte
+        if (!is_word(c)) {
+            if (written == limit) {
+                break;
+            }
+            out[written++] = (char)c;
+            i++;
+            continue;
+        }
+
+        // The rest of the word; dotted digits stay with it: "v1.2.3"
+        size_t word_start = written;
+        while (i < length && (is_word((unsigned char)message[i]) ||
+                              (message[i] == '.' && i + 1 < length && is_digit((unsigned char)message[i + 1])))) {
+            if (written == limit) {
+                // Cut without splitting a UTF-8 sequence; never past the
+                // start of this word, so placeholders before it stay whole
+                while (written > word_start && ((unsigned char)message[i] & 0xC0) == 0x80) {
+                    i--;
+                    written--;
+                }
+                out[written] = '\0';
+                return written;
+            }
+            out[written++] = message[i++];
+        }
+    }
+
+    out[written] = '\0';
+    return written;
+}
@@ -2,24 +2,57 @@
  * ========================================
  * Logger Implementation - Loglama Sistemi
  * ========================================
+ *
+ * Dosya çıktısı asenkrondur. Çağıran thread satırı doğrudan halka
+ * tampondaki bir slota formatlar ve döner; tek bir arka plan thread'i hazır
+ * slotları toplu writev çağrılarıyla açık tutulan dosyaya yazar. Halka
+ * Vyukov'un sınırlı kuyruğudur: her slotun sıra numarası, slotun
+ * üreticiye mi tüketiciye mi ait olduğunu gösterir, kilit gerekmez.
+ *
+ * Dosya boyutu yazılan bayt sayacından izlenir. Eşik aşıldığında yazıcı
+ * thread'i dosyayı kapatıp zaman damgalı ada taşır ve yeniden açar; bu
+ * sırada üreticiler halkaya yazmaya devam eder. Döndürülen segmentleri
+ * ayrı bir arşiv thread'i sıkıştırır ve eski olanları siler.
+ *
+ * Binary biçimde çağıran thread satırı formatlamaz, argümanları slota
+ * kopyalar (log_binary.c). Yazıcı thread'i kaydın kullandığı format ve
+ * modül tanımlarını dosyaya ilk kez gerektiğinde ekler.
+ *
+ * Sıcak döngülerin dosyayı doldurmaması için her LOG_RATE_LIMITED
+ * yerinin (dosya ve satır) kendi token kovası vardır ve aynı yerden art
+ * arda gelen aynı mesaj "son mesaj N kez tekrarlandı" olarak birleştirilir.
  */
 
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L     // localtime_r, clock_gettime
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
 #include <stdarg.h>
+#include <stdint.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <pthread.h>
 
 #ifdef _WIN32
     #include <windows.h>
     #include <direct.h>
+    #include <io.h>
     #define mkdir(path, mode) _mkdir(path)
 #else
     #include <sys/stat.h>
+    #include <sys/uio.h>
     #include <unistd.h>
+    #include <dirent.h>
 #endif
 
 #include "../../include/logger.h"
+#include "../../include/file_compress.h"
+#include "../../include/log_binary.h"
+#include "../../include/platform.h"
 
 // Global logger konfigürasyonu
 static LogConfig g_log_config = {
@@ -28,11 +61,771 @@ static LogConfig g_log_config = {
     .console_output = 1,
     .file_output = 1,
     .max_file_size = 10, // 10 MB
-    .max_backup_files = 5
+    .max_backup_files = 5,
+    .overflow_policy = LOG_OVERFLOW_BLOCK,
+    .timestamp_precision = LOG_TIMESTAMP_SECONDS,
+    .format = LOG_FORMAT_TEXT
 };
 
 static int g_logger_initialized = 0;
 
+// logger.h makroları seviye kontrolünü çağrı yerinde bununla yapar
+LogLevel g_log_min_level = LOG_INFO;
+
+// ========================================
+// Halka tampon
+// ========================================
+
+#define LOG_RING_MASK (LOG_RING_SLOTS - 1)
+
+typedef struct {
+    uint64_t sequence;      // pos: üreticiye boş, pos + 1: yazıldı, okunmayı bekliyor
+    uint32_t length;        // 0: atlanan tekrar, dosyaya bir şey yazılmaz
+    uint32_t binary;        // text metin satırı değil, log_binary kaydı
+    char text[LOG_LINE_MAX];
+} LogSlot;
+
+static LogSlot g_ring[LOG_RING_SLOTS];
+static uint64_t g_ring_tail = 0;    // üreticilerin bir sonraki konumu (atomik)
+static uint64_t g_ring_head = 0;    // yalnızca drain_ring sahibi değiştirir
+
+static uint64_t g_dropped = 0;
+static uint64_t g_dropped_reported = 0;
+
+// Dosya tanımlayıcısı yalnızca yazıcı thread'i (veya drain_ring sahibi) kullanır
+static int g_log_fd = -1;
+static int g_reopen_requested = 0;
+static int g_drain_lock = 0;
+
+static pthread_t g_flush_thread;
+static volatile int g_flush_running = 0;
+
+// Açık dosyanın boyutu; yalnızca drain_ring sahibi değiştirir
+static uint64_t g_log_file_bytes = 0;
+static uint64_t g_rotation_retry_bytes = 0;
+static int g_rotate_requested = 0;
+
+static pthread_t g_archive_thread;
+static volatile int g_archive_running = 0;
+static int g_archive_requested = 0;
+
+// LOG_RATE_LIMITED yerlerinin oranını ezen genel ayar; 0 ise her yer kendi oranını kullanır
+static double g_rate_limit_per_second = 0;
+static double g_rate_limit_burst = 0;
+
+// Açık dosya binary mi; dosyaya yazılmış tanımlar (id başına bir bit).
+// İkisi de yalnızca drain_ring sahibine aittir ve her açılışta sıfırlanır.
+#define LOG_DEFINED_WORDS ((LOG_BINARY_MAX_IDS + 1 + 63) / 64)
+static int g_file_is_binary = 0;
+static uint64_t g_defined_ids[LOG_DEFINED_WORDS];
+
+// Bir toplu yazımda slot başına en fazla üç segment (iki tanım + kayıt)
+// ve kuyruk taşma bildirimi için iki segment
+#define LOG_SEGMENTS_MAX (LOG_FLUSH_BATCH * 3 + 2)
+static char g_definition_scratch[LOG_FLUSH_BATCH * 2][LOG_BINARY_DEFINITION_MAX];
+static char g_text_headers[LOG_FLUSH_BATCH + 1][LOG_BINARY_TEXT_HEADER_SIZE];
+static char g_render_scratch[LOG_FLUSH_BATCH][LOG_LINE_MAX];
+
+static void report_idle_log_sites(int force);
+
+// ========================================
+// Zaman damgası önbelleği
+// ========================================
+
+// "YYYY-MM-DD HH:MM:SS" her thread'de yalnızca saniye değişince yeniden
+// formatlanır; localtime() ve strftime() satır başına çağrılmaz
+#define LOG_TIMESTAMP_MAX 32
+
+static __thread time_t tls_cached_second = (time_t)-1;
+static __thread char tls_cached_timestamp[LOG_TIMESTAMP_MAX];
+
+// Saniye ve alt saniye (mikrosaniye). Milisaniye için kaba saat yeterli
+// ve sistem çağrısı gerektirmez; mikrosaniye tam çözünürlüklü saati okur.
+static time_t current_log_time(long *microseconds) {
+#if defined(_WIN32)
+    FILETIME file_time;
+    GetSystemTimeAsFileTime(&file_time);
+    unsigned long long ticks = ((unsigned long long)file_time.dwHighDateTime << 32) | file_time.dwLowDateTime;
+    ticks -= 116444736000000000ULL; // 1601 -> 1970, 100 ns birim
+    *microseconds = (long)((ticks / 10) % 1000000);
+    return (time_t)(ticks / 10000000ULL);
+#elif defined(CLOCK_REALTIME)
+    struct timespec ts;
+#ifdef CLOCK_REALTIME_COARSE
+    clockid_t clock_id = g_log_config.timestamp_precision == LOG_TIMESTAMP_MICROS
+                      ? CLOCK_REALTIME : CLOCK_REALTIME_COARSE;
+#else
+    clockid_t clock_id = CLOCK_REALTIME;
+#endif
+    clock_gettime(clock_id, &ts);
+    *microseconds = ts.tv_nsec / 1000;
+    return ts.tv_sec;
+#else
+    *microseconds = 0;
+    return time(NULL);
+#endif
+}
+
+// Zaman damgasını out'a yazar ve uzunluğunu döndürür
+static int format_log_timestamp(char *out, time_t now, long microseconds) {
+    if (now != tls_cached_second) {
+        struct tm timeinfo;
+#ifdef _WIN32
+        localtime_s(&timeinfo, &now);
+#else
+        localtime_r(&now, &timeinfo);
+#endif
+        strftime(tls_cached_timestamp, sizeof(tls_cached_timestamp), "%Y-%m-%d %H:%M:%S", &timeinfo);
+        tls_cached_second = now;
+    }
+    
+    memcpy(out, tls_cached_timestamp, 19);
+    int len = 19;
+    
+    int digits = g_log_config.timestamp_precision == LOG_TIMESTAMP_MICROS ? 6 :
+                 g_log_config.timestamp_precision == LOG_TIMESTAMP_MILLIS ? 3 : 0;
+    if (digits > 0) {
+        long fraction = digits == 3 ? microseconds / 1000 : microseconds;
+        out[len++] = '.';
+        for (int i = digits - 1; i >= 0; i--) {
+            out[len + i] = (char)('0' + fraction % 10);
+            fraction /= 10;
+        }
+        len += digits;
+    }
+    
+    out[len] = '\0';
+    return len;
+}
+
+static void close_log_fd(void) {
+    if (g_log_fd >= 0) {
+#ifdef _WIN32
+        _close(g_log_fd);
+#else
+        close(g_log_fd);
+#endif
+        g_log_fd = -1;
+    }
+}
+
+// Dosyayı açar ve bayt sayacını mevcut boyuttan başlatır. Windows'ta da
+// binary kip: kayıtlardaki 0x0A baytları CRLF'ye çevrilmez, bayt sayacı
+// diskteki boyutla aynı kalır; metin satırları her platformda LF ile biter.
+static void open_log_fd(void) {
+    close_log_fd();
+#ifdef _WIN32
+    g_log_fd = _open(g_log_config.log_file_path, _O_WRONLY | _O_APPEND | _O_CREAT | _O_BINARY,
+                     _S_IREAD | _S_IWRITE);
+    long long end = g_log_fd >= 0 ? _lseeki64(g_log_fd, 0, SEEK_END) : -1;
+#else
+    g_log_fd = open(g_log_config.log_file_path, O_WRONLY | O_APPEND | O_CREAT, 0644);
+    long long end = g_log_fd >= 0 ? (long long)lseek(g_log_fd, 0, SEEK_END) : -1;
+#endif
+    
+    // Binary dosya başlığı; tanımlar her dosyada yeniden yazılır
+    g_file_is_binary = g_log_config.format == LOG_FORMAT_BINARY;
+    memset(g_defined_ids, 0, sizeof(g_defined_ids));
+    if (g_file_is_binary && end == 0 && g_log_fd >= 0) {
+#ifdef _WIN32
+        if (_write(g_log_fd, LOG_BINARY_MAGIC, LOG_BINARY_MAGIC_SIZE) == LOG_BINARY_MAGIC_SIZE) {
+#else
+        if (write(g_log_fd, LOG_BINARY_MAGIC, LOG_BINARY_MAGIC_SIZE) == LOG_BINARY_MAGIC_SIZE) {
+#endif
+            end = LOG_BINARY_MAGIC_SIZE;
+        }
+    }
+    
+    __atomic_store_n(&g_log_file_bytes, end > 0 ? (uint64_t)end : 0, __ATOMIC_RELAXED);
+    g_rotation_retry_bytes = 0;
+}
+
+static int log_path_exists(const char *path) {
+#ifdef _WIN32
+    return _access(path, 0) == 0;
+#else
+    return access(path, F_OK) == 0;
+#endif
+}
+
+// "automation.log.YYYYMMDD_HHMMSS"; aynı saniyede ikinci döndürme "_1" alır.
+// Ad, ham segment de sıkıştırılmışı da yoksa kullanılır.
+static int make_rotated_path(char *out, size_t size) {
+    time_t now = time(NULL);
+    struct tm timeinfo;
+#ifdef _WIN32
+    localtime_s(&timeinfo, &now);
+#else
+    localtime_r(&now, &timeinfo);
+#endif
+    
+    int len = snprintf(out, size, "%s.%04d%02d%02d_%02d%02d%02d",
+                       g_log_config.log_file_path,
+                       timeinfo.tm_year + 1900, timeinfo.tm_mon + 1, timeinfo.tm_mday,
+                       timeinfo.tm_hour, timeinfo.tm_min, timeinfo.tm_sec);
+    if (len < 0 || (size_t)len + 16 >= size) {
+        return 0;
+    }
+    
+    // Ekler tek haneli kalır ki ad sıralaması zaman sırasıyla aynı olsun
+    for (int n = 1; n <= 9; n++) {
+        char archive_path[MAX_PATH_LEN + 64];
+        snprintf(archive_path, sizeof(archive_path), "%s" LOG_ARCHIVE_EXTENSION, out);
+        if (!log_path_exists(out) && !log_path_exists(archive_path)) {
+            return 1;
+        }
+        snprintf(out + len, size - len, "_%d", n);
+    }
+    return 0;
+}
+
+// drain_ring kilidi altında çağrılır: o ana kadarki satırlar eski dosyada
+// kalır, sonrakiler aynı adla açılan yeni dosyaya gider. Taşıma başarısız
+// olursa (ör. Windows'ta dosya başka süreçte açıksa) 1 MB sonra yeniden denenir.
+static void rotate_open_file(void) {
+    char rotated_path[MAX_PATH_LEN + 32];
+    uint64_t file_bytes = __atomic_load_n(&g_log_file_bytes, __ATOMIC_RELAXED);
+    
+    if (file_bytes == 0) {
+        return;
+    }
+    
+    if (!make_rotated_path(rotated_path, sizeof(rotated_path))) {
+        g_rotation_retry_bytes = file_bytes + 1024 * 1024;
+        return;
+    }
+    
+    close_log_fd();
+    int renamed = rename(g_log_config.log_file_path, rotated_path) == 0;
+    open_log_fd();
+    
+    if (renamed) {
+        __atomic_store_n(&g_archive_requested, 1, __ATOMIC_RELEASE);
+    } else {
+        g_rotation_retry_bytes = __atomic_load_n(&g_log_file_bytes, __ATOMIC_RELAXED) + 1024 * 1024;
+    }
+}
+
+static void rotate_if_needed(void) {
+    if (g_log_fd < 0) {
+        return;
+    }
+    
+    if (__atomic_exchange_n(&g_rotate_requested, 0, __ATOMIC_ACQ_REL)) {
+        rotate_open_file();
+        return;
+    }
+    
+    if (g_log_config.max_file_size <= 0) {
+        return;
+    }
+    
+    uint64_t limit = (uint64_t)g_log_config.max_file_size * 1024 * 1024;
+    uint64_t file_bytes = __atomic_load_n(&g_log_file_bytes, __ATOMIC_RELAXED);
+    if (file_bytes >= limit && file_bytes >= g_rotation_retry_bytes) {
+        rotate_open_file();
+    }
+}
+
+// Kısmi yazımları tamamlayarak tüm segmentleri yazar; yazılan bayt sayısını döndürür
+static size_t write_segments(const char **data, const size_t *sizes, int count) {
+    if (g_log_fd < 0) {
+        return 0;
+    }
+    
+    size_t total = 0;
+#ifdef _WIN32
+    for (int i = 0; i < count; i++) {
+        int written = _write(g_log_fd, data[i], (unsigned int)sizes[i]);
+        if (written > 0) {
+            total += (size_t)written;
+        }
+    }
+#else
+    struct iovec iov[LOG_SEGMENTS_MAX];
+    for (int i = 0; i < count; i++) {
+        iov[i].iov_base = (void *)data[i];
+        iov[i].iov_len = sizes[i];
+    }
+    
+    int first = 0;
+    while (first < count) {
+        ssize_t written = writev(g_log_fd, iov + first, count - first);
+        if (written < 0) {
+            return total;
+        }
+        total += (size_t)written;
+        while (first < count && (size_t)written >= iov[first].iov_len) {
+            written -= iov[first].iov_len;
+            first++;
+        }
+        if (first < count) {
+            iov[first].iov_base = (char *)iov[first].iov_base + written;
+            iov[first].iov_len -= written;
+        }
+    }
+#endif
+    return total;
+}
+
+static int add_definition(uint32_t id, char *scratch, const char **data, size_t *sizes, int count) {
+    if (id > LOG_BINARY_MAX_IDS || (g_defined_ids[id / 64] & (1ULL << (id % 64)))) {
+        return count;
+    }
+    
+    size_t length = write_log_definition(id, scratch, LOG_BINARY_DEFINITION_MAX);
+    if (length > 0) {
+        data[count] = scratch;
+        sizes[count] = length;
+        count++;
+        g_defined_ids[id / 64] |= 1ULL << (id % 64);
+    }
+    return count;
+}
+
+// Slotu açık dosyanın biçimine çevirir: binary dosyada metin satırı TEXT
+// kaydı olur, metin dosyasında binary kayıt satıra dönüştürülür
+static int add_slot_segments(const LogSlot *slot, int index, const char **data, size_t *sizes, int count) {
+    if (g_file_is_binary && slot->binary) {
+        uint32_t module_id;
+        uint32_t format_id;
+        get_log_record_ids(slot->text, &module_id, &format_id);
+        count = add_definition(module_id, g_definition_scratch[index * 2], data, sizes, count);
+        count = add_definition(format_id, g_definition_scratch[index * 2 + 1], data, sizes, count);
+        data[count] = slot->text;
+        sizes[count] = slot->length;
+    } else if (g_file_is_binary) {
+        data[count] = g_text_headers[index];
+        sizes[count] = write_log_text_header(g_text_headers[index], slot->length);
+        count++;
+        data[count] = slot->text;
+        sizes[count] = slot->length;
+    } else if (slot->binary) {
+        data[count] = g_render_scratch[index];
+        sizes[count] = render_log_record_line(slot->text, slot->length,
+                                              g_render_scratch[index], LOG_LINE_MAX);
+    } else {
+        data[count] = slot->text;
+        sizes[count] = slot->length;
+    }
+    return count + 1;
+}
+
+// Hazır slotları sırayla dosyaya aktarır; aynı anda tek sahibi olur.
+// Dönüş değeri yazılan satır sayısıdır.
+static int drain_ring(void) {
+    int expected = 0;
+    if (!__atomic_compare_exchange_n(&g_drain_lock, &expected, 1, false,
+                                     __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+        return 0;
+    }
+    
+    if (__atomic_exchange_n(&g_reopen_requested, 0, __ATOMIC_ACQ_REL) || g_log_fd < 0) {
+        open_log_fd();
+    }
+    rotate_if_needed();
+    
+    int total = 0;
+    for (;;) {
+        const char *data[LOG_SEGMENTS_MAX];
+        size_t sizes[LOG_SEGMENTS_MAX];
+        int count = 0;
+        char notice[160];
+        
+        // COUNT politikası: atılan mesaj sayısı bir sonraki toplu yazıma eklenir
+        uint64_t dropped = __atomic_load_n(&g_dropped, __ATOMIC_RELAXED);
+        if (g_log_config.overflow_policy == LOG_OVERFLOW_COUNT && dropped != g_dropped_reported) {
+            char timestamp[LOG_TIMESTAMP_MAX];
+            long microseconds;
+            time_t now = current_log_time(&microseconds);
+            format_log_timestamp(timestamp, now, microseconds);
+            int len = snprintf(notice, sizeof(notice),
+                               "[%s] WARNING: log kuyruğu doldu, %llu mesaj atlandı\n",
+                               timestamp, (unsigned long long)(dropped - g_dropped_reported));
+            if (g_file_is_binary) {
+                data[count] = g_text_headers[LOG_FLUSH_BATCH];
+                sizes[count] = write_log_text_header(g_text_headers[LOG_FLUSH_BATCH], (size_t)len);
+                count++;
+            }
+            data[count] = notice;
+            sizes[count] = (size_t)len;
+            count++;
+            g_dropped_reported = dropped;
+        }
+        
+        uint64_t head = g_ring_head;
+        int lines = 0;
+        while (lines < LOG_FLUSH_BATCH) {
+            LogSlot *slot = &g_ring[(head + lines) & LOG_RING_MASK];
+            if (__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) != head + lines + 1) {
+                break;
+            }
+            if (slot->length > 0) {
+                count = add_slot_segments(slot, lines, data, sizes, count);
+            }
+            lines++;
+        }
+        
+        if (count == 0 && lines == 0) {
+            break;
+        }
+        
+        size_t bytes = write_segments(data, sizes, count);
+        __atomic_store_n(&g_log_file_bytes,
+                         __atomic_load_n(&g_log_file_bytes, __ATOMIC_RELAXED) + bytes,
+                         __ATOMIC_RELAXED);
+        
+        // Slotları bir sonraki tura (pos + LOG_RING_SLOTS) üreticilere geri ver
+        for (int i = 0; i < lines; i++) {
+            __atomic_store_n(&g_ring[(head + i) & LOG_RING_MASK].sequence,
+                             head + i + LOG_RING_SLOTS, __ATOMIC_RELEASE);
+        }
+        g_ring_head = head + lines;
+        total += lines;
+        
+        rotate_if_needed();
+        
+        if (lines < LOG_FLUSH_BATCH) {
+            break;
+        }
+    }
+    
+    __atomic_store_n(&g_drain_lock, 0, __ATOMIC_RELEASE);
+    return total;
+}
+
+// Bir slot ayırır; kuyruk doluysa politikaya göre bekler veya NULL döner
+static LogSlot* acquire_slot(uint64_t *position) {
+    uint64_t pos = __atomic_load_n(&g_ring_tail, __ATOMIC_RELAXED);
+    
+    for (;;) {
+        LogSlot *slot = &g_ring[pos & LOG_RING_MASK];
+        uint64_t sequence = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+        int64_t diff = (int64_t)(sequence - pos);
+        
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&g_ring_tail, &pos, pos + 1, true,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                *position = pos;
+                return slot;
+            }
+        } else if (diff < 0) {
+            // Kuyruk dolu: yazıcı thread'i henüz yetişemedi
+            if (g_log_config.overflow_policy != LOG_OVERFLOW_BLOCK || !g_flush_running) {
+                __atomic_fetch_add(&g_dropped, 1, __ATOMIC_RELAXED);
+                return NULL;
+            }
+            // Yazıcı thread'i uyuyorsa kuyruğu bu thread boşaltır
+            if (drain_ring() == 0) {
+                sleep_ms(1);
+            }
+            pos = __atomic_load_n(&g_ring_tail, __ATOMIC_RELAXED);
+        } else {
+            pos = __atomic_load_n(&g_ring_tail, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+static void publish_slot(LogSlot *slot, uint64_t position) {
+    __atomic_store_n(&slot->sequence, position + 1, __ATOMIC_RELEASE);
+}
+
+static void* flush_thread_main(void *arg) {
+    (void)arg;
+    
+    while (g_flush_running) {
+        report_idle_log_sites(0);
+        if (drain_ring() == 0) {
+            sleep_ms(LOG_FLUSH_INTERVAL_MS);
+        }
+    }
+    
+    drain_ring();
+    return NULL;
+}
+
+// ========================================
+// Döndürülen segmentler: sıkıştırma ve saklama
+// ========================================
+
+// Log dizinindeki "<dosya adı>.<rakam>..." girdileri. key, ".snap" ve
+// ".snap.tmp" ekleri atılmış addır; aynı segmentin ham ve sıkıştırılmış
+// hâli aynı key'i paylaşır.
+typedef struct {
+    char name[256];
+    char key[256];
+} RotatedLog;
+
+static void split_log_path(char *dir, size_t dir_size, const char **base) {
+    const char *path = g_log_config.log_file_path;
+    const char *slash = strrchr(path, '/');
+    const char *backslash = strrchr(path, '\\');
+    if (backslash && (!slash || backslash > slash)) {
+        slash = backslash;
+    }
+    
+    if (slash) {
+        size_t len = (size_t)(slash - path);
+        if (len >= dir_size) {
+            len = dir_size - 1;
+        }
+        memcpy(dir, path, len);
+        dir[len] = '\0';
+        *base = slash + 1;
+    } else {
+        snprintf(dir, dir_size, ".");
+        *base = path;
+    }
+}
+
+static int ends_with(const char *text, const char *suffix) {
+    size_t text_len = strlen(text);
+    size_t suffix_len = strlen(suffix);
+    return text_len >= suffix_len && strcmp(text + text_len - suffix_len, suffix) == 0;
+}
+
+static void add_rotated_log(RotatedLog **logs, int *count, int *capacity,
+                            const char *name, const char *base) {
+    size_t base_len = strlen(base);
+    if (strncmp(name, base, base_len) != 0 || name[base_len] != '.' ||
+        name[base_len + 1] < '0' || name[base_len + 1] > '9' || strlen(name) >= sizeof((*logs)->name)) {
+        return;
+    }
+    
+    if (*count == *capacity) {
+        int new_capacity = *capacity ? *capacity * 2 : 16;
+        RotatedLog *grown = realloc(*logs, (size_t)new_capacity * sizeof(RotatedLog));
+        if (!grown) {
+            return;
+        }
+        *logs = grown;
+        *capacity = new_capacity;
+    }
+    
+    RotatedLog *entry = &(*logs)[(*count)++];
+    strcpy(entry->name, name);
+    strcpy(entry->key, name);
+    if (ends_with(entry->key, ".tmp")) {
+        entry->key[strlen(entry->key) - 4] = '\0';
+    }
+    if (ends_with(entry->key, LOG_ARCHIVE_EXTENSION)) {
+        entry->key[strlen(entry->key) - strlen(LOG_ARCHIVE_EXTENSION)] = '\0';
+    }
+}
+
+static int compare_rotated_logs(const void *a, const void *b) {
+    const RotatedLog *left = a;
+    const RotatedLog *right = b;
+    int order = strcmp(left->key, right->key);
+    return order != 0 ? order : strcmp(left->name, right->name);
+}
+
+// Key sırasına (zaman sırası) göre dizilmiş liste; *logs malloc'ludur
+static int list_rotated_logs(char *dir, size_t dir_size, RotatedLog **logs) {
+    const char *base;
+    int count = 0;
+    int capacity = 0;
+    
+    split_log_path(dir, dir_size, &base);
+    *logs = NULL;
+    
+#ifdef _WIN32
+    char search_path[MAX_PATH_LEN + 8];
+    WIN32_FIND_DATAA find_data;
+    snprintf(search_path, sizeof(search_path), "%s\\%s.*", dir, base);
+    HANDLE find = FindFirstFileA(search_path, &find_data);
+    if (find != INVALID_HANDLE_VALUE) {
+        do {
+            if (!(find_data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) {
+                add_rotated_log(logs, &count, &capacity, find_data.cFileName, base);
+            }
+        } while (FindNextFileA(find, &find_data));
+        FindClose(find);
+    }
+#else
+    DIR *directory = opendir(dir);
+    if (directory) {
+        struct dirent *entry;
+        while ((entry = readdir(directory)) != NULL) {
+            add_rotated_log(logs, &count, &capacity, entry->d_name, base);
+        }
+        closedir(directory);
+    }
+#endif
+    
+    if (count > 1) {
+        qsort(*logs, (size_t)count, sizeof(RotatedLog), compare_rotated_logs);
+    }
+    return count;
+}
+
+// Ham segmentleri sıkıştırır; arşiv önce ".snap.tmp" olarak yazılıp yerine
+// taşınır, ham dosya ancak bundan sonra silinir. Önceki çalıştırmadan kalan
+// segmentler de bu şekilde tamamlanır.
+static void compress_rotated_logs(void) {
+    char dir[MAX_PATH_LEN];
+    RotatedLog *logs;
+    int count = list_rotated_logs(dir, sizeof(dir), &logs);
+    
+    for (int i = 0; i < count && g_archive_running; i++) {
+        if (strcmp(logs[i].name, logs[i].key) != 0) {
+            continue; // zaten sıkıştırılmış veya yarım kalmış arşiv
+        }
+        
+        // Her ad bir öncekini ve ekini tam alır; kesilen yol başka bir
+        // dosyayı gösterebileceğinden o segment atlanır
+        char raw_path[MAX_PATH_LEN + 256];
+        char archive_path[sizeof(raw_path) + sizeof(LOG_ARCHIVE_EXTENSION)];
+        char temp_path[sizeof(archive_path) + sizeof(".tmp")];
+        int len = snprintf(raw_path, sizeof(raw_path), "%s/%s", dir, logs[i].name);
+        if (len < 0 || (size_t)len >= sizeof(raw_path)) {
+            continue;
+        }
+        snprintf(archive_path, sizeof(archive_path), "%s" LOG_ARCHIVE_EXTENSION, raw_path);
+        snprintf(temp_path, sizeof(temp_path), "%s.tmp", archive_path);
+        
+        CompressedFileInfo info;
+        if (!compress_file(raw_path, temp_path, &info)) {
+            continue;
+        }
+        
+        remove(archive_path);
+        if (rename(temp_path, archive_path) == 0) {
+            remove(raw_path);
+            log_debug("Log segmenti sıkıştırıldı: %s (%lld -> %lld bayt)",
+                      archive_path, info.raw_bytes, info.stored_bytes);
+        } else {
+            remove(temp_path);
+        }
+    }
+    
+    free(logs);
+}
+
+static void* archive_thread_main(void *arg) {
+    (void)arg;
+    
+    while (g_archive_running) {
+        if (__atomic_exchange_n(&g_archive_requested, 0, __ATOMIC_ACQ_REL)) {
+            compress_rotated_logs();
+            clear_old_logs();
+        } else {
+            sleep_ms(LOG_ARCHIVE_POLL_MS);
+        }
+    }
+    
+    return NULL;
+}
+
+// ========================================
+// Kapanış ve çökme durumunda boşaltma
+// ========================================
+
+static void stop_flush_thread(void) {
+    if (g_flush_running) {
+        g_flush_running = 0;
+        pthread_join(g_flush_thread, NULL);
+    }
+    report_idle_log_sites(1);
+    drain_ring();
+}
+
+// Sürmekte olan sıkıştırma bitince durur; kalan segmentler bir sonraki
+// başlatmada sıkıştırılır
+static void stop_archive_thread(void) {
+    if (g_archive_running) {
+        g_archive_running = 0;
+        pthread_join(g_archive_thread, NULL);
+    }
+}
+
+static void logger_atexit(void) {
+    stop_flush_thread();
+    stop_archive_thread();
+}
+
+static const int g_crash_signals[] = {
+    SIGSEGV, SIGABRT, SIGFPE, SIGILL,
+#ifndef _WIN32
+    SIGBUS,
+#endif
+};
+#define CRASH_SIGNAL_COUNT ((int)(sizeof(g_crash_signals) / sizeof(g_crash_signals[0])))
+
+static int crash_write(const void *data, size_t size) {
+#ifdef _WIN32
+    return _write(g_log_fd, data, (unsigned int)size) == (int)size;
+#else
+    return write(g_log_fd, data, size) == (ssize_t)size;
+#endif
+}
+
+static int log_id_defined(uint32_t id) {
+    return id <= LOG_BINARY_MAX_IDS && (g_defined_ids[id / 64] & (1ULL << (id % 64)));
+}
+
+// Sinyal bağlamında çalışır: biçimlendirme, kilit, dosya açma yok; yalnızca
+// açık dosyanın biçiminde hazır duran slotlar write(2) ile yazılır. Metin
+// dosyasındaki binary kayıtlar ve tanımı dosyaya henüz yazılmamış binary
+// kayıtlar çözülemeyeceği için atlanır.
+static void crash_drain_ring(void) {
+    if (g_log_fd < 0) {
+        return;
+    }
+    
+    for (uint64_t head = g_ring_head; ; head++) {
+        const LogSlot *slot = &g_ring[head & LOG_RING_MASK];
+        if (__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) != head + 1) {
+            break;
+        }
+        if (slot->length == 0) {
+            continue;
+        }
+        
+        if (!slot->binary && g_file_is_binary) {
+            char header[LOG_BINARY_TEXT_HEADER_SIZE];
+            size_t header_size = write_log_text_header(header, slot->length);
+            if (!crash_write(header, header_size)) {
+                break;
+            }
+        } else if (slot->binary) {
+            uint32_t module_id;
+            uint32_t format_id;
+            get_log_record_ids(slot->text, &module_id, &format_id);
+            if (!g_file_is_binary || !log_id_defined(module_id) || !log_id_defined(format_id)) {
+                continue;
+            }
+        }
+        if (!crash_write(slot->text, slot->length)) {
+            break;
+        }
+    }
+}
+
+// Kuyruktakileri yazıp sinyali varsayılan davranışıyla yeniden tetikler.
+// Yazıcı thread'i o an yazıyorsa kısa bir süre bırakmasını bekler; bırakmazsa
+// (ör. çöken thread yazıcının kendisiyse) kuyruk yazılmaz.
+static void crash_signal_handler(int sig) {
+    for (int attempt = 0; attempt < 100; attempt++) {
+        int expected = 0;
+        if (__atomic_compare_exchange_n(&g_drain_lock, &expected, 1, false,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            crash_drain_ring();
+            break;
+        }
+        sleep_ms(1);
+    }
+    
+    signal(sig, SIG_DFL);
+    raise(sig);
+}
+
+static void install_crash_handlers(void) {
+    for (int i = 0; i < CRASH_SIGNAL_COUNT; i++) {
+        signal(g_crash_signals[i], crash_signal_handler);
+    }
+}
+
 // Logger başlatma
 int init_logger(void) {
     if (g_logger_initialized) {
@@ -42,26 +835,68 @@ int init_logger(void) {
     // Log dizinini oluştur
     create_log_directory();
     
+    static int process_hooks_installed = 0;
+    if (!process_hooks_installed) {
+        for (uint64_t i = 0; i < LOG_RING_SLOTS; i++) {
+            g_ring[i].sequence = i;
+        }
+        atexit(logger_atexit);
+        install_crash_handlers();
+        process_hooks_installed = 1;
+    }
+    
+    __atomic_store_n(&g_reopen_requested, 1, __ATOMIC_RELEASE);
+    g_flush_running = 1;
+    if (pthread_create(&g_flush_thread, NULL, flush_thread_main, NULL) != 0) {
+        // Thread yoksa satırlar çağıran thread'de yazılır
+        g_flush_running = 0;
+    }
+    
+    // Başlangıçta da çalışır: önceki çalıştırmadan kalan segmentler
+    // sıkıştırılır ve saklama sınırı uygulanır
+    __atomic_store_n(&g_archive_requested, 1, __ATOMIC_RELEASE);
+    g_archive_running = 1;
+    if (pthread_create(&g_archive_thread, NULL, archive_thread_main, NULL) != 0) {
+        g_archive_running = 0;
+    }
+    
     g_logger_initialized = 1;
     return 1;
 }
 
 // Logger temizleme
 int cleanup_logger(void) {
+    stop_flush_thread();
+    stop_archive_thread();
     g_logger_initialized = 0;
     return 1;
 }
 
+int flush_logger(void) {
+    // Yazıcı thread'i o an yazıyorsa o turu bitirmesini bekle
+    while (drain_ring() == 0 && __atomic_load_n(&g_drain_lock, __ATOMIC_ACQUIRE)) {
+        sleep_ms(1);
+    }
+    return 1;
+}
+
+unsigned long long get_log_dropped_count(void) {
+    return __atomic_load_n(&g_dropped, __ATOMIC_RELAXED);
+}
+
 // Log seviyesi ayarlama
 int set_log_level(LogLevel level) {
     g_log_config.min_level = level;
+    g_log_min_level = level;
     return 1;
 }
 
 // Log dosyası ayarlama
 int set_log_file(const char* filepath) {
     if (filepath && strlen(filepath) < sizeof(g_log_config.log_file_path)) {
+        flush_logger();
         strcpy(g_log_config.log_file_path, filepath);
+        __atomic_store_n(&g_reopen_requested, 1, __ATOMIC_RELEASE);
         return 1;
     }
     return 0;
@@ -79,85 +914,445 @@ int enable_file_logging(int enable) {
     return 1;
 }
 
-// Ana loglama fonksiyonu
-void log_message(LogLevel level, const char* format, ...) {
-    if (!g_logger_initialized) {
-        init_logger();
+// Zaman damgasına milisaniye/mikrosaniye ekleme
+int set_log_timestamp_precision(LogTimestampPrecision precision) {
+    g_log_config.timestamp_precision = precision;
+    return 1;
+}
+
+// Boyut eşiği (MB) ve saklanacak eski segment sayısı
+int set_log_rotation(int max_file_size_mb, int max_backup_files) {
+    g_log_config.max_file_size = max_file_size_mb;
+    g_log_config.max_backup_files = max_backup_files;
+    __atomic_store_n(&g_archive_requested, 1, __ATOMIC_RELEASE);
+    return 1;
+}
+
+// Metin veya binary dosya biçimi. Kuyrukta kalanlar eski dosyaya yazılır;
+// yeniden açılış yalnızca iki alan da değiştikten sonra istenir.
+int set_log_format(LogFormat format, const char* filepath) {
+    if (filepath && strlen(filepath) >= sizeof(g_log_config.log_file_path)) {
+        return 0;
     }
     
-    if (level < g_log_config.min_level) {
-        return;
+    flush_logger();
+    if (filepath) {
+        strcpy(g_log_config.log_file_path, filepath);
+    }
+    g_log_config.format = format;
+    __atomic_store_n(&g_reopen_requested, 1, __ATOMIC_RELEASE);
+    return 1;
+}
+
+// LOG_RATE_LIMITED yerleri için genel oran; per_second <= 0 yerlerin kendi oranına döner
+int set_log_rate_limit(double per_second, int burst) {
+    g_rate_limit_per_second = per_second > 0 ? per_second : 0;
+    g_rate_limit_burst = burst > 0 ? burst : per_second;
+    return 1;
+}
+
+// Kuyruk dolu olduğunda davranış
+int set_log_overflow_policy(LogOverflowPolicy policy) {
+    g_log_config.overflow_policy = policy;
+    return 1;
+}
+
+// ========================================
+// Hız sınırı ve tekrar birleştirme
+// ========================================
+
+// Yalnızca LOG_RATE_LIMITED yerleri sınırlanır; yer __FILE__ ve __LINE__
+// ile tanınır, aynı format string'ini paylaşan yerler ayrı kova alır. Kova boşken gelen
+// mesajlar sayılıp atılır; aynı yerden art arda gelen aynı mesaj yazılmaz.
+// Sayılar bir sonraki mesajla veya yer LOG_SITE_IDLE_MS sessiz kalınca
+// yazıcı thread'i tarafından özet satırı olarak yazılır.
+#define LOG_SITE_SLOTS 1024
+#define LOG_SITE_IDLE_MS 1000
+#define LOG_SITE_SCAN_MS 250
+
+typedef struct {
+    const char *file;               // file ve line anahtar; file NULL ise boş
+    int line;
+    const char *format;
+    const char *module;
+    int lock;
+    LogLevel level;
+    double rate;                    // saniyede mesaj; 0 ise genel ayar
+    double tokens;
+    uint64_t refill_us;
+    uint64_t last_seen_us;
+    uint64_t last_hash;
+    unsigned long long repeats;
+    unsigned long long suppressed;
+} LogSite;
+
+static LogSite g_sites[LOG_SITE_SLOTS];
+static uint64_t g_last_site_scan_us = 0;
+
+static uint64_t to_microseconds(time_t seconds, long microseconds) {
+    return (uint64_t)seconds * 1000000 + (uint64_t)microseconds;
+}
+
+static void lock_site(LogSite *site) {
+    while (__atomic_exchange_n(&site->lock, 1, __ATOMIC_ACQUIRE)) {
+        // kısa kritik bölge
+    }
+}
+
+static void unlock_site(LogSite *site) {
+    __atomic_store_n(&site->lock, 0, __ATOMIC_RELEASE);
+}
+
+static double site_rate(const LogSite *site) {
+    return g_rate_limit_per_second > 0 ? g_rate_limit_per_second : site->rate;
+}
+
+static double site_burst(const LogSite *site) {
+    double burst = g_rate_limit_per_second > 0 ? g_rate_limit_burst : site->rate;
+    return burst >= 1 ? burst : 1;
+}
+
+// Yer ilk kez görüldüğünde kilit tutularak eklenir; file en son yayınlanır,
+// onu gören herkes line ve diğer alanları da görür. Tablo doluysa NULL.
+static LogSite* find_log_site(const char *file, int line, const char *format, const char *module,
+                              LogLevel level, double rate, uint64_t now_us) {
+    uint64_t key = (uint64_t)(uintptr_t)file ^ ((uint64_t)(uint32_t)line << 3);
+    uint32_t start = (uint32_t)(((key >> 3) * 0x9E3779B97F4A7C15ULL) >> 54);
+    
+    for (uint32_t probe = 0; probe < LOG_SITE_SLOTS; probe++) {
+        LogSite *site = &g_sites[(start + probe) & (LOG_SITE_SLOTS - 1)];
+        const char *current = __atomic_load_n(&site->file, __ATOMIC_ACQUIRE);
+        
+        if (current == NULL) {
+            lock_site(site);
+            current = site->file;
+            if (current == NULL) {
+                site->line = line;
+                site->format = format;
+                site->module = module;
+                site->level = level;
+                site->rate = rate;
+                site->tokens = site_burst(site);
+                site->refill_us = now_us;
+                site->last_seen_us = now_us;
+                __atomic_store_n(&site->file, file, __ATOMIC_RELEASE);
+                unlock_site(site);
+                return site;
+            }
+            unlock_site(site);
+        }
+        
+        if (current == file && site->line == line) {
+            return site;
+        }
     }
     
-    va_list args;
-    char message[1024];
-    char timestamp[64];
-    time_t now;
-    struct tm* timeinfo;
+    return NULL;
+}
+
+// Kovadan bir token alır; önceden atılmış mesaj sayısı *suppressed'e yazılır
+static int take_site_token(LogSite *site, uint64_t now_us, unsigned long long *suppressed) {
+    int allowed = 0;
+    *suppressed = 0;
+    
+    lock_site(site);
+    if (now_us > site->refill_us) {
+        site->tokens += (double)(now_us - site->refill_us) * site_rate(site) / 1000000.0;
+        double burst = site_burst(site);
+        if (site->tokens > burst) {
+            site->tokens = burst;
+        }
+        site->refill_us = now_us;
+    }
+    site->last_seen_us = now_us;
     
-    // Zaman damgası oluştur
-    time(&now);
-    timeinfo = localtime(&now);
-    strftime(timestamp, sizeof(timestamp), "%Y-%m-%d %H:%M:%S", timeinfo);
+    if (site->tokens >= 1) {
+        site->tokens -= 1;
+        *suppressed = site->suppressed;
+        site->suppressed = 0;
+        allowed = 1;
+    } else {
+        site->suppressed++;
+    }
+    unlock_site(site);
     
-    // Mesajı formatla
+    return allowed;
+}
+
+// Aynı mesajsa sayar ve 1 döner; değilse bekleyen tekrar sayısını verir
+static int coalesce_site_message(LogSite *site, uint64_t hash, uint64_t now_us,
+                                 unsigned long long *repeats) {
+    int duplicate;
+    *repeats = 0;
+    
+    lock_site(site);
+    site->last_seen_us = now_us;
+    duplicate = site->last_hash == hash;
+    if (duplicate) {
+        site->repeats++;
+    } else {
+        *repeats = site->repeats;
+        site->repeats = 0;
+        site->last_hash = hash;
+    }
+    unlock_site(site);
+    
+    return duplicate;
+}
+
+static uint64_t hash_log_bytes(const char *data, size_t length) {
+    uint64_t hash = 1469598103934665603ULL;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (unsigned char)data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash ? hash : 1;
+}
+
+static void emit_log(LogSite *site, const char* module, LogLevel level, time_t now, long microseconds,
+                     const char* format, va_list args);
+
+static void emit_internal(const char* module, LogLevel level, const char* format, ...) {
+    long microseconds;
+    time_t now = current_log_time(&microseconds);
+    va_list args;
     va_start(args, format);
-    vsnprintf(message, sizeof(message), format, args);
+    emit_log(NULL, module, level, now, microseconds, format, args);
     va_end(args);
+}
+
+static void report_log_site(const char *module, LogLevel level, const char *format,
+                            unsigned long long repeats, unsigned long long suppressed) {
+    if (repeats > 0) {
+        emit_internal(module, level, "Son mesaj %llu kez daha tekrarlandı: %s", repeats, format);
+    }
+    if (suppressed > 0) {
+        emit_internal(module, level, "Hız sınırı: %llu mesaj atlandı: %s", suppressed, format);
+    }
+}
+
+// Sessiz kalan yerlerin bekleyen sayılarını yazar; force kapanışta hepsini
+static void report_idle_log_sites(int force) {
+    long microseconds;
+    time_t now = current_log_time(&microseconds);
+    uint64_t now_us = to_microseconds(now, microseconds);
+    
+    if (!force && now_us - g_last_site_scan_us < LOG_SITE_SCAN_MS * 1000ULL) {
+        return;
+    }
+    g_last_site_scan_us = now_us;
+    
+    for (int i = 0; i < LOG_SITE_SLOTS; i++) {
+        LogSite *site = &g_sites[i];
+        if (!__atomic_load_n(&site->file, __ATOMIC_ACQUIRE)) {
+            continue;
+        }
+        
+        unsigned long long repeats = 0;
+        unsigned long long suppressed = 0;
+        lock_site(site);
+        if ((site->repeats || site->suppressed) &&
+            (force || now_us - site->last_seen_us >= LOG_SITE_IDLE_MS * 1000ULL)) {
+            repeats = site->repeats;
+            suppressed = site->suppressed;
+            site->repeats = 0;
+            site->suppressed = 0;
+            site->last_hash = 0;
+        }
+        unlock_site(site);
+        
+        report_log_site(site->module, site->level, site->format, repeats, suppressed);
+    }
+}
+
+// Satırı (veya binary kaydı) üretip doğrudan kuyruk slotuna formatlar.
+// Sınırlanan yerlerde tekrar eden mesajın slotu boş yayınlanır; tekrar
+// özeti yeni mesajdan önce yazılmalıysa kayıt bir kez yığına taşınır.
+static void emit_log(LogSite *site, const char* module, LogLevel level, time_t now, long microseconds,
+                     const char* format, va_list args) {
+    int to_file = g_log_config.file_output;
+    uint64_t position = 0;
+    LogSlot *slot = to_file ? acquire_slot(&position) : NULL;
+    char local_record[LOG_LINE_MAX];
+    char local_line[LOG_LINE_MAX];
+    char *record = slot ? slot->text : local_record;
+    int record_length = 0;
+    int encoded = 0;
+    
+    // Binary kayıt: yalnızca argümanlar kopyalanır
+    if (to_file && g_log_config.format == LOG_FORMAT_BINARY) {
+        va_list values;
+        va_copy(values, args);
+        int len = encode_log_record(record, LOG_LINE_MAX, module, level,
+                                    to_microseconds(now, microseconds), format, values);
+        va_end(values);
+        if (len > 0) {
+            record_length = len;
+            encoded = 1;
+        }
+    }
+    
+    // Metin satırı: dosya için (kodlanamadıysa) ve konsol için
+    char *line = encoded ? local_line : record;
+    int line_length = 0;
+    int prefix_length = 0;
+    if (!encoded || g_log_config.console_output) {
+        // Zaman damgası oluştur (thread başına önbellekten)
+        char timestamp[LOG_TIMESTAMP_MAX];
+        format_log_timestamp(timestamp, now, microseconds);
+        
+        prefix_length = snprintf(line, LOG_LINE_MAX, "[%s] %s: ", timestamp, get_log_level_string(level));
+        int len = prefix_length;
+        int message_len = vsnprintf(line + len, LOG_LINE_MAX - len - 1, format, args);
+        if (message_len > 0) {
+            len += message_len < LOG_LINE_MAX - len - 1 ? message_len : LOG_LINE_MAX - len - 2;
+        }
+        line[len++] = '\n';
+        line[len] = '\0';
+        line_length = len;
+        if (!encoded) {
+            record_length = len;
+        }
+    }
+    
+    if (site) {
+        // Binary kayıtta zaman damgasından sonrası, metinde önekten sonrası karşılaştırılır
+        uint64_t hash = encoded ? hash_log_bytes(record + 12, (size_t)record_length - 12)
+                                : hash_log_bytes(line + prefix_length, (size_t)(line_length - prefix_length));
+        unsigned long long repeats;
+        if (coalesce_site_message(site, hash, to_microseconds(now, microseconds), &repeats)) {
+            if (slot) {
+                slot->length = 0;
+                publish_slot(slot, position);
+            }
+            return;
+        }
+        if (repeats > 0) {
+            // Seyrek yol: özet satırı bu mesajdan önce kuyruğa girer
+            if (slot) {
+                memcpy(local_record, record, (size_t)record_length);
+                if (!encoded) {
+                    line = local_record;
+                }
+                record = local_record;
+                slot->length = 0;
+                publish_slot(slot, position);
+            }
+            report_log_site(module, level, format, repeats, 0);
+            if (slot && (slot = acquire_slot(&position)) != NULL) {
+                memcpy(slot->text, record, (size_t)record_length);
+            }
+        }
+    }
     
     // Konsola yazdır
     if (g_log_config.console_output) {
-        printf("[%s] %s: %s\n", timestamp, get_log_level_string(level), message);
+        fwrite(line, 1, (size_t)line_length, stdout);
+    }
+    
+    // Dosyaya yazdır: kayıt kuyruğa girer, yazıcı thread'i dosyaya aktarır
+    if (slot) {
+        slot->length = (uint32_t)record_length;
+        slot->binary = (uint32_t)encoded;
+        publish_slot(slot, position);
+        
+        if (!g_flush_running) {
+            drain_ring();
+        }
+    }
+}
+
+static void log_with_limit(const char* module, const char* file, int line, LogLevel level,
+                           double per_second, const char* format, va_list args) {
+    if (!g_logger_initialized) {
+        init_logger();
     }
     
-    // Dosyaya yazdır
-    if (g_log_config.file_output) {
-        FILE* file = fopen(g_log_config.log_file_path, "a");
-        if (file) {
-            fprintf(file, "[%s] %s: %s\n", timestamp, get_log_level_string(level), message);
-            fclose(file);
+    if (level < g_log_min_level || (!g_log_config.console_output && !g_log_config.file_output)) {
+        return;
+    }
+    
+    long microseconds;
+    time_t now = current_log_time(&microseconds);
+    LogSite *site = NULL;
+    
+    if (file && per_second > 0) {
+        uint64_t now_us = to_microseconds(now, microseconds);
+        site = find_log_site(file, line, format, module, level, per_second, now_us);
+        if (site) {
+            unsigned long long suppressed;
+            if (!take_site_token(site, now_us, &suppressed)) {
+                return;
+            }
+            if (suppressed > 0) {
+                report_log_site(module, level, format, 0, suppressed);
+            }
         }
     }
+    
+    emit_log(site, module, level, now, microseconds, format, args);
+}
+
+// Ana loglama fonksiyonu: satır tek seferde, doğrudan kuyruk slotuna formatlanır.
+// Binary biçimde slota yalnızca kayıt yazılır; metin yalnızca konsol için
+// veya format kodlanamıyorsa üretilir.
+void vlog_module_message(const char* module, LogLevel level, const char* format, va_list args) {
+    log_with_limit(module, NULL, 0, level, 0, format, args);
 }
 
-// Debug log
-void log_debug(const char* format, ...) {
+void vlog_message(LogLevel level, const char* format, va_list args) {
+    log_with_limit(NULL, NULL, 0, level, 0, format, args);
+}
+
+void log_limited_message(const char* module, const char* file, int line, LogLevel level,
+                         double per_second, const char* format, ...) {
     va_list args;
     va_start(args, format);
-    char message[1024];
-    vsnprintf(message, sizeof(message), format, args);
+    log_with_limit(module, file, line, level, per_second, format, args);
     va_end(args);
-    log_message(LOG_DEBUG, "%s", message);
 }
 
-// Info log
-void log_info(const char* format, ...) {
+void log_module_message(const char* module, LogLevel level, const char* format, ...) {
     va_list args;
     va_start(args, format);
-    char message[1024];
-    vsnprintf(message, sizeof(message), format, args);
+    vlog_module_message(module, level, format, args);
     va_end(args);
-    log_message(LOG_INFO, "%s", message);
 }
 
-// Warning log
-void log_warning(const char* format, ...) {
+void log_message(LogLevel level, const char* format, ...) {
     va_list args;
     va_start(args, format);
-    char message[1024];
-    vsnprintf(message, sizeof(message), format, args);
+    vlog_module_message(NULL, level, format, args);
     va_end(args);
-    log_message(LOG_WARNING, "%s", message);
 }
 
-// Error log
-void log_error(const char* format, ...) {
+// Makroların yerine fonksiyon adresi gereken yerler için
+void (log_debug)(const char* format, ...) {
     va_list args;
     va_start(args, format);
-    char message[1024];
-    vsnprintf(message, sizeof(message), format, args);
+    vlog_message(LOG_DEBUG, format, args);
+    va_end(args);
+}
+
+void (log_info)(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    vlog_message(LOG_INFO, format, args);
+    va_end(args);
+}
+
+void (log_warning)(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    vlog_message(LOG_WARNING, format, args);
+    va_end(args);
+}
+
+void (log_error)(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    vlog_message(LOG_ERROR, format, args);
     va_end(args);
-    log_message(LOG_ERROR, "%s", message);
 }
 
 // Log seviyesi string'i al
@@ -195,51 +1390,116 @@ int create_log_directory(void) {
     return 1;
 }
 
-// Log dosyası boyutunu al
+const char* get_log_file_path(void) {
+    return g_log_config.log_file_path;
+}
+
+LogFormat get_log_format(void) {
+    return g_log_config.format;
+}
+
+// Log dosyası boyutunu al (MB); dosya açılmadan sayaçtan okunur
 int get_log_file_size(void) {
-    FILE* file = fopen(g_log_config.log_file_path, "r");
-    if (!file) {
-        return 0;
-    }
-    
-    fseek(file, 0, SEEK_END);
-    long size = ftell(file);
-    fclose(file);
-    
-    return (int)(size / (1024 * 1024)); // MB cinsinden
+    return (int)(get_log_file_bytes() / (1024 * 1024));
 }
 
-// Log dosyası rotasyonu
+unsigned long long get_log_file_bytes(void) {
+    return __atomic_load_n(&g_log_file_bytes, __ATOMIC_RELAXED);
+}
+
+// Log dosyası rotasyonu: normalde yazıcı thread'i eşikte kendisi döndürür,
+// bu çağrı eşik aşılmışsa beklemeden döndürür
 int rotate_log_file(void) {
-    if (get_log_file_size() < g_log_config.max_file_size) {
+    if (g_log_config.max_file_size <= 0 || get_log_file_size() < g_log_config.max_file_size) {
         return 1; // Rotasyon gerekli değil
     }
     
-    // Backup dosyası oluştur
-    char backup_path[512];
-    time_t now;
-    struct tm* timeinfo;
+    return backup_log_file();
+}
+
+// Backup dosyası oluştur: kuyruktakiler eski dosyaya yazılır, sonrası yeni dosyaya
+int backup_log_file(void) {
+    __atomic_store_n(&g_rotate_requested, 1, __ATOMIC_RELEASE);
+    flush_logger();
+    return 1;
+}
+
+// Döndürülmüş segmentler (key sırasıyla) ve en sonda aktif dosya. Bir
+// segmentin ham hâli varsa o seçilir; sıkıştırma sürerken ikisi birden
+// bulunabilir. Yarım kalmış ".snap.tmp" arşivleri atlanır.
+int list_log_segments(LogSegment **segments) {
+    char dir[MAX_PATH_LEN];
+    RotatedLog *logs;
+    int count = list_rotated_logs(dir, sizeof(dir), &logs);
     
-    time(&now);
-    timeinfo = localtime(&now);
+    *segments = malloc((size_t)(count + 1) * sizeof(LogSegment));
+    if (!*segments) {
+        free(logs);
+        return 0;
+    }
     
-    snprintf(backup_path, sizeof(backup_path), "%s.%04d%02d%02d_%02d%02d%02d",
-             g_log_config.log_file_path,
-             timeinfo->tm_year + 1900, timeinfo->tm_mon + 1, timeinfo->tm_mday,
-             timeinfo->tm_hour, timeinfo->tm_min, timeinfo->tm_sec);
+    // Aynı key içinde ad sırası: ham, ".snap", ".snap.tmp"
+    int used = 0;
+    int last = -1;
+    for (int i = 0; i < count; i++) {
+        int raw = strcmp(logs[i].name, logs[i].key) == 0;
+        if (!raw && !ends_with(logs[i].name, LOG_ARCHIVE_EXTENSION)) {
+            continue;
+        }
+        if (last >= 0 && strcmp(logs[i].key, logs[last].key) == 0) {
+            continue; // aynı segmentin ham hâli zaten eklendi
+        }
+        last = i;
+        
+        LogSegment *segment = &(*segments)[used++];
+        snprintf(segment->path, sizeof(segment->path), "%s/%s", dir, logs[i].name);
+        segment->compressed = !raw;
+    }
     
-    rename(g_log_config.log_file_path, backup_path);
+    LogSegment *active = &(*segments)[used++];
+    snprintf(active->path, sizeof(active->path), "%s", g_log_config.log_file_path);
+    active->compressed = 0;
     
-    return 1;
-}
-
-// Backup dosyası oluştur
-int backup_log_file(void) {
-    return rotate_log_file();
+    free(logs);
+    return used;
 }
 
-// Eski logları temizle
+// Eski logları temizle: en yeni max_backup_files segment (ham veya
+// sıkıştırılmış) kalır, daha eskiler silinir
 int clear_old_logs(void) {
-    // Bu fonksiyon geliştirilecek - şimdilik basit implementasyon
+    if (g_log_config.max_backup_files < 0) {
+        return 1;
+    }
+    
+    char dir[MAX_PATH_LEN];
+    RotatedLog *logs;
+    int count = list_rotated_logs(dir, sizeof(dir), &logs);
+    
+    // Farklı key sayısı; liste key'e göre sıralı
+    int segments = 0;
+    for (int i = 0; i < count; i++) {
+        if (i == 0 || strcmp(logs[i].key, logs[i - 1].key) != 0) {
+            segments++;
+        }
+    }
+    
+    int to_remove = segments - g_log_config.max_backup_files;
+    int removed = 0;
+    for (int i = 0; i < count && to_remove > 0; i++) {
+        char path[MAX_PATH_LEN + 256];
+        snprintf(path, sizeof(path), "%s/%s", dir, logs[i].name);
+        remove(path);
+        
+        if (i + 1 == count || strcmp(logs[i].key, logs[i + 1].key) != 0) {
+            to_remove--;
+            removed++;
+        }
+    }
+    
+    if (removed > 0) {
+        log_debug("%d eski log segmenti silindi", removed);
+    }
+    
+    free(logs);
     return 1;
-}
\ No newline at end of file
+}
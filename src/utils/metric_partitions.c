@@ -0,0 +1,484 @@
+/*
+ * ========================================
+ * Metric Partitions Implementation - Zamana Göre Bölümlenmiş Metrik Tabloları
+ * ========================================
+ *
+ * With partitioning on, system_metrics is a UNION ALL view over one table
+ * per day or week, listed in metric_partitions. Expiring a day becomes a
+ * DROP TABLE instead of deleting rows one index entry at a time, and range
+ * queries only open the tables whose span overlaps the requested window.
+ * Row ids stay unique across partitions through metric_partition_sequence.
+ * Spans are aligned to UTC midnight (weeks start on Monday).
+ */
+
+#include "../../include/metric_partitions.h"
+#include "../../include/db_pool.h"
+#include "../../include/logger.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#define SECONDS_PER_DAY (24 * 60 * 60)
+
+// Table created when partitioning an existing, non-empty system_metrics
+#define LEGACY_PARTITION "system_metrics_legacy"
+
+static const char *partition_columns = "id, timestamp, cpu_usage, memory_usage, disk_usage, hostname_id";
+
+// Set once at startup and by set_metric_partitioning; read by every thread
+static volatile bool partitioned = false;
+static PartitionSpan partition_span = PARTITION_DAILY;
+
+static bool system_metrics_is_view(void) {
+    sqlite3_stmt *stmt;
+    bool is_view = false;
+
+    if (sqlite3_prepare_v2(db, "SELECT 1 FROM sqlite_master WHERE type = 'view' AND name = 'system_metrics';",
+                           -1, &stmt, NULL) == SQLITE_OK) {
+        is_view = sqlite3_step(stmt) == SQLITE_ROW;
+        sqlite3_finalize(stmt);
+    }
+
+    return is_view;
+}
+
+bool create_partition_tables(void) {
+    const char *sql =
+        "CREATE TABLE IF NOT EXISTS metric_partitions ("
+        "name TEXT PRIMARY KEY,"
+        "start_ts INTEGER NOT NULL,"
+        "end_ts INTEGER NOT NULL"
+        ");"
+        "CREATE INDEX IF NOT EXISTS idx_metric_partitions_start ON metric_partitions(start_ts);"
+        "CREATE TABLE IF NOT EXISTS metric_partition_sequence ("
+        "id INTEGER PRIMARY KEY CHECK (id = 1),"
+        "last_id INTEGER NOT NULL"
+        ");";
+
+    if (!execute_query(sql)) {
+        return false;
+    }
+
+    partitioned = system_metrics_is_view();
+    return true;
+}
+
+bool metric_partitioning_enabled(void) {
+    return partitioned;
+}
+
+bool partition_span_from_name(const char *name, PartitionSpan *span) {
+    if (!name || strcmp(name, "none") == 0) {
+        *span = PARTITION_NONE;
+    } else if (strcmp(name, "day") == 0 || strcmp(name, "daily") == 0) {
+        *span = PARTITION_DAILY;
+    } else if (strcmp(name, "week") == 0 || strcmp(name, "weekly") == 0) {
+        *span = PARTITION_WEEKLY;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// ========================================
+// Catalog queries
+// ========================================
+
+int list_metric_partitions(sqlite3 *conn, time_t from, time_t to, MetricPartition **partitions) {
+    const char *sql = "SELECT name, start_ts, end_ts FROM metric_partitions "
+                      "WHERE end_ts > ? AND start_ts < ? ORDER BY start_ts DESC;";
+
+    *partitions = NULL;
+
+    sqlite3_stmt *stmt;
+    if (sqlite3_prepare_v2(conn, sql, -1, &stmt, NULL) != SQLITE_OK) {
+        log_error("Failed to prepare statement: %s", sqlite3_errmsg(conn));
+        return -1;
+    }
+
+    sqlite3_bind_int64(stmt, 1, from);
+    sqlite3_bind_int64(stmt, 2, to);
+
+    int count = 0, capacity = 0;
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        if (count == capacity) {
+            capacity = capacity > 0 ? capacity * 2 : 16;
+            MetricPartition *grown = realloc(*partitions, sizeof(MetricPartition) * capacity);
+            if (!grown) {
+                log_error("Memory allocation failed");
+                sqlite3_finalize(stmt);
+                free(*partitions);
+                *partitions = NULL;
+                return -1;
+            }
+            *partitions = grown;
+        }
+
+        MetricPartition *partition = &(*partitions)[count++];
+        strncpy(partition->name, (const char*)sqlite3_column_text(stmt, 0), sizeof(partition->name) - 1);
+        partition->name[sizeof(partition->name) - 1] = '\0';
+        partition->start_ts = sqlite3_column_int64(stmt, 1);
+        partition->end_ts = sqlite3_column_int64(stmt, 2);
+    }
+
+    sqlite3_finalize(stmt);
+    return count;
+}
+
+static bool query_int64(const char *sql, long long bind_value, long long *value) {
+    sqlite3_stmt *stmt;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK) {
+        log_error("Failed to prepare statement: %s", sqlite3_errmsg(db));
+        return false;
+    }
+
+    if (sqlite3_bind_parameter_count(stmt) > 0) {
+        sqlite3_bind_int64(stmt, 1, bind_value);
+    }
+
+    int rc = sqlite3_step(stmt);
+    if (rc == SQLITE_ROW && sqlite3_column_type(stmt, 0) != SQLITE_NULL) {
+        *value = sqlite3_column_int64(stmt, 0);
+    }
+    sqlite3_finalize(stmt);
+
+    return rc == SQLITE_ROW || rc == SQLITE_DONE;
+}
+
+// Recreates the system_metrics view over the current partition list
+static bool rebuild_partition_view(void) {
+    MetricPartition *partitions;
+    int count = list_metric_partitions(db, LLONG_MIN, LLONG_MAX, &partitions);
+    if (count < 0) {
+        return false;
+    }
+
+    size_t size = 256 + (size_t)count * (strlen(partition_columns) + METRIC_PARTITION_NAME_SIZE + 32);
+    char *sql = malloc(size);
+    if (!sql) {
+        log_error("Memory allocation failed");
+        free(partitions);
+        return false;
+    }
+
+    int len = snprintf(sql, size, "DROP VIEW IF EXISTS system_metrics; CREATE VIEW system_metrics AS ");
+    if (count == 0) {
+        // Keeps the columns readable until the first partition exists
+        len += snprintf(sql + len, size - len,
+                        "SELECT 0 AS id, 0 AS timestamp, 0.0 AS cpu_usage, 0.0 AS memory_usage, "
+                        "0.0 AS disk_usage, 0 AS hostname_id WHERE 0");
+    }
+    for (int i = count - 1; i >= 0; i--) {
+        len += snprintf(sql + len, size - len, "SELECT %s FROM %s%s", partition_columns,
+                        partitions[i].name, i > 0 ? " UNION ALL " : "");
+    }
+    snprintf(sql + len, size - len, ";");
+
+    bool ok = execute_query(sql);
+    free(sql);
+    free(partitions);
+    return ok;
+}
+
+// ========================================
+// Writer side
+// ========================================
+
+static void partition_bounds(time_t timestamp, time_t *start, time_t *end) {
+    time_t day = timestamp - timestamp % SECONDS_PER_DAY;
+
+    if (partition_span == PARTITION_WEEKLY) {
+        // 1970-01-01 was a Thursday
+        *start = day - ((day / SECONDS_PER_DAY + 3) % 7) * SECONDS_PER_DAY;
+        *end = *start + 7 * SECONDS_PER_DAY;
+    } else {
+        *start = day;
+        *end = day + SECONDS_PER_DAY;
+    }
+}
+
+static void format_partition_name(time_t start, char *name, size_t size) {
+    struct tm *tm_info = gmtime(&start);
+
+    if (start % SECONDS_PER_DAY == 0) {
+        snprintf(name, size, "system_metrics_p%04d%02d%02d",
+                 tm_info->tm_year + 1900, tm_info->tm_mon + 1, tm_info->tm_mday);
+    } else {
+        snprintf(name, size, "system_metrics_p%04d%02d%02d_%02d%02d%02d",
+                 tm_info->tm_year + 1900, tm_info->tm_mon + 1, tm_info->tm_mday,
+                 tm_info->tm_hour, tm_info->tm_min, tm_info->tm_sec);
+    }
+}
+
+static int find_partition(time_t timestamp, MetricPartition *partition) {
+    const char *sql = "SELECT name, start_ts, end_ts FROM metric_partitions "
+                      "WHERE start_ts <= ? AND end_ts > ? LIMIT 1;";
+
+    sqlite3_stmt *stmt;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK) {
+        log_error("Failed to prepare statement: %s", sqlite3_errmsg(db));
+        return -1;
+    }
+
+    sqlite3_bind_int64(stmt, 1, timestamp);
+    sqlite3_bind_int64(stmt, 2, timestamp);
+
+    int found = 0;
+    if (sqlite3_step(stmt) == SQLITE_ROW) {
+        strncpy(partition->name, (const char*)sqlite3_column_text(stmt, 0), sizeof(partition->name) - 1);
+        partition->name[sizeof(partition->name) - 1] = '\0';
+        partition->start_ts = sqlite3_column_int64(stmt, 1);
+        partition->end_ts = sqlite3_column_int64(stmt, 2);
+        found = 1;
+    }
+
+    sqlite3_finalize(stmt);
+    return found;
+}
+
+static bool create_partition(time_t timestamp, MetricPartition *partition) {
+    long long start, end;
+    time_t span_start, span_end;
+    partition_bounds(timestamp, &span_start, &span_end);
+    start = span_start;
+    end = span_end;
+
+    // Neighbours from the legacy table or another span setting win
+    if (!query_int64("SELECT MAX(end_ts) FROM metric_partitions WHERE end_ts <= ?;", timestamp, &start) ||
+        !query_int64("SELECT MIN(start_ts) FROM metric_partitions WHERE start_ts > ?;", timestamp, &end)) {
+        return false;
+    }
+    if (start < span_start) {
+        start = span_start;
+    }
+    if (end > span_end) {
+        end = span_end;
+    }
+
+    partition->start_ts = start;
+    partition->end_ts = end;
+    format_partition_name(partition->start_ts, partition->name, sizeof(partition->name));
+
+    char sql[768];
+    snprintf(sql, sizeof(sql),
+             "CREATE TABLE %s ("
+             "id INTEGER PRIMARY KEY,"
+             "timestamp INTEGER NOT NULL,"
+             "cpu_usage REAL NOT NULL,"
+             "memory_usage REAL NOT NULL,"
+             "disk_usage REAL NOT NULL,"
+             "hostname_id INTEGER NOT NULL REFERENCES interned_strings(id)"
+             ");"
+             "CREATE INDEX %s_timestamp ON %s(timestamp);"
+             "CREATE INDEX %s_hostname ON %s(hostname_id, timestamp);"
+             "INSERT INTO metric_partitions (name, start_ts, end_ts) VALUES ('%s', %lld, %lld);",
+             partition->name, partition->name, partition->name, partition->name, partition->name,
+             partition->name, start, end);
+
+    if (!execute_query(sql) || !rebuild_partition_view()) {
+        log_error("Failed to create metric partition %s", partition->name);
+        return false;
+    }
+
+    log_info("Created metric partition %s", partition->name);
+    return true;
+}
+
+bool resolve_insert_partition(time_t timestamp, char *table, size_t table_size, long long *row_id) {
+    MetricPartition partition;
+    int found = find_partition(timestamp, &partition);
+
+    if (found < 0 || (found == 0 && !create_partition(timestamp, &partition))) {
+        return false;
+    }
+
+    if (!execute_query("UPDATE metric_partition_sequence SET last_id = last_id + 1 WHERE id = 1;") ||
+        !query_int64("SELECT last_id FROM metric_partition_sequence WHERE id = 1;", 0, row_id)) {
+        return false;
+    }
+
+    snprintf(table, table_size, "%s", partition.name);
+    return true;
+}
+
+static long long count_rows(const char *table) {
+    char sql[128];
+    long long rows = 0;
+    snprintf(sql, sizeof(sql), "SELECT COUNT(*) FROM %s;", table);
+    return query_int64(sql, 0, &rows) ? rows : -1;
+}
+
+int expire_metric_partitions(time_t cutoff_time, int batch_rows) {
+    MetricPartition *partitions;
+    int count = list_metric_partitions(db, LLONG_MIN, cutoff_time, &partitions);
+    if (count < 0) {
+        return -1;
+    }
+
+    long long removed = 0;
+    bool dropped = false;
+    bool ok = true;
+    char sql[256];
+
+    for (int i = 0; i < count && ok; i++) {
+        if (partitions[i].end_ts <= cutoff_time) {
+            // Whole partition expired: dropping it costs the same at any size
+            long long rows = count_rows(partitions[i].name);
+            snprintf(sql, sizeof(sql), "DROP TABLE %s; DELETE FROM metric_partitions WHERE name = '%s';",
+                     partitions[i].name, partitions[i].name);
+            ok = rows >= 0 && execute_query(sql);
+            if (ok) {
+                log_info("Dropped expired metric partition %s (%lld rows)", partitions[i].name, rows);
+                removed += rows;
+                dropped = true;
+            }
+        } else if (removed < batch_rows) {
+            // The partition holding the cutoff is trimmed like a plain table
+            sqlite3_stmt *stmt;
+            snprintf(sql, sizeof(sql),
+                     "DELETE FROM %s WHERE rowid IN (SELECT rowid FROM %s WHERE timestamp < ? LIMIT ?);",
+                     partitions[i].name, partitions[i].name);
+            ok = sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) == SQLITE_OK;
+            if (ok) {
+                sqlite3_bind_int64(stmt, 1, cutoff_time);
+                sqlite3_bind_int64(stmt, 2, batch_rows - removed);
+                ok = sqlite3_step(stmt) == SQLITE_DONE;
+                removed += sqlite3_changes(db);
+                sqlite3_finalize(stmt);
+            }
+        }
+    }
+
+    free(partitions);
+
+    if (ok && dropped) {
+        ok = rebuild_partition_view();
+    }
+
+    if (!ok) {
+        log_error("Failed to expire metric partitions: %s", sqlite3_errmsg(db));
+        return -1;
+    }
+
+    return removed > INT_MAX ? INT_MAX : (int)removed;
+}
+
+bool delete_system_metrics_before(time_t cutoff_time) {
+    if (partitioned) {
+        return expire_metric_partitions(cutoff_time, INT_MAX) >= 0;
+    }
+
+    sqlite3_stmt *stmt;
+    if (sqlite3_prepare_v2(db, "DELETE FROM system_metrics WHERE timestamp < ?;", -1, &stmt, NULL) != SQLITE_OK) {
+        return false;
+    }
+
+    sqlite3_bind_int64(stmt, 1, cutoff_time);
+    bool ok = sqlite3_step(stmt) == SQLITE_DONE;
+    sqlite3_finalize(stmt);
+    return ok;
+}
+
+// ========================================
+// Layout conversion
+// ========================================
+
+// Renames a non-empty system_metrics to a partition covering its rows
+static bool partition_existing_table(void) {
+    long long rows = 0, oldest = 0, newest = 0, last_id = 0;
+
+    if (!query_int64("SELECT COUNT(*) FROM system_metrics;", 0, &rows) ||
+        !query_int64("SELECT MIN(timestamp) FROM system_metrics;", 0, &oldest) ||
+        !query_int64("SELECT MAX(timestamp) FROM system_metrics;", 0, &newest) ||
+        !query_int64("SELECT MAX(id) FROM system_metrics;", 0, &last_id) ||
+        !query_int64("SELECT MAX(seq, ?) FROM sqlite_sequence WHERE name = 'system_metrics';", last_id, &last_id)) {
+        return false;
+    }
+
+    char sql[256];
+    if (rows > 0) {
+        snprintf(sql, sizeof(sql),
+                 "ALTER TABLE system_metrics RENAME TO " LEGACY_PARTITION ";"
+                 "INSERT INTO metric_partitions (name, start_ts, end_ts) VALUES ('" LEGACY_PARTITION "', %lld, %lld);",
+                 oldest, newest + 1);
+    } else {
+        snprintf(sql, sizeof(sql), "DROP TABLE system_metrics;");
+    }
+
+    if (!execute_query(sql)) {
+        return false;
+    }
+
+    snprintf(sql, sizeof(sql),
+             "INSERT OR REPLACE INTO metric_partition_sequence (id, last_id) VALUES (1, %lld);", last_id);
+    return execute_query(sql) && rebuild_partition_view();
+}
+
+// Copies every partition back into one system_metrics table
+static bool merge_partitions(void) {
+    MetricPartition *partitions;
+    int count = list_metric_partitions(db, LLONG_MIN, LLONG_MAX, &partitions);
+    if (count < 0) {
+        return false;
+    }
+
+    // Same layout as create_tables
+    bool ok = execute_query("DROP VIEW system_metrics;"
+                            "CREATE TABLE system_metrics ("
+                            "id INTEGER PRIMARY KEY AUTOINCREMENT,"
+                            "timestamp INTEGER NOT NULL,"
+                            "cpu_usage REAL NOT NULL,"
+                            "memory_usage REAL NOT NULL,"
+                            "disk_usage REAL NOT NULL,"
+                            "hostname_id INTEGER NOT NULL REFERENCES interned_strings(id)"
+                            ");");
+
+    char sql[512];
+    for (int i = count - 1; i >= 0 && ok; i--) {
+        snprintf(sql, sizeof(sql),
+                 "INSERT INTO system_metrics (%s) SELECT %s FROM %s; DROP TABLE %s;",
+                 partition_columns, partition_columns, partitions[i].name, partitions[i].name);
+        ok = execute_query(sql);
+    }
+    free(partitions);
+
+    // Index names are free again once the legacy partition is gone
+    return ok && execute_query(
+        "DELETE FROM metric_partitions;"
+        "CREATE INDEX IF NOT EXISTS idx_system_metrics_timestamp ON system_metrics(timestamp);"
+        "CREATE INDEX IF NOT EXISTS idx_system_metrics_hostname ON system_metrics(hostname_id, timestamp);");
+}
+
+static bool set_metric_partitioning_job(void *arg) {
+    PartitionSpan span = *(PartitionSpan *)arg;
+    bool enable = span != PARTITION_NONE;
+
+    if (enable) {
+        // Applies to partitions created from now on
+        partition_span = span;
+    }
+    if (enable == partitioned) {
+        return true;
+    }
+
+    log_info("%s system_metrics partitions", enable ? "Creating" : "Merging");
+
+    if (!execute_query("BEGIN;")) {
+        return false;
+    }
+
+    bool ok = enable ? partition_existing_table() : merge_partitions();
+    if (!ok || !execute_query("COMMIT;")) {
+        log_error("Failed to change system_metrics partitioning");
+        execute_query("ROLLBACK;");
+        return false;
+    }
+
+    partitioned = enable;
+    return true;
+}
+
+bool set_metric_partitioning(PartitionSpan span) {
+    return db_write_exclusive(set_metric_partitioning_job, &span);
+}
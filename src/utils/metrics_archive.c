@@ -0,0 +1,726 @@
+/*
+ * ========================================
+ * Metrics Archive Implementation - Sıkıştırılmış Soğuk Veri Katmanı
+ * ========================================
+ *
+ * Old system_metrics rows are packed per hostname into blocks of up to
+ * ARCHIVE_BLOCK_ROWS rows. Each column is stored as its own BLOB:
+ * timestamps as delta-of-delta, doubles XOR'ed against the previous value
+ * (Facebook Gorilla, VLDB 2015). Regular sampling intervals and slowly
+ * changing percentages compress to a few bits per value.
+ *
+ * Rows are archived a whole UTC day at a time, once all of the day is past
+ * the cutoff, so each host gets full blocks (or one block per day) instead
+ * of a small block per retention pass. One write job packs one day, or a
+ * part of it halved until it holds at most ARCHIVE_JOB_ROWS rows.
+ */
+
+#include "../../include/metrics_archive.h"
+#include "../../include/metric_partitions.h"
+#include "../../include/db_pool.h"
+#include "../../include/logger.h"
+#include "../../include/platform.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+// ========================================
+// Bit stream helpers
+// ========================================
+
+typedef struct {
+    uint8_t *data;
+    size_t capacity;
+    size_t bit_pos;
+    bool failed;
+} BitWriter;
+
+typedef struct {
+    const uint8_t *data;
+    size_t size;
+    size_t bit_pos;
+    bool overrun;
+} BitReader;
+
+static void bit_writer_init(BitWriter *writer, size_t initial_capacity) {
+    writer->data = calloc(initial_capacity, 1);
+    writer->capacity = writer->data ? initial_capacity : 0;
+    writer->bit_pos = 0;
+    writer->failed = writer->data == NULL;
+}
+
+static void write_bits(BitWriter *writer, uint64_t value, int nbits) {
+    if (writer->failed) {
+        return;
+    }
+
+    size_t needed = (writer->bit_pos + nbits + 7) / 8;
+    if (needed > writer->capacity) {
+        size_t new_capacity = writer->capacity * 2 > needed ? writer->capacity * 2 : needed;
+        uint8_t *grown = realloc(writer->data, new_capacity);
+        if (!grown) {
+            writer->failed = true;
+            return;
+        }
+        memset(grown + writer->capacity, 0, new_capacity - writer->capacity);
+        writer->data = grown;
+        writer->capacity = new_capacity;
+    }
+
+    while (nbits > 0) {
+        int free_bits = 8 - (int)(writer->bit_pos & 7);
+        int take = nbits < free_bits ? nbits : free_bits;
+        uint8_t chunk = (uint8_t)((value >> (nbits - take)) & ((1u << take) - 1));
+
+        writer->data[writer->bit_pos >> 3] |= (uint8_t)(chunk << (free_bits - take));
+        writer->bit_pos += take;
+        nbits -= take;
+    }
+}
+
+static uint64_t read_bits(BitReader *reader, int nbits) {
+    uint64_t value = 0;
+
+    if (reader->bit_pos + nbits > reader->size * 8) {
+        reader->overrun = true;
+        return 0;
+    }
+
+    while (nbits > 0) {
+        int avail = 8 - (int)(reader->bit_pos & 7);
+        int take = nbits < avail ? nbits : avail;
+        uint8_t byte = reader->data[reader->bit_pos >> 3];
+        uint8_t chunk = (uint8_t)((byte >> (avail - take)) & ((1u << take) - 1));
+
+        value = (value << take) | chunk;
+        reader->bit_pos += take;
+        nbits -= take;
+    }
+
+    return value;
+}
+
+// ========================================
+// Timestamp codec (delta-of-delta)
+// ========================================
+
+size_t archive_encode_timestamps(const int64_t *timestamps, int count, uint8_t **out) {
+    BitWriter writer;
+    bit_writer_init(&writer, (size_t)count + 16);
+
+    int64_t prev = 0, prev_delta = 0;
+    for (int i = 0; i < count; i++) {
+        if (i == 0) {
+            write_bits(&writer, (uint64_t)timestamps[0], 64);
+            prev = timestamps[0];
+            continue;
+        }
+
+        int64_t delta = timestamps[i] - prev;
+        int64_t dod = delta - prev_delta;
+
+        if (dod == 0) {
+            write_bits(&writer, 0x0, 1);
+        } else if (dod >= -63 && dod <= 64) {
+            write_bits(&writer, 0x2, 2);
+            write_bits(&writer, (uint64_t)(dod + 63), 7);
+        } else if (dod >= -255 && dod <= 256) {
+            write_bits(&writer, 0x6, 3);
+            write_bits(&writer, (uint64_t)(dod + 255), 9);
+        } else if (dod >= -2047 && dod <= 2048) {
+            write_bits(&writer, 0xE, 4);
+            write_bits(&writer, (uint64_t)(dod + 2047), 12);
+        } else {
+            write_bits(&writer, 0xF, 4);
+            write_bits(&writer, (uint64_t)dod, 64);
+        }
+
+        prev_delta = delta;
+        prev = timestamps[i];
+    }
+
+    if (writer.failed) {
+        free(writer.data);
+        *out = NULL;
+        return 0;
+    }
+
+    *out = writer.data;
+    return (writer.bit_pos + 7) / 8;
+}
+
+bool archive_decode_timestamps(const uint8_t *data, size_t size, int count, int64_t *timestamps) {
+    BitReader reader = { data, size, 0, false };
+    int64_t prev = 0, prev_delta = 0;
+
+    for (int i = 0; i < count && !reader.overrun; i++) {
+        if (i == 0) {
+            prev = (int64_t)read_bits(&reader, 64);
+            timestamps[0] = prev;
+            continue;
+        }
+
+        int64_t dod;
+        if (read_bits(&reader, 1) == 0) {
+            dod = 0;
+        } else if (read_bits(&reader, 1) == 0) {
+            dod = (int64_t)read_bits(&reader, 7) - 63;
+        } else if (read_bits(&reader, 1) == 0) {
+            dod = (int64_t)read_bits(&reader, 9) - 255;
+        } else if (read_bits(&reader, 1) == 0) {
+            dod = (int64_t)read_bits(&reader, 12) - 2047;
+        } else {
+            dod = (int64_t)read_bits(&reader, 64);
+        }
+
+        prev_delta += dod;
+        prev += prev_delta;
+        timestamps[i] = prev;
+    }
+
+    return !reader.overrun;
+}
+
+// ========================================
+// Double codec (XOR with previous value)
+// ========================================
+
+static uint64_t double_to_bits(double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static double bits_to_double(uint64_t bits) {
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+size_t archive_encode_doubles(const double *values, int count, uint8_t **out) {
+    BitWriter writer;
+    bit_writer_init(&writer, (size_t)count * 2 + 16);
+
+    uint64_t prev = 0;
+    int prev_leading = -1, prev_trailing = 0;
+
+    for (int i = 0; i < count; i++) {
+        uint64_t bits = double_to_bits(values[i]);
+
+        if (i == 0) {
+            write_bits(&writer, bits, 64);
+            prev = bits;
+            continue;
+        }
+
+        uint64_t xor_value = bits ^ prev;
+        prev = bits;
+
+        if (xor_value == 0) {
+            write_bits(&writer, 0x0, 1);
+            continue;
+        }
+
+        int leading = __builtin_clzll(xor_value);
+        int trailing = __builtin_ctzll(xor_value);
+        if (leading > 31) {
+            leading = 31; // 5-bit field
+        }
+
+        if (prev_leading >= 0 && leading >= prev_leading && trailing >= prev_trailing) {
+            // Meaningful bits fit inside the previous window
+            int length = 64 - prev_leading - prev_trailing;
+            write_bits(&writer, 0x2, 2);
+            write_bits(&writer, xor_value >> prev_trailing, length);
+        } else {
+            int length = 64 - leading - trailing;
+            write_bits(&writer, 0x3, 2);
+            write_bits(&writer, (uint64_t)leading, 5);
+            write_bits(&writer, (uint64_t)(length - 1), 6);
+            write_bits(&writer, xor_value >> trailing, length);
+            prev_leading = leading;
+            prev_trailing = trailing;
+        }
+    }
+
+    if (writer.failed) {
+        free(writer.data);
+        *out = NULL;
+        return 0;
+    }
+
+    *out = writer.data;
+    return (writer.bit_pos + 7) / 8;
+}
+
+bool archive_decode_doubles(const uint8_t *data, size_t size, int count, double *values) {
+    BitReader reader = { data, size, 0, false };
+    uint64_t prev = 0;
+    int prev_leading = 0, prev_trailing = 0;
+
+    for (int i = 0; i < count && !reader.overrun; i++) {
+        if (i == 0) {
+            prev = read_bits(&reader, 64);
+            values[0] = bits_to_double(prev);
+            continue;
+        }
+
+        if (read_bits(&reader, 1) != 0) {
+            if (read_bits(&reader, 1) != 0) {
+                prev_leading = (int)read_bits(&reader, 5);
+                int length = (int)read_bits(&reader, 6) + 1;
+                prev_trailing = 64 - prev_leading - length;
+            }
+            int length = 64 - prev_leading - prev_trailing;
+            prev ^= read_bits(&reader, length) << prev_trailing;
+        }
+
+        values[i] = bits_to_double(prev);
+    }
+
+    return !reader.overrun;
+}
+
+// ========================================
+// Archive tables
+// ========================================
+
+bool create_archive_tables(void) {
+    const char *create_archive =
+        "CREATE TABLE IF NOT EXISTS system_metrics_archive ("
+        "id INTEGER PRIMARY KEY AUTOINCREMENT,"
+        "hostname TEXT NOT NULL,"
+        "start_ts INTEGER NOT NULL,"
+        "end_ts INTEGER NOT NULL,"
+        "row_count INTEGER NOT NULL,"
+        "timestamps BLOB NOT NULL,"
+        "cpu_usage BLOB NOT NULL,"
+        "memory_usage BLOB NOT NULL,"
+        "disk_usage BLOB NOT NULL"
+        ");"
+        "CREATE INDEX IF NOT EXISTS idx_system_metrics_archive_end ON system_metrics_archive(end_ts);";
+
+    return execute_query(create_archive);
+}
+
+// Column buffers for one block being built or decoded
+typedef struct {
+    int64_t timestamps[ARCHIVE_BLOCK_ROWS];
+    double cpu[ARCHIVE_BLOCK_ROWS];
+    double memory[ARCHIVE_BLOCK_ROWS];
+    double disk[ARCHIVE_BLOCK_ROWS];
+    char hostname[256];
+    int count;
+} ArchiveBlock;
+
+static bool write_archive_block(sqlite3_stmt *insert, const ArchiveBlock *block) {
+    uint8_t *columns[4] = { NULL, NULL, NULL, NULL };
+    size_t sizes[4];
+    bool ok = false;
+
+    sizes[0] = archive_encode_timestamps(block->timestamps, block->count, &columns[0]);
+    sizes[1] = archive_encode_doubles(block->cpu, block->count, &columns[1]);
+    sizes[2] = archive_encode_doubles(block->memory, block->count, &columns[2]);
+    sizes[3] = archive_encode_doubles(block->disk, block->count, &columns[3]);
+
+    if (columns[0] && columns[1] && columns[2] && columns[3]) {
+        sqlite3_reset(insert);
+        sqlite3_bind_text(insert, 1, block->hostname, -1, SQLITE_STATIC);
+        sqlite3_bind_int64(insert, 2, block->timestamps[0]);
+        sqlite3_bind_int64(insert, 3, block->timestamps[block->count - 1]);
+        sqlite3_bind_int(insert, 4, block->count);
+        for (int i = 0; i < 4; i++) {
+            sqlite3_bind_blob(insert, 5 + i, columns[i], (int)sizes[i], SQLITE_STATIC);
+        }
+
+        ok = sqlite3_step(insert) == SQLITE_DONE;
+        if (!ok) {
+            log_error("Failed to write archive block: %s", sqlite3_errmsg(db));
+        }
+    } else {
+        log_error("Memory allocation failed");
+    }
+
+    for (int i = 0; i < 4; i++) {
+        free(columns[i]);
+    }
+
+    return ok;
+}
+
+// Single integer result of a query with one bound value; 0 when NULL
+static bool query_archive_int64(const char *sql, long long bind_value, long long *value) {
+    sqlite3_stmt *stmt;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK) {
+        log_error("Failed to prepare statement: %s", sqlite3_errmsg(db));
+        return false;
+    }
+
+    sqlite3_bind_int64(stmt, 1, bind_value);
+    bool ok = sqlite3_step(stmt) == SQLITE_ROW;
+    if (ok) {
+        *value = sqlite3_column_int64(stmt, 0);
+    }
+    sqlite3_finalize(stmt);
+    return ok;
+}
+
+// Picks the span the next job packs: the UTC day holding the oldest raw row,
+// halved while it holds more than ARCHIVE_JOB_ROWS rows. Returns false
+// (with *span_end 0) when no whole span lies before cutoff_time yet.
+static bool next_archive_span(time_t cutoff_time, time_t *span_end) {
+    long long oldest = 0, rows = 0;
+    *span_end = 0;
+
+    if (!query_archive_int64("SELECT COALESCE(MIN(timestamp), ?) FROM system_metrics;", cutoff_time, &oldest)) {
+        return false;
+    }
+
+    time_t span_start = (time_t)(oldest - oldest % ARCHIVE_SPAN_SECONDS);
+    time_t span = ARCHIVE_SPAN_SECONDS;
+    if (span_start + span > cutoff_time) {
+        return true;
+    }
+
+    while (span > ARCHIVE_MIN_SPAN_SECONDS) {
+        if (!query_archive_int64("SELECT COUNT(*) FROM system_metrics WHERE timestamp < ?;",
+                                 span_start + span, &rows)) {
+            return false;
+        }
+        if (rows <= ARCHIVE_JOB_ROWS) {
+            break;
+        }
+        span /= 2;
+    }
+
+    *span_end = span_start + span;
+    return true;
+}
+
+typedef struct {
+    time_t cutoff_time;
+    long long archived_rows;
+} ArchiveJob;
+
+// Packs one span into blocks and removes its raw rows, inside the writer's
+// transaction like any other write job
+static bool archive_system_metrics_span_job(void *arg) {
+    ArchiveJob *job = arg;
+    const char *select_sql =
+        "SELECT m.timestamp, m.cpu_usage, m.memory_usage, m.disk_usage, h.value "
+        "FROM system_metrics m JOIN interned_strings h ON h.id = m.hostname_id "
+        "WHERE m.timestamp < ? ORDER BY m.hostname_id, m.timestamp;";
+    const char *insert_sql =
+        "INSERT INTO system_metrics_archive (hostname, start_ts, end_ts, row_count, "
+        "timestamps, cpu_usage, memory_usage, disk_usage) VALUES (?, ?, ?, ?, ?, ?, ?, ?);";
+
+    job->archived_rows = 0;
+
+    time_t span_end;
+    if (!next_archive_span(job->cutoff_time, &span_end)) {
+        return false;
+    }
+    if (span_end == 0) {
+        return true;
+    }
+
+    // p95 of closed rollup buckets is computed from raw rows
+    finalize_metric_rollups();
+
+    ArchiveBlock *block = malloc(sizeof(ArchiveBlock));
+    if (!block) {
+        log_error("Memory allocation failed");
+        return false;
+    }
+    block->count = 0;
+    block->hostname[0] = '\0';
+
+    sqlite3_stmt *select = NULL, *insert = NULL;
+    if (sqlite3_prepare_v2(db, select_sql, -1, &select, NULL) != SQLITE_OK ||
+        sqlite3_prepare_v2(db, insert_sql, -1, &insert, NULL) != SQLITE_OK) {
+        log_error("Failed to prepare statement: %s", sqlite3_errmsg(db));
+        sqlite3_finalize(select);
+        sqlite3_finalize(insert);
+        free(block);
+        return false;
+    }
+
+    sqlite3_bind_int64(select, 1, span_end);
+
+    bool ok = true;
+    long long archived = 0, blocks = 0;
+
+    while (ok && sqlite3_step(select) == SQLITE_ROW) {
+        const char *hostname = (const char*)sqlite3_column_text(select, 4);
+
+        if (block->count > 0 &&
+            (block->count == ARCHIVE_BLOCK_ROWS || strcmp(block->hostname, hostname) != 0)) {
+            ok = write_archive_block(insert, block);
+            blocks++;
+            block->count = 0;
+        }
+
+        if (block->count == 0) {
+            strncpy(block->hostname, hostname, sizeof(block->hostname) - 1);
+            block->hostname[sizeof(block->hostname) - 1] = '\0';
+        }
+
+        block->timestamps[block->count] = sqlite3_column_int64(select, 0);
+        block->cpu[block->count] = sqlite3_column_double(select, 1);
+        block->memory[block->count] = sqlite3_column_double(select, 2);
+        block->disk[block->count] = sqlite3_column_double(select, 3);
+        block->count++;
+        archived++;
+    }
+
+    if (ok && block->count > 0) {
+        ok = write_archive_block(insert, block);
+        blocks++;
+    }
+
+    sqlite3_finalize(select);
+    sqlite3_finalize(insert);
+    free(block);
+
+    if (ok) {
+        ok = delete_system_metrics_before(span_end);
+    }
+
+    if (!ok) {
+        log_error("Failed to archive system metrics: %s", sqlite3_errmsg(db));
+        return false;
+    }
+
+    if (archived > 0) {
+        log_info("Archived %lld system metric rows into %lld blocks", archived, blocks);
+    }
+    job->archived_rows = archived;
+    return true;
+}
+
+int archive_system_metrics_span(time_t cutoff_time) {
+    ArchiveJob job = { cutoff_time, 0 };
+    if (!db_write(archive_system_metrics_span_job, &job)) {
+        return -1;
+    }
+    return job.archived_rows > INT_MAX ? INT_MAX : (int)job.archived_rows;
+}
+
+// Loops span by span, pausing between jobs so inserts interleave with a
+// long backlog; the viewer and cleanup_old_records use it
+bool archive_old_system_metrics(int days_to_keep) {
+    time_t cutoff_time = time(NULL) - ((time_t)days_to_keep * 24 * 60 * 60);
+    int archived;
+
+    while ((archived = archive_system_metrics_span(cutoff_time)) > 0) {
+        sleep_ms(RETENTION_BATCH_PAUSE_MS);
+    }
+
+    return archived == 0;
+}
+
+static bool decode_archive_block(sqlite3_stmt *stmt, ArchiveBlock *block) {
+    block->count = sqlite3_column_int(stmt, 1);
+    if (block->count <= 0 || block->count > ARCHIVE_BLOCK_ROWS) {
+        return false;
+    }
+
+    strncpy(block->hostname, (const char*)sqlite3_column_text(stmt, 0), sizeof(block->hostname) - 1);
+    block->hostname[sizeof(block->hostname) - 1] = '\0';
+
+    return archive_decode_timestamps(sqlite3_column_blob(stmt, 2), sqlite3_column_bytes(stmt, 2),
+                                     block->count, block->timestamps) &&
+           archive_decode_doubles(sqlite3_column_blob(stmt, 3), sqlite3_column_bytes(stmt, 3),
+                                  block->count, block->cpu) &&
+           archive_decode_doubles(sqlite3_column_blob(stmt, 4), sqlite3_column_bytes(stmt, 4),
+                                  block->count, block->memory) &&
+           archive_decode_doubles(sqlite3_column_blob(stmt, 5), sqlite3_column_bytes(stmt, 5),
+                                  block->count, block->disk);
+}
+
+// Appends archived rows with from <= timestamp < to to *metrics (which may
+// already hold *count rows). Archived rows carry id 0.
+static bool read_archived_system_metrics(sqlite3 *conn, time_t from, time_t to, SystemMetrics **metrics, int *count) {
+    const char *sql =
+        "SELECT hostname, row_count, timestamps, cpu_usage, memory_usage, disk_usage "
+        "FROM system_metrics_archive WHERE end_ts >= ? AND start_ts < ? ORDER BY start_ts;";
+
+    sqlite3_stmt *stmt;
+    if (sqlite3_prepare_v2(conn, sql, -1, &stmt, NULL) != SQLITE_OK) {
+        log_error("Failed to prepare statement: %s", sqlite3_errmsg(conn));
+        return false;
+    }
+
+    ArchiveBlock *block = malloc(sizeof(ArchiveBlock));
+    if (!block) {
+        log_error("Memory allocation failed");
+        sqlite3_finalize(stmt);
+        return false;
+    }
+
+    sqlite3_bind_int64(stmt, 1, from);
+    sqlite3_bind_int64(stmt, 2, to);
+
+    bool ok = true;
+    while (ok && sqlite3_step(stmt) == SQLITE_ROW) {
+        if (!decode_archive_block(stmt, block)) {
+            log_warning("Skipping corrupt archive block");
+            continue;
+        }
+
+        SystemMetrics *grown = realloc(*metrics, sizeof(SystemMetrics) * (*count + block->count));
+        if (!grown) {
+            log_error("Memory allocation failed");
+            ok = false;
+            break;
+        }
+        *metrics = grown;
+
+        for (int i = 0; i < block->count; i++) {
+            if (block->timestamps[i] < from || block->timestamps[i] >= to) {
+                continue;
+            }
+
+            SystemMetrics *row = &(*metrics)[(*count)++];
+            row->id = 0;
+            row->timestamp = (time_t)block->timestamps[i];
+            row->cpu_usage = block->cpu[i];
+            row->memory_usage = block->memory[i];
+            row->disk_usage = block->disk[i];
+            strcpy(row->hostname, block->hostname);
+        }
+    }
+
+    free(block);
+    sqlite3_finalize(stmt);
+    return ok;
+}
+
+bool get_archived_system_metrics(time_t from, time_t to, SystemMetrics **metrics, int *count) {
+    sqlite3 *conn = db_acquire_reader();
+    bool ok = read_archived_system_metrics(conn, from, to, metrics, count);
+    db_release_reader(conn);
+    return ok;
+}
+
+// Appends up to limit archived rows with timestamp < before, newest first
+static bool read_latest_archived_system_metrics(sqlite3 *conn, time_t before, int limit, SystemMetrics **metrics, int *count) {
+    const char *sql =
+        "SELECT hostname, row_count, timestamps, cpu_usage, memory_usage, disk_usage "
+        "FROM system_metrics_archive WHERE start_ts < ? ORDER BY end_ts DESC;";
+
+    sqlite3_stmt *stmt;
+    if (sqlite3_prepare_v2(conn, sql, -1, &stmt, NULL) != SQLITE_OK) {
+        log_error("Failed to prepare statement: %s", sqlite3_errmsg(conn));
+        return false;
+    }
+
+    ArchiveBlock *block = malloc(sizeof(ArchiveBlock));
+    SystemMetrics *grown = realloc(*metrics, sizeof(SystemMetrics) * (*count + limit));
+    if (!block || !grown) {
+        log_error("Memory allocation failed");
+        free(block);
+        if (grown) *metrics = grown;
+        sqlite3_finalize(stmt);
+        return false;
+    }
+    *metrics = grown;
+
+    sqlite3_bind_int64(stmt, 1, before);
+
+    int added = 0;
+    while (added < limit && sqlite3_step(stmt) == SQLITE_ROW) {
+        if (!decode_archive_block(stmt, block)) {
+            log_warning("Skipping corrupt archive block");
+            continue;
+        }
+
+        // Blocks of different hosts may overlap in time; good enough for "latest N"
+        for (int i = block->count - 1; i >= 0 && added < limit; i--) {
+            if (block->timestamps[i] >= before) {
+                continue;
+            }
+
+            SystemMetrics *row = &(*metrics)[(*count)++];
+            row->id = 0;
+            row->timestamp = (time_t)block->timestamps[i];
+            row->cpu_usage = block->cpu[i];
+            row->memory_usage = block->memory[i];
+            row->disk_usage = block->disk[i];
+            strcpy(row->hostname, block->hostname);
+            added++;
+        }
+    }
+
+    free(block);
+    sqlite3_finalize(stmt);
+    return true;
+}
+
+bool get_latest_archived_system_metrics(time_t before, int limit, SystemMetrics **metrics, int *count) {
+    sqlite3 *conn = db_acquire_reader();
+    bool ok = read_latest_archived_system_metrics(conn, before, limit, metrics, count);
+    db_release_reader(conn);
+    return ok;
+}
+
+static bool cleanup_old_archive_blocks_job(void *arg) {
+    time_t cutoff_time = *(time_t *)arg;
+    sqlite3_stmt *stmt;
+    if (sqlite3_prepare_v2(db, "DELETE FROM system_metrics_archive WHERE end_ts < ?;", -1, &stmt, NULL) != SQLITE_OK) {
+        log_error("Failed to prepare cleanup statement: %s", sqlite3_errmsg(db));
+        return false;
+    }
+
+    sqlite3_bind_int64(stmt, 1, cutoff_time);
+    int rc = sqlite3_step(stmt);
+    sqlite3_finalize(stmt);
+
+    if (rc != SQLITE_DONE) {
+        log_error("Failed to cleanup archive blocks: %s", sqlite3_errmsg(db));
+        return false;
+    }
+
+    int deleted = sqlite3_changes(db);
+    if (deleted > 0) {
+        log_info("Cleaned up %d old archive blocks", deleted);
+    }
+    return true;
+}
+
+bool cleanup_old_archive_blocks(time_t cutoff_time) {
+    return db_write(cleanup_old_archive_blocks_job, &cutoff_time);
+}
+
+static bool read_archive_statistics(sqlite3 *conn, ArchiveStats *stats) {
+    const char *sql =
+        "SELECT COUNT(*), COALESCE(SUM(row_count), 0), "
+        "COALESCE(SUM(LENGTH(timestamps) + LENGTH(cpu_usage) + LENGTH(memory_usage) + LENGTH(disk_usage)), 0), "
+        "COALESCE(MIN(start_ts), 0), COALESCE(MAX(end_ts), 0) FROM system_metrics_archive;";
+
+    sqlite3_stmt *stmt;
+    if (sqlite3_prepare_v2(conn, sql, -1, &stmt, NULL) != SQLITE_OK) {
+        log_error("Failed to prepare statement: %s", sqlite3_errmsg(conn));
+        return false;
+    }
+
+    memset(stats, 0, sizeof(*stats));
+    if (sqlite3_step(stmt) == SQLITE_ROW) {
+        stats->block_count = sqlite3_column_int64(stmt, 0);
+        stats->row_count = sqlite3_column_int64(stmt, 1);
+        stats->compressed_bytes = sqlite3_column_int64(stmt, 2);
+        stats->oldest_timestamp = sqlite3_column_int64(stmt, 3);
+        stats->newest_timestamp = sqlite3_column_int64(stmt, 4);
+    }
+
+    sqlite3_finalize(stmt);
+    return true;
+}
+
+bool get_archive_statistics(ArchiveStats *stats) {
+    sqlite3 *conn = db_acquire_reader();
+    bool ok = read_archive_statistics(conn, stats);
+    db_release_reader(conn);
+    return ok;
+}
@@ -0,0 +1,46 @@
+/*
+ * ========================================
+ * Platform Implementation - Taşınabilir Yardımcılar
+ * ========================================
+ *
+ * Small wrappers over calls that differ between Windows and POSIX, shared
+ * by the modules instead of a private copy in each.
+ */
+
+#ifndef _WIN32
+    // nanosleep and clock_gettime under -std=c99
+    #define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "../../include/platform.h"
+#include <errno.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <time.h>
+#endif
+
+void sleep_ms(int milliseconds) {
+    if (milliseconds <= 0) {
+        return;
+    }
+#ifdef _WIN32
+    Sleep((DWORD)milliseconds);
+#else
+    struct timespec remaining = { milliseconds / 1000, (long)(milliseconds % 1000) * 1000000L };
+    // A signal cuts the sleep short; sleep the rest
+    while (nanosleep(&remaining, &remaining) != 0 && errno == EINTR) {
+    }
+#endif
+}
+
+long long monotonic_ms(void) {
+#ifdef _WIN32
+    return (long long)GetTickCount64();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+#endif
+}
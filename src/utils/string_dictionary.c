@@ -0,0 +1,185 @@
+/*
+ * ========================================
+ * String Dictionary Implementation - Tekrarlanan Metinler İçin Sözlük
+ * ========================================
+ *
+ * Hostnames, ping targets, severities and operation names take a handful
+ * of distinct values across millions of rows. Each distinct value is stored
+ * once in interned_strings and the rows keep its integer id, which is both
+ * smaller on disk and a cheaper index key. The hash table below maps values
+ * to ids so the insert path normally does not query the dictionary at all.
+ */
+
+#include "../../include/string_dictionary.h"
+#include "../../include/logger.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+
+// Open addressing, twice the entry limit so probes stay short
+#define STRING_CACHE_SLOTS (STRING_CACHE_MAX_ENTRIES * 2)
+
+typedef struct {
+    char *value;
+    uint32_t hash;
+    int id;
+} StringCacheEntry;
+
+static StringCacheEntry string_cache[STRING_CACHE_SLOTS];
+static int string_cache_count = 0;
+
+// Readers look ids up while the writer thread adds them
+static pthread_mutex_t string_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static uint32_t hash_string(const char *value) {
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    while (*value) {
+        hash ^= (uint8_t)*value++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static StringCacheEntry* cache_slot(const char *value, uint32_t hash) {
+    uint32_t index = hash & (STRING_CACHE_SLOTS - 1);
+
+    while (string_cache[index].value &&
+           (string_cache[index].hash != hash || strcmp(string_cache[index].value, value) != 0)) {
+        index = (index + 1) & (STRING_CACHE_SLOTS - 1);
+    }
+
+    return &string_cache[index];
+}
+
+static void cache_clear_locked(void) {
+    for (int i = 0; i < STRING_CACHE_SLOTS; i++) {
+        free(string_cache[i].value);
+        string_cache[i].value = NULL;
+    }
+    string_cache_count = 0;
+}
+
+// Returns the cached id of value, 0 if it is not cached
+static int cache_lookup(const char *value, uint32_t hash) {
+    pthread_mutex_lock(&string_cache_mutex);
+    StringCacheEntry *slot = cache_slot(value, hash);
+    int id = slot->value ? slot->id : 0;
+    pthread_mutex_unlock(&string_cache_mutex);
+    return id;
+}
+
+static void cache_store(const char *value, uint32_t hash, int id) {
+    pthread_mutex_lock(&string_cache_mutex);
+
+    if (string_cache_count >= STRING_CACHE_MAX_ENTRIES) {
+        cache_clear_locked();
+    }
+
+    StringCacheEntry *slot = cache_slot(value, hash);
+    if (!slot->value) {
+        slot->value = malloc(strlen(value) + 1);
+        if (slot->value) {
+            strcpy(slot->value, value);
+            slot->hash = hash;
+            slot->id = id;
+            string_cache_count++;
+        }
+    }
+
+    pthread_mutex_unlock(&string_cache_mutex);
+}
+
+void clear_string_cache(void) {
+    pthread_mutex_lock(&string_cache_mutex);
+    cache_clear_locked();
+    pthread_mutex_unlock(&string_cache_mutex);
+}
+
+// A rolled back transaction may have removed ids handed out from the cache
+static void on_rollback(void *arg) {
+    (void)arg;
+    clear_string_cache();
+}
+
+bool create_string_dictionary(void) {
+    const char *sql =
+        "CREATE TABLE IF NOT EXISTS interned_strings ("
+        "id INTEGER PRIMARY KEY,"
+        "value TEXT NOT NULL UNIQUE"
+        ");";
+
+    if (!execute_query(sql)) {
+        return false;
+    }
+
+    sqlite3_rollback_hook(db, on_rollback, NULL);
+    return true;
+}
+
+static int select_string_id(sqlite3 *conn, const char *value) {
+    sqlite3_stmt *stmt;
+    if (sqlite3_prepare_v2(conn, "SELECT id FROM interned_strings WHERE value = ?;", -1, &stmt, NULL) != SQLITE_OK) {
+        log_error("Failed to prepare statement: %s", sqlite3_errmsg(conn));
+        return -1;
+    }
+
+    sqlite3_bind_text(stmt, 1, value, -1, SQLITE_STATIC);
+
+    int rc = sqlite3_step(stmt);
+    int id = rc == SQLITE_ROW ? sqlite3_column_int(stmt, 0) : (rc == SQLITE_DONE ? 0 : -1);
+    sqlite3_finalize(stmt);
+
+    return id;
+}
+
+int find_interned_string(sqlite3 *conn, const char *value) {
+    if (!value) {
+        value = "";
+    }
+
+    uint32_t hash = hash_string(value);
+    int id = cache_lookup(value, hash);
+    if (id > 0) {
+        return id;
+    }
+
+    id = select_string_id(conn, value);
+    if (id > 0) {
+        cache_store(value, hash, id);
+    }
+
+    return id;
+}
+
+int intern_string(const char *value) {
+    if (!value) {
+        value = "";
+    }
+
+    int id = find_interned_string(db, value);
+    if (id != 0) {
+        return id;
+    }
+
+    sqlite3_stmt *stmt;
+    if (sqlite3_prepare_v2(db, "INSERT INTO interned_strings (value) VALUES (?);", -1, &stmt, NULL) != SQLITE_OK) {
+        log_error("Failed to prepare statement: %s", sqlite3_errmsg(db));
+        return -1;
+    }
+
+    sqlite3_bind_text(stmt, 1, value, -1, SQLITE_STATIC);
+    int rc = sqlite3_step(stmt);
+    sqlite3_finalize(stmt);
+
+    if (rc != SQLITE_DONE) {
+        log_error("Failed to intern string: %s", sqlite3_errmsg(db));
+        return -1;
+    }
+
+    id = (int)sqlite3_last_insert_rowid(db);
+    cache_store(value, hash_string(value), id);
+    return id;
+}
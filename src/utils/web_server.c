@@ -5,7 +5,10 @@
  */
 
 #include "../../include/web_server.h"
+#include "../../include/database_export.h"
 #include "../../include/logger.h"
+#include "../../include/log_checkpoint.h"
+#include "../../include/log_follow.h"
 #include "../../lib/cJSON/cJSON.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -108,25 +111,32 @@ bool start_web_server(void) {
             HttpRequest request;
             HttpResponse response;
             
-            if (parse_http_request(buffer, &request)) {
-                // Route request
-                if (strncmp(request.path, "/api/", 5) == 0) {
-                    handle_api_request(&request, &response);
-                } else if (strcmp(request.path, "/") == 0 || strcmp(request.path, "/dashboard") == 0) {
-                    serve_dashboard(&response);
+            bool parsed = parse_http_request(buffer, &request);
+            
+            if (parsed && strncmp(request.path, "/api/export", 11) == 0) {
+                // Exports do not fit the fixed response body; they write to the socket themselves
+                api_stream_export(client_socket, &request);
+            } else {
+                if (parsed) {
+                    // Route request
+                    if (strncmp(request.path, "/api/", 5) == 0) {
+                        handle_api_request(&request, &response);
+                    } else if (strcmp(request.path, "/") == 0 || strcmp(request.path, "/dashboard") == 0) {
+                        serve_dashboard(&response);
+                    } else {
+                        serve_static_file(request.path, &response);
+                    }
                 } else {
-                    serve_static_file(request.path, &response);
+                    create_http_response(&response, HTTP_400_BAD_REQUEST, "text/plain", "Bad Request");
                 }
-            } else {
-                create_http_response(&response, HTTP_400_BAD_REQUEST, "text/plain", "Bad Request");
-            }
 
-            // Add CORS headers if enabled
-            if (config.enable_cors) {
-                add_cors_headers(&response);
-            }
+                // Add CORS headers if enabled
+                if (config.enable_cors) {
+                    add_cors_headers(&response);
+                }
 
-            send_http_response(client_socket, &response);
+                send_http_response(client_socket, &response);
+            }
         }
 
         #ifdef _WIN32
@@ -251,7 +261,18 @@ void send_http_response(int client_socket, const HttpResponse* response) {
 
 // Handle API requests
 void handle_api_request(const HttpRequest* request, HttpResponse* response) {
-    if (strncmp(request->path, "/api/system-metrics", 19) == 0) {
+    if (strncmp(request->path, "/api/system-metrics/rollup", 26) == 0 ||
+        strncmp(request->path, "/api/network-metrics/rollup", 27) == 0) {
+        api_get_metrics_rollup(request, response);
+    } else if (strncmp(request->path, "/api/database/stats", 19) == 0) {
+        api_get_database_stats(request, response);
+    } else if (strncmp(request->path, "/api/logs/stats", 15) == 0) {
+        api_get_log_stats(request, response);
+    } else if (strncmp(request->path, "/api/logs/live", 14) == 0) {
+        api_get_log_live(request, response);
+    } else if (strncmp(request->path, "/api/logs/alerts", 16) == 0) {
+        api_get_log_alerts(request, response);
+    } else if (strncmp(request->path, "/api/system-metrics", 19) == 0) {
         api_get_system_metrics(request, response);
     } else if (strncmp(request->path, "/api/file-operations", 20) == 0) {
         api_get_file_operations(request, response);
@@ -267,11 +288,12 @@ void handle_api_request(const HttpRequest* request, HttpResponse* response) {
     }
 }
 
-// API: Get system metrics
+// API: Get system metrics; ?recent=1 returns the last few minutes, oldest first
 void api_get_system_metrics(const HttpRequest* request, HttpResponse* response) {
     SystemMetrics* metrics = NULL;
     int count = 0;
     int limit = 50; // Default limit
+    bool recent = false;
 
     // Parse limit from query string
     if (strlen(request->query_string) > 0) {
@@ -280,9 +302,12 @@ void api_get_system_metrics(const HttpRequest* request, HttpResponse* response)
             limit = atoi(limit_param + 6);
             if (limit <= 0 || limit > 1000) limit = 50;
         }
+        recent = strstr(request->query_string, "recent=1") != NULL;
     }
 
-    if (get_system_metrics_history(&metrics, &count, limit)) {
+    bool ok = recent ? get_recent_system_metrics(&metrics, &count)
+                     : get_system_metrics_history(&metrics, &count, limit);
+    if (ok) {
         cJSON* json = cJSON_CreateObject();
         cJSON* data_array = cJSON_CreateArray();
 
@@ -312,6 +337,433 @@ void api_get_system_metrics(const HttpRequest* request, HttpResponse* response)
     }
 }
 
+// Read an integer query parameter, e.g. "from=1700000000"
+static long long get_query_param_int(const HttpRequest* request, const char* name, long long default_value) {
+    char key[64];
+    snprintf(key, sizeof(key), "%s=", name);
+    
+    const char* param = strstr(request->query_string, key);
+    while (param && param != request->query_string && *(param - 1) != '&') {
+        param = strstr(param + 1, key);
+    }
+    
+    return param ? atoll(param + strlen(key)) : default_value;
+}
+
+// API: Get rolled-up metrics (resolution picked from the requested range)
+void api_get_metrics_rollup(const HttpRequest* request, HttpResponse* response) {
+    time_t now = time(NULL);
+    time_t to = (time_t)get_query_param_int(request, "to", now);
+    time_t from = (time_t)get_query_param_int(request, "from", to - 24 * 60 * 60);
+    int points = (int)get_query_param_int(request, "points", ROLLUP_DEFAULT_MAX_POINTS);
+    bool network = strncmp(request->path, "/api/network-metrics", 20) == 0;
+    
+    if (points <= 0 || points > ROLLUP_DEFAULT_MAX_POINTS) points = ROLLUP_DEFAULT_MAX_POINTS;
+    
+    cJSON* json = cJSON_CreateObject();
+    cJSON* data_array = cJSON_CreateArray();
+    int count = 0;
+    bool ok;
+    
+    if (network) {
+        NetworkMetricsRollup* rows = NULL;
+        ok = get_network_metrics_rollup(from, to, points, &rows, &count);
+        for (int i = 0; ok && i < count; i++) {
+            cJSON* item = cJSON_CreateObject();
+            cJSON_AddNumberToObject(item, "bucket_start", rows[i].bucket_start);
+            cJSON_AddStringToObject(item, "target", rows[i].target);
+            cJSON_AddNumberToObject(item, "samples", rows[i].sample_count);
+            cJSON_AddNumberToObject(item, "successes", rows[i].success_count);
+            cJSON_AddNumberToObject(item, "ping_min", rows[i].ping.min);
+            cJSON_AddNumberToObject(item, "ping_max", rows[i].ping.max);
+            cJSON_AddNumberToObject(item, "ping_avg", rows[i].ping.avg);
+            cJSON_AddNumberToObject(item, "ping_p95", rows[i].ping.p95);
+            cJSON_AddItemToArray(data_array, item);
+        }
+        if (rows) free(rows);
+    } else {
+        SystemMetricsRollup* rows = NULL;
+        ok = get_system_metrics_rollup(from, to, points, &rows, &count);
+        for (int i = 0; ok && i < count; i++) {
+            cJSON* item = cJSON_CreateObject();
+            cJSON_AddNumberToObject(item, "bucket_start", rows[i].bucket_start);
+            cJSON_AddStringToObject(item, "hostname", rows[i].hostname);
+            cJSON_AddNumberToObject(item, "samples", rows[i].sample_count);
+            cJSON_AddNumberToObject(item, "cpu_avg", rows[i].cpu.avg);
+            cJSON_AddNumberToObject(item, "cpu_max", rows[i].cpu.max);
+            cJSON_AddNumberToObject(item, "cpu_p95", rows[i].cpu.p95);
+            cJSON_AddNumberToObject(item, "memory_avg", rows[i].memory.avg);
+            cJSON_AddNumberToObject(item, "memory_max", rows[i].memory.max);
+            cJSON_AddNumberToObject(item, "memory_p95", rows[i].memory.p95);
+            cJSON_AddNumberToObject(item, "disk_avg", rows[i].disk.avg);
+            cJSON_AddNumberToObject(item, "disk_max", rows[i].disk.max);
+            cJSON_AddNumberToObject(item, "disk_p95", rows[i].disk.p95);
+            cJSON_AddItemToArray(data_array, item);
+        }
+        if (rows) free(rows);
+    }
+    
+    if (ok) {
+        cJSON_AddItemToObject(json, "data", data_array);
+        cJSON_AddNumberToObject(json, "count", count);
+        cJSON_AddNumberToObject(json, "resolution", select_rollup_resolution(from, to, points));
+        
+        char* json_string = cJSON_Print(json);
+        create_http_response(response, HTTP_200_OK, "application/json", json_string);
+        free(json_string);
+    } else {
+        cJSON_Delete(data_array);
+        create_http_response(response, HTTP_500_INTERNAL_ERROR, "application/json", 
+            "{\"error\":\"Failed to retrieve metric rollups\"}");
+    }
+    
+    cJSON_Delete(json);
+}
+
+// API: Row counts, page usage and metric summaries over a window
+void api_get_database_stats(const HttpRequest* request, HttpResponse* response) {
+    const char* metrics[] = { "cpu_usage", "memory_usage", "disk_usage", "ping_time", "threats_found" };
+    time_t now = time(NULL);
+    time_t to = (time_t)get_query_param_int(request, "to", now + 1);
+    time_t from = (time_t)get_query_param_int(request, "from", to - 24 * 60 * 60);
+    
+    TableCounts counts;
+    DatabasePageStats pages;
+    
+    if (!get_table_counts(&counts) || !get_database_page_stats(&pages)) {
+        create_http_response(response, HTTP_500_INTERNAL_ERROR, "application/json", 
+            "{\"error\":\"Failed to retrieve database statistics\"}");
+        return;
+    }
+    
+    cJSON* json = cJSON_CreateObject();
+    
+    cJSON* counts_json = cJSON_CreateObject();
+    cJSON_AddNumberToObject(counts_json, "system_metrics", counts.system_metrics);
+    cJSON_AddNumberToObject(counts_json, "archived_system_metrics", counts.archived_system_metrics);
+    cJSON_AddNumberToObject(counts_json, "file_operations", counts.file_operations);
+    cJSON_AddNumberToObject(counts_json, "network_metrics", counts.network_metrics);
+    cJSON_AddNumberToObject(counts_json, "security_scans", counts.security_scans);
+    cJSON_AddNumberToObject(counts_json, "scheduled_tasks", counts.scheduled_tasks);
+    cJSON_AddItemToObject(json, "counts", counts_json);
+    
+    cJSON* pages_json = cJSON_CreateObject();
+    cJSON_AddNumberToObject(pages_json, "page_size", pages.page_size);
+    cJSON_AddNumberToObject(pages_json, "page_count", pages.page_count);
+    cJSON_AddNumberToObject(pages_json, "freelist_count", pages.freelist_count);
+    cJSON_AddNumberToObject(pages_json, "total_bytes", pages.total_bytes);
+    cJSON_AddItemToObject(json, "pages", pages_json);
+    
+    TableSize* sizes = NULL;
+    int size_count = 0;
+    if (get_table_sizes(&sizes, &size_count)) {
+        cJSON* sizes_json = cJSON_CreateArray();
+        for (int i = 0; i < size_count; i++) {
+            cJSON* item = cJSON_CreateObject();
+            cJSON_AddStringToObject(item, "name", sizes[i].name);
+            cJSON_AddNumberToObject(item, "pages", sizes[i].pages);
+            cJSON_AddNumberToObject(item, "bytes", sizes[i].bytes);
+            cJSON_AddItemToArray(sizes_json, item);
+        }
+        cJSON_AddItemToObject(json, "tables", sizes_json);
+        free(sizes);
+    }
+    
+    cJSON* summary_json = cJSON_CreateObject();
+    for (int i = 0; i < (int)(sizeof(metrics) / sizeof(metrics[0])); i++) {
+        MetricSummary summary;
+        if (get_metric_summary(metrics[i], from, to, &summary)) {
+            cJSON* item = cJSON_CreateObject();
+            cJSON_AddNumberToObject(item, "samples", summary.sample_count);
+            cJSON_AddNumberToObject(item, "min", summary.min);
+            cJSON_AddNumberToObject(item, "max", summary.max);
+            cJSON_AddNumberToObject(item, "avg", summary.avg);
+            cJSON_AddItemToObject(summary_json, metrics[i], item);
+        }
+    }
+    cJSON_AddItemToObject(json, "summary", summary_json);
+    cJSON_AddNumberToObject(json, "from", from);
+    cJSON_AddNumberToObject(json, "to", to);
+    
+    char* json_string = cJSON_Print(json);
+    create_http_response(response, HTTP_200_OK, "application/json", json_string);
+    free(json_string);
+    cJSON_Delete(json);
+}
+
+// API: Log statistics over the active log and its rotated segments,
+// e.g. /api/logs/stats?days=7
+void api_get_log_stats(const HttpRequest* request, HttpResponse* response) {
+    static const char* level_names[LOG_KERNEL_LEVELS] = { "debug", "info", "warning", "error" };
+    int days = (int)get_query_param_int(request, "days", 7);
+    if (days <= 0 || days > LOG_ANALYSIS_DAYS) days = 7;
+    
+    LogStatistics stats;
+    if (!update_log_set_statistics(0, time(NULL), &stats)) {
+        create_http_response(response, HTTP_404_NOT_FOUND, "application/json", 
+            "{\"error\":\"No log files found\"}");
+        return;
+    }
+    
+    cJSON* json = cJSON_CreateObject();
+    cJSON_AddNumberToObject(json, "files", stats.files);
+    cJSON_AddNumberToObject(json, "bytes", (double)stats.bytes);
+    cJSON_AddNumberToObject(json, "lines", (double)stats.counts.lines);
+    cJSON_AddStringToObject(json, "first_time", stats.first_time);
+    cJSON_AddStringToObject(json, "last_time", stats.last_time);
+    
+    cJSON* levels_json = cJSON_CreateObject();
+    for (int level = 0; level < LOG_KERNEL_LEVELS; level++) {
+        cJSON_AddNumberToObject(levels_json, level_names[level], (double)stats.counts.levels[level]);
+    }
+    cJSON_AddNumberToObject(levels_json, "unclassified", (double)stats.counts.unclassified);
+    cJSON_AddItemToObject(json, "levels", levels_json);
+    
+    cJSON* hourly_json = cJSON_CreateArray();
+    for (int hour = 0; hour < 24; hour++) {
+        cJSON_AddItemToArray(hourly_json, cJSON_CreateNumber((double)stats.hourly[hour]));
+    }
+    cJSON_AddItemToObject(json, "hourly", hourly_json);
+    
+    // Newest day first, as in the time-based analysis menu
+    cJSON* daily_json = cJSON_CreateArray();
+    for (int day = 0; day < days; day++) {
+        cJSON* item = cJSON_CreateObject();
+        cJSON_AddNumberToObject(item, "days_ago", day);
+        for (int level = 0; level < LOG_KERNEL_LEVELS; level++) {
+            cJSON_AddNumberToObject(item, level_names[level], (double)stats.daily[day][level]);
+        }
+        cJSON_AddNumberToObject(item, "unclassified", (double)stats.daily[day][LOG_KERNEL_LEVELS]);
+        cJSON_AddItemToArray(daily_json, item);
+    }
+    cJSON_AddItemToObject(json, "daily", daily_json);
+    
+    cJSON* categories_json = cJSON_CreateObject();
+    for (int category = 0; category < LOG_CATEGORY_COUNT; category++) {
+        cJSON_AddNumberToObject(categories_json, get_log_category_name((LogErrorCategory)category),
+                                (double)stats.error_categories[category]);
+    }
+    cJSON_AddItemToObject(json, "error_categories", categories_json);
+    
+    cJSON* messages_json = cJSON_CreateArray();
+    for (int i = 0; i < stats.top_message_count; i++) {
+        cJSON* item = cJSON_CreateObject();
+        cJSON_AddStringToObject(item, "text", stats.top_messages[i].text);
+        cJSON_AddNumberToObject(item, "count", (double)stats.top_messages[i].count);
+        cJSON_AddNumberToObject(item, "error", (double)stats.top_messages[i].error);
+        cJSON_AddItemToArray(messages_json, item);
+    }
+    cJSON_AddItemToObject(json, "top_messages", messages_json);
+    
+    cJSON* errors_json = cJSON_CreateArray();
+    for (int i = 0; i < stats.recent_error_count; i++) {
+        cJSON* item = cJSON_CreateObject();
+        cJSON_AddStringToObject(item, "time", stats.recent_errors[i].time);
+        cJSON_AddStringToObject(item, "message", stats.recent_errors[i].message);
+        cJSON_AddItemToArray(errors_json, item);
+    }
+    cJSON_AddItemToObject(json, "recent_errors", errors_json);
+    
+    char* json_string = cJSON_PrintUnformatted(json);
+    create_http_response(response, HTTP_200_OK, "application/json", json_string);
+    free(json_string);
+    cJSON_Delete(json);
+}
+
+static cJSON* create_log_alert_json(const LogAlert* alert) {
+    cJSON* item = cJSON_CreateObject();
+    cJSON_AddNumberToObject(item, "timestamp", (double)alert->timestamp);
+    cJSON_AddStringToObject(item, "level", get_log_level_string((LogLevel)alert->level));
+    cJSON_AddNumberToObject(item, "line_count", alert->line_count);
+    cJSON_AddNumberToObject(item, "threshold", alert->threshold);
+    cJSON_AddStringToObject(item, "message", alert->message);
+    return item;
+}
+
+// API: Counters of the live log follow and its latest alerts
+void api_get_log_live(const HttpRequest* request, HttpResponse* response) {
+    static const char* level_names[LOG_KERNEL_LEVELS] = { "debug", "info", "warning", "error" };
+    (void)request;
+    
+    LogFollowStatus status;
+    get_log_follow_status(&status);
+    
+    cJSON* json = cJSON_CreateObject();
+    cJSON_AddBoolToObject(json, "running", status.running);
+    cJSON_AddStringToObject(json, "watcher", status.inotify ? "inotify" : "polling");
+    cJSON_AddNumberToObject(json, "started", (double)status.started);
+    cJSON_AddNumberToObject(json, "lines", (double)status.counts.lines);
+    cJSON_AddNumberToObject(json, "alert_count", (double)status.alert_count);
+    
+    cJSON* levels_json = cJSON_CreateObject();
+    cJSON* minute_json = cJSON_CreateObject();
+    cJSON* thresholds_json = cJSON_CreateObject();
+    for (int level = 0; level < LOG_KERNEL_LEVELS; level++) {
+        cJSON_AddNumberToObject(levels_json, level_names[level], (double)status.counts.levels[level]);
+        cJSON_AddNumberToObject(minute_json, level_names[level], (double)status.last_minute[level]);
+        cJSON_AddNumberToObject(thresholds_json, level_names[level], status.thresholds[level]);
+    }
+    cJSON_AddNumberToObject(levels_json, "unclassified", (double)status.counts.unclassified);
+    cJSON_AddNumberToObject(minute_json, "unclassified", (double)status.last_minute[LOG_KERNEL_LEVELS]);
+    cJSON_AddItemToObject(json, "levels", levels_json);
+    cJSON_AddItemToObject(json, "last_minute", minute_json);
+    cJSON_AddItemToObject(json, "thresholds_per_minute", thresholds_json);
+    
+    cJSON* files_json = cJSON_CreateArray();
+    for (int i = 0; i < status.file_count; i++) {
+        cJSON* item = cJSON_CreateObject();
+        cJSON_AddStringToObject(item, "path", status.files[i].path);
+        cJSON_AddBoolToObject(item, "open", status.files[i].open);
+        cJSON_AddBoolToObject(item, "binary", status.files[i].binary);
+        cJSON_AddNumberToObject(item, "lines", (double)status.files[i].counts.lines);
+        cJSON_AddNumberToObject(item, "bytes", (double)status.files[i].bytes);
+        cJSON_AddNumberToObject(item, "rotations", status.files[i].rotations);
+        cJSON_AddItemToArray(files_json, item);
+    }
+    cJSON_AddItemToObject(json, "files", files_json);
+    
+    // Newest first, as in /api/logs/alerts
+    cJSON* alerts_json = cJSON_CreateArray();
+    for (int i = status.recent_alert_count - 1; i >= 0; i--) {
+        cJSON_AddItemToArray(alerts_json, create_log_alert_json(&status.recent_alerts[i]));
+    }
+    cJSON_AddItemToObject(json, "recent_alerts", alerts_json);
+    
+    char* json_string = cJSON_PrintUnformatted(json);
+    create_http_response(response, HTTP_200_OK, "application/json", json_string);
+    free(json_string);
+    cJSON_Delete(json);
+}
+
+// API: Stored log alerts, newest first, e.g. /api/logs/alerts?limit=20
+void api_get_log_alerts(const HttpRequest* request, HttpResponse* response) {
+    int limit = (int)get_query_param_int(request, "limit", 50);
+    if (limit <= 0 || limit > 1000) limit = 50;
+    
+    LogAlert* alerts = NULL;
+    int count = 0;
+    if (!get_log_alerts(&alerts, &count, limit)) {
+        create_http_response(response, HTTP_500_INTERNAL_ERROR, "application/json", 
+            "{\"error\":\"Failed to retrieve log alerts\"}");
+        return;
+    }
+    
+    cJSON* json = cJSON_CreateArray();
+    for (int i = 0; i < count; i++) {
+        cJSON_AddItemToArray(json, create_log_alert_json(&alerts[i]));
+    }
+    free(alerts);
+    
+    char* json_string = cJSON_PrintUnformatted(json);
+    create_http_response(response, HTTP_200_OK, "application/json", json_string);
+    free(json_string);
+    cJSON_Delete(json);
+}
+
+// Read a text query parameter, e.g. "format=csv"
+static bool get_query_param_string(const HttpRequest* request, const char* name, char* value, size_t size) {
+    char key[64];
+    snprintf(key, sizeof(key), "%s=", name);
+    
+    const char* param = strstr(request->query_string, key);
+    while (param && param != request->query_string && *(param - 1) != '&') {
+        param = strstr(param + 1, key);
+    }
+    if (!param) {
+        return false;
+    }
+    
+    param += strlen(key);
+    size_t length = strcspn(param, "&");
+    if (length >= size) {
+        length = size - 1;
+    }
+    memcpy(value, param, length);
+    value[length] = '\0';
+    return true;
+}
+
+static bool send_all(int client_socket, const char* data, size_t size) {
+    #ifdef MSG_NOSIGNAL
+    int flags = MSG_NOSIGNAL; // a client that hangs up must not kill the server
+    #else
+    int flags = 0;
+    #endif
+    
+    while (size > 0) {
+        int sent = send(client_socket, data, (int)size, flags);
+        if (sent <= 0) {
+            return false;
+        }
+        data += sent;
+        size -= sent;
+    }
+    return true;
+}
+
+// Each export buffer becomes one HTTP chunk
+static bool chunked_socket_sink(const void* data, size_t size, void* user_data) {
+    int client_socket = *(int*)user_data;
+    char chunk_header[32];
+    snprintf(chunk_header, sizeof(chunk_header), "%lx\r\n", (unsigned long)size);
+    
+    return send_all(client_socket, chunk_header, strlen(chunk_header)) &&
+           send_all(client_socket, (const char*)data, size) &&
+           send_all(client_socket, "\r\n", 2);
+}
+
+// API: Stream a table as CSV, NDJSON or binary
+// e.g. /api/export?table=system_metrics&format=ndjson&from=1700000000&to=1700600000
+void api_stream_export(int client_socket, const HttpRequest* request) {
+    char table_name[64] = "";
+    char format_name[16] = "csv";
+    ExportTable table;
+    ExportFormat format;
+    
+    get_query_param_string(request, "table", table_name, sizeof(table_name));
+    get_query_param_string(request, "format", format_name, sizeof(format_name));
+    
+    if (!export_table_from_name(table_name, &table) || !export_format_from_name(format_name, &format)) {
+        HttpResponse response;
+        create_http_response(&response, HTTP_400_BAD_REQUEST, "application/json",
+            "{\"error\":\"Unknown table or format\"}");
+        if (config.enable_cors) {
+            add_cors_headers(&response);
+        }
+        send_http_response(client_socket, &response);
+        return;
+    }
+    
+    time_t from = (time_t)get_query_param_int(request, "from", 0);
+    time_t to = (time_t)get_query_param_int(request, "to", 0);
+    
+    // The row count is unknown up front, so the body is sent chunked
+    char header[512];
+    snprintf(header, sizeof(header),
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Type: %s\r\n"
+        "Content-Disposition: attachment; filename=\"%s.%s\"\r\n"
+        "Transfer-Encoding: chunked\r\n"
+        "Server: AutomationCenter/1.0\r\n"
+        "%s"
+        "\r\n",
+        export_format_content_type(format), export_table_name(table), export_format_extension(format),
+        config.enable_cors ? "Access-Control-Allow-Origin: *\r\n" : "");
+    
+    if (!send_all(client_socket, header, strlen(header))) {
+        return;
+    }
+    
+    long long rows = 0;
+    if (export_table(table, format, from, to, chunked_socket_sink, &client_socket, &rows)) {
+        // Terminating chunk; a failed export ends without it so the client sees a truncated body
+        send_all(client_socket, "0\r\n\r\n", 5);
+        log_info("Streamed %lld rows of %s", rows, export_table_name(table));
+    } else {
+        log_warning("Export of %s aborted after %lld rows", export_table_name(table), rows);
+    }
+}
+
 // API: Get file operations
 void api_get_file_operations(const HttpRequest* request, HttpResponse* response) {
     FileOperation* operations = NULL;